@@ -49,6 +49,7 @@ namespace eos
         UsedParameter tau_B;
 
         SwitchOption opt_l;
+        LeptonFlavour lepton_flavour;
 
         UsedParameter m_l;
 
@@ -60,6 +61,7 @@ namespace eos
             f_B(p["decay-constant::B_u"], u),
             tau_B(p["life_time::B_u"], u),
             opt_l(o, "l", {"e", "mu", "tau"}, "tau"),
+            lepton_flavour(lepton_flavour_from_option(opt_l.value())),
             m_l(p["mass::" + opt_l.value()], u)
         {
             u.uses(*model);
@@ -72,7 +74,7 @@ namespace eos
 
         double decay_width() const
         {
-            const WilsonCoefficients<ChargedCurrent> wc = model->wilson_coefficients_b_to_u(opt_l.value(), false);
+            const WilsonCoefficients<ChargedCurrent> wc = model->wilson_coefficients_b_to_u(lepton_flavour, false);
 
             // cf. [DBG2013], eq. (5), p. 5
             const complex<double> ga = wc.cvl() - wc.cvr();
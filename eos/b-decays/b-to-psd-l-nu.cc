@@ -68,6 +68,7 @@ namespace eos
         UsedParameter m_P;
 
         SwitchOption opt_l;
+        LeptonFlavour lepton_flavour;
 
         UsedParameter m_l;
 
@@ -77,7 +78,7 @@ namespace eos
 
         std::function<double (const double &)> m_U_msbar;
         std::function<complex<double> ()> v_Ub;
-        std::function<WilsonCoefficients<ChargedCurrent> (const std::string &, bool)> wc;
+        std::function<WilsonCoefficients<ChargedCurrent> (const LeptonFlavour &, bool)> wc;
 
         GSL::QAGS::Config int_config;
 
@@ -171,6 +172,7 @@ namespace eos
             tau_B(p["life_time::B_" + opt_q.value()], u),
             m_P(p[_mass_P()], u),
             opt_l(o, "l", {"e", "mu", "tau"}, "mu"),
+            lepton_flavour(lepton_flavour_from_option(opt_l.value())),
             m_l(p["mass::" + opt_l.value()], u),
             g_fermi(p["G_Fermi"], u),
             hbar(p["hbar"], u),
@@ -203,7 +205,7 @@ namespace eos
         b_to_psd_l_nu::Amplitudes amplitudes(const double & s) const
         {
             // NP contributions in EFT including tensor operator (cf. [DDS:2014A]).
-            auto wc = this->wc(opt_l.value(), false);
+            auto wc = this->wc(lepton_flavour, false);
             const complex<double> gV = wc.cvr() + (wc.cvl() - 1.0); // in SM cvl=1 => gV contains NP contribution of cvl
             const complex<double> gS = wc.csr() + wc.csl();
             const complex<double> gT = wc.ct();
@@ -207,6 +207,7 @@ namespace eos
         UsedParameter g_fermi;
 
         SwitchOption opt_l;
+        LeptonFlavour lepton_flavour;
 
         UsedParameter m_l;
 
@@ -244,6 +245,7 @@ namespace eos
             tau_B(p["life_time::B_" + opt_q.value()], u),
             g_fermi(p["G_Fermi"], u),
             opt_l(o, "l", {"e", "mu", "tau"}, "mu"),
+            lepton_flavour(lepton_flavour_from_option(opt_l.value())),
             m_l(p["mass::" + opt_l.value()], u),
             m_B(p["mass::B_" + opt_q.value()], u),
             m_V(p["mass::D_" + opt_q.value() + "^*"], u),
@@ -277,7 +279,7 @@ namespace eos
             b_to_dstar_l_nu::Amplitudes result;
 
             // NP contributions in EFT including tensor operator cf. [DSD2014], p. 3
-            const WilsonCoefficients<ChargedCurrent> wc = model->wilson_coefficients_b_to_c(opt_l.value(), false);
+            const WilsonCoefficients<ChargedCurrent> wc = model->wilson_coefficients_b_to_c(lepton_flavour, false);
             const complex<double> VL = wc.cvl() - 1.0;
             const complex<double> VR = wc.cvr();
             const complex<double> SL = wc.csl();
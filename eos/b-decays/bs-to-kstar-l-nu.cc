@@ -59,6 +59,7 @@ namespace eos
         UsedParameter m_b_MSbar;
 
         SwitchOption opt_l;
+        LeptonFlavour lepton_flavour;
         
         UsedParameter m_l;
 
@@ -77,6 +78,7 @@ namespace eos
             m_Kstar(p["mass::K_u^*"], u),
             m_b_MSbar(p["mass::b(MSbar)"], u),
             opt_l(o, "l", {"e", "mu", "tau"}, "mu"),
+            lepton_flavour(lepton_flavour_from_option(opt_l.value())),
             m_l(p["mass::" + opt_l.value()], u),
             mu(p["mu"], u),
             g_fermi(p["G_Fermi"], u),
@@ -107,7 +109,7 @@ namespace eos
         {
             static const double sqrt2 = sqrt(2.0);
 
-            WilsonCoefficients<ChargedCurrent> wc = model->wilson_coefficients_b_to_u(opt_l.value(), false);
+            WilsonCoefficients<ChargedCurrent> wc = model->wilson_coefficients_b_to_u(lepton_flavour, false);
             double m_Bs2 = m_Bs * m_Bs;
             double sqrts = sqrt(s), lam = lambda(m_Bs * m_Bs, m_Kstar * m_Kstar, s), sqrtlam = sqrt(lam);
             double N = this->norm(s);
@@ -33,10 +33,12 @@ namespace eos
         std::shared_ptr<Model> model;
 
         SwitchOption opt_l;
+        LeptonFlavour lepton_flavour;
         
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "SM"), p, o)),
-            opt_l(o, "l", {"e", "mu", "tau"}, "mu")
+            opt_l(o, "l", {"e", "mu", "tau"}, "mu"),
+            lepton_flavour(lepton_flavour_from_option(opt_l.value()))
         {
             u.uses(*model);
         }
@@ -50,7 +52,7 @@ namespace eos
             // inclusive |V_ub|^2 = |V_ub^eff|^2 (|C_V,LL|^2 + |C_V,RL|^2)
 
             double v_ub_eff_squared = std::norm(model->ckm_ub());
-            auto wc = model->wilson_coefficients_b_to_u(opt_l.value(), false);
+            auto wc = model->wilson_coefficients_b_to_u(lepton_flavour, false);
 
             return std::sqrt(v_ub_eff_squared * (std::norm(wc.cvl()) + std::norm(wc.cvr())));
         }
@@ -268,6 +268,7 @@ namespace eos
         UsedParameter g_fermi;
 
         SwitchOption opt_l;
+        LeptonFlavour lepton_flavour;
         UsedParameter m_l;
 
         UsedParameter m_Lambda_b;
@@ -285,6 +286,7 @@ namespace eos
             tau_Lambda_b(p["life_time::Lambda_b"], u),
             g_fermi(p["G_Fermi"], u),
             opt_l(o, "l", {"e", "mu", "tau"}, "mu"),
+            lepton_flavour(lepton_flavour_from_option(opt_l.value())),
             m_l(p["mass::" + opt_l.value()], u),
             m_Lambda_b(p["mass::Lambda_b"], u),
             m_Lambda_c(p["mass::Lambda_c"], u),
@@ -320,7 +322,7 @@ namespace eos
             lambdab_to_lambdac_l_nu::Amplitudes result;
 
             // uses the b->c WCs in EOS basis
-            const auto wc = model->wilson_coefficients_b_to_c(opt_l.value(), false);
+            const auto wc = model->wilson_coefficients_b_to_c(lepton_flavour, false);
             const complex<double> cvl = wc.cvl();
             const complex<double> cvr = wc.cvr();
             const complex<double> csl = wc.csl();
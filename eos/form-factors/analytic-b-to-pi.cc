@@ -29,9 +29,12 @@
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qcd.hh>
+#include <eos/utils/thread_pool.hh>
 
 #include <functional>
 #include <limits>
+#include <map>
+#include <vector>
 
 #include <gsl/gsl_sf_gamma.h>
 
@@ -72,6 +75,18 @@ namespace eos
 
         GSL::QAGS::Config config;
 
+        /*
+         * The form factors and the decay constant are cached for the current parameter point,
+         * and recomputed only if the value of any parameter (including those of the model and
+         * the pion LCDAs) has changed.
+         */
+        std::vector<Parameter> dependencies;
+
+        // the values of all dependencies, for which the cached results are valid
+        mutable std::vector<double> results_key;
+        mutable double result_decay_constant;
+        mutable std::map<double, double> results_f_p, results_f_0, results_f_t;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make("SM", p, o)),
             MB(p["mass::B_d"], u),
@@ -115,6 +130,63 @@ namespace eos
             }
 
             u.uses(*model);
+
+            for (const auto & id : u)
+            {
+                dependencies.push_back(p[id]);
+            }
+
+            for (const auto & id : pi)
+            {
+                dependencies.push_back(p[id]);
+            }
+
+            results_key.resize(dependencies.size(), std::numeric_limits<double>::quiet_NaN());
+            result_decay_constant = std::numeric_limits<double>::quiet_NaN();
+        }
+
+        // discard all cached results if any parameter has changed since they were computed
+        void validate_results() const
+        {
+            bool valid = true;
+            for (unsigned i = 0 ; valid && (i < dependencies.size()) ; ++i)
+            {
+                valid = (results_key[i] == dependencies[i].evaluate());
+            }
+
+            if (valid)
+                return;
+
+            for (unsigned i = 0 ; i < dependencies.size() ; ++i)
+            {
+                results_key[i] = dependencies[i].evaluate();
+            }
+
+            result_decay_constant = std::numeric_limits<double>::quiet_NaN();
+            results_f_p.clear();
+            results_f_0.clear();
+            results_f_t.clear();
+        }
+
+        /*
+         * Evaluate independent integrals concurrently on the thread pool.
+         *
+         * The pion LCDAs cache their coefficients for the most recent scale. All integrands are evaluated
+         * at the scale mu, and we evaluate the LCDAs' coefficients at mu in the calling thread, so that
+         * the integrands only read from that cache. Exceptions propagate to the calling thread.
+         */
+        std::vector<double> integrate_concurrently(const std::vector<std::function<double ()>> & integrals) const
+        {
+            this->pi.mupi(mu);
+
+            std::vector<double> results(integrals.size(), 0.0);
+
+            ThreadPool::instance()->parallel_for(integrals.size(), [&] (const unsigned & i)
+            {
+                results[i] = integrals[i]();
+            });
+
+            return results;
         }
 
         inline double m_b_msbar(const double & mu) const
@@ -161,6 +233,18 @@ namespace eos
         }
 
         double decay_constant() const
+        {
+            validate_results();
+
+            if (std::isnan(result_decay_constant))
+            {
+                result_decay_constant = _decay_constant();
+            }
+
+            return result_decay_constant;
+        }
+
+        double _decay_constant() const
         {
             static const double pi = M_PI, pi2 = pi * pi;
             static const double eps = 1.0e-10;
@@ -227,14 +311,17 @@ namespace eos
                     return std::exp(-s / Mprime2) * ((s - mb2) * (s - mb2) + 4.0 * s * alpha_s_mu / (3.0 * pi) * rho_1(s, mb, mu));
                 }
             );
-            const double integral_numerator = integrate<GSL::QAGS>(integrand_numerator, mb2 + eps, sprime0B, config);
             std::function<double (const double &)> integrand_denominator(
                 [&] (const double & s) -> double
                 {
                     return std::exp(-s / Mprime2) * ((s - mb2) * (s - mb2) / s + 4.0 * alpha_s_mu / (3.0 * pi) * rho_1(s, mb, mu));
                 }
             );
-            const double integral_denominator = integrate<GSL::QAGS>(integrand_denominator, mb2 + eps, sprime0B, config);
+            const std::vector<double> integrals = integrate_concurrently({
+                [&] () { return integrate<GSL::QAGS>(integrand_numerator,   mb2 + eps, sprime0B, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_denominator, mb2 + eps, sprime0B, config); }
+            });
+            const double integral_numerator = integrals[0], integral_denominator = integrals[1];
 
             double numerator = 3.0 * mb2 / (8.0 * pi2) * integral_numerator
                 + mb4 * std::exp(-mb2 / Mprime2) * (
@@ -1641,8 +1728,14 @@ namespace eos
                 }
             );
 
-            double result = integrate<GSL::QAGS>(integrand_numerator_zero, u0_zero, 1.000, config) / integrate<GSL::QAGS>(integrand_numerator_q2, u0_q2, 1.000, config)
-                / integrate<GSL::QAGS>(integrand_denominator_zero, u0_zero, 1.000, config) * integrate<GSL::QAGS>(integrand_denominator_q2, u0_q2, 1.000, config);
+            const std::vector<double> integrals = integrate_concurrently({
+                [&] () { return integrate<GSL::QAGS>(integrand_numerator_zero,   u0_zero, 1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_numerator_q2,     u0_q2,   1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_denominator_zero, u0_zero, 1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_denominator_q2,   u0_q2,   1.000, config); }
+            });
+
+            double result = integrals[0] / integrals[1] / integrals[2] * integrals[3];
             return result;
         }
 
@@ -1684,8 +1777,14 @@ namespace eos
                 }
             );
 
-            double result = integrate<GSL::QAGS>(integrand_numerator_zero, u0_zero, 1.000, config) / integrate<GSL::QAGS>(integrand_numerator_q2, u0_q2, 1.000, config)
-                / integrate<GSL::QAGS>(integrand_denominator_zero, u0_zero, 1.000, config) * integrate<GSL::QAGS>(integrand_denominator_q2, u0_q2, 1.000, config);
+            const std::vector<double> integrals = integrate_concurrently({
+                [&] () { return integrate<GSL::QAGS>(integrand_numerator_zero,   u0_zero, 1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_numerator_q2,     u0_q2,   1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_denominator_zero, u0_zero, 1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_denominator_q2,   u0_q2,   1.000, config); }
+            });
+
+            double result = integrals[0] / integrals[1] / integrals[2] * integrals[3];
 
             return result;
         }
@@ -1721,8 +1820,14 @@ namespace eos
                 }
             );
 
-            double result = integrate<GSL::QAGS>(integrand_numerator_zero, u0_zero, 1.000, config) / integrate<GSL::QAGS>(integrand_numerator_q2, u0_q2, 1.000, config)
-                / integrate<GSL::QAGS>(integrand_denominator_zero, u0_zero, 1.000, config) * integrate<GSL::QAGS>(integrand_denominator_q2, u0_q2, 1.000, config);
+            const std::vector<double> integrals = integrate_concurrently({
+                [&] () { return integrate<GSL::QAGS>(integrand_numerator_zero,   u0_zero, 1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_numerator_q2,     u0_q2,   1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_denominator_zero, u0_zero, 1.000, config); },
+                [&] () { return integrate<GSL::QAGS>(integrand_denominator_q2,   u0_q2,   1.000, config); }
+            });
+
+            double result = integrals[0] / integrals[1] / integrals[2] * integrals[3];
 
             return result;
         }
@@ -1736,8 +1841,14 @@ namespace eos
             std::function<double (const double &)> F(
                 [&] (const double & _M2) -> double
                 {
-                    const double F_lo  = F_lo_tw2(q2, _M2) + F_lo_tw3(q2, _M2) + F_lo_tw4(q2, _M2);
-                    const double F_nlo = F_nlo_tw2(q2, _M2) + F_lo_tw3(q2, _M2);
+                    const std::vector<double> terms = integrate_concurrently({
+                        [&] () { return F_lo_tw2(q2, _M2); },
+                        [&] () { return F_lo_tw3(q2, _M2); },
+                        [&] () { return F_lo_tw4(q2, _M2); },
+                        [&] () { return F_nlo_tw2(q2, _M2); }
+                    });
+                    const double F_lo  = terms[0] + terms[1] + terms[2];
+                    const double F_nlo = terms[3] + terms[1];
 
                     return F_lo + alpha_s / (3.0 * M_PI) * F_nlo;
                 }
@@ -1764,10 +1875,20 @@ namespace eos
             std::function<double (const double &)> F0(
                 [&] (const double & _M2) -> double
                 {
-                    const double F_lo     = F_lo_tw2(q2, _M2) + F_lo_tw3(q2, _M2) + F_lo_tw4(q2, _M2);
-                    const double F_nlo    = F_nlo_tw2(q2, _M2) + F_nlo_tw3(q2, _M2);
-                    const double Ftil_lo  = Ftil_lo_tw3(q2, _M2) + Ftil_lo_tw4(q2, _M2);
-                    const double Ftil_nlo = Ftil_nlo_tw2(q2, _M2) + Ftil_lo_tw3(q2, _M2);
+                    const std::vector<double> terms = integrate_concurrently({
+                        [&] () { return F_lo_tw2(q2, _M2); },
+                        [&] () { return F_lo_tw3(q2, _M2); },
+                        [&] () { return F_lo_tw4(q2, _M2); },
+                        [&] () { return F_nlo_tw2(q2, _M2); },
+                        [&] () { return F_nlo_tw3(q2, _M2); },
+                        [&] () { return Ftil_lo_tw3(q2, _M2); },
+                        [&] () { return Ftil_lo_tw4(q2, _M2); },
+                        [&] () { return Ftil_nlo_tw2(q2, _M2); }
+                    });
+                    const double F_lo     = terms[0] + terms[1] + terms[2];
+                    const double F_nlo    = terms[3] + terms[4];
+                    const double Ftil_lo  = terms[5] + terms[6];
+                    const double Ftil_nlo = terms[7] + terms[5];
 
                     const double F        = F_lo + alpha_s / (3.0 * M_PI) * F_nlo;
                     const double Ftil     = Ftil_lo + alpha_s / (3.0 * M_PI) * Ftil_nlo;
@@ -1792,8 +1913,14 @@ namespace eos
             std::function<double (const double &)> F(
                 [&] (const double & _M2) -> double
                 {
-                    const double FT_lo  = FT_lo_tw2(q2, _M2) + FT_lo_tw3(q2, _M2) + FT_lo_tw4(q2, _M2);
-                    const double FT_nlo = FT_nlo_tw2(q2, _M2) + FT_lo_tw3(q2, _M2);
+                    const std::vector<double> terms = integrate_concurrently({
+                        [&] () { return FT_lo_tw2(q2, _M2); },
+                        [&] () { return FT_lo_tw3(q2, _M2); },
+                        [&] () { return FT_lo_tw4(q2, _M2); },
+                        [&] () { return FT_nlo_tw2(q2, _M2); }
+                    });
+                    const double FT_lo  = terms[0] + terms[1] + terms[2];
+                    const double FT_nlo = terms[3] + terms[1];
 
                     return FT_lo + alpha_s / (3.0 * M_PI) * FT_nlo;
                 }
@@ -1809,12 +1936,32 @@ namespace eos
         }
 
         double f_p(const double & q2) const
+        {
+            validate_results();
+
+            auto r = results_f_p.find(q2);
+            if (results_f_p.end() == r)
+            {
+                r = results_f_p.insert(std::make_pair(q2, _f_p(q2))).first;
+            }
+
+            return r->second;
+        }
+
+        double _f_p(const double & q2) const
         {
             const double MB2 = MB * MB;
             const double M2_rescaled = this->M2() * this->rescale_factor_p(q2);
             const double fB = decay_constant();
-            const double F_lo = F_lo_tw2(q2, M2_rescaled) + F_lo_tw3(q2, M2_rescaled) + F_lo_tw4(q2, M2_rescaled);
-            const double F_nlo = F_nlo_tw2(q2, M2_rescaled) + F_nlo_tw3(q2, M2_rescaled);
+            const std::vector<double> terms = integrate_concurrently({
+                [&] () { return F_lo_tw2(q2, M2_rescaled); },
+                [&] () { return F_lo_tw3(q2, M2_rescaled); },
+                [&] () { return F_lo_tw4(q2, M2_rescaled); },
+                [&] () { return F_nlo_tw2(q2, M2_rescaled); },
+                [&] () { return F_nlo_tw3(q2, M2_rescaled); }
+            });
+            const double F_lo = terms[0] + terms[1] + terms[2];
+            const double F_nlo = terms[3] + terms[4];
             /*
              * we estimate the NNLO corrections to obey the relation |F_nnlo / F_nlo| = |F_nlo / F_lo|.
              * Therefore we set F_nnlo = F_nlo^2 / F_lo * zeta_nnlo, where zeta ranges between -1 and +1.
@@ -1831,13 +1978,37 @@ namespace eos
             if (std::abs(q2) < 1e-6)
                 return f_p(q2);
 
+            validate_results();
+
+            auto r = results_f_0.find(q2);
+            if (results_f_0.end() == r)
+            {
+                r = results_f_0.insert(std::make_pair(q2, _f_0(q2))).first;
+            }
+
+            return r->second;
+        }
+
+        double _f_0(const double & q2) const
+        {
             const double MB2 = MB * MB, mpi2 = mpi * mpi;
             const double M2_rescaled = this->M2() * this->rescale_factor_0(q2);
             const double fB = decay_constant();
-            const double F_lo = F_lo_tw2(q2, M2_rescaled) + F_lo_tw3(q2, M2_rescaled) + F_lo_tw4(q2, M2_rescaled);
-            const double F_nlo = F_nlo_tw2(q2, M2_rescaled) + F_nlo_tw3(q2, M2_rescaled);
-            const double Ftil_lo = Ftil_lo_tw3(q2, M2_rescaled) + Ftil_lo_tw4(q2, M2_rescaled);
-            const double Ftil_nlo = Ftil_nlo_tw2(q2, M2_rescaled) + Ftil_nlo_tw3(q2, M2_rescaled);
+            const std::vector<double> terms = integrate_concurrently({
+                [&] () { return F_lo_tw2(q2, M2_rescaled); },
+                [&] () { return F_lo_tw3(q2, M2_rescaled); },
+                [&] () { return F_lo_tw4(q2, M2_rescaled); },
+                [&] () { return F_nlo_tw2(q2, M2_rescaled); },
+                [&] () { return F_nlo_tw3(q2, M2_rescaled); },
+                [&] () { return Ftil_lo_tw3(q2, M2_rescaled); },
+                [&] () { return Ftil_lo_tw4(q2, M2_rescaled); },
+                [&] () { return Ftil_nlo_tw2(q2, M2_rescaled); },
+                [&] () { return Ftil_nlo_tw3(q2, M2_rescaled); }
+            });
+            const double F_lo = terms[0] + terms[1] + terms[2];
+            const double F_nlo = terms[3] + terms[4];
+            const double Ftil_lo = terms[5] + terms[6];
+            const double Ftil_nlo = terms[7] + terms[8];
             //const double Ftil_nnlo = F_nlo * F_nlo / F_lo * zeta_nnlo;
             const double alpha_s = model->alpha_s(mu);
 
@@ -1845,13 +2016,33 @@ namespace eos
         }
 
         double f_t(const double & q2) const
+        {
+            validate_results();
+
+            auto r = results_f_t.find(q2);
+            if (results_f_t.end() == r)
+            {
+                r = results_f_t.insert(std::make_pair(q2, _f_t(q2))).first;
+            }
+
+            return r->second;
+        }
+
+        double _f_t(const double & q2) const
         {
             const double mb = this->m_b_msbar(mu);
             const double MB2 = MB * MB;
             const double M2_rescaled = this->M2() * this->rescale_factor_T(q2);
             const double fB = decay_constant();
-            const double FT_lo = FT_lo_tw2(q2, M2_rescaled) + FT_lo_tw3(q2, M2_rescaled) + FT_lo_tw4(q2, M2_rescaled);
-            const double FT_nlo = FT_nlo_tw2(q2, M2_rescaled) + FT_nlo_tw3(q2, M2_rescaled);
+            const std::vector<double> terms = integrate_concurrently({
+                [&] () { return FT_lo_tw2(q2, M2_rescaled); },
+                [&] () { return FT_lo_tw3(q2, M2_rescaled); },
+                [&] () { return FT_lo_tw4(q2, M2_rescaled); },
+                [&] () { return FT_nlo_tw2(q2, M2_rescaled); },
+                [&] () { return FT_nlo_tw3(q2, M2_rescaled); }
+            });
+            const double FT_lo = terms[0] + terms[1] + terms[2];
+            const double FT_nlo = terms[3] + terms[4];
             //const double FT_nnlo = FT_nlo * FT_nlo / FT_lo * zeta_nnlo;
             const double alpha_s = model->alpha_s(mu);
 
@@ -242,6 +242,26 @@ class AnalyticFormFactorBToPiDKMMO2008Test :
                 TEST_CHECK_NEARLY_EQUAL( 0.3510, ff_no_rescale.f_t(  5.0), 1. * eps);
                 TEST_CHECK_NEARLY_EQUAL( 0.4904, ff_no_rescale.f_t( 10.0), 1. * eps);
 
+                // the cached results are recomputed after a change of the parameters
+                {
+                    const double f_p = ff.f_p(5.0), f_0 = ff_no_rescale.f_0(5.0), f_t = ff_no_rescale.f_t(5.0), f_B = ff.decay_constant();
+
+                    p["pi::a2@1GeV"] = 0.27;
+
+                    AnalyticFormFactorBToPiDKMMO2008 ff_fresh(p, Options{ });
+                    AnalyticFormFactorBToPiDKMMO2008 ff_no_rescale_fresh(p, Options{{"rescale-borel", "0"}});
+
+                    TEST_CHECK(std::abs(ff.f_p(5.0) - f_p) > eps);
+                    TEST_CHECK_EQUAL(ff_fresh.f_p(5.0),            ff.f_p(5.0));
+                    TEST_CHECK(std::abs(ff_no_rescale.f_0(5.0) - f_0) > eps);
+                    TEST_CHECK_EQUAL(ff_no_rescale_fresh.f_0(5.0), ff_no_rescale.f_0(5.0));
+                    TEST_CHECK(std::abs(ff_no_rescale.f_t(5.0) - f_t) > eps);
+                    TEST_CHECK_EQUAL(ff_no_rescale_fresh.f_t(5.0), ff_no_rescale.f_t(5.0));
+                    TEST_CHECK_EQUAL(ff_fresh.decay_constant(),    ff.decay_constant());
+
+                    p["QCD::cond_GG"] = 0.024;
+                    TEST_CHECK(std::abs(ff.decay_constant() - f_B) > eps);
+                }
             }
         }
 } analytic_form_factor_b_to_pi_DKMMO2008_test;
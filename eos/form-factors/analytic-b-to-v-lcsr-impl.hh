@@ -33,9 +33,13 @@
 #include <eos/utils/qcd.hh>
 #include <eos/utils/stringify.hh>
 
+#include <array>
+#include <cmath>
 #include <functional>
 
 #include <iostream>
+#include <limits>
+#include <vector>
 
 namespace eos
 {
@@ -95,6 +99,23 @@ namespace eos
         std::function<double (const Implementation *, const double &, const double &)> integrand_t23B_2pt;
         bool switch_borel;
 
+        /*
+         * The form factors A_0, A_12, T_2, T_3 and T_23 are linear combinations of the sum rules
+         * for A_1, A_2, A_30, T_23A and T_23B, and the first moments are normalized to the sum rules.
+         * We therefore cache the results of the seven sum rules for the last value of q2, and
+         * evaluate each of them at most once per q2 and parameter point.
+         */
+        enum class SumRule
+        {
+            a_1 = 0, a_2, a_30, v, t_1, t_23A, t_23B
+        };
+
+        std::vector<Parameter> dependencies;
+
+        // q2, followed by the values of all dependencies, for which the cached sum rules are valid
+        mutable std::vector<double> sum_rules_key;
+        mutable std::array<double, 7> sum_rules;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make("SM", p, o)),
             m_B(p[Process_::m_B], u),
@@ -215,6 +236,19 @@ namespace eos
                 std::cout << "   I2d1_g_bar  (sigma = 0.05, q2 = 0) = " << I2d1_A1_2pt_g_bar(sigma, q2) << std::endl;
                 #endif
             }
+
+            for (const auto & id : u)
+            {
+                dependencies.push_back(p[id]);
+            }
+
+            for (const auto & id : *model)
+            {
+                dependencies.push_back(p[id]);
+            }
+
+            sum_rules_key.resize(dependencies.size() + 1, std::numeric_limits<double>::quiet_NaN());
+            sum_rules.fill(std::numeric_limits<double>::quiet_NaN());
         }
 
         ~Implementation() = default;
@@ -400,6 +434,63 @@ namespace eos
 
             return sigma(s0, q2);
         }
+
+        double sum_rule(const SumRule & sr, const double & q2) const
+        {
+            bool valid = (sum_rules_key[0] == q2);
+            for (unsigned i = 0 ; valid && (i < dependencies.size()) ; ++i)
+            {
+                valid = (sum_rules_key[i + 1] == dependencies[i].evaluate());
+            }
+
+            if (! valid)
+            {
+                sum_rules.fill(std::numeric_limits<double>::quiet_NaN());
+
+                sum_rules_key[0] = q2;
+                for (unsigned i = 0 ; i < dependencies.size() ; ++i)
+                {
+                    sum_rules_key[i + 1] = dependencies[i].evaluate();
+                }
+            }
+
+            double & result = sum_rules[static_cast<unsigned>(sr)];
+            if (! std::isnan(result))
+                return result;
+
+            switch (sr)
+            {
+                case SumRule::a_1:
+                    result = sum_rule_a_1(q2, switch_borel);
+                    break;
+
+                case SumRule::a_2:
+                    result = sum_rule_a_2(q2, switch_borel);
+                    break;
+
+                case SumRule::a_30:
+                    result = sum_rule_a_30(q2, switch_borel);
+                    break;
+
+                case SumRule::v:
+                    result = sum_rule_v(q2, switch_borel);
+                    break;
+
+                case SumRule::t_1:
+                    result = sum_rule_t_1(q2, switch_borel);
+                    break;
+
+                case SumRule::t_23A:
+                    result = sum_rule_t_23A(q2, switch_borel);
+                    break;
+
+                case SumRule::t_23B:
+                    result = sum_rule_t_23B(q2, switch_borel);
+                    break;
+            }
+
+            return result;
+        }
         // }}}
 
         /* A_1 : 2-particle functions */
@@ -3700,14 +3791,16 @@ namespace eos
 
         /* A1 : form factor and moments */
         // {{{
-        double a_1(const double & q2) const
+        double sum_rule_a_1(const double & q2, const bool & borel) const
         {
             const double sigma_0 = this->sigma_0(q2, s0_0_A1(), s0_1_A1());
 
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_a1_2pt, this, std::placeholders::_1, q2);
+            // the first moments are always normalized to the Borel-transformed sum rule
+            const std::function<double (const Implementation *, const double &, const double &)> integrand = borel ? &Implementation::integrand_A1_2pt_borel : integrand_a1_2pt;
+            const std::function<double (const double &)> integrand_2pt = std::bind(integrand, this, std::placeholders::_1, q2);
 
             const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_A1_2pt(switch_borel ? sigma_0 : 0.0, q2);
+            const double surface_2pt  = 0.0 - surface_A1_2pt(borel ? sigma_0 : 0.0, q2);
 
             double integral_3pt = 0.0;
             double surface_3pt  = 0.0;
@@ -3727,7 +3820,12 @@ namespace eos
                              - surface_A1_3pt_D(sigma_0, q2);
             }
 
-            return f_B() * pow(m_B(), 3) / (2.0 * f_V() * m_V * (m_B + m_V)) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+        }
+
+        double a_1(const double & q2) const
+        {
+            return f_B() * pow(m_B(), 3) / (2.0 * f_V() * m_V * (m_B + m_V)) * sum_rule(SumRule::a_1, q2) / ( Process_::chi2);
         }
 
         double normalized_moment_1_a_1(const double & q2) const
@@ -3736,9 +3834,6 @@ namespace eos
 
             const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_A1_2pt_borel_m1, this, std::placeholders::_1, q2);
 
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_A1_2pt_borel, this, std::placeholders::_1, q2);
-
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_A1_2pt_m1(sigma_0, q2);
 
@@ -3761,27 +3856,7 @@ namespace eos
             }
             const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
 
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_A1_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_A1_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_A1_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A1_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A1_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A1_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+            const double denominator     = switch_borel ? sum_rule(SumRule::a_1, q2) : sum_rule_a_1(q2, true);
 
             return numerator / denominator;
         }
@@ -6456,14 +6531,16 @@ namespace eos
 
         /* A2 : form factor and moments */
         // {{{
-        double a_2(const double & q2) const
+        double sum_rule_a_2(const double & q2, const bool & borel) const
         {
             const double sigma_0 = this->sigma_0(q2, s0_0_A2(), s0_1_A2());
 
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_a2_2pt, this, std::placeholders::_1, q2);
+            // the first moments are always normalized to the Borel-transformed sum rule
+            const std::function<double (const Implementation *, const double &, const double &)> integrand = borel ? &Implementation::integrand_A2_2pt_borel : integrand_a2_2pt;
+            const std::function<double (const double &)> integrand_2pt = std::bind(integrand, this, std::placeholders::_1, q2);
 
             const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_A2_2pt(switch_borel ? sigma_0 : 0.0, q2);
+            const double surface_2pt  = 0.0 - surface_A2_2pt(borel ? sigma_0 : 0.0, q2);
 
             double integral_3pt = 0.0;
             double surface_3pt  = 0.0;
@@ -6483,7 +6560,12 @@ namespace eos
                              - surface_A2_3pt_D(sigma_0, q2);
             }
 
-            return f_B() * m_B() * (m_B + m_V) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+        }
+
+        double a_2(const double & q2) const
+        {
+            return f_B() * m_B() * (m_B + m_V) / (2.0 * f_V() * m_V) * sum_rule(SumRule::a_2, q2) / ( Process_::chi2);
         }
 
         double normalized_moment_1_a_2(const double & q2) const
@@ -6492,9 +6574,6 @@ namespace eos
 
             const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_A2_2pt_borel_m1, this, std::placeholders::_1, q2);
 
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_A2_2pt_borel, this, std::placeholders::_1, q2);
-
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_A2_2pt_m1(sigma_0, q2);
 
@@ -6517,27 +6596,7 @@ namespace eos
             }
             const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
 
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_A2_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_A2_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_A2_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A2_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A2_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A2_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+            const double denominator     = switch_borel ? sum_rule(SumRule::a_2, q2) : sum_rule_a_2(q2, true);
 
             return numerator / denominator;
         }
@@ -9208,14 +9267,16 @@ namespace eos
 
         /* A30 : form factor and moments */
         // {{{
-        double a_30(const double & q2) const
+        double sum_rule_a_30(const double & q2, const bool & borel) const
         {
             const double sigma_0 = this->sigma_0(q2, s0_0_A30(), s0_1_A30());
 
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_a30_2pt, this, std::placeholders::_1, q2);
+            // the first moments are always normalized to the Borel-transformed sum rule
+            const std::function<double (const Implementation *, const double &, const double &)> integrand = borel ? &Implementation::integrand_A30_2pt_borel : integrand_a30_2pt;
+            const std::function<double (const double &)> integrand_2pt = std::bind(integrand, this, std::placeholders::_1, q2);
 
             const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_A30_2pt(switch_borel ? sigma_0 : 0.0, q2);
+            const double surface_2pt  = 0.0 - surface_A30_2pt(borel ? sigma_0 : 0.0, q2);
 
             double integral_3pt = 0.0;
             double surface_3pt  = 0.0;
@@ -9235,7 +9296,12 @@ namespace eos
                              - surface_A30_3pt_D(sigma_0, q2);
             }
 
-            return f_B() * q2 * m_B / (4.0 * f_V() * pow(m_V, 2)) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+        }
+
+        double a_30(const double & q2) const
+        {
+            return f_B() * q2 * m_B / (4.0 * f_V() * pow(m_V, 2)) * sum_rule(SumRule::a_30, q2) / ( Process_::chi2);
         }
 
         double normalized_moment_1_a_30(const double & q2) const
@@ -9244,9 +9310,6 @@ namespace eos
 
             const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_A30_2pt_borel_m1, this, std::placeholders::_1, q2);
 
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_A30_2pt_borel, this, std::placeholders::_1, q2);
-
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_A30_2pt_m1(sigma_0, q2);
 
@@ -9269,27 +9332,7 @@ namespace eos
             }
             const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
 
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_A30_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_A30_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_A30_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A30_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A30_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A30_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+            const double denominator     = switch_borel ? sum_rule(SumRule::a_30, q2) : sum_rule_a_30(q2, true);
 
             return numerator / denominator;
         }
@@ -11537,14 +11580,16 @@ namespace eos
 
         /* V : form factor and moments */
         // {{{
-        double v(const double & q2) const
+        double sum_rule_v(const double & q2, const bool & borel) const
         {
             const double sigma_0 = this->sigma_0(q2, s0_0_V(), s0_1_V());
 
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_v_2pt, this, std::placeholders::_1, q2);
+            // the first moments are always normalized to the Borel-transformed sum rule
+            const std::function<double (const Implementation *, const double &, const double &)> integrand = borel ? &Implementation::integrand_V_2pt_borel : integrand_v_2pt;
+            const std::function<double (const double &)> integrand_2pt = std::bind(integrand, this, std::placeholders::_1, q2);
 
             const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_V_2pt(switch_borel ? sigma_0 : 0.0, q2);
+            const double surface_2pt  = 0.0 - surface_V_2pt(borel ? sigma_0 : 0.0, q2);
 
             double integral_3pt = 0.0;
             double surface_3pt  = 0.0;
@@ -11564,7 +11609,12 @@ namespace eos
                              - surface_V_3pt_D(sigma_0, q2);
             }
 
-            return f_B() * pow(m_B, 2) * (m_B + m_V) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+        }
+
+        double v(const double & q2) const
+        {
+            return f_B() * pow(m_B, 2) * (m_B + m_V) / (2.0 * f_V() * m_V) * sum_rule(SumRule::v, q2) / ( Process_::chi2);
         }
 
         double normalized_moment_1_v(const double & q2) const
@@ -11573,9 +11623,6 @@ namespace eos
 
             const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_V_2pt_borel_m1, this, std::placeholders::_1, q2);
 
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_V_2pt_borel, this, std::placeholders::_1, q2);
-
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_V_2pt_m1(sigma_0, q2);
 
@@ -11598,27 +11645,7 @@ namespace eos
             }
             const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
 
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_V_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_V_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_V_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_V_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_V_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_V_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+            const double denominator     = switch_borel ? sum_rule(SumRule::v, q2) : sum_rule_v(q2, true);
 
             return numerator / denominator;
         }
@@ -14186,14 +14213,16 @@ namespace eos
 
         /* T1 : form factor and moments */
         // {{{
-        double t_1(const double & q2) const
+        double sum_rule_t_1(const double & q2, const bool & borel) const
         {
             const double sigma_0 = this->sigma_0(q2, s0_0_T1(), s0_1_T1());
 
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_t1_2pt, this, std::placeholders::_1, q2);
+            // the first moments are always normalized to the Borel-transformed sum rule
+            const std::function<double (const Implementation *, const double &, const double &)> integrand = borel ? &Implementation::integrand_T1_2pt_borel : integrand_t1_2pt;
+            const std::function<double (const double &)> integrand_2pt = std::bind(integrand, this, std::placeholders::_1, q2);
 
             const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_T1_2pt(switch_borel ? sigma_0 : 0.0, q2);
+            const double surface_2pt  = 0.0 - surface_T1_2pt(borel ? sigma_0 : 0.0, q2);
 
             double integral_3pt = 0.0;
             double surface_3pt  = 0.0;
@@ -14213,7 +14242,12 @@ namespace eos
                              - surface_T1_3pt_D(sigma_0, q2);
             }
 
-            return f_B() * pow(m_B(), 2) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+        }
+
+        double t_1(const double & q2) const
+        {
+            return f_B() * pow(m_B(), 2) / (2.0 * f_V() * m_V) * sum_rule(SumRule::t_1, q2) / ( Process_::chi2);
         }
 
         double normalized_moment_1_t_1(const double & q2) const
@@ -14222,9 +14256,6 @@ namespace eos
 
             const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_T1_2pt_borel_m1, this, std::placeholders::_1, q2);
 
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_T1_2pt_borel, this, std::placeholders::_1, q2);
-
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_T1_2pt_m1(sigma_0, q2);
 
@@ -14247,27 +14278,7 @@ namespace eos
             }
             const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
 
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_T1_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_T1_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_T1_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T1_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T1_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T1_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+            const double denominator     = switch_borel ? sum_rule(SumRule::t_1, q2) : sum_rule_t_1(q2, true);
 
             return numerator / denominator;
         }
@@ -17076,14 +17087,16 @@ namespace eos
 
         /* T23A : form factor and moments */
         // {{{
-        double t_23A(const double & q2) const
+        double sum_rule_t_23A(const double & q2, const bool & borel) const
         {
             const double sigma_0 = this->sigma_0(q2, s0_0_T23A(), s0_1_T23A());
 
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_t23A_2pt, this, std::placeholders::_1, q2);
+            // the first moments are always normalized to the Borel-transformed sum rule
+            const std::function<double (const Implementation *, const double &, const double &)> integrand = borel ? &Implementation::integrand_T23A_2pt_borel : integrand_t23A_2pt;
+            const std::function<double (const double &)> integrand_2pt = std::bind(integrand, this, std::placeholders::_1, q2);
 
             const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_T23A_2pt(switch_borel ? sigma_0 : 0.0, q2);
+            const double surface_2pt  = 0.0 - surface_T23A_2pt(borel ? sigma_0 : 0.0, q2);
 
             double integral_3pt = 0.0;
             double surface_3pt  = 0.0;
@@ -17103,7 +17116,12 @@ namespace eos
                              - surface_T23A_3pt_D(sigma_0, q2);
             }
 
-            return f_B() * pow(m_B(), 2) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+        }
+
+        double t_23A(const double & q2) const
+        {
+            return f_B() * pow(m_B(), 2) / (2.0 * f_V() * m_V) * sum_rule(SumRule::t_23A, q2) / ( Process_::chi2);
         }
 
         double normalized_moment_1_t_23A(const double & q2) const
@@ -17112,9 +17130,6 @@ namespace eos
 
             const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_T23A_2pt_borel_m1, this, std::placeholders::_1, q2);
 
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_T23A_2pt_borel, this, std::placeholders::_1, q2);
-
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_T23A_2pt_m1(sigma_0, q2);
 
@@ -17137,27 +17152,7 @@ namespace eos
             }
             const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
 
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_T23A_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_T23A_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_T23A_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T23A_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T23A_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T23A_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+            const double denominator     = switch_borel ? sum_rule(SumRule::t_23A, q2) : sum_rule_t_23A(q2, true);
 
             return numerator / denominator;
         }
@@ -20259,14 +20254,16 @@ namespace eos
 
         /* T23B : form factor and moments */
         // {{{
-        double t_23B(const double & q2) const
+        double sum_rule_t_23B(const double & q2, const bool & borel) const
         {
             const double sigma_0 = this->sigma_0(q2, s0_0_T23B(), s0_1_T23B());
 
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_t23B_2pt, this, std::placeholders::_1, q2);
+            // the first moments are always normalized to the Borel-transformed sum rule
+            const std::function<double (const Implementation *, const double &, const double &)> integrand = borel ? &Implementation::integrand_T23B_2pt_borel : integrand_t23B_2pt;
+            const std::function<double (const double &)> integrand_2pt = std::bind(integrand, this, std::placeholders::_1, q2);
 
             const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_T23B_2pt(switch_borel ? sigma_0 : 0.0, q2);
+            const double surface_2pt  = 0.0 - surface_T23B_2pt(borel ? sigma_0 : 0.0, q2);
 
             double integral_3pt = 0.0;
             double surface_3pt  = 0.0;
@@ -20286,7 +20283,12 @@ namespace eos
                              - surface_T23B_3pt_D(sigma_0, q2);
             }
 
-            return f_B() * pow(m_B(), 2) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+        }
+
+        double t_23B(const double & q2) const
+        {
+            return f_B() * pow(m_B(), 2) / (2.0 * f_V() * m_V) * sum_rule(SumRule::t_23B, q2) / ( Process_::chi2);
         }
 
         double normalized_moment_1_t_23B(const double & q2) const
@@ -20295,9 +20297,6 @@ namespace eos
 
             const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_T23B_2pt_borel_m1, this, std::placeholders::_1, q2);
 
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_T23B_2pt_borel, this, std::placeholders::_1, q2);
-
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_T23B_2pt_m1(sigma_0, q2);
 
@@ -20320,27 +20319,7 @@ namespace eos
             }
             const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
 
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_T23B_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_T23B_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_T23B_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T23B_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T23B_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T23B_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
+            const double denominator     = switch_borel ? sum_rule(SumRule::t_23B, q2) : sum_rule_t_23B(q2, true);
 
             return numerator / denominator;
         }
@@ -23222,6 +23201,25 @@ namespace eos
              + c_2 * (1.0 * this->_imp->t_23A(q2) - 2.0 * this->_imp->t_23B(q2));
     }
 
+    template <typename Process_>
+    typename AnalyticFormFactorBToVLCSR<Process_>::Values
+    AnalyticFormFactorBToVLCSR<Process_>::values(const double & q2) const
+    {
+        Values result;
+
+        result.v    = this->v(q2);
+        result.a_0  = this->a_0(q2);
+        result.a_1  = this->a_1(q2);
+        result.a_2  = this->a_2(q2);
+        result.a_12 = this->a_12(q2);
+        result.t_1  = this->t_1(q2);
+        result.t_2  = this->t_2(q2);
+        result.t_3  = this->t_3(q2);
+        result.t_23 = this->t_23(q2);
+
+        return result;
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToVLCSR<Process_>::normalized_moment_1_a_1(const double & q2) const
@@ -51,6 +51,16 @@ namespace eos
 
             static FormFactors<PToV> * make(const Parameters &, const Options &);
 
+            /*!
+             * Values of all form factors at one point q2.
+             */
+            struct Values
+            {
+                double v;
+                double a_0, a_1, a_2, a_12;
+                double t_1, t_2, t_3, t_23;
+            };
+
             /* Form factors */
             virtual double v(const double & q2) const;
             virtual double a_0(const double & q2) const;
@@ -63,6 +73,15 @@ namespace eos
             virtual double t_3(const double & q2) const;
             virtual double t_23(const double & q2) const;
 
+            /*!
+             * Evaluate all form factors at once.
+             *
+             * The form factors are linear combinations of seven sum rules. Each sum rule
+             * is evaluated only once per q2 and parameter point, and its result is shared
+             * with the other form factors and with the first moments.
+             */
+            Values values(const double & q2) const;
+
             /* First moments of the sum rules */
             double normalized_moment_1_a_1(const double & q2) const;
             double normalized_moment_1_a_2(const double & q2) const;
@@ -22,6 +22,7 @@
 #include <eos/form-factors/analytic-b-to-v-lcsr.hh>
 #include <eos/form-factors/mesonic.hh>
 
+#include <cmath>
 #include <vector>
 #include <utility>
 
@@ -2938,6 +2939,25 @@ class LCSRFormFactorsTest :
                 TEST_CHECK_RELATIVE_ERROR( 0.132538, ff->t_3(-5.0),         eps);
                 TEST_CHECK_RELATIVE_ERROR( 0.156777, ff->t_3( 0.0),         eps);
                 TEST_CHECK_RELATIVE_ERROR( 0.181452, ff->t_3(+5.0),         eps);
+
+                // the joint evaluation reproduces the individual form factors
+                AnalyticFormFactorBToVLCSR<lcsr::BToRho> ff_joint(p, o);
+                const auto values = ff_joint.values(+5.0);
+                TEST_CHECK_RELATIVE_ERROR(ff->v(+5.0),    values.v,         1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->a_0(+5.0),  values.a_0,       1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->a_1(+5.0),  values.a_1,       1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->a_2(+5.0),  values.a_2,       1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->a_12(+5.0), values.a_12,      1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_1(+5.0),  values.t_1,       1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_2(+5.0),  values.t_2,       1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_3(+5.0),  values.t_3,       1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_23(+5.0), values.t_23,      1.0e-12);
+
+                // the cached sum rules are invalidated when a parameter changes
+                p["B->rho::M^2@B-LCSR"]            = 1.5;
+                TEST_CHECK(std::abs(ff_joint.v(+5.0) / values.v - 1.0) > 1.0e-4);
+                TEST_CHECK_RELATIVE_ERROR(ff->v(+5.0),    ff_joint.v(+5.0), 1.0e-12);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_23(+5.0), ff_joint.t_23(+5.0), 1.0e-12);
             }
 
 
@@ -28,6 +28,10 @@
 
 #include <gsl/gsl_sf_expint.h>
 
+#include <array>
+#include <cmath>
+#include <limits>
+
 namespace eos
 {
     template <>
@@ -43,6 +47,10 @@ namespace eos
 
         double switch_gminus;
 
+        // powers of omega_0 = lambda_B, which are recomputed only if lambda_B changes
+        mutable double omega_0_powers_key;
+        mutable std::array<double, 6> omega_0_powers;
+
         inline
         QualifiedName parameter(const char * _name) const
         {
@@ -60,7 +68,8 @@ namespace eos
             lambda_E2(p[parameter("lambda_E^2").str()], u),
             lambda_H2(p[parameter("lambda_H^2").str()], u),
             opt_gminus(o, "gminus", { "zero", "WW-limit" }, "WW-limit"),
-            switch_gminus(1.0)
+            switch_gminus(1.0),
+            omega_0_powers_key(std::numeric_limits<double>::quiet_NaN())
         {
             if (opt_gminus.value() == "zero")
             {
@@ -74,6 +83,23 @@ namespace eos
             return 1.0 / lambda_B_inv();
         }
 
+        inline double omega_0_pow(const unsigned & n) const
+        {
+            if (omega_0_powers_key != lambda_B_inv())
+            {
+                const double omega_0 = lambda_B();
+
+                for (unsigned k = 0 ; k < omega_0_powers.size() ; ++k)
+                {
+                    omega_0_powers[k] = std::pow(omega_0, k);
+                }
+
+                omega_0_powers_key = lambda_B_inv();
+            }
+
+            return omega_0_powers[n];
+        }
+
         /* Leading twist two-particle LCDAs */
 
         inline double phi_plus(const double & omega) const
@@ -90,7 +116,7 @@ namespace eos
             const double omega_0 = lambda_B();
 
             const double limitWW = 1.0 / omega_0 * std::exp(-omega / omega_0);
-            const double nonWW   = -(lambda_E2 - lambda_H2) / (18.0 * pow(omega_0, 5)) *
+            const double nonWW   = -(lambda_E2 - lambda_H2) / (18.0 * omega_0_pow(5)) *
                 (
                     2.0 * omega_0 * omega_0 - 4.0 * omega_0 * omega + omega * omega
                 ) * std::exp(-omega / omega_0);
@@ -103,7 +129,7 @@ namespace eos
             const double omega_0 = lambda_B();
 
             const double limitWW = -omega / omega_0 * std::exp(-omega / omega_0);
-            const double nonWW   = (lambda_E2 - lambda_H2) / (18.0 * pow(omega_0, 4))
+            const double nonWW   = (lambda_E2 - lambda_H2) / (18.0 * omega_0_pow(4))
                 * (2.0 * omega_0 - omega) * omega * std::exp(-omega / omega_0);
 
             return limitWW + nonWW;
@@ -161,14 +187,14 @@ namespace eos
             const double Ei = gsl_sf_expint_Ei(-omega / omega_0);
             const double exp = std::exp(-omega / omega_0);
 
-            const double termA = -lambda_E2 / (6.0 * pow(omega_0, 2)) *
+            const double termA = -lambda_E2 / (6.0 * omega_0_pow(2)) *
                 (
                     (omega - 2.0 * omega_0) * Ei
                     + (omega + 2.0 * omega_0) * exp * (std::log(omega / omega_0) + gamma_E)
                     - 2.0 * omega * exp
                 );
             const double termB = exp / (2.0 * omega_0) * pow(omega, 2) * (
-                    1.0 - (lambda_E2 - lambda_H2) / (36.0 * pow(omega_0, 2))
+                    1.0 - (lambda_E2 - lambda_H2) / (36.0 * omega_0_pow(2))
                 );
 
             return termA + termB;
@@ -186,14 +212,14 @@ namespace eos
             const double Ei = gsl_sf_expint_Ei(-omega / omega_0);
             const double exp = std::exp(-omega / omega_0);
 
-            const double termA = lambda_E2 / (6.0 * pow(omega_0, 3)) *
+            const double termA = lambda_E2 / (6.0 * omega_0_pow(3)) *
                 (
                     - omega_0 * Ei
                     + (omega + omega_0) * exp * (std::log(omega / omega_0) + gamma_E)
                     - 2.0 * omega * exp
                 );
-            const double termB = exp / (2.0 * pow(omega_0, 2)) * (2.0 * omega_0 - omega) * omega * (
-                    1.0 - (lambda_E2 - lambda_H2) / (36.0 * pow(omega_0, 2))
+            const double termB = exp / (2.0 * omega_0_pow(2)) * (2.0 * omega_0 - omega) * omega * (
+                    1.0 - (lambda_E2 - lambda_H2) / (36.0 * omega_0_pow(2))
                 );
 
             return termA + termB;
@@ -207,13 +233,13 @@ namespace eos
             const double omega_0 = lambda_B();
             const double exp = std::exp(-omega / omega_0);
 
-            const double termA = lambda_E2 / (6.0 * pow(omega_0, 4)) * exp *
+            const double termA = lambda_E2 / (6.0 * omega_0_pow(4)) * exp *
                 (
                     - omega_0
                     - omega * (std::log(omega / omega_0) + gamma_E - 2.0)
                 );
-            const double termB = exp / (2.0 * pow(omega_0, 3)) * (2.0 * pow(omega_0, 2) - 4.0 * omega_0 * omega + pow(omega, 2)) * (
-                    1.0 - (lambda_E2 - lambda_H2) / (36.0 * pow(omega_0, 2))
+            const double termB = exp / (2.0 * omega_0_pow(3)) * (2.0 * omega_0_pow(2) - 4.0 * omega_0 * omega + pow(omega, 2)) * (
+                    1.0 - (lambda_E2 - lambda_H2) / (36.0 * omega_0_pow(2))
                 );
 
             return termA + termB;
@@ -236,11 +262,11 @@ namespace eos
             const double exp_plus = std::exp(omega / omega_0);
 
             // integral of g_plus
-            const double  termA = -lambda_E2 / (12.0 * pow(omega_0, 2)) *
-            ((pow(omega, 2) - 4.0 * omega_0 * omega + 6.0 * pow(omega_0, 2)) * Ei - omega_0 * exp * (std::log(omega / omega_0) + gamma_E) * 2.0 * (3.0 * omega_0 + omega)
+            const double  termA = -lambda_E2 / (12.0 * omega_0_pow(2)) *
+            ((pow(omega, 2) - 4.0 * omega_0 * omega + 6.0 * omega_0_pow(2)) * Ei - omega_0 * exp * (std::log(omega / omega_0) + gamma_E) * 2.0 * (3.0 * omega_0 + omega)
              - omega_0 * exp * (omega_0 - 5.0 * omega));
-            const double  termB = -exp / 2.0 * (2.0 * pow(omega_0, 2) + 2.0 * omega_0 * omega + pow(omega, 2)) * (1.0 - (lambda_E2 - lambda_H2) / (36.0 * pow(omega_0, 2)));
-            const double  int_glus = (termA - lambda_E2 / 12.0) + (termB + pow(omega_0, 2) - (lambda_E2 - lambda_H2) / 36.0);
+            const double  termB = -exp / 2.0 * (2.0 * omega_0_pow(2) + 2.0 * omega_0 * omega + pow(omega, 2)) * (1.0 - (lambda_E2 - lambda_H2) / (36.0 * omega_0_pow(2)));
+            const double  int_glus = (termA - lambda_E2 / 12.0) + (termB + omega_0_pow(2) - (lambda_E2 - lambda_H2) / 36.0);
             // integral of g_minusWW
             const double int_gminusWW = (3.0 / 4.0) * exp * omega_0 * (exp_plus * omega_0 - omega - omega_0);
             return       int_glus - switch_gminus * int_gminusWW;
@@ -274,7 +300,7 @@ namespace eos
             const double omega_0 = lambda_B();
 
             // cf. [1703.02446], eq. (5.8), p. 17
-            return (lambda_E2 - lambda_H2) / (6.0 * pow(omega_0, 5)) * omega_1 * pow(omega_2, 2) * std::exp(-(omega_1 + omega_2) / omega_0);
+            return (lambda_E2 - lambda_H2) / (6.0 * omega_0_pow(5)) * omega_1 * pow(omega_2, 2) * std::exp(-(omega_1 + omega_2) / omega_0);
         }
 
         inline double phi_4(const double & omega_1, const double & omega_2) const
@@ -282,15 +308,15 @@ namespace eos
             const double omega_0 = lambda_B();
 
             // cf. [1703.02446], eq. (5.8), p. 17
-            return (lambda_E2 + lambda_H2) / (6.0 * pow(omega_0, 4)) * pow(omega_2, 2) * std::exp(-(omega_1 + omega_2) / omega_0);
+            return (lambda_E2 + lambda_H2) / (6.0 * omega_0_pow(4)) * pow(omega_2, 2) * std::exp(-(omega_1 + omega_2) / omega_0);
         }
 
         inline double phi_bar_3(const double & omega_1, const double & omega_2) const
         {
             const double omega_0 = lambda_B();
 
-            const double termA = - (lambda_E2 - lambda_H2) / (6.0 * pow(omega_0, 4)) * (omega_0 + omega_1) * omega_2 * omega_2 * std::exp(-(omega_1 + omega_2) / omega_0);
-            const double termB = (lambda_E2 - lambda_H2) / (6.0 * pow(omega_0, 3)) * omega_2 * omega_2 * std::exp(- omega_2 / omega_0);
+            const double termA = - (lambda_E2 - lambda_H2) / (6.0 * omega_0_pow(4)) * (omega_0 + omega_1) * omega_2 * omega_2 * std::exp(-(omega_1 + omega_2) / omega_0);
+            const double termB = (lambda_E2 - lambda_H2) / (6.0 * omega_0_pow(3)) * omega_2 * omega_2 * std::exp(- omega_2 / omega_0);
 
             return termA + termB;
         }
@@ -299,8 +325,8 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = - (lambda_E2 + lambda_H2) / (6.0 * pow(omega_0, 3)) * omega_2 * omega_2 * std::exp(-(omega_1 + omega_2) / omega_0);
-            const double termB = (lambda_E2 + lambda_H2) / (6.0 * pow(omega_0, 3)) * omega_2 * omega_2 * std::exp(- omega_2 / omega_0);
+            const double termA = - (lambda_E2 + lambda_H2) / (6.0 * omega_0_pow(3)) * omega_2 * omega_2 * std::exp(-(omega_1 + omega_2) / omega_0);
+            const double termB = (lambda_E2 + lambda_H2) / (6.0 * omega_0_pow(3)) * omega_2 * omega_2 * std::exp(- omega_2 / omega_0);
 
             return termA + termB;
         }
@@ -309,8 +335,8 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = - (lambda_E2 - lambda_H2) / (6.0 * pow(omega_0, 4)) * omega_1 * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(-(omega_1 + omega_2) / omega_0);
-            const double termB = (lambda_E2 - lambda_H2) / (3.0 * pow(omega_0, 2)) * omega_1 * std::exp(- omega_1 / omega_0);
+            const double termA = - (lambda_E2 - lambda_H2) / (6.0 * omega_0_pow(4)) * omega_1 * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(-(omega_1 + omega_2) / omega_0);
+            const double termB = (lambda_E2 - lambda_H2) / (3.0 * omega_0_pow(2)) * omega_1 * std::exp(- omega_1 / omega_0);
 
             return termA + termB;
         }
@@ -319,7 +345,7 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = - (lambda_E2 + lambda_H2) / (6.0 * pow(omega_0, 3)) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(-(omega_1 + omega_2) / omega_0);
+            const double termA = - (lambda_E2 + lambda_H2) / (6.0 * omega_0_pow(3)) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(-(omega_1 + omega_2) / omega_0);
             const double termB = (lambda_E2 + lambda_H2) / (3.0 * omega_0) * std::exp(- omega_1 / omega_0);
 
             return termA + termB;
@@ -329,9 +355,9 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = (lambda_E2 - lambda_H2) / (6.0 * pow(omega_0, 3)) * (omega_0 + omega_1) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(-(omega_1 + omega_2) / omega_0);
+            const double termA = (lambda_E2 - lambda_H2) / (6.0 * omega_0_pow(3)) * (omega_0 + omega_1) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(-(omega_1 + omega_2) / omega_0);
             const double termB = - (lambda_E2 - lambda_H2) / (3.0 * omega_0) * (omega_0 + omega_1) * std::exp(- omega_1 / omega_0);
-            const double termC = - (lambda_E2 - lambda_H2) / (6.0 * pow(omega_0, 2)) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(- omega_2 / omega_0);
+            const double termC = - (lambda_E2 - lambda_H2) / (6.0 * omega_0_pow(2)) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(- omega_2 / omega_0);
             const double termD = - 1.0 / 3.0 * (- lambda_E2 + lambda_H2);
 
             return termA + termB + termC + termD;
@@ -341,9 +367,9 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = (lambda_E2 + lambda_H2) / (6.0 * pow(omega_0, 2)) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(-(omega_1 + omega_2) / omega_0);
+            const double termA = (lambda_E2 + lambda_H2) / (6.0 * omega_0_pow(2)) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(-(omega_1 + omega_2) / omega_0);
             const double termB = - 1.0 / 3.0 * (lambda_E2 + lambda_H2) * std::exp(- omega_1 / omega_0);
-            const double termC = - (lambda_E2 + lambda_H2) / (6.0 * pow(omega_0, 2)) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(- omega_2 / omega_0);
+            const double termC = - (lambda_E2 + lambda_H2) / (6.0 * omega_0_pow(2)) * (2.0 * omega_0 * omega_0 + 2.0 * omega_0 * omega_2 + omega_2 * omega_2) * std::exp(- omega_2 / omega_0);
             const double termD = - 1.0 / 3.0 * (- lambda_E2 - lambda_H2);
 
             return termA + termB + termC + termD;
@@ -353,8 +379,8 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = - lambda_E2 / (3.0 * pow(omega_0, 3)) * (omega_0 + omega_1) * omega_2 * std::exp(-(omega_1 + omega_2) / omega_0);
-            const double termB = lambda_E2 / (3.0 * pow(omega_0, 2)) * omega_2 * std::exp(- omega_2 / omega_0);
+            const double termA = - lambda_E2 / (3.0 * omega_0_pow(3)) * (omega_0 + omega_1) * omega_2 * std::exp(-(omega_1 + omega_2) / omega_0);
+            const double termB = lambda_E2 / (3.0 * omega_0_pow(2)) * omega_2 * std::exp(- omega_2 / omega_0);
 
             return termA + termB;
         }
@@ -363,7 +389,7 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = - lambda_E2 / (3.0 * pow(omega_0, 2)) * ((-1.0 +  std::exp( omega_1 / omega_0))
+            const double termA = - lambda_E2 / (3.0 * omega_0_pow(2)) * ((-1.0 +  std::exp( omega_1 / omega_0))
                                * omega_0 - omega_1) * (omega_0 + omega_2)  * std::exp(-(omega_1 + omega_2) / omega_0);
             const double termB = lambda_E2 / (3.0 * omega_0) * ((-1.0 +  std::exp( omega_1 / omega_0))
                                * omega_0 - omega_1) * std::exp(- omega_1/ omega_0);
@@ -376,8 +402,8 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = - lambda_H2 / (3.0 * pow(omega_0, 3)) * (omega_0 + omega_1) * omega_2 * std::exp(-(omega_1 + omega_2) / omega_0);
-            const double termB = lambda_H2 / (3.0 * pow(omega_0, 2)) * omega_2 * std::exp(- omega_2 / omega_0);
+            const double termA = - lambda_H2 / (3.0 * omega_0_pow(3)) * (omega_0 + omega_1) * omega_2 * std::exp(-(omega_1 + omega_2) / omega_0);
+            const double termB = lambda_H2 / (3.0 * omega_0_pow(2)) * omega_2 * std::exp(- omega_2 / omega_0);
 
             return termA + termB;
         }
@@ -386,7 +412,7 @@ namespace eos
         {
             const double omega_0 = lambda_B();
 
-            const double termA = - lambda_H2 / (3.0 * pow(omega_0, 2)) * ((-1.0 +  std::exp( omega_1 / omega_0))
+            const double termA = - lambda_H2 / (3.0 * omega_0_pow(2)) * ((-1.0 +  std::exp( omega_1 / omega_0))
                                * omega_0 - omega_1) * (omega_0 + omega_2)  * std::exp(-(omega_1 + omega_2) / omega_0);
             const double termB = lambda_H2 / (3.0 * omega_0) * ((-1.0 +  std::exp( omega_1 / omega_0))
                                * omega_0 - omega_1) * std::exp(- omega_1/ omega_0);
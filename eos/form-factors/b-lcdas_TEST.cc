@@ -756,5 +756,26 @@ class BMesonLCDAsTest :
                     TEST_CHECK_NEARLY_EQUAL( 2.3773500e-2, B.chi_bar_bar_4(3.0, 0.3), eps);
                 }
             }
+
+            /* Changes of the parameters */
+            {
+                Parameters p = Parameters::Defaults();
+                p["B::1/lambda_B_p"] = 2.1739;
+                p["B::lambda_E^2"]   = 0.3174;
+                p["B::lambda_H^2"]   = 0.3174;
+
+                BMesonLCDAs B(p, Options{ { "q", "u" } });
+                TEST_CHECK_NEARLY_EQUAL( 0.247243,   B.phi_minus(1.0),   eps);
+
+                p["B::1/lambda_B_p"] = 3.0;
+                p["B::lambda_H^2"]   = 0.2;
+
+                BMesonLCDAs reference(p, Options{ { "q", "u" } });
+                TEST_CHECK_EQUAL(reference.phi_minus(1.0),          B.phi_minus(1.0));
+                TEST_CHECK_EQUAL(reference.g_plus(1.0),             B.g_plus(1.0));
+                TEST_CHECK_EQUAL(reference.phi_bar_3(1.0, 0.3),     B.phi_bar_3(1.0, 0.3));
+                TEST_CHECK_EQUAL(reference.phi_bar_bar_4(1.0, 0.3), B.phi_bar_bar_4(1.0, 0.3));
+                TEST_CHECK(std::abs(B.phi_minus(1.0) - 0.247243) > eps);
+            }
         }
 } b_lcdas_test;
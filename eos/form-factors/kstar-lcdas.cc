@@ -23,6 +23,10 @@
 #include <eos/utils/qcd.hh>
 #include <eos/utils/stringify.hh>
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 namespace eos
 {
     template <>
@@ -45,6 +49,23 @@ namespace eos
         UsedParameter _mu_b;
         UsedParameter _mu_t;
 
+        /*
+         * The LCDAs are evaluated many times for the same scale and the same parameters,
+         * e.g. within the integrands of light-cone sum rules. We therefore cache the
+         * scale-dependent coefficients, and recompute them only if the scale or any of
+         * the parameters (including those of the model) have changed.
+         */
+        struct Coefficients
+        {
+            double a_1_para, a_2_para, a_1_perp, a_2_perp, f_perp;
+        };
+
+        std::vector<Parameter> dependencies;
+
+        // the scale, followed by the values of all dependencies, for which the coefficients are valid
+        mutable std::vector<double> coefficients_key;
+        mutable Coefficients coefficients;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make("SM", p, o)),
             a_1_para_0(p["K^*::a_1_para@1GeV"], u),
@@ -57,6 +78,17 @@ namespace eos
             _mu_b(p["QCD::mu_b"], u),
             _mu_t(p["QCD::mu_t"], u)
         {
+            for (const auto & id : u)
+            {
+                dependencies.push_back(p[id]);
+            }
+
+            for (const auto & id : *model)
+            {
+                dependencies.push_back(p[id]);
+            }
+
+            coefficients_key.resize(dependencies.size() + 1, std::numeric_limits<double>::quiet_NaN());
         }
 
         inline double c_rge(const double & _mu) const
@@ -90,30 +122,59 @@ namespace eos
             throw InternalError("Implementation<KstarLCDAs>: RGE coefficient must not be evolved above mu_t = " + stringify(_mu_t()));
         }
 
+        const Coefficients & coefficients_at(const double & mu) const
+        {
+            bool valid = (coefficients_key[0] == mu);
+            for (unsigned i = 0 ; valid && (i < dependencies.size()) ; ++i)
+            {
+                valid = (coefficients_key[i + 1] == dependencies[i].evaluate());
+            }
+
+            if (valid)
+                return coefficients;
+
+            // c_rge might throw; only update the key once all coefficients are known
+            const double c = c_rge(mu);
+
+            coefficients.a_1_para = a_1_para_0 * std::pow(c, 32.0 / 9.0);
+            coefficients.a_2_para = a_2_para_0 * std::pow(c, 50.0 / 9.0);
+            coefficients.a_1_perp = a_1_perp_0 * std::pow(c, 36.0 / 9.0);
+            coefficients.a_2_perp = a_2_perp_0 * std::pow(c, 52.0 / 9.0);
+            // gamma_0 / (beta_0^Nf=3) = 4 / 23, see [BFS2001], p. 14, below eq. (48)
+            coefficients.f_perp   = f_perp_0   * std::pow(c, +4.0 / 23.0 * QCD::beta_function_nf_3[0]);
+
+            coefficients_key[0] = mu;
+            for (unsigned i = 0 ; i < dependencies.size() ; ++i)
+            {
+                coefficients_key[i + 1] = dependencies[i].evaluate();
+            }
+
+            return coefficients;
+        }
+
         inline double a_1_para(const double & mu) const
         {
-            return a_1_para_0 * std::pow(c_rge(mu), 32.0 / 9.0);
+            return coefficients_at(mu).a_1_para;
         }
 
         inline double a_2_para(const double & mu) const
         {
-            return a_2_para_0 * std::pow(c_rge(mu), 50.0 / 9.0);
+            return coefficients_at(mu).a_2_para;
         }
 
         inline double a_1_perp(const double & mu) const
         {
-            return a_1_perp_0 * std::pow(c_rge(mu), 36.0 / 9.0);
+            return coefficients_at(mu).a_1_perp;
         }
 
         inline double a_2_perp(const double & mu) const
         {
-            return a_2_perp_0 * std::pow(c_rge(mu), 52.0 / 9.0);
+            return coefficients_at(mu).a_2_perp;
         }
 
         inline double f_perp(const double & mu) const
         {
-            // gamma_0 / (beta_0^Nf=3) = 4 / 23, see [BFS2001], p. 14, below eq. (48)
-            return f_perp_0 * std::pow(c_rge(mu), +4.0 / 23.0 * QCD::beta_function_nf_3[0]);
+            return coefficients_at(mu).f_perp;
         }
     };
 
@@ -96,5 +96,26 @@ class KstarLCDAsTest :
                 TEST_CHECK_NEARLY_EQUAL( 1.28268, kstar.phi_2_perp(0.7, 1.0),  eps);
                 TEST_CHECK_NEARLY_EQUAL( 0.77004, kstar.phi_2_perp(0.9, 1.0),  eps);
             }
+
+            /* Changes of the parameters */
+            {
+                Parameters p1 = p.clone();
+                KstarLCDAs kstar(p1, Options{ });
+
+                TEST_CHECK_NEARLY_EQUAL( 0.02486,  kstar.a_1_para(2.0),   eps);
+
+                // a change of an LCDA parameter
+                p1["K^*::a_1_para@1GeV"] = 0.06;
+                TEST_CHECK_NEARLY_EQUAL( 0.04972,  kstar.a_1_para(2.0),   eps);
+
+                // a change of a model parameter
+                p1["QCD::alpha_s(MZ)"] = 0.1230;
+
+                KstarLCDAs reference(p1, Options{ });
+                TEST_CHECK_EQUAL(reference.a_1_para(2.0), kstar.a_1_para(2.0));
+                TEST_CHECK_EQUAL(reference.a_2_perp(3.0), kstar.a_2_perp(3.0));
+                TEST_CHECK_EQUAL(reference.f_perp(2.0),   kstar.f_perp(2.0));
+                TEST_CHECK(std::abs(kstar.a_1_para(2.0) - 0.04972) > eps);
+            }
         }
 } kstar_lcdas_test;
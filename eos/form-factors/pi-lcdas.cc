@@ -23,6 +23,10 @@
 #include <eos/utils/qcd.hh>
 #include <eos/utils/stringify.hh>
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 namespace eos
 {
     template <>
@@ -51,6 +55,26 @@ namespace eos
         UsedParameter _mu_b;
         UsedParameter _mu_t;
 
+        /*
+         * The LCDAs are evaluated many times for the same scale and the same parameters,
+         * e.g. within the integrands of light-cone sum rules. We therefore cache the
+         * scale-dependent coefficients, and recompute them only if the scale or any of
+         * the parameters (including those of the model) have changed.
+         */
+        struct Coefficients
+        {
+            double a2pi, a4pi, f3pi, omega3pi, deltapipi, omega4pi;
+
+            // requires the running of m_ud, and is therefore only computed on demand
+            double mupi;
+        };
+
+        std::vector<Parameter> dependencies;
+
+        // the scale, followed by the values of all dependencies, for which the coefficients are valid
+        mutable std::vector<double> coefficients_key;
+        mutable Coefficients coefficients;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make("SM", p, o)),
             a2pi_0(p["pi::a2@1GeV"], u),
@@ -65,6 +89,17 @@ namespace eos
             _mu_b(p["QCD::mu_b"], u),
             _mu_t(p["QCD::mu_t"], u)
         {
+            for (const auto & id : u)
+            {
+                dependencies.push_back(p[id]);
+            }
+
+            for (const auto & id : *model)
+            {
+                dependencies.push_back(p[id]);
+            }
+
+            coefficients_key.resize(dependencies.size() + 1, std::numeric_limits<double>::quiet_NaN());
         }
 
         inline double c_rge(const double & _mu) const
@@ -98,14 +133,45 @@ namespace eos
             throw InternalError("Implementation<PionLCDAs>: RGE coefficient must not be evolved above mu_t = " + stringify(_mu_t()));
         }
 
+        const Coefficients & coefficients_at(const double & mu) const
+        {
+            bool valid = (coefficients_key[0] == mu);
+            for (unsigned i = 0 ; valid && (i < dependencies.size()) ; ++i)
+            {
+                valid = (coefficients_key[i + 1] == dependencies[i].evaluate());
+            }
+
+            if (valid)
+                return coefficients;
+
+            // c_rge might throw; only update the key once all coefficients are known
+            const double c = c_rge(mu);
+
+            coefficients.a2pi      = a2pi_0      * std::pow(c, 50.0 / 9.0);
+            coefficients.a4pi      = a4pi_0      * std::pow(c, 364.0 / 45.0);
+            coefficients.f3pi      = f3pi_0      * std::pow(c, 55.0 / 9.0);
+            coefficients.omega3pi  = omega3pi_0  * std::pow(c, 49.0 / 9.0);
+            coefficients.deltapipi = deltapipi_0 * std::pow(c, 32.0 / 9.0);
+            coefficients.omega4pi  = omega4pi_0  * std::pow(c, 58.0 / 9.0);
+            coefficients.mupi      = std::numeric_limits<double>::quiet_NaN();
+
+            coefficients_key[0] = mu;
+            for (unsigned i = 0 ; i < dependencies.size() ; ++i)
+            {
+                coefficients_key[i + 1] = dependencies[i].evaluate();
+            }
+
+            return coefficients;
+        }
+
         inline double a2pi(const double & mu) const
         {
-            return a2pi_0 * std::pow(c_rge(mu), 50.0 / 9.0);
+            return coefficients_at(mu).a2pi;
         }
 
         inline double a4pi(const double & mu) const
         {
-            return a4pi_0 * std::pow(c_rge(mu), 364.0 / 45.0);
+            return coefficients_at(mu).a4pi;
         }
 
         inline double m_ud_msbar(const double & mu) const
@@ -115,12 +181,19 @@ namespace eos
 
         inline double mupi(const double & mu) const
         {
-            return m_pi * m_pi / this->m_ud_msbar(mu);
+            const Coefficients & c = coefficients_at(mu);
+
+            if (std::isnan(c.mupi))
+            {
+                coefficients.mupi = m_pi * m_pi / this->m_ud_msbar(mu);
+            }
+
+            return c.mupi;
         }
 
         double f3pi(const double & mu) const
         {
-            return f3pi_0 * std::pow(c_rge(mu), 55.0 / 9.0);
+            return coefficients_at(mu).f3pi;
         }
 
         inline double eta3pi(const double & mu) const
@@ -130,17 +203,17 @@ namespace eos
 
         double omega3pi(const double & mu) const
         {
-            return omega3pi_0 * std::pow(c_rge(mu), 49.0 / 9.0);
+            return coefficients_at(mu).omega3pi;
         }
 
         double deltapipi(const double & mu) const
         {
-            return deltapipi_0 * std::pow(c_rge(mu), 32.0 / 9.0);
+            return coefficients_at(mu).deltapipi;
         }
 
         double omega4pi(const double & mu) const
         {
-            return omega4pi_0 * std::pow(c_rge(mu), 58.0 / 9.0);
+            return coefficients_at(mu).omega4pi;
         }
     };
 
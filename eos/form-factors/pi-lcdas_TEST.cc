@@ -192,5 +192,29 @@ class PionLCDAsTest :
                 TEST_CHECK_NEARLY_EQUAL(-1.686311876,   pi.phi4_d2(0.2, 2.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(-5.678881509,   pi.phi4_d2(0.3, 2.0), eps);
             }
+
+            /* Changes of the parameters */
+            {
+                Parameters p1 = p.clone();
+                PionLCDAs pi(p1, Options{ });
+
+                TEST_CHECK_NEARLY_EQUAL( 0.126731,      pi.a2pi(2.0),         eps);
+                TEST_CHECK_NEARLY_EQUAL( 2.434973113,   pi.mupi(2.0),         eps);
+
+                // a change of an LCDA parameter
+                p1["pi::a2@1GeV"] = 0.34;
+                TEST_CHECK_NEARLY_EQUAL( 0.253462,      pi.a2pi(2.0),         eps);
+
+                // a change of a model parameter
+                p1["QCD::alpha_s(MZ)"] = 0.1230;
+                p1["mass::u(2GeV)"]    = 0.0022;
+
+                PionLCDAs reference(p1, Options{ });
+                TEST_CHECK_EQUAL(reference.a2pi(2.0),   pi.a2pi(2.0));
+                TEST_CHECK_EQUAL(reference.a4pi(3.0),   pi.a4pi(3.0));
+                TEST_CHECK_EQUAL(reference.mupi(2.0),   pi.mupi(2.0));
+                TEST_CHECK_EQUAL(reference.eta3pi(2.0), pi.eta3pi(2.0));
+                TEST_CHECK(std::abs(pi.a2pi(2.0) - 0.253462) > eps);
+            }
         }
 } pi_lcdas_test;
@@ -38,16 +38,50 @@ namespace eos
     using std::pow;
     using std::sqrt;
 
+    ShortDistanceLowRecoil::LoopFunctions
+    ShortDistanceLowRecoil::loop_functions(const double & s, const double & mu, const double & m_b_PS, const double & m_c_MSbar,
+                bool ccbar_resonance)
+    {
+        LoopFunctions result;
+
+        // cf. [BFS2001] Eqs. (82)-(84), p. 30
+        result.F17 = CharmLoops::F17_massless(mu, s, m_b_PS);
+        result.F27 = CharmLoops::F27_massless(mu, s, m_b_PS);
+        result.F87 = CharmLoops::F87_massless(mu, s, m_b_PS);
+        result.F19 = CharmLoops::F19_massless(mu, s, m_b_PS);
+        result.F29 = CharmLoops::F29_massless(mu, s, m_b_PS);
+        result.F89 = CharmLoops::F89_massless(s, m_b_PS);
+
+        // Uses b pole mass according to [BFS2001], Sec. 3.1, paragraph Quark Masses
+        // Substitute pole mass by PS mass
+        result.G0 = -3.0 / 8.0 * ((ccbar_resonance ? LongDistance::g_had_ccbar(s, m_c_MSbar) : CharmLoops::h(mu, s)) + 4.0 / 9.0);
+        result.Gb = -3.0 / 8.0 * (CharmLoops::h(mu, s, m_b_PS) + 4.0 / 9.0);
+
+        return result;
+    }
+
     complex<double>
     ShortDistanceLowRecoil::c7eff(const double & s, const double & mu, const double & alpha_s, const double & m_b_PS, bool use_nlo,
                 const WilsonCoefficients<BToS> & wc)
+    {
+        LoopFunctions loops;
+        loops.F17 = CharmLoops::F17_massless(mu, s, m_b_PS);
+        loops.F27 = CharmLoops::F27_massless(mu, s, m_b_PS);
+        loops.F87 = CharmLoops::F87_massless(mu, s, m_b_PS);
+
+        return c7eff(alpha_s, use_nlo, loops, wc);
+    }
+
+    complex<double>
+    ShortDistanceLowRecoil::c7eff(const double & alpha_s, bool use_nlo, const LoopFunctions & loops,
+                const WilsonCoefficients<BToS> & wc)
     {
         // cf. [BFS2001] Eq. (29), p. 8, and Eqs. (82)-(84), p. 30
         complex<double> lo = -1.0/3.0 * wc.c3() - 4.0/9.0 * wc.c4() - 20.0/3.0 * wc.c5() - 80.0/9.0 * wc.c6();
         complex<double> nlo = -1.0 * (
-                  wc.c1() * CharmLoops::F17_massless(mu, s, m_b_PS)
-                + wc.c2() * CharmLoops::F27_massless(mu, s, m_b_PS)
-                + wc.c8() * CharmLoops::F87_massless(mu, s, m_b_PS));
+                  wc.c1() * loops.F17
+                + wc.c2() * loops.F27
+                + wc.c8() * loops.F87);
 
         complex<double> result = wc.c7() + lo;
         if (use_nlo)
@@ -63,16 +97,29 @@ namespace eos
     {
         // Uses b pole mass according to [BFS2001], Sec. 3.1, paragraph Quark Masses
         // Substitute pole mass by PS mass
+        LoopFunctions loops;
+        loops.F19 = CharmLoops::F19_massless(mu, s, m_b_PS);
+        loops.F29 = CharmLoops::F29_massless(mu, s, m_b_PS);
+        loops.F89 = CharmLoops::F89_massless(s, m_b_PS);
+        loops.G0 = -3.0 / 8.0 * ((ccbar_resonance ? LongDistance::g_had_ccbar(s, m_c_MSbar) : CharmLoops::h(mu, s)) + 4.0 / 9.0);
+        loops.Gb = -3.0 / 8.0 * (CharmLoops::h(mu, s, m_b_PS) + 4.0 / 9.0);
+
+        return c9eff(s, alpha_s, m_c_MSbar, use_nlo, ccbar_resonance, lambda_hat_u, loops, wc);
+    }
+
+    complex<double>
+    ShortDistanceLowRecoil::c9eff(const double & s, const double & alpha_s, const double & m_c_MSbar,
+                bool use_nlo, bool ccbar_resonance, const complex<double> & lambda_hat_u, const LoopFunctions & loops,
+                const WilsonCoefficients<BToS> & wc)
+    {
         complex<double> c = -2.0 / 27.0 * (8.0 * wc.c1() + 6.0 * wc.c2() - 6.0 * wc.c3() - 8.0 * wc.c4() - 12.0 * wc.c5() - 160.0 * wc.c6());
         complex<double> c_0 = -2.0 / 27.0 * (48.0 * wc.c1() + 36.0 * wc.c2() + 198.0 * wc.c3() - 24.0 * wc.c4() + 1872.0 * wc.c5() - 384.0 * wc.c6());
         complex<double> c_b = +2.0 / 27.0 * (126.0 * wc.c3() + 24.0 * wc.c4() + 1368.0 * wc.c5() + 384.0 * wc.c6());
-        complex<double> G0 = -3.0 / 8.0 * ((ccbar_resonance ? LongDistance::g_had_ccbar(s, m_c_MSbar) : CharmLoops::h(mu, s)) + 4.0 / 9.0);
-        complex<double> Gb = -3.0 / 8.0 * (CharmLoops::h(mu, s, m_b_PS) + 4.0 / 9.0);
 
-        complex<double> lo = c_b * Gb + c_0 * G0 + c;
-        complex<double> nlo_alpha_s = -1.0 * (wc.c1() * CharmLoops::F19_massless(mu, s, m_b_PS)
-                                            + wc.c2() * CharmLoops::F29_massless(mu, s, m_b_PS)
-                                            + wc.c8() * CharmLoops::F89_massless(s, m_b_PS));
+        complex<double> lo = c_b * loops.Gb + c_0 * loops.G0 + c;
+        complex<double> nlo_alpha_s = -1.0 * (wc.c1() * loops.F19
+                                            + wc.c2() * loops.F29
+                                            + wc.c8() * loops.F89);
         complex<double> nlo_mc = m_c_MSbar * m_c_MSbar / s * 8.0 *
             ((4.0/9.0 * wc.c1() + 1.0/3.0 * wc.c2()) * (1.0 + lambda_hat_u) + 2.0 * wc.c3() + 20.0 * wc.c5());
 
@@ -65,6 +65,31 @@ namespace eos
 
     struct ShortDistanceLowRecoil
     {
+        /*!
+         * The loop functions that enter c7eff and c9eff at a fixed dilepton invariant mass.
+         *
+         * They depend neither on the Wilson coefficients nor on the CKM matrix elements, and
+         * can therefore be shared between the evaluation of a decay and of its CP conjugate.
+         */
+        struct LoopFunctions
+        {
+            complex<double> F17, F27, F87;
+            complex<double> F19, F29, F89;
+            complex<double> G0, Gb;
+        };
+
+        /*!
+         * Loop functions in the region of low hadronic recoil.
+         *
+         * @param s                     dilepton invariant mass
+         * @param mu                    renormalization scale
+         * @param m_b_PS                PS mass of the bottom quark
+         * @param m_c                   MSbar mass of the charm quark
+         * @param ccbar_resonance       true, if phenomenological data from e^+e^- -> ccbar resonance -> hadrons shall be used
+         */
+        static LoopFunctions loop_functions(const double & s, const double & mu, const double & m_b_PS, const double & m_c_MSbar,
+                bool ccbar_resonance);
+
         /*!
          * Effective Wilson coefficient c7 in the region of low hadronic recoil.
          *
@@ -80,6 +105,17 @@ namespace eos
         static complex<double> c7eff(const double & s, const double & mu, const double & alpha_s, const double & m_b_PS, bool use_nlo,
                 const WilsonCoefficients<BToS> & wc);
 
+        /*!
+         * Effective Wilson coefficient c7 in the region of low hadronic recoil, for precomputed loop functions.
+         *
+         * @param alpha_s       strong coupling evaluated at the scale mu
+         * @param use_nlo       true, if NLO contributions shall be used
+         * @param loops         the loop functions, as obtained from loop_functions()
+         * @param wc            the Wilson coefficients
+         */
+        static complex<double> c7eff(const double & alpha_s, bool use_nlo, const LoopFunctions & loops,
+                const WilsonCoefficients<BToS> & wc);
+
         /*!
          * Effective Wilson coefficient c9 in the region of low hadronic recoil.
          *
@@ -98,6 +134,22 @@ namespace eos
         static complex<double> c9eff(const double & s, const double & mu, const double & alpha_s, const double & m_b_PS, const double & m_c_MSbar,
                 bool use_nlo, bool ccbar_resonance, const complex<double> & lambda_hat_u,
                 const WilsonCoefficients<BToS> & wc);
+
+        /*!
+         * Effective Wilson coefficient c9 in the region of low hadronic recoil, for precomputed loop functions.
+         *
+         * @param s                     dilepton invariant mass
+         * @param alpha_s               strong coupling evaluated at the scale mu
+         * @param m_c                   MSbar mass of the charm quark
+         * @param use_nlo               true, if NLO contributions shall be used
+         * @param ccbar_resonance       true, if phenomenological data from e^+e^- -> ccbar resonance -> hadrons shall be used
+         * @param lambda_hat_u          certain combination of CKM matrix elements: V_ub V_us^* / (V_tb V_ts^*)
+         * @param loops                 the loop functions, as obtained from loop_functions()
+         * @param wc                    the Wilson coefficients
+         */
+        static complex<double> c9eff(const double & s, const double & alpha_s, const double & m_c_MSbar,
+                bool use_nlo, bool ccbar_resonance, const complex<double> & lambda_hat_u, const LoopFunctions & loops,
+                const WilsonCoefficients<BToS> & wc);
     };
 }
 
@@ -38,8 +38,10 @@
 #include <eos/utils/qcd.hh>
 #include <eos/utils/save.hh>
 
+#include <array>
 #include <cmath>
 #include <functional>
+#include <tuple>
 
 #include <gsl/gsl_sf.h>
 
@@ -112,7 +114,7 @@ namespace eos
 
         char q;
 
-        std::string lepton_flavour;
+        LeptonFlavour lepton_flavour;
 
         bool cp_conjugate;
 
@@ -148,7 +150,7 @@ namespace eos
             uncertainty_xi_par(p["formfactors::xi_par_uncertainty"], u),
             tau(p["life_time::B_" + o.get("q", "d")], u),
             e_q(-1.0/3.0),
-            lepton_flavour(o.get("l", "mu")),
+            lepton_flavour(lepton_flavour_from_option(o.get("l", "mu"))),
             cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false")))
         {
             if (0.0 == m_l())
@@ -229,9 +231,23 @@ namespace eos
 #endif
         }
 
+        WilsonCoefficients<BToS> wilson_coefficients(const bool & conjugate) const
+        {
+            return model->wilson_coefficients_b_to_s(mu(), lepton_flavour, conjugate);
+        }
+
         WilsonCoefficients<BToS> wilson_coefficients() const
         {
-            return model->wilson_coefficients_b_to_s(mu(), lepton_flavour, cp_conjugate);
+            return wilson_coefficients(cp_conjugate);
+        }
+
+        complex<double> lambda_hat_u(const bool & conjugate) const
+        {
+            complex<double> result = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
+            if (conjugate)
+                result = std::conj(result);
+
+            return result;
         }
 
         struct DipoleFormFactors
@@ -241,7 +257,89 @@ namespace eos
             complex<double> calT_parallel;
         };
 
-        DipoleFormFactors calT_BFS2004(const double & s, const WilsonCoefficients<BToS> & wc) const
+        /*
+         * All s-dependent intermediate results that neither depend on the Wilson coefficients nor
+         * on the CKM matrix elements. They are identical for the decay and its CP conjugate,
+         * and are computed only once when both are needed.
+         */
+        struct CPInvariants
+        {
+            // kinematics and couplings
+            double m_b_PS, energy, lam, norm_s;
+            double a_mu, a_mu_f;
+
+            // form factors
+            double ff_v, ff_a_0, ff_a_1, ff_a_2, ff_t_1, ff_t_2, ff_t_3;
+            double xi_perp, xi_par;
+
+            // QCDF integrals and the inverse of the "negative" moment of the B meson LCDA
+            QCDFIntegrals::Results qcdf_0, qcdf_c, qcdf_b;
+            complex<double> lambda_B_m_inv;
+
+            // charm and bottom loop functions
+            complex<double> h_c, h_b, h_0;
+            complex<double> F19_massive, F27_massive, F29_massive;
+            complex<double> F19_massless, F27_massless, F29_massless, F87_massless, F89_massless;
+        };
+
+        CPInvariants cp_invariants(const double & s) const
+        {
+            CPInvariants result;
+
+            const double m_c_pole = model->m_c_pole();
+            const double m_b_PS = this->m_b_PS();
+
+            result.m_b_PS = m_b_PS;
+            result.energy = energy(s);
+            result.lam = lam(s);
+            result.norm_s = norm(s);
+
+            // alpha_s at the hard and at the factorization scale
+            result.a_mu = model->alpha_s(mu()) * QCD::casimir_f / 4.0 / M_PI;
+            result.a_mu_f = model->alpha_s(std::sqrt(mu() * 0.5)) * QCD::casimir_f / 4.0 / M_PI;
+
+            result.ff_v   = form_factors->v(s);
+            result.ff_a_0 = form_factors->a_0(s);
+            result.ff_a_1 = form_factors->a_1(s);
+            result.ff_a_2 = form_factors->a_2(s);
+            result.ff_t_1 = form_factors->t_1(s);
+            result.ff_t_2 = form_factors->t_2(s);
+            result.ff_t_3 = form_factors->t_3(s);
+
+            // cf. [BHP2008], Eq. (E.4), p. 23
+            result.xi_perp = uncertainty_xi_perp * (m_B() / (m_B() + m_Kstar())) * result.ff_v;
+            result.xi_par  = uncertainty_xi_par * ((m_B() + m_Kstar()) / (2.0 * result.energy) * result.ff_a_1 - (1.0 - m_Kstar() / m_B()) * result.ff_a_2);
+
+            // The QCDF integrals depend only on s and on hadronic inputs. They are shared by all observables
+            // (and all integration grids) of this decay that evaluate them at the same point, for the same parameters.
+            const auto qcdf = QCDFIntegralsCache::instance()->dilepton(s, m_c_pole, m_b_PS, m_B(), m_Kstar(), mu(), a_1_perp(), a_2_perp(), a_1_par(), a_2_par());
+            result.qcdf_0 = qcdf.massless;
+            result.qcdf_c = qcdf.charm;
+            result.qcdf_b = qcdf.bottom;
+
+            // cf. [BFS2001], Eq. (54), p. 15
+            const double omega_0 = lambda_B_p;
+            result.lambda_B_m_inv = complex<double>(-gsl_sf_expint_Ei(s / m_B / omega_0), M_PI) * (std::exp(-s / m_B / omega_0) / omega_0);
+
+            // Use b pole mass according to [BFS2001], Sec. 3.1, paragraph Quark Masses,
+            // then replace b pole mass by the PS mass.
+            result.h_c = CharmLoops::h(mu, s, m_c_pole);
+            result.h_b = CharmLoops::h(mu, s, m_b_PS);
+            result.h_0 = CharmLoops::h(mu, s);
+
+            result.F19_massive = memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole);
+            result.F27_massive = memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole);
+            result.F29_massive = memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole);
+            result.F19_massless = CharmLoops::F19_massless(mu, s, m_b_PS);
+            result.F27_massless = CharmLoops::F27_massless(mu, s, m_b_PS);
+            result.F29_massless = CharmLoops::F29_massless(mu, s, m_b_PS);
+            result.F87_massless = CharmLoops::F87_massless(mu, s, m_b_PS);
+            result.F89_massless = CharmLoops::F89_massless(s, m_b_PS);
+
+            return result;
+        }
+
+        DipoleFormFactors calT_BFS2004(const double & s, const WilsonCoefficients<BToS> & wc, const complex<double> & lambda_hat_u, const CPInvariants & inv) const
         {
             // charges of down- and up-type quarks
             static const double e_d = -1.0/3.0;
@@ -251,31 +349,21 @@ namespace eos
             double delta_qu = (q == 'u' ? 1.0 : 0.0);
 
             // kinematics
-            double m_c_pole = model->m_c_pole();
-            double m_b_PS = this->m_b_PS(), m_b_PS2 = m_b_PS * m_b_PS;
-            double energy = this->energy(s);
+            double m_b_PS = inv.m_b_PS, m_b_PS2 = m_b_PS * m_b_PS;
+            double energy = inv.energy;
             double L = -1.0 * (m_b_PS2 - s) / s * std::log(1.0 - s / m_b_PS2);
 
             // couplings
-            double alpha_s_mu = model->alpha_s(mu()); // alpha_s at the hard scale
-            double a_mu = alpha_s_mu * QCD::casimir_f / 4.0 / M_PI;
-            double alpha_s_mu_f = model->alpha_s(std::sqrt(mu() * 0.5)); // alpha_s at the factorization scale
-            double a_mu_f = alpha_s_mu_f * QCD::casimir_f / 4.0 / M_PI;
-            complex<double> lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
-            if (cp_conjugate)
-                lambda_hat_u = std::conj(lambda_hat_u);
+            double a_mu = inv.a_mu, a_mu_f = inv.a_mu_f;
 
-            // Compute the QCDF Integrals
+            // QCDF Integrals
             double invm1_par = 3.0 * (1.0 + a_1_par + a_2_par); // <ubar^-1>_par
             double invm1_perp = 3.0 * (1.0 + a_1_perp + a_2_perp); // <ubar^-1>_perp
-            QCDFIntegrals::Results qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
-            QCDFIntegrals::Results qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
-            QCDFIntegrals::Results qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            const QCDFIntegrals::Results & qcdf_0 = inv.qcdf_0, & qcdf_c = inv.qcdf_c, & qcdf_b = inv.qcdf_b;
 
-            // inverse of the "negative" moment of the B meson LCDA
-            // cf. [BFS2001], Eq. (54), p. 15
-            double omega_0 = lambda_B_p, lambda_B_p_inv = 1.0 / lambda_B_p;
-            complex<double> lambda_B_m_inv = complex<double>(-gsl_sf_expint_Ei(s / m_B / omega_0), M_PI) * (std::exp(-s / m_B / omega_0) / omega_0);
+            // inverse moments of the B meson LCDA
+            double lambda_B_p_inv = 1.0 / lambda_B_p;
+            const complex<double> & lambda_B_m_inv = inv.lambda_B_m_inv;
 
             /* Y(s) for the up and the top sector */
             // cf. [BFS2001], Eq. (10), p. 4
@@ -286,12 +374,12 @@ namespace eos
 
             // Use b pole mass according to [BFS2001], Sec. 3.1, paragraph Quark Masses,
             // then replace b pole mass by the PS mass.
-            complex<double> Y_top = Y_top_c * CharmLoops::h(mu, s, m_c_pole)
-                 + Y_top_b * CharmLoops::h(mu, s, m_b_PS)
-                 + Y_top_0 * CharmLoops::h(mu, s)
+            complex<double> Y_top = Y_top_c * inv.h_c
+                 + Y_top_b * inv.h_b
+                 + Y_top_0 * inv.h_0
                  + Y_top_;
             // cf. [BFS2004], Eq. (43), p. 24
-            complex<double> Y_up = (4.0 / 3.0 * wc.c1() + wc.c2()) * (CharmLoops::h(mu, s, m_c_pole) - CharmLoops::h(mu, s));
+            complex<double> Y_up = (4.0 / 3.0 * wc.c1() + wc.c2()) * (inv.h_c - inv.h_0);
 
             /* Effective wilson coefficients */
             // cf. [BFS2001], below Eq. (9), p. 4
@@ -308,11 +396,11 @@ namespace eos
             complex<double> C1f_top_perp_right = (c7eff + wc.c7prime()) * (8.0 * std::log(m_b_PS / mu()) - L - 4.0 * (1.0 - mu_f() / m_b_PS));
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             complex<double> C1nf_top_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * inv.F27_massive + c8eff * inv.F87_massless
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
-                        + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
+                        wc.c1() * inv.F19_massive
+                        + wc.c2() * inv.F29_massive
+                        + c8eff * inv.F89_massless));
 
             /* perpendicular, up sector */
             // cf. [BFS2004], comment before Eq. (43), p. 24
@@ -321,10 +409,10 @@ namespace eos
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
             complex<double> C1nf_up_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (inv.F27_massive - inv.F27_massless)
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (inv.F19_massive - inv.F19_massless)
+                        + wc.c2() * (inv.F29_massive - inv.F29_massless)));
 
             /* parallel, top sector */
             // cf. [BFS2001], Eqs. (14), (15), p. 5, in comparison with \delta_{2,3} = 1
@@ -333,12 +421,12 @@ namespace eos
             complex<double> C1f_top_par = -1.0 * (c7eff - wc.c7prime()) * (8.0 * std::log(m_b_PS / mu) + 2.0 * L - 4.0 * (1.0 - mu_f() / m_b_PS));
             // cf. [BFS2001], Eqs. (38), p. 9
             complex<double> C1nf_top_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
-                    + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * inv.F27_massive
+                    + c8eff * inv.F87_massless
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
-                        + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
+                        wc.c1() * inv.F19_massive
+                        + wc.c2() * inv.F29_massive
+                        + c8eff * inv.F89_massless));
 
             /* parallel, up sector */
             // cf. [BFS2004], comment before Eq. (43), p. 24
@@ -347,10 +435,10 @@ namespace eos
             // cf. [BFS2004], last paragraph in Sec A.1, p. 24
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
             complex<double> C1nf_up_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (inv.F27_massive - inv.F27_massless)
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (inv.F19_massive - inv.F19_massless)
+                        + wc.c2() * (inv.F29_massive - inv.F29_massless)));
 
             // compute the factorizing contributions
             complex<double> C_perp_left  = C0_top_perp_left  + lambda_hat_u * C0_up_perp
@@ -452,19 +540,19 @@ namespace eos
 
             // cf. [BFS2001], Eq. (15), and [BHP2008], Eq. (C.4)
             DipoleFormFactors result;
-            result.calT_perp_left  = xi_perp(s) * C_perp_left
+            result.calT_perp_left  = inv.xi_perp * C_perp_left
                 + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_perp) / m_B * T_perp_left
                 + Delta_T_perp;
-            result.calT_perp_right = xi_perp(s) * C_perp_right
+            result.calT_perp_right = inv.xi_perp * C_perp_right
                 + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_perp) / m_B * T_perp_right
                 + Delta_T_perp;
-            result.calT_parallel = xi_par(s) * C_par
+            result.calT_parallel = inv.xi_par * C_par
                 + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_par * m_Kstar) / (m_B * energy) * T_par;
 
             return result;
         }
 
-        DipoleFormFactors calT_ABBBSW2008(const double & s, const WilsonCoefficients<BToS> & wc) const
+        DipoleFormFactors calT_ABBBSW2008(const double & s, const WilsonCoefficients<BToS> & wc, const complex<double> & lambda_hat_u, const CPInvariants & inv) const
         {
             // charges of down- and up-type quarks
             static const double
@@ -476,34 +564,25 @@ namespace eos
 
             // kinematics
             const double
-                m_c_pole = model->m_c_pole(),
-                m_b_PS = this->m_b_PS(),
-                energy = this->energy(s);
+                m_b_PS = inv.m_b_PS,
+                energy = inv.energy;
 
             // couplings
             const double
-                alpha_s_mu = model->alpha_s(mu()), // alpha_s at the hard scale
-                a_mu = alpha_s_mu * QCD::casimir_f / 4.0 / M_PI,
-                alpha_s_mu_f = model->alpha_s(std::sqrt(mu() * 0.5)), // alpha_s at the factorization scale
-                a_mu_f = alpha_s_mu_f * QCD::casimir_f / 4.0 / M_PI;
-
-            complex<double> lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
-            if (cp_conjugate)
-                lambda_hat_u = std::conj(lambda_hat_u);
+                a_mu = inv.a_mu,
+                a_mu_f = inv.a_mu_f;
 
-            QCDFIntegrals::Results
-                qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
-                qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
-                qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            const QCDFIntegrals::Results
+                & qcdf_0 = inv.qcdf_0,
+                & qcdf_c = inv.qcdf_c,
+                & qcdf_b = inv.qcdf_b;
 
-            // inverse of the "negative" moment of the B meson LCDA
-            // cf. [BFS2001], Eq. (54), p. 15
+            // inverse moments of the B meson LCDA
             const double
-                omega_0 = lambda_B_p,
                 lambda_B_p_inv = 1.0 / lambda_B_p;
 
             const complex<double>
-                lambda_B_m_inv = complex<double>(-gsl_sf_expint_Ei(s / m_B / omega_0), M_PI) * (std::exp(-s / m_B / omega_0) / omega_0);
+                & lambda_B_m_inv = inv.lambda_B_m_inv;
 
             /* Effective wilson coefficients */
             // cf. [BFS2001], below Eq. (26), p. 8
@@ -513,40 +592,40 @@ namespace eos
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             const complex<double>
                 C1nf_top_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
-                    + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * inv.F27_massive
+                    + c8eff * inv.F87_massless
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
-                        + c8eff * CharmLoops::F89_massless(s, m_b_PS))),
+                        wc.c1() * inv.F19_massive
+                        + wc.c2() * inv.F29_massive
+                        + c8eff * inv.F89_massless)),
 
             /* perpendicular, up sector */
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
                 C1nf_up_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (inv.F27_massive - inv.F27_massless)
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS)))),
+                        wc.c1() * (inv.F19_massive - inv.F19_massless)
+                        + wc.c2() * (inv.F29_massive - inv.F29_massless))),
 
             /* parallel, top sector */
             // cf. [BFS2001], Eqs. (38), p. 9
                 C1nf_top_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
-                    + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * inv.F27_massive
+                    + c8eff * inv.F87_massless
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
-                        + c8eff * CharmLoops::F89_massless(s, m_b_PS))),
+                        wc.c1() * inv.F19_massive
+                        + wc.c2() * inv.F29_massive
+                        + c8eff * inv.F89_massless)),
 
             /* parallel, up sector */
             // cf. [BFS2004], last paragraph in Sec A.1, p. 24
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
                 C1nf_up_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (inv.F27_massive - inv.F27_massless)
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (inv.F19_massive - inv.F19_massless)
+                        + wc.c2() * (inv.F29_massive - inv.F29_massless)));
 
             // compute the factorizing contributions
             // in ABBBSW2008: C0 is included in naively factorizing part and C1f = 0
@@ -641,9 +720,9 @@ namespace eos
 
             // cf. [BFS2001], Eq. (15), and [BHP2008], Eq. (C.4)
             DipoleFormFactors result;
-            result.calT_perp_left  = xi_perp(s) * C_perp + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_perp) / m_B * T_perp + Delta_T_perp;
+            result.calT_perp_left  = inv.xi_perp * C_perp + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_perp) / m_B * T_perp + Delta_T_perp;
             result.calT_perp_right = result.calT_perp_left;
-            result.calT_parallel   = xi_par(s) * C_par   + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_par * m_Kstar) / (m_B * energy) * T_par;
+            result.calT_parallel   = inv.xi_par * C_par   + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_par * m_Kstar) / (m_B * energy) * T_par;
 
             return result;
         }
@@ -711,24 +790,22 @@ namespace eos
         /* Amplitudes */
         // cf. [BHP2008], p. 20
         // cf. [BHvD2012], app B, eqs. (B13 - B19)
-        Amplitudes amp_BFS2004(const double & s) const
+        Amplitudes amp_BFS2004(const double & s, const WilsonCoefficients<BToS> & wc, const complex<double> & lambda_hat_u, const CPInvariants & inv) const
         {
             Amplitudes result;
 
-            WilsonCoefficients<BToS> wc = wilson_coefficients();
-
             const double
                 shat = s_hat(s),
-                mbhat = m_b_PS() / m_B,
+                mbhat = inv.m_b_PS / m_B,
                 mKhat2 = power_of<2>(m_Kstar() / m_B()),
                 m_K2 = power_of<2>(m_Kstar()),
                 m_B2 = power_of<2>(m_B()),
                 m2_diff = m_B2 - m_K2,
-                norm_s = this->norm(s),
-                sqrt_lam = std::sqrt(lam(s)),
+                norm_s = inv.norm_s,
+                sqrt_lam = std::sqrt(inv.lam),
                 sqrt_s = std::sqrt(s);
 
-            DipoleFormFactors dff = calT_BFS2004(s, wc);
+            DipoleFormFactors dff = calT_BFS2004(s, wc, lambda_hat_u, inv);
 
             const complex<double>
                 wilson_minus_right = (wc.c9() - wc.c9prime()) + (wc.c10() - wc.c10prime()),
@@ -740,10 +817,10 @@ namespace eos
             const double prefactor_long = -norm_s / (2.0 * m_Kstar() * std::sqrt(s));
 
             const complex<double>
-                a = (m2_diff - s) * 2.0 * energy(s) * xi_perp(s) - lam(s) * m_B() / m2_diff * (xi_perp(s) - xi_par(s)),
-                b = 2.0 * m_b_PS() * (
-                        ((m_B2 + 3.0 * m_K2 - s) * 2.0 * energy(s) / m_B() - lam(s) / m2_diff) * dff.calT_perp_left
-                        - lam(s) / m2_diff * dff.calT_parallel
+                a = (m2_diff - s) * 2.0 * inv.energy * inv.xi_perp - inv.lam * m_B() / m2_diff * (inv.xi_perp - inv.xi_par),
+                b = 2.0 * inv.m_b_PS * (
+                        ((m_B2 + 3.0 * m_K2 - s) * 2.0 * inv.energy / m_B() - inv.lam / m2_diff) * dff.calT_perp_left
+                        - inv.lam / m2_diff * dff.calT_parallel
                     );
 
             result.a_long_right = prefactor_long * (wilson_minus_right * a + uncertainty_long() * b);
@@ -752,37 +829,37 @@ namespace eos
             // perpendicular amplitude
             const double prefactor_perp = +std::sqrt(2.0) * norm_s * m_B() * std::sqrt(lambda(1.0, mKhat2, shat));
 
-            result.a_perp_right = prefactor_perp * (wilson_plus_right * xi_perp(s) + uncertainty_perp() * (2.0 * mbhat / shat) * dff.calT_perp_right);
-            result.a_perp_left  = prefactor_perp * (wilson_plus_left  * xi_perp(s) + uncertainty_perp() * (2.0 * mbhat / shat) * dff.calT_perp_right);
+            result.a_perp_right = prefactor_perp * (wilson_plus_right * inv.xi_perp + uncertainty_perp() * (2.0 * mbhat / shat) * dff.calT_perp_right);
+            result.a_perp_left  = prefactor_perp * (wilson_plus_left  * inv.xi_perp + uncertainty_perp() * (2.0 * mbhat / shat) * dff.calT_perp_right);
 
             // parallel amplitude
             const double prefactor_par = -std::sqrt(2.0) * norm_s * m2_diff;
 
             result.a_par_right = prefactor_par * (
-                                    wilson_minus_right * xi_perp(s) * 2.0 * energy(s) / m2_diff
-                                    + uncertainty_para() * 4.0 * m_b_PS() * energy(s) / s / m_B() * dff.calT_perp_left
+                                    wilson_minus_right * inv.xi_perp * 2.0 * inv.energy / m2_diff
+                                    + uncertainty_para() * 4.0 * inv.m_b_PS * inv.energy / s / m_B() * dff.calT_perp_left
                                  );
             result.a_par_left  = prefactor_par * (
-                                    wilson_minus_left  * xi_perp(s) * 2.0 * energy(s) / m2_diff
-                                    + uncertainty_para() * 4.0 * m_b_PS() * energy(s) / s / m_B() * dff.calT_perp_left
+                                    wilson_minus_left  * inv.xi_perp * 2.0 * inv.energy / m2_diff
+                                    + uncertainty_para() * 4.0 * inv.m_b_PS * inv.energy / s / m_B() * dff.calT_perp_left
                                  );
 
             // timelike amplitude
             result.a_timelike = norm_s * sqrt_lam / sqrt_s
                 * (2.0 * (wc.c10() - wc.c10prime()) + s / m_l / (m_b_MSbar + m_s_MSbar) * (wc.cP() - wc.cPprime()))
-                * form_factors->a_0(s);
+                * inv.ff_a_0;
 
             // scalar amplitude
-            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s_MSbar) * form_factors->a_0(s);
+            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s_MSbar) * inv.ff_a_0;
 
             // tensor amplitudes [BHvD2012]  eqs. (B18 - B20)
             // no form factor relations used
             const double
-                ff_T1  = form_factors->t_1(s),
-                ff_T2  = form_factors->t_2(s),
-                ff_T3  = form_factors->t_3(s),
+                ff_T1  = inv.ff_t_1,
+                ff_T2  = inv.ff_t_2,
+                ff_T3  = inv.ff_t_3,
 
-                kin_tensor_1 = norm_s / m_Kstar() * ((m_B2 + 3.0 * m_K2 - s) * ff_T2 - lam(s) / m2_diff * ff_T3),
+                kin_tensor_1 = norm_s / m_Kstar() * ((m_B2 + 3.0 * m_K2 - s) * ff_T2 - inv.lam / m2_diff * ff_T3),
                 kin_tensor_2 = 2.0 * norm_s * sqrt_lam / sqrt_s * ff_T1,
                 kin_tensor_3 = 2.0 * norm_s * m2_diff / sqrt_s * ff_T2;
 
@@ -805,12 +882,10 @@ namespace eos
         // cf. [BHvD2012] for tensor amplitudes
         // use full QCD form factors in leading QCDF (naively factorizing) amplitudes
         // use soft form factors in non-factorizable contributions (~ alpha_s)
-        Amplitudes amp_ABBBSW2008(const double & s) const
+        Amplitudes amp_ABBBSW2008(const double & s, const WilsonCoefficients<BToS> & wc, const complex<double> & lambda_hat_u, const CPInvariants & inv) const
         {
             Amplitudes result;
 
-            WilsonCoefficients<BToS> wc = wilson_coefficients();
-
             const double
                 shat = s_hat(s),
                 sqrt_s = std::sqrt(s),
@@ -820,25 +895,17 @@ namespace eos
                 m_sum = m_B() + m_Kstar(),
                 m_diff = m_B() - m_Kstar(),
                 m2_diff = m_B2 - m_K2,
-                norm_s = this->norm(s),
-                sqrt_lam = std::sqrt(lam(s));
+                norm_s = inv.norm_s,
+                sqrt_lam = std::sqrt(inv.lam);
 
             const double
-                ff_V   = form_factors->v(s),
-                ff_A0  = form_factors->a_0(s),
-                ff_A1  = form_factors->a_1(s),
-                ff_A2  = form_factors->a_2(s),
-                ff_T1  = form_factors->t_1(s),
-                ff_T2  = form_factors->t_2(s),
-                ff_T3  = form_factors->t_3(s);
-
-            const double
-                m_c_pole = model->m_c_pole(),
-                m_b_PS = this->m_b_PS();
-
-            complex<double> lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
-            if (cp_conjugate)
-                lambda_hat_u = std::conj(lambda_hat_u);
+                ff_V   = inv.ff_v,
+                ff_A0  = inv.ff_a_0,
+                ff_A1  = inv.ff_a_1,
+                ff_A2  = inv.ff_a_2,
+                ff_T1  = inv.ff_t_1,
+                ff_T2  = inv.ff_t_2,
+                ff_T3  = inv.ff_t_3;
 
             /* Y(s) for the up and the top sector for effective Wilson coefficients */
             // cf. [BFS2001], Eq. (10), p. 4
@@ -850,12 +917,12 @@ namespace eos
 
             // Use b pole mass according to [BFS2001], Sec. 3.1, paragraph Quark Masses,
             // then replace b pole mass by the PS mass.
-            complex<double> Y_top = Y_top_c * CharmLoops::h(mu, s, m_c_pole)
-                 + Y_top_b * CharmLoops::h(mu, s, m_b_PS)
-                 + Y_top_0 * CharmLoops::h(mu, s)
+            complex<double> Y_top = Y_top_c * inv.h_c
+                 + Y_top_b * inv.h_b
+                 + Y_top_0 * inv.h_0
                  + Y_top_;
             // cf. [BFS2004], Eq. (43), p. 24
-            complex<double> Y_up = (4.0 / 3.0 * wc.c1() + wc.c2()) * (CharmLoops::h(mu, s, m_c_pole) - CharmLoops::h(mu, s));
+            complex<double> Y_up = (4.0 / 3.0 * wc.c1() + wc.c2()) * (inv.h_c - inv.h_0);
 
             const complex<double>
                 // cf. [BFS2001], below Eq. (9), p. 4
@@ -877,8 +944,8 @@ namespace eos
             const double pre_long = -norm_s / (2.0 * m_Kstar() * std::sqrt(s));
 
             const complex<double>
-                a = (m2_diff - s) * m_sum * ff_A1 - lam(s) / m_sum * ff_A2,
-                b = (m_B2 + 3.0 * m_K2 - s) * ff_T2 - lam(s) / m2_diff * ff_T3;
+                a = (m2_diff - s) * m_sum * ff_A1 - inv.lam / m_sum * ff_A2,
+                b = (m_B2 + 3.0 * m_K2 - s) * ff_T2 - inv.lam / m2_diff * ff_T3;
 
             result.a_long_right = pre_long * (c910_mi_r * a + c7_mi * b);
             result.a_long_left  = pre_long * (c910_mi_l * a + c7_mi * b);
@@ -906,7 +973,7 @@ namespace eos
 
             // tensor amplitudes
             const double
-                kin_tensor_1 = norm_s / m_Kstar() * ((m_B2 + 3.0 * m_K2 - s) * ff_T2 - lam(s) / m2_diff * ff_T3),
+                kin_tensor_1 = norm_s / m_Kstar() * ((m_B2 + 3.0 * m_K2 - s) * ff_T2 - inv.lam / m2_diff * ff_T3),
                 kin_tensor_2 = 2.0 * norm_s * sqrt_lam / sqrt_s * ff_T1,
                 kin_tensor_3 = 2.0 * norm_s * m2_diff / sqrt_s * ff_T2;
 
@@ -926,14 +993,14 @@ namespace eos
             // Beyond Naive factorization part - from QCDF
             //
 
-            DipoleFormFactors dff = calT_ABBBSW2008(s, wc);
+            DipoleFormFactors dff = calT_ABBBSW2008(s, wc, lambda_hat_u, inv);
 
             // these kinematical factors reduce for mKstar = 0 to [ABBBSW2008] eq. (3.46)
 #if 0
             const complex<double>
                 c_long = 2.0 * m_b_MSbar * (
-                           ((m_B2 + 3.0 * m_K2 - s) * 2.0 * energy(s) / m_B() - lam(s) / m2_diff) * dff.calT_perp_left
-                            - lam(s) / m2_diff * dff.calT_parallel
+                           ((m_B2 + 3.0 * m_K2 - s) * 2.0 * energy(s) / m_B() - inv.lam / m2_diff) * dff.calT_perp_left
+                            - inv.lam / m2_diff * dff.calT_parallel
                          );
 
             result.a_long_right += uncertainty_long_right * pre_long * c_long;
@@ -965,22 +1032,22 @@ namespace eos
             return result;
         }
 
-        Amplitudes amplitudes(const double & s) const
+        Amplitudes amplitudes(const double & s, const WilsonCoefficients<BToS> & wc, const complex<double> & lambda_hat_u, const CPInvariants & inv) const
         {
             Amplitudes amp;
 
             if (ff_relation == "BFS2004")
-                amp = amp_BFS2004(s);
+                amp = amp_BFS2004(s, wc, lambda_hat_u, inv);
             else if (ff_relation == "ABBBSW2008")
-                amp = amp_ABBBSW2008(s);
+                amp = amp_ABBBSW2008(s, wc, lambda_hat_u, inv);
             else
                 throw InvalidOptionValueError("large-recoil-ff", ff_relation, "BFS2004, ABBBSW2008");
             return amp;
         }
 
-        std::array<double, 12> differential_angular_coefficients_array(const double & s) const
+        Amplitudes amplitudes(const double & s) const
         {
-            return angular_coefficients_array(amplitudes(s), s, m_l());
+            return amplitudes(s, wilson_coefficients(), lambda_hat_u(cp_conjugate), cp_invariants(s));
         }
 
         AngularCoefficients differential_angular_coefficients(const double & s) const
@@ -990,13 +1057,50 @@ namespace eos
 
         AngularCoefficients integrated_angular_coefficients(const double & s_min, const double & s_max) const
         {
-            std::function<std::array<double, 12> (const double &)> integrand =
-                    std::bind(&Implementation<BToKstarDilepton<LargeRecoil>>::differential_angular_coefficients_array, this, std::placeholders::_1);
+            // the Wilson coefficients do not depend on s
+            const WilsonCoefficients<BToS> wc = wilson_coefficients();
+            const complex<double> lambda_hat_u = this->lambda_hat_u(cp_conjugate);
+
+            std::function<std::array<double, 12> (const double &)> integrand = [&] (const double & s) -> std::array<double, 12>
+            {
+                return angular_coefficients_array(amplitudes(s, wc, lambda_hat_u, cp_invariants(s)), s, m_l());
+            };
             std::array<double, 12> integrated_angular_coefficients_array = integrate1D(integrand, 64, s_min, s_max);
 
             return array_to_angular_coefficients(integrated_angular_coefficients_array);
         }
 
+        // The angular coefficients of the decay and of its CP conjugate, irrespective of the option 'cp-conjugate'.
+        std::array<double, 24> differential_angular_coefficients_cp_pair_array(const double & s,
+                const WilsonCoefficients<BToS> & wc, const WilsonCoefficients<BToS> & wc_bar,
+                const complex<double> & lambda_hat_u, const complex<double> & lambda_hat_u_bar) const
+        {
+            // evaluate the CP-invariant intermediate results only once
+            const CPInvariants inv = cp_invariants(s);
+
+            return angular_coefficients_cp_pair_array(amplitudes(s, wc, lambda_hat_u, inv), amplitudes(s, wc_bar, lambda_hat_u_bar, inv), s, m_l());
+        }
+
+        std::pair<AngularCoefficients, AngularCoefficients> differential_angular_coefficients_cp_pair(const double & s) const
+        {
+            return array_to_angular_coefficients_cp_pair(differential_angular_coefficients_cp_pair_array(s,
+                        wilson_coefficients(false), wilson_coefficients(true), lambda_hat_u(false), lambda_hat_u(true)));
+        }
+
+        // Integrate the angular coefficients of the decay and of its CP conjugate in a single pass over s.
+        std::pair<AngularCoefficients, AngularCoefficients> integrated_angular_coefficients_cp_pair(const double & s_min, const double & s_max) const
+        {
+            const WilsonCoefficients<BToS> wc = wilson_coefficients(false), wc_bar = wilson_coefficients(true);
+            const complex<double> lambda_hat_u = this->lambda_hat_u(false), lambda_hat_u_bar = this->lambda_hat_u(true);
+
+            std::function<std::array<double, 24> (const double &)> integrand = [&] (const double & s) -> std::array<double, 24>
+            {
+                return differential_angular_coefficients_cp_pair_array(s, wc, wc_bar, lambda_hat_u, lambda_hat_u_bar);
+            };
+
+            return array_to_angular_coefficients_cp_pair(integrate1D(integrand, 64, s_min, s_max));
+        }
+
         double a_fb_zero_crossing() const
         {
             // We trust QCDF results in a validity range from 0.5 GeV^2 < s < 6.0 GeV^2
@@ -1235,11 +1339,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_p_prime_4(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         // cf. [DMRV2012], p. 9, eq. (15)
         return (a_c.j4 + a_c_bar.j4) / std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s));
@@ -1248,11 +1349,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_p_prime_5(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         // cf. [DMRV2012], p. 9, eq. (16)
         return (a_c.j5 + a_c_bar.j5) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1261,11 +1359,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_p_prime_6(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         // cf. [DMRV2012], p. 9, eq. (17)
         return -1.0 * (a_c.j7 + a_c_bar.j7) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1371,11 +1466,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_3_normalized_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return (a_c.j3 + a_c_bar.j3) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1411,11 +1503,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_6c_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return 0.5 * (a_c.j6c + a_c_bar.j6c);
     }
@@ -1451,11 +1540,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_9_normalized_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return (a_c.j9 + a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1463,11 +1549,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_1c_plus_j_2c_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return 0.5 * (a_c.j1c + a_c_bar.j1c + a_c.j2c + a_c_bar.j2c);
     }
@@ -1475,11 +1558,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_1s_minus_3j_2s_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return 0.5 * (a_c.j1s + a_c_bar.j1s - 3.0 * (a_c.j2s + a_c_bar.j2s));
     }
@@ -1490,7 +1570,7 @@ namespace eos
         double J4_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
 
             J4_electrons = differential_j_4(s);
         }
@@ -1498,7 +1578,7 @@ namespace eos
         double J4_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
 
             J4_muons = differential_j_4(s);
         }
@@ -1512,7 +1592,7 @@ namespace eos
         double J5_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
 
             J5_electrons = differential_j_5(s);
         }
@@ -1520,7 +1600,7 @@ namespace eos
         double J5_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
 
             J5_muons = differential_j_5(s);
         }
@@ -1534,7 +1614,7 @@ namespace eos
         double J6s_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
 
             J6s_electrons = differential_j_6s(s);
         }
@@ -1542,7 +1622,7 @@ namespace eos
         double J6s_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
 
             J6s_muons = differential_j_6s(s);
         }
@@ -1556,7 +1636,7 @@ namespace eos
         double gamma_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
 
             gamma_electrons = differential_decay_width(s);
         }
@@ -1564,7 +1644,7 @@ namespace eos
         double gamma_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
 
             gamma_muons = differential_decay_width(s);
         }
@@ -1588,11 +1668,11 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_branching_ratio_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double br = integrated_branching_ratio(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double br_bar = integrated_branching_ratio(s_min, s_max);
+        double br = decay_width(a_c) * _imp->tau() / _imp->hbar();
+        double br_bar = decay_width(a_c_bar) * _imp->tau() / _imp->hbar();
 
         return 0.5 * (br + br_bar);
     }
@@ -1600,11 +1680,11 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_cp_asymmetry(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double gamma = integrated_decay_width(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double gamma_bar = integrated_decay_width(s_min, s_max);
+        double gamma = decay_width(a_c);
+        double gamma_bar = decay_width(a_c_bar);
 
         return (gamma - gamma_bar) / (gamma + gamma_bar);
     }
@@ -1635,11 +1715,11 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_forward_backward_asymmetry_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double a_fb = integrated_forward_backward_asymmetry(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double a_fb_bar = integrated_forward_backward_asymmetry(s_min, s_max);
+        double a_fb = (a_c.j6s + 0.5 * a_c.j6c) / decay_width(a_c);
+        double a_fb_bar = (a_c_bar.j6s + 0.5 * a_c_bar.j6c) / decay_width(a_c_bar);
 
         return 0.5 * (a_fb + a_fb_bar);
     }
@@ -1655,11 +1735,11 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_longitudinal_polarisation_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double f_l = integrated_longitudinal_polarisation(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double f_l_bar = integrated_longitudinal_polarisation(s_min, s_max);
+        double f_l = (a_c.j1c - a_c.j2c / 3.0) / decay_width(a_c);
+        double f_l_bar = (a_c_bar.j1c - a_c_bar.j2c / 3.0) / decay_width(a_c_bar);
 
         return 0.5 * (f_l + f_l_bar);
     }
@@ -1675,11 +1755,11 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_transversal_polarisation_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double f_t = integrated_transversal_polarisation(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double f_t_bar = integrated_transversal_polarisation(s_min, s_max);
+        double f_t = 2.0 * (a_c.j1s - a_c.j2s / 3.0) / decay_width(a_c);
+        double f_t_bar = 2.0 * (a_c_bar.j1s - a_c_bar.j2s / 3.0) / decay_width(a_c_bar);
 
         return 0.5 * (f_t + f_t_bar);
     }
@@ -1696,11 +1776,11 @@ namespace eos
     BToKstarDilepton<LargeRecoil>::integrated_transverse_asymmetry_2_cp_averaged(const double & s_min, const double & s_max) const
     {
         // cf. [BHvD2010], eq. (2.10), p. 6
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double a_t_2 = integrated_transverse_asymmetry_2(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double a_t_2_bar = integrated_transverse_asymmetry_2(s_min, s_max);
+        double a_t_2 = 0.5 * a_c.j3 / a_c.j2s;
+        double a_t_2_bar = 0.5 * a_c_bar.j3 / a_c_bar.j2s;
 
         return 0.5 * (a_t_2 + a_t_2_bar);
     }
@@ -1752,11 +1832,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_p_prime_4(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         // cf. [DMRV2012], p. 9, eq. (15)
         return (a_c.j4 + a_c_bar.j4) / std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s));
@@ -1765,11 +1842,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_p_prime_5(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         // cf. [DMRV2012], p. 9, eq. (16)
         return (a_c.j5 + a_c_bar.j5) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1778,11 +1852,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_p_prime_6(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         // cf. [DMRV2012], p. 9, eq. (17)
         return -1.0 * (a_c.j7 + a_c_bar.j7) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1878,11 +1949,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_3_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j3 + a_c_bar.j3) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1897,11 +1965,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_4_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j4 + a_c_bar.j4) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1916,11 +1981,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_5_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j5 + a_c_bar.j5) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1949,11 +2011,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_7_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j7 + a_c_bar.j7) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1968,11 +2027,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_8_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j8 + a_c_bar.j8) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1994,11 +2050,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_9_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j9 + a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -2006,11 +2059,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_a_9(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j9 - a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -2021,7 +2071,7 @@ namespace eos
         double J4_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
 
             J4_electrons = integrated_j_4(s_min, s_max);
         }
@@ -2029,7 +2079,7 @@ namespace eos
         double J4_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
 
             J4_muons = integrated_j_4(s_min, s_max);
         }
@@ -2043,7 +2093,7 @@ namespace eos
         double J5_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
 
             J5_electrons = integrated_j_5(s_min, s_max);
         }
@@ -2051,7 +2101,7 @@ namespace eos
         double J5_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
 
             J5_muons = integrated_j_5(s_min, s_max);
         }
@@ -2065,7 +2115,7 @@ namespace eos
         double J6s_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
 
             J6s_electrons = integrated_j_6s(s_min, s_max);
         }
@@ -2073,7 +2123,7 @@ namespace eos
         double J6s_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
 
             J6s_muons = integrated_j_6s(s_min, s_max);
         }
@@ -2090,14 +2140,14 @@ namespace eos
         double br_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
             br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
 
         double br_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
             br_muons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
 
@@ -2227,7 +2277,7 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane using the LHC
         // spectator quark flavor
         char q;
 
-        std::string lepton_flavour;
+        LeptonFlavour lepton_flavour;
 
         bool cp_conjugate;
 
@@ -2255,7 +2305,7 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane using the LHC
             lambda_psd(p["B->Pll::Lambda_pseudo@LargeRecoil"], u),
             sl_phase_psd(p["B->Pll::sl_phase_pseudo@LargeRecoil"], u),
             e_q(-1.0/3.0),
-            lepton_flavour(o.get("l", "mu")),
+            lepton_flavour(lepton_flavour_from_option(o.get("l", "mu"))),
             cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false")))
         {
             form_factors = FormFactorFactory<PToP>::create("B->K::" + o.get("form-factors", "KMPW2010"), p, o);
@@ -2315,9 +2365,10 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane using the LHC
 
             // Compute the QCDF Integrals
             double invm1_psd = 3.0 * (1.0 + a_1 + a_2); // <ubar^-1>
-            QCDFIntegrals::Results qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
-            QCDFIntegrals::Results qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
-            QCDFIntegrals::Results qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
+            const auto qcdf = QCDFIntegralsCache::instance()->dilepton(s, m_c_pole, m_b_PS, m_B(), m_K(), mu(), 0.0, 0.0, a_1(), a_2());
+            const QCDFIntegrals::Results & qcdf_0 = qcdf.massless;
+            const QCDFIntegrals::Results & qcdf_c = qcdf.charm;
+            const QCDFIntegrals::Results & qcdf_b = qcdf.bottom;
 
             // inverse of the "negative" moment of the B meson LCDA
             // cf. [BFS2001], Eq. (54), p. 15
@@ -2691,14 +2742,14 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane using the LHC
         double br_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
             br_electrons = BToKDilepton<LargeRecoil>::differential_branching_ratio(s);
         }
 
         double br_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
             br_muons = BToKDilepton<LargeRecoil>::differential_branching_ratio(s);
         }
 
@@ -2830,7 +2881,7 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane using the LHC
         double br_electrons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::electron);
             // br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
             br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
@@ -2838,7 +2889,7 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane using the LHC
         double br_muons;
         {
             Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
+            Save<LeptonFlavour> save_lepton_flavour(_imp->lepton_flavour, LeptonFlavour::muon);
             br_muons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
 
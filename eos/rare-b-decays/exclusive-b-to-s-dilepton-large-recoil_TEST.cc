@@ -22,6 +22,7 @@
 #include <test/test.hh>
 #include <eos/observable.hh>
 #include <eos/rare-b-decays/exclusive-b-to-s-dilepton-large-recoil.hh>
+#include <eos/rare-b-decays/qcdf_integrals.hh>
 #include <eos/utils/complex.hh>
 #include <eos/utils/wilson-polynomial.hh>
 
@@ -180,6 +181,125 @@ class BToKstarDileptonLargeRecoilBobethCompatibilityTest :
     }
 } b_to_kstar_dilepton_large_recoil_bobeth_compatibility_test;
 
+class BToKstarDileptonLargeRecoilCPPairTest :
+    public TestCase
+{
+    public:
+        BToKstarDileptonLargeRecoilCPPairTest() :
+            TestCase("b_to_kstar_dilepton_large_recoil_cp_pair_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // The CP-averaged observables and CP asymmetries integrate the angular coefficients of the decay
+            // and of its CP conjugate jointly. Compare them with integrations of either mode on its own.
+            // The adaptive integration refines both modes jointly, so the results agree only to within
+            // the accuracy of the integration.
+            Parameters p = Parameters::Defaults();
+            p["b->s::Re{c7}"] = 0.0;
+            p["b->s::Im{c7}"] = -0.331;
+            p["b->smumu::Re{c9}"] = 0.0;
+            p["b->smumu::Im{c9}"] = +4.27;
+            p["b->smumu::Re{c10}"] = 0.0;
+            p["b->smumu::Im{c10}"] = -4.17;
+
+            Options oo;
+            oo.set("model", "WilsonScan");
+            oo.set("form-factors", "KMPW2010");
+            oo.set("l", "mu");
+
+            BToKstarDilepton<LargeRecoil> d(p, oo);
+
+            oo.set("cp-conjugate", "false");
+            BToKstarDilepton<LargeRecoil> d_b(p, oo);
+
+            oo.set("cp-conjugate", "true");
+            BToKstarDilepton<LargeRecoil> d_bbar(p, oo);
+
+            static const double eps = 1e-4;
+
+            for (auto & q2 : std::vector<std::array<double, 2>>{ {{ 1.0, 6.0 }}, {{ 2.0, 4.3 }} })
+            {
+                const double s_min = q2[0], s_max = q2[1];
+
+                const double gamma     = d_b.integrated_decay_width(s_min, s_max);
+                const double gamma_bar = d_bbar.integrated_decay_width(s_min, s_max);
+
+                TEST_CHECK_RELATIVE_ERROR(d.integrated_branching_ratio_cp_averaged(s_min, s_max),
+                        0.5 * (d_b.integrated_branching_ratio(s_min, s_max) + d_bbar.integrated_branching_ratio(s_min, s_max)), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_cp_asymmetry(s_min, s_max),
+                        (gamma - gamma_bar) / (gamma + gamma_bar), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_forward_backward_asymmetry_cp_averaged(s_min, s_max),
+                        0.5 * (d_b.integrated_forward_backward_asymmetry(s_min, s_max) + d_bbar.integrated_forward_backward_asymmetry(s_min, s_max)), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_longitudinal_polarisation_cp_averaged(s_min, s_max),
+                        0.5 * (d_b.integrated_longitudinal_polarisation(s_min, s_max) + d_bbar.integrated_longitudinal_polarisation(s_min, s_max)), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_transverse_asymmetry_2_cp_averaged(s_min, s_max),
+                        0.5 * (d_b.integrated_transverse_asymmetry_2(s_min, s_max) + d_bbar.integrated_transverse_asymmetry_2(s_min, s_max)), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_j_3_normalized_cp_averaged(s_min, s_max),
+                        (d_b.integrated_j_3(s_min, s_max) + d_bbar.integrated_j_3(s_min, s_max)) / (gamma + gamma_bar), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_j_9_normalized_cp_averaged(s_min, s_max),
+                        (d_b.integrated_j_9(s_min, s_max) + d_bbar.integrated_j_9(s_min, s_max)) / (gamma + gamma_bar), eps);
+            }
+        }
+} b_to_kstar_dilepton_large_recoil_cp_pair_test;
+
+class BToKstarDileptonLargeRecoilQCDFIntegralsCacheTest :
+    public TestCase
+{
+    public:
+        BToKstarDileptonLargeRecoilQCDFIntegralsCacheTest() :
+            TestCase("b_to_kstar_dilepton_large_recoil_qcdf_integrals_cache_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            Parameters p = Parameters::Defaults();
+
+            Kinematics k
+            {
+                { "q2_min", 1.0 },
+                { "q2_max", 6.0 }
+            };
+
+            Options o
+            {
+                { "model",        "WilsonScan" },
+                { "l",            "mu"         },
+                { "form-factors", "KMPW2010"   }
+            };
+
+            // Each observable owns a separate instance of the decay
+            ObservablePtr br   = Observable::make("B->K^*ll::BR@LargeRecoil",   p, k, o);
+            ObservablePtr a_fb = Observable::make("B->K^*ll::A_FB@LargeRecoil", p, k, o);
+
+            QCDFIntegralsCache * cache = QCDFIntegralsCache::instance();
+            cache->clear();
+
+            const double br_value = br->evaluate();
+            const unsigned entries = cache->number_of_entries();
+            const unsigned long hits = cache->number_of_hits();
+            TEST_CHECK(entries > 0);
+
+            // The second observable finds all the integrals of the first one
+            a_fb->evaluate();
+            TEST_CHECK_EQUAL(entries, cache->number_of_entries());
+            TEST_CHECK(cache->number_of_hits() >= hits + entries);
+
+            // Cached results are identical to freshly computed ones
+            TEST_CHECK_EQUAL(br_value, br->evaluate());
+            cache->clear();
+            TEST_CHECK_EQUAL(br_value, br->evaluate());
+            TEST_CHECK_EQUAL(entries, cache->number_of_entries());
+
+            // A change of the hadronic inputs must not reuse the previous entries
+            p["B->K^*::a_1_perp"] = p["B->K^*::a_1_perp"]() + 0.01;
+            br->evaluate();
+            TEST_CHECK_EQUAL(2 * entries, cache->number_of_entries());
+        }
+} b_to_kstar_dilepton_large_recoil_qcdf_integrals_cache_test;
+
 class BToKDileptonLargeRecoilBobethCompatibilityTest :
     public TestCase
 {
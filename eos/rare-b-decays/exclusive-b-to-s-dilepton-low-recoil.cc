@@ -27,7 +27,7 @@
 #include <eos/rare-b-decays/hard-scattering.hh>
 #include <eos/rare-b-decays/long-distance.hh>
 #include <eos/utils/destringify.hh>
-#include <eos/utils/integrate.hh>
+#include <eos/utils/integrate-impl.hh>
 #include <eos/utils/kinematic.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/memoise.hh>
@@ -40,6 +40,7 @@
 
 #include <cmath>
 #include <functional>
+#include <tuple>
 
 namespace eos
 {
@@ -90,7 +91,7 @@ namespace eos
 
         std::shared_ptr<FormFactors<PToV>> form_factors;
 
-        std::string lepton_flavour;
+        LeptonFlavour lepton_flavour;
 
         bool cp_conjugate;
 
@@ -117,7 +118,7 @@ namespace eos
             sl_phase_par(p["B->Vll::sl_phase" + std::string(destringify<bool>(o.get("simple-sl")) ? "" : "_pa") + "@LowRecoil"], u),
             sl_phase_perp(p["B->Vll::sl_phase" + std::string(destringify<bool>(o.get("simple-sl")) ? "" : "_pp") + "@LowRecoil"], u),
             tau(p["life_time::B_" + o.get("q", "d")], u),
-            lepton_flavour(o.get("l", "mu")),
+            lepton_flavour(lepton_flavour_from_option(o.get("l", "mu"))),
             cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false"))),
             ccbar_resonance(destringify<bool>(o.get("ccbar-resonance", "false"))),
             use_nlo(destringify<bool>(o.get("nlo", "true")))
@@ -153,16 +154,21 @@ namespace eos
             return ShortDistanceLowRecoil::c7eff(s, mu(), model->alpha_s(mu), m_b_PS(), use_nlo, wc);
         }
 
-        // cf. [GP2004], Eq. (55), p. 10
-        complex<double> c9eff(const WilsonCoefficients<BToS> & wc, const double & s) const
+        complex<double> lambda_hat_u(const bool & conjugate) const
         {
-            complex<double> lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
-            if (cp_conjugate)
+            complex<double> result = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
+            if (conjugate)
             {
-                lambda_hat_u = conj(lambda_hat_u);
+                result = conj(result);
             }
 
-            return ShortDistanceLowRecoil::c9eff(s, mu(), model->alpha_s(mu), m_b_PS(), model->m_c_msbar(mu), use_nlo, ccbar_resonance, lambda_hat_u, wc);
+            return result;
+        }
+
+        // cf. [GP2004], Eq. (55), p. 10
+        complex<double> c9eff(const WilsonCoefficients<BToS> & wc, const double & s) const
+        {
+            return ShortDistanceLowRecoil::c9eff(s, mu(), model->alpha_s(mu), m_b_PS(), model->m_c_msbar(mu), use_nlo, ccbar_resonance, lambda_hat_u(cp_conjugate), wc);
         }
 
         double rho_1(const double & s) const
@@ -219,21 +225,51 @@ namespace eos
             return s / m_B / m_B;
         }
 
-        Amplitudes amplitudes(const double & s) const
+        /*
+         * All s-dependent intermediate results that neither depend on the Wilson coefficients nor
+         * on the CKM matrix elements. They are identical for the decay and its CP conjugate,
+         * and are computed only once when both are needed.
+         */
+        struct CPInvariants
+        {
+            ShortDistanceLowRecoil::LoopFunctions loops;
+            double alpha_s, m_c_MSbar, kappa, norm_s;
+            double ff_v, ff_a_0, ff_a_1, ff_a_2, ff_t_1, ff_t_2, ff_t_3;
+        };
+
+        CPInvariants cp_invariants(const double & s) const
+        {
+            CPInvariants result;
+
+            result.m_c_MSbar = model->m_c_msbar(mu);
+            result.loops = ShortDistanceLowRecoil::loop_functions(s, mu(), m_b_PS(), result.m_c_MSbar, ccbar_resonance);
+            result.alpha_s = model->alpha_s(mu());
+            result.kappa = kappa();
+            result.norm_s = norm(s);
+
+            result.ff_v   = form_factors->v(s);
+            result.ff_a_0 = form_factors->a_0(s);
+            result.ff_a_1 = form_factors->a_1(s);
+            result.ff_a_2 = form_factors->a_2(s);
+            result.ff_t_1 = form_factors->t_1(s);
+            result.ff_t_2 = form_factors->t_2(s);
+            result.ff_t_3 = form_factors->t_3(s);
+
+            return result;
+        }
+
+        Amplitudes amplitudes(const double & s, const WilsonCoefficients<BToS> & wc, const complex<double> & lambda_hat_u, const CPInvariants & inv) const
         {
             // compute J_i, [BHvD2010], p. 26, Eqs. (A1)-(A11)
-            // TODO: possibly optimize the calculation
             Amplitudes result;
 
-            WilsonCoefficients<BToS> wc = model->wilson_coefficients_b_to_s(mu(), lepton_flavour, cp_conjugate);
-
             const double m_B2 = m_B * m_B, m_Kstar2 = m_Kstar * m_Kstar, m2_diff = m_B2 - m_Kstar2;
             const double m_Kstarhat = m_Kstar / m_B;
             const double m_Kstarhat2 = std::pow(m_Kstarhat, 2);
             const double s_hat = s / m_B / m_B;
-            const double a_1 = form_factors->a_1(s), a_2 = form_factors->a_2(s);
-            const double alpha_s = model->alpha_s(mu());
-            const double norm_s = this->norm(s);
+            const double a_1 = inv.ff_a_1, a_2 = inv.ff_a_2;
+            const double alpha_s = inv.alpha_s;
+            const double norm_s = inv.norm_s;
             const double lam = lambda(m_B2, m_Kstar2, s);
             const double sqrt_lam = std::sqrt(lam);
             const double sqrt_s = std::sqrt(s);
@@ -242,14 +278,14 @@ namespace eos
             const complex<double> subleading_par  = 0.5 / m_B * alpha_s * std::polar(lambda_par(), sl_phase_par());
             const complex<double> subleading_long = 0.5 / m_B * alpha_s * std::polar(lambda_long(), sl_phase_long());
 
-            const complex<double> c_9eff = c9eff(wc, s);
-            const complex<double> c_7eff = c7eff(wc, s);
+            const complex<double> c_9eff = ShortDistanceLowRecoil::c9eff(s, inv.alpha_s, inv.m_c_MSbar, use_nlo, ccbar_resonance, lambda_hat_u, inv.loops, wc);
+            const complex<double> c_7eff = ShortDistanceLowRecoil::c7eff(inv.alpha_s, use_nlo, inv.loops, wc);
             const complex<double> c910_plus_left   = (c_9eff + wc.c9prime()) - (wc.c10() + wc.c10prime());
             const complex<double> c910_plus_right  = (c_9eff + wc.c9prime()) + (wc.c10() + wc.c10prime());
             const complex<double> c910_minus_left  = (c_9eff - wc.c9prime()) - (wc.c10() - wc.c10prime());
             const complex<double> c910_minus_right = (c_9eff - wc.c9prime()) + (wc.c10() - wc.c10prime());
-            const complex<double> c7_plus  = kappa() * (c_7eff + wc.c7prime()) * (2.0 * m_B / s);
-            const complex<double> c7_minus = kappa() * (c_7eff - wc.c7prime()) * (2.0 * m_B / s);
+            const complex<double> c7_plus  = inv.kappa * (c_7eff + wc.c7prime()) * (2.0 * m_B / s);
+            const complex<double> c7_minus = inv.kappa * (c_7eff - wc.c7prime()) * (2.0 * m_B / s);
 
             // longitudinal
             complex<double> prefactor_long = complex<double>(-1.0, 0.0) * m_B()
@@ -270,7 +306,7 @@ namespace eos
             complex<double> wilson_perp_right = c910_plus_right + c7_plus * (m_b_MSbar() + m_s() + lambda_perp()) - subleading_perp;
             complex<double> wilson_perp_left  = c910_plus_left  + c7_plus * (m_b_MSbar() + m_s() + lambda_perp()) - subleading_perp;
 
-            double formfactor_perp = std::sqrt(2.0 * lambda(1.0, m_Kstarhat2, s_hat)) / (1.0 + m_Kstarhat) * form_factors->v(s);
+            double formfactor_perp = std::sqrt(2.0 * lambda(1.0, m_Kstarhat2, s_hat)) / (1.0 + m_Kstarhat) * inv.ff_v;
             // cf. [BHvD2010], Eq. (3.13), p. 10
             result.a_perp_right = norm_s * prefactor_perp * wilson_perp_right * formfactor_perp;
             result.a_perp_left  = norm_s * prefactor_perp * wilson_perp_left  * formfactor_perp;
@@ -287,16 +323,16 @@ namespace eos
             // timelike
             result.a_timelike = norm_s * sqrt_lam / sqrt_s
                 * (2.0 * (wc.c10() - wc.c10prime()) + s / m_l / (m_b_MSbar + m_s()) * (wc.cP() - wc.cPprime()))
-                * form_factors->a_0(s);
+                * inv.ff_a_0;
 
             // scalar amplitude
-            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s()) * form_factors->a_0(s);
+            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s()) * inv.ff_a_0;
 
             // tensor amplitudes [BHvD2012]  eqs. (B18 - B20)
             // no form factor relations used
-            const double ff_T1  = form_factors->t_1(s);
-            const double ff_T2  = form_factors->t_2(s);
-            const double ff_T3  = form_factors->t_3(s);
+            const double ff_T1  = inv.ff_t_1;
+            const double ff_T2  = inv.ff_t_2;
+            const double ff_T3  = inv.ff_t_3;
 
             const double kin_tensor_1 = norm_s / m_Kstar * ((m_B2 + 3.0 * m_Kstar2 - s) * ff_T2 - lam / m2_diff * ff_T3);
             const double kin_tensor_2 = 2.0 * norm_s * sqrt_lam / sqrt_s * ff_T1;
@@ -318,9 +354,9 @@ namespace eos
             return result;
         }
 
-        std::array<double, 12> differential_angular_coefficients_array(const double & s) const
+        Amplitudes amplitudes(const double & s) const
         {
-            return angular_coefficients_array(amplitudes(s), s, m_l());
+            return amplitudes(s, model->wilson_coefficients_b_to_s(mu(), lepton_flavour, cp_conjugate), lambda_hat_u(cp_conjugate), cp_invariants(s));
         }
 
         AngularCoefficients differential_angular_coefficients(const double & s) const
@@ -330,13 +366,53 @@ namespace eos
 
         AngularCoefficients integrated_angular_coefficients(const double & s_min, const double & s_max) const
         {
-            std::function<std::array<double, 12> (const double &)> integrand =
-                    std::bind(&Implementation<BToKstarDilepton<LowRecoil>>::differential_angular_coefficients_array, this, std::placeholders::_1);
+            // the Wilson coefficients do not depend on s
+            const WilsonCoefficients<BToS> wc = model->wilson_coefficients_b_to_s(mu(), lepton_flavour, cp_conjugate);
+            const complex<double> lambda_hat_u = this->lambda_hat_u(cp_conjugate);
+
+            std::function<std::array<double, 12> (const double &)> integrand = [&] (const double & s) -> std::array<double, 12>
+            {
+                return angular_coefficients_array(amplitudes(s, wc, lambda_hat_u, cp_invariants(s)), s, m_l());
+            };
             std::array<double, 12> integrated_angular_coefficients_array = integrate1D(integrand, 64, s_min, s_max);
 
             return array_to_angular_coefficients(integrated_angular_coefficients_array);
         }
 
+        // The angular coefficients of the decay and of its CP conjugate, irrespective of the option 'cp-conjugate'.
+        std::array<double, 24> differential_angular_coefficients_cp_pair_array(const double & s,
+                const WilsonCoefficients<BToS> & wc, const WilsonCoefficients<BToS> & wc_bar,
+                const complex<double> & lambda_hat_u, const complex<double> & lambda_hat_u_bar) const
+        {
+            // evaluate the CP-invariant intermediate results only once
+            const CPInvariants inv = cp_invariants(s);
+
+            return angular_coefficients_cp_pair_array(amplitudes(s, wc, lambda_hat_u, inv), amplitudes(s, wc_bar, lambda_hat_u_bar, inv), s, m_l());
+        }
+
+        std::pair<AngularCoefficients, AngularCoefficients> differential_angular_coefficients_cp_pair(const double & s) const
+        {
+            return array_to_angular_coefficients_cp_pair(differential_angular_coefficients_cp_pair_array(s,
+                        model->wilson_coefficients_b_to_s(mu(), lepton_flavour, false), model->wilson_coefficients_b_to_s(mu(), lepton_flavour, true),
+                        lambda_hat_u(false), lambda_hat_u(true)));
+        }
+
+        // Integrate the angular coefficients of the decay and of its CP conjugate in a single pass over s.
+        std::pair<AngularCoefficients, AngularCoefficients> integrated_angular_coefficients_cp_pair(const double & s_min, const double & s_max) const
+        {
+            const WilsonCoefficients<BToS>
+                wc     = model->wilson_coefficients_b_to_s(mu(), lepton_flavour, false),
+                wc_bar = model->wilson_coefficients_b_to_s(mu(), lepton_flavour, true);
+            const complex<double> lambda_hat_u = this->lambda_hat_u(false), lambda_hat_u_bar = this->lambda_hat_u(true);
+
+            std::function<std::array<double, 24> (const double &)> integrand = [&] (const double & s) -> std::array<double, 24>
+            {
+                return differential_angular_coefficients_cp_pair_array(s, wc, wc_bar, lambda_hat_u, lambda_hat_u_bar);
+            };
+
+            return array_to_angular_coefficients_cp_pair(integrate1D(integrand, 64, s_min, s_max));
+        }
+
         // Quantity Y = Y_9 + lambda_u_hat Y_9^u + kappa_hat Y_7, the strong phase contributor of the amplitudes
         complex<double> Y(const double & s) const
         {
@@ -572,11 +648,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::differential_p_prime_4(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         // cf. [DMRV2012], p. 9, eq. (15)
         return (a_c.j4 + a_c_bar.j4) / std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s));
@@ -585,11 +658,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::differential_p_prime_5(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         // cf. [DMRV2012], p. 9, eq. (16)
         return (a_c.j5 + a_c_bar.j5) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -598,11 +668,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::differential_p_prime_6(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         // cf. [DMRV2012], p. 9, eq. (17)
         return -1.0 * (a_c.j7 + a_c_bar.j7) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -765,11 +832,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::differential_j_3_normalized_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return (a_c.j3 + a_c_bar.j3) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -805,11 +869,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::differential_j_6c_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return 0.5 * (a_c.j6c + a_c_bar.j6c);
     }
@@ -845,11 +906,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::differential_j_9_normalized_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return (a_c.j9 + a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -857,11 +915,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::differential_j_1c_plus_j_2c_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return 0.5 * (a_c.j1c + a_c_bar.j1c + a_c.j2c + a_c_bar.j2c);
     }
@@ -869,11 +924,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::differential_j_1s_minus_3j_2s_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->differential_angular_coefficients_cp_pair(s);
 
         return 0.5 * (a_c.j1s + a_c_bar.j1s - 3.0 * (a_c.j2s + a_c_bar.j2s));
     }
@@ -894,11 +946,11 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_branching_ratio_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double br = integrated_branching_ratio(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double br_bar = integrated_branching_ratio(s_min, s_max);
+        double br = decay_width(a_c) * _imp->tau() / _imp->hbar();
+        double br_bar = decay_width(a_c_bar) * _imp->tau() / _imp->hbar();
 
         return 0.5 * (br + br_bar);
     }
@@ -923,11 +975,11 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_forward_backward_asymmetry_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double a_fb = integrated_forward_backward_asymmetry(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double a_fb_bar = integrated_forward_backward_asymmetry(s_min, s_max);
+        double a_fb = (a_c.j6s + 0.5 * a_c.j6c) / decay_width(a_c);
+        double a_fb_bar = (a_c_bar.j6s + 0.5 * a_c_bar.j6c) / decay_width(a_c_bar);
 
         return 0.5 * (a_fb + a_fb_bar);
     }
@@ -958,11 +1010,11 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_longitudinal_polarisation_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double f_l = integrated_longitudinal_polarisation(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double f_l_bar = integrated_longitudinal_polarisation(s_min, s_max);
+        double f_l = (a_c.j1c - a_c.j2c / 3.0) / decay_width(a_c);
+        double f_l_bar = (a_c_bar.j1c - a_c_bar.j2c / 3.0) / decay_width(a_c_bar);
 
         return 0.5 * (f_l + f_l_bar);
     }
@@ -987,11 +1039,11 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_transversal_polarisation_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double f_t = integrated_transversal_polarisation(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double f_t_bar = integrated_transversal_polarisation(s_min, s_max);
+        double f_t = 2.0 * (a_c.j1s - a_c.j2s / 3.0) / decay_width(a_c);
+        double f_t_bar = 2.0 * (a_c_bar.j1s - a_c_bar.j2s / 3.0) / decay_width(a_c_bar);
 
         return 0.5 * (f_t + f_t_bar);
     }
@@ -1008,11 +1060,11 @@ namespace eos
     BToKstarDilepton<LowRecoil>::integrated_transverse_asymmetry_2_cp_averaged(const double & s_min, const double & s_max) const
     {
         // cf. [BHvD2010], eq. (2.10), p. 6
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double a_t_2 = integrated_transverse_asymmetry_2(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double a_t_2_bar = integrated_transverse_asymmetry_2(s_min, s_max);
+        double a_t_2 = 0.5 * a_c.j3 / a_c.j2s;
+        double a_t_2_bar = 0.5 * a_c_bar.j3 / a_c_bar.j2s;
 
         return 0.5 * (a_t_2 + a_t_2_bar);
     }
@@ -1087,11 +1139,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_p_prime_4(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         // cf. [DMRV2012], p. 9, eq. (15)
         return (a_c.j4 + a_c_bar.j4) / std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s));
@@ -1100,11 +1149,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_p_prime_5(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         // cf. [DMRV2012], p. 9, eq. (16)
         return (a_c.j5 + a_c_bar.j5) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1113,11 +1159,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_p_prime_6(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         // cf. [DMRV2012], p. 9, eq. (17)
         return -1.0 * (a_c.j7 + a_c_bar.j7) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1188,11 +1231,11 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_cp_asymmetry(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double gamma = integrated_decay_width(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double gamma_bar = integrated_decay_width(s_min, s_max);
+        double gamma = decay_width(a_c);
+        double gamma_bar = decay_width(a_c_bar);
 
         // cf. [BHvD2011], p. 6/7, remarks below eq. (2.15), and eq. (2.36), p.11
         return (gamma - gamma_bar) / (gamma + gamma_bar);
@@ -1204,11 +1247,11 @@ namespace eos
         Log::instance()->message("BToKstarDilepton<LowRecoil>::integrated_cp_asymmetry_1", ll_error)
             << "This observable seems to be wrongly implemented. Please check before using it!";
 
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double gamma = integrated_decay_width(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double gamma_bar = integrated_decay_width(s_min, s_max);
+        double gamma = decay_width(a_c);
+        double gamma_bar = decay_width(a_c_bar);
 
         // cf. [BHvD2011], p. 6/7, remarks below eq. (2.15), and eq. (2.36), p.11
         return (gamma - gamma_bar) / (gamma + gamma_bar);
@@ -1217,11 +1260,11 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_cp_asymmetry_2(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double a_fb = integrated_forward_backward_asymmetry(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double a_fb_bar = integrated_forward_backward_asymmetry(s_min, s_max);
+        double a_fb = (a_c.j6s + 0.5 * a_c.j6c) / decay_width(a_c);
+        double a_fb_bar = (a_c_bar.j6s + 0.5 * a_c_bar.j6c) / decay_width(a_c_bar);
 
         // cf. [BHvD2011], p. 6/7, remarks below eq. (2.15), and eq. (2.38), p. 11
         // Note that in the code A_FB does not flip its sign under CP. Therefore a_fb_bar -> -a_fb_bar here.
@@ -1231,11 +1274,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_cp_asymmetry_3(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         // cf. [BHvD2011], eq. (2.40, p. 12
         return (a_c.j6s - a_c_bar.j6s)
@@ -1246,11 +1286,11 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_cp_summed_decay_width(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double gamma = integrated_decay_width(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double gamma_bar = integrated_decay_width(s_min, s_max);
+        double gamma = decay_width(a_c);
+        double gamma_bar = decay_width(a_c_bar);
 
         return (gamma + gamma_bar);
     }
@@ -1258,11 +1298,11 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_unnormalized_cp_asymmetry_1(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
-        double gamma = integrated_decay_width(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double gamma_bar = integrated_decay_width(s_min, s_max);
+        double gamma = decay_width(a_c);
+        double gamma_bar = decay_width(a_c_bar);
 
         return (gamma - gamma_bar);
     }
@@ -1313,11 +1353,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_j_3_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j3 + a_c_bar.j3) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1332,11 +1369,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_j_4_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j4 + a_c_bar.j4) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1351,11 +1385,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_j_5_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j5 + a_c_bar.j5) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1384,11 +1415,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_j_7_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j7 + a_c_bar.j7) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1403,11 +1431,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_j_8_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j8 + a_c_bar.j8) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1429,11 +1454,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_j_9_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j9 + a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1441,11 +1463,8 @@ namespace eos
     double
     BToKstarDilepton<LowRecoil>::integrated_a_9(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        AngularCoefficients a_c, a_c_bar;
+        std::tie(a_c, a_c_bar) = _imp->integrated_angular_coefficients_cp_pair(s_min, s_max);
 
         return (a_c.j9 - a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1554,7 +1573,7 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane using the LHC
         // Mean life time
         UsedParameter tau;
 
-        std::string lepton_flavour;
+        LeptonFlavour lepton_flavour;
 
         bool cp_conjugate;
 
@@ -1577,7 +1596,7 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane using the LHC
             lambda_pseudo(p["B->Pll::Lambda_pseudo@LowRecoil"], u),
             sl_phase_pseudo(p["B->Pll::sl_phase_pseudo@LowRecoil"], u),
             tau(p["life_time::B_" + o.get("q", "d")], u),
-            lepton_flavour(o.get("l", "mu")),
+            lepton_flavour(lepton_flavour_from_option(o.get("l", "mu"))),
             cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false"))),
             ccbar_resonance(destringify<bool>(o.get("ccbar-resonance", "false")))
         {
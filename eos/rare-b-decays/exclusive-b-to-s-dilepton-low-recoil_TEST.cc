@@ -270,6 +270,70 @@ class BToKstarDileptonLowRecoilTest :
         }
 } b_to_kstar_dilepton_low_recoil_test;
 
+class BToKstarDileptonLowRecoilCPPairTest :
+    public TestCase
+{
+    public:
+        BToKstarDileptonLowRecoilCPPairTest() :
+            TestCase("b_to_kstar_dilepton_low_recoil_cp_pair_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // The CP-averaged observables and CP asymmetries integrate the angular coefficients of the decay
+            // and of its CP conjugate jointly. Compare them with integrations of either mode on its own.
+            // The adaptive integration refines both modes jointly, so the results agree only to within
+            // the accuracy of the integration.
+            Parameters p = Parameters::Defaults();
+            p["b->s::Re{c7}"] = 0.0;
+            p["b->s::Im{c7}"] = -0.331;
+            p["b->smumu::Re{c9}"] = 0.0;
+            p["b->smumu::Im{c9}"] = +4.27;
+            p["b->smumu::Re{c10}"] = 0.0;
+            p["b->smumu::Im{c10}"] = -4.17;
+
+            Options oo;
+            oo.set("model", "WilsonScan");
+            oo.set("form-factors", "BZ2004");
+            oo.set("l", "mu");
+
+            BToKstarDilepton<LowRecoil> d(p, oo);
+
+            oo.set("cp-conjugate", "false");
+            BToKstarDilepton<LowRecoil> d_b(p, oo);
+
+            oo.set("cp-conjugate", "true");
+            BToKstarDilepton<LowRecoil> d_bbar(p, oo);
+
+            static const double eps = 1e-4;
+
+            for (auto & q2 : std::vector<std::array<double, 2>>{ {{ 14.18, 16.0 }}, {{ 16.0, 19.21 }} })
+            {
+                const double s_min = q2[0], s_max = q2[1];
+
+                const double gamma     = d_b.integrated_decay_width(s_min, s_max);
+                const double gamma_bar = d_bbar.integrated_decay_width(s_min, s_max);
+
+                TEST_CHECK_RELATIVE_ERROR(d.integrated_branching_ratio_cp_averaged(s_min, s_max),
+                        0.5 * (d_b.integrated_branching_ratio(s_min, s_max) + d_bbar.integrated_branching_ratio(s_min, s_max)), eps);
+                TEST_CHECK_RELATIVE_ERROR(d.integrated_cp_summed_decay_width(s_min, s_max), gamma + gamma_bar, eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_cp_asymmetry(s_min, s_max),
+                        (gamma - gamma_bar) / (gamma + gamma_bar), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_forward_backward_asymmetry_cp_averaged(s_min, s_max),
+                        0.5 * (d_b.integrated_forward_backward_asymmetry(s_min, s_max) + d_bbar.integrated_forward_backward_asymmetry(s_min, s_max)), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_longitudinal_polarisation_cp_averaged(s_min, s_max),
+                        0.5 * (d_b.integrated_longitudinal_polarisation(s_min, s_max) + d_bbar.integrated_longitudinal_polarisation(s_min, s_max)), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_transverse_asymmetry_2_cp_averaged(s_min, s_max),
+                        0.5 * (d_b.integrated_transverse_asymmetry_2(s_min, s_max) + d_bbar.integrated_transverse_asymmetry_2(s_min, s_max)), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_j_3_normalized_cp_averaged(s_min, s_max),
+                        (d_b.integrated_j_3(s_min, s_max) + d_bbar.integrated_j_3(s_min, s_max)) / (gamma + gamma_bar), eps);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_j_9_normalized_cp_averaged(s_min, s_max),
+                        (d_b.integrated_j_9(s_min, s_max) + d_bbar.integrated_j_9(s_min, s_max)) / (gamma + gamma_bar), eps);
+            }
+        }
+} b_to_kstar_dilepton_low_recoil_cp_pair_test;
+
 class BToKstarDileptonLowRecoilPolynomialTest :
     public TestCase
 {
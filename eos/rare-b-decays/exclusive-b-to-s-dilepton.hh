@@ -23,7 +23,9 @@
 
 #include <eos/utils/power_of.hh>
 
+#include <algorithm>
 #include <array>
+#include <utility>
 
 namespace eos
 {
@@ -62,6 +64,17 @@ namespace eos
             return a_c;
         }
 
+        // The angular coefficients of a decay (first twelve entries) and of its CP conjugate (last twelve entries).
+        inline std::pair<AngularCoefficients, AngularCoefficients> array_to_angular_coefficients_cp_pair(const std::array<double, 24> & arr)
+        {
+            AngularCoefficients a_c = { arr[0], arr[1], arr[2], arr[3], arr[4],  arr[5],
+                arr[6], arr[7], arr[8], arr[9], arr[10], arr[11] };
+            AngularCoefficients a_c_bar = { arr[12], arr[13], arr[14], arr[15], arr[16], arr[17],
+                arr[18], arr[19], arr[20], arr[21], arr[22], arr[23] };
+
+            return std::make_pair(a_c, a_c_bar);
+        }
+
         inline double decay_width(const AngularCoefficients & a_c)
         {
             // cf. [BHvD2010], p. 6, eq. (2.7)
@@ -168,6 +181,18 @@ namespace eos
 
             return result;
         }
+
+        // The angular coefficients of a decay and of its CP conjugate, as expected by array_to_angular_coefficients_cp_pair.
+        inline std::array<double, 24> angular_coefficients_cp_pair_array(const Amplitudes & A, const Amplitudes & A_bar, const double & s, const double & m_l)
+        {
+            const std::array<double, 12> a_c = angular_coefficients_array(A, s, m_l), a_c_bar = angular_coefficients_array(A_bar, s, m_l);
+
+            std::array<double, 24> result;
+            std::copy(a_c.cbegin(), a_c.cend(), result.begin());
+            std::copy(a_c_bar.cbegin(), a_c_bar.cend(), result.begin() + 12);
+
+            return result;
+        }
     }
 }
 
@@ -19,12 +19,20 @@
 
 #include <eos/rare-b-decays/qcdf_integrals.hh>
 #include <eos/utils/exception.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/polylog.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/stringify.hh>
 
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <functional>
 #include <limits>
+#include <unordered_map>
 
 #include <iostream>
 
@@ -336,14 +344,23 @@ namespace eos
                 atanrho(std::atan(radixrho)), atan4mh2(std::atan(radix4mh2)), atanh4mh2rho(std::atanh(radix4mh2 / radixrho)),
                 aminus(0.5 * complex<double>(1.0, -radixrho)), aplus(1.0 - aminus),
                 bminus(0.5 * complex<double>(1.0, -radix4mh2)), bplus(1.0 - bminus),
-                lnam(std::log(aminus)), lnbm(std::log(bminus)), lnradices(std::log(radixrho - radix4mh2)),
-                dilogam2(dilog(power_of<2>(aminus / aplus))),
-                dilogapbm(dilog((aplus * bminus) / (aminus * bplus))),
-                dilogambm(dilog((aminus * bminus) / (aplus * bplus))),
-                trilogam2(trilog(power_of<2>(aminus / aplus))),
-                trilogapbm(trilog((aplus * bminus) / (aminus * bplus))),
-                trilogambm(trilog((aminus * bminus) / (aplus * bplus)))
+                lnam(std::log(aminus)), lnbm(std::log(bminus)), lnradices(std::log(radixrho - radix4mh2))
             {
+                // evaluate all polylogarithms in one batch
+                const std::array<complex<double>, 3> x
+                {{
+                    power_of<2>(aminus / aplus),
+                    (aplus * bminus) / (aminus * bplus),
+                    (aminus * bminus) / (aplus * bplus)
+                }};
+                const std::array<complex<double>, 3> dilogx = dilog(x), trilogx = trilog(x);
+
+                dilogam2   = dilogx[0];
+                dilogapbm  = dilogx[1];
+                dilogambm  = dilogx[2];
+                trilogam2  = trilogx[0];
+                trilogapbm = trilogx[1];
+                trilogambm = trilogx[2];
             }
 
             complex<double> j1(const double & a1, const double & a2) const;
@@ -1157,14 +1174,33 @@ namespace eos
                 lnsigma(std::log(mh2 * rho / (rho - 4.0 * mh2))),
                 aminus(0.5 * complex<double>(1.0, -radixrho)), aplus(1.0 - aminus), lnam(std::log(aminus)),
                 bminus(0.5 * (1.0 + radix4mh2)), bplus(1.0 - bminus), lnbm(std::log(bminus)),
-                lntau(std::log(bminus / mh)),
-                dilogx4(dilog(power_of<2>(aminus / aplus))), dilogx5(dilog(-1.0 * bminus / bplus)),
-                diloginvx7(dilog(aminus / bplus)), diloginvx9(dilog(aplus / bplus)),
-                dilogx13(dilog((aplus * bminus) / (aminus * bplus))),
-                redilogx12(real(dilog((aminus * bminus) / (aplus * bplus)))), redilog2ap(real(dilog(2.0 * aplus))),
-                trilogx4(trilog(power_of<2>(aminus / aplus))), trilogx5(trilog(-1.0 * bminus / bplus)),
-                retrilogx12(real(trilog((aminus * bminus) / (aplus * bplus))))
+                lntau(std::log(bminus / mh))
             {
+                // evaluate all polylogarithms in one batch; the trilogarithms are needed for the first three arguments only
+                const std::array<complex<double>, 7> x
+                {{
+                    power_of<2>(aminus / aplus),
+                    -1.0 * bminus / bplus,
+                    (aminus * bminus) / (aplus * bplus),
+                    aminus / bplus,
+                    aplus / bplus,
+                    (aplus * bminus) / (aminus * bplus),
+                    2.0 * aplus
+                }};
+                const std::array<complex<double>, 7> dilogx = dilog(x);
+                std::array<complex<double>, 3> trilogx;
+                trilog(x.data(), trilogx.data(), trilogx.size());
+
+                dilogx4     = dilogx[0];
+                dilogx5     = dilogx[1];
+                redilogx12  = real(dilogx[2]);
+                diloginvx7  = dilogx[3];
+                diloginvx9  = dilogx[4];
+                dilogx13    = dilogx[5];
+                redilog2ap  = real(dilogx[6]);
+                trilogx4    = trilogx[0];
+                trilogx5    = trilogx[1];
+                retrilogx12 = real(trilogx[2]);
             }
 
             complex<double> j1(const double & a1, const double & a2) const;
@@ -1735,13 +1771,12 @@ namespace eos
         // Massless case
 
         // cf. [vD2011], Eq. (xx), p. ?
-        inline complex<double> j2_massless(const double & sh, const double & a1, const double & a2)
+        inline complex<double> j2_massless(const double & sh, const complex<double> & dilogsh, const double & a1, const double & a2)
         {
             static const double pi2 = M_PI * M_PI;
 
             double lnsh = std::log(sh), ln1msh = std::log(1.0 - sh);
             double atanhsh = std::atanh(1.0 - 2.0 * sh);
-            complex<double> dilogsh = dilog(sh);
 
             // asymptotic part
             complex<double> asymp = ((6 + pi2) * (1.0 - sh) + 3.0 * lnsh * (2.0 - 2.0 * (1.0 - sh) * ln1msh + (1 - sh) * lnsh) - 6.0 * (1.0 - sh) * dilogsh)
@@ -1763,13 +1798,12 @@ namespace eos
         }
 
         // cf. [vD2011], Eq. (xx), p. ?
-        inline complex<double> j3_massless(const double & sh, const double & a1, const double & a2)
+        inline complex<double> j3_massless(const double & sh, const complex<double> & dilogsh, const double & a1, const double & a2)
         {
             static const double pi = M_PI, pi2 = pi * pi;
 
             double sh2 = sh * sh;
             double lnsh = std::log(sh), ln1msh = std::log(1.0 - sh);
-            complex<double> dilogsh = dilog(sh);
 
             // asymptotic part
             complex<double> asymp = ((1.0 - sh) * (-9.0 + (15.0 + 2.0 * pi2) * sh)
@@ -2095,11 +2129,14 @@ namespace eos
         double sh = s / m_B / m_B;
         double eh = (1.0 + power_of<2>(m_V / m_B) - sh) / 2.0;
 
+        // the only polylogarithm that arises in the massless case is shared between j2 and j3
+        const complex<double> dilogsh = dilog(sh);
+
         // perpendicular amplitude
         results.j0_perp = impl::j0(sh, a_1_perp, a_2_perp);
         results.j0bar_perp = impl::j0(sh, -a_1_perp, a_2_perp);
         results.j1_perp = impl::moment_inverse_ubar(a_1_perp, a_2_perp);
-        results.j2_perp = impl::j2_massless(sh, a_1_perp, a_2_perp);
+        results.j2_perp = impl::j2_massless(sh, dilogsh, a_1_perp, a_2_perp);
         results.j4_perp = impl::j4_massless(sh, m_B, mu, a_1_perp, a_2_perp);
         results.j5_perp = impl::j5_massless(sh, m_B, mu, a_1_perp, a_2_perp);
         // This integral arises in perpendicular amplitudes, but depends on parallel Gegenbauer moments!
@@ -2109,7 +2146,7 @@ namespace eos
         // parallel amplitude
         results.j0_parallel = impl::j0(sh, a_1_parallel, a_2_parallel);
         results.j1_parallel = impl::moment_inverse_ubar(a_1_parallel, a_2_parallel);
-        results.j3_parallel = impl::j3_massless(sh, a_1_parallel, a_2_parallel);
+        results.j3_parallel = impl::j3_massless(sh, dilogsh, a_1_parallel, a_2_parallel);
         results.j4_parallel = impl::j4_massless(sh, m_B, mu, a_1_parallel, a_2_parallel);
 
         // composite results
@@ -2118,4 +2155,140 @@ namespace eos
 
         return results;
     }
+
+    template <>
+    struct Implementation<QCDFIntegralsCache>
+    {
+        // s followed by the hadronic inputs m_c, m_b, m_B, m_V, mu and the four Gegenbauer moments
+        typedef std::array<double, 10> Key;
+
+        struct KeyHash
+        {
+            std::size_t operator() (const Key & key) const
+            {
+                std::size_t result = 0;
+                for (const auto & k : key)
+                {
+                    result ^= std::hash<double>()(k) + 0x9e3779b97f4a7c15ul + (result << 6) + (result >> 2);
+                }
+
+                return result;
+            }
+        };
+
+        struct Shard
+        {
+            Mutex mutex;
+
+            std::unordered_map<Key, QCDFIntegralsCache::Entry, KeyHash> entries;
+        };
+
+        // Lookups in different shards do not contend for the same lock.
+        static constexpr unsigned number_of_shards = 16;
+
+        // Bounds the memory footprint of each shard; a full shard is cleared entirely.
+        static constexpr unsigned max_entries_per_shard = 2048;
+
+        std::array<Shard, number_of_shards> shards;
+
+        std::atomic<unsigned long> hits;
+
+        Implementation() :
+            hits(0)
+        {
+        }
+
+        QCDFIntegralsCache::Entry lookup(const Key & key)
+        {
+            const std::size_t hash = KeyHash()(key);
+            Shard & shard = shards[hash % number_of_shards];
+
+            {
+                Lock l(shard.mutex);
+
+                auto i = shard.entries.find(key);
+                if (shard.entries.end() != i)
+                {
+                    ++hits;
+                    return i->second;
+                }
+            }
+
+            // Compute outside of the lock. Concurrent misses on the same key compute identical entries.
+            const double & s = key[0], & m_c = key[1], & m_b = key[2], & m_B = key[3], & m_V = key[4], & mu = key[5];
+            const double & a_1_perp = key[6], & a_2_perp = key[7], & a_1_par = key[8], & a_2_par = key[9];
+            QCDFIntegralsCache::Entry entry
+            {
+                QCDFIntegrals::dilepton_massless_case(s, m_B, m_V, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
+                QCDFIntegrals::dilepton_charm_case(s, m_c, m_B, m_V, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
+                QCDFIntegrals::dilepton_bottom_case(s, m_b, m_B, m_V, mu, a_1_perp, a_2_perp, a_1_par, a_2_par)
+            };
+
+            {
+                Lock l(shard.mutex);
+
+                if (shard.entries.size() >= max_entries_per_shard)
+                    shard.entries.clear();
+
+                shard.entries.emplace(key, entry);
+            }
+
+            return entry;
+        }
+    };
+
+    QCDFIntegralsCache::QCDFIntegralsCache() :
+        InstantiationPolicy<QCDFIntegralsCache, Singleton>(),
+        PrivateImplementationPattern<QCDFIntegralsCache>(new Implementation<QCDFIntegralsCache>)
+    {
+    }
+
+    QCDFIntegralsCache::~QCDFIntegralsCache()
+    {
+    }
+
+    QCDFIntegralsCache *
+    QCDFIntegralsCache::instance()
+    {
+        return InstantiationPolicy<QCDFIntegralsCache, Singleton>::instance();
+    }
+
+    QCDFIntegralsCache::Entry
+    QCDFIntegralsCache::dilepton(const double & s, const double & m_c, const double & m_b, const double & m_B, const double & m_V, const double & mu,
+            const double & a_1_perp, const double & a_2_perp,
+            const double & a_1_parallel, const double & a_2_parallel)
+    {
+        return _imp->lookup(Implementation<QCDFIntegralsCache>::Key{ { s, m_c, m_b, m_B, m_V, mu, a_1_perp, a_2_perp, a_1_parallel, a_2_parallel } });
+    }
+
+    void
+    QCDFIntegralsCache::clear()
+    {
+        for (auto & shard : _imp->shards)
+        {
+            Lock l(shard.mutex);
+
+            shard.entries.clear();
+        }
+    }
+
+    unsigned
+    QCDFIntegralsCache::number_of_entries() const
+    {
+        unsigned result = 0;
+        for (auto & shard : _imp->shards)
+        {
+            Lock l(shard.mutex);
+
+            result += shard.entries.size();
+        }
+
+        return result;
+    }
+
+    unsigned long
+    QCDFIntegralsCache::number_of_hits() const
+    {
+        return _imp->hits;
+    }
 }
@@ -21,6 +21,8 @@
 #define EOS_GUARD_EOS_RARE_B_DECAYS_QCDF_INTEGRALS_HH 1
 
 #include <eos/utils/complex.hh>
+#include <eos/utils/instantiation_policy.hh>
+#include <eos/utils/private_implementation_pattern.hh>
 
 namespace eos
 {
@@ -146,6 +148,59 @@ namespace eos
         complex<double> jtilde1_perp;
         complex<double> jtilde2_parallel;
     };
+
+    /*!
+     * Process-wide cache of the QCDF integrals of B -> V l^+ l^- for all three quark loops.
+     *
+     * Entries are keyed on the decay's hadronic inputs and on s. They are thus shared
+     * across all observables and decays that use the same inputs. Changing any of the
+     * parameters yields a new key, so that stale entries are never returned.
+     *
+     * The cache is split into shards that are locked individually, and may be used concurrently.
+     */
+    class QCDFIntegralsCache :
+        public InstantiationPolicy<QCDFIntegralsCache, Singleton>,
+        public PrivateImplementationPattern<QCDFIntegralsCache>
+    {
+        public:
+            struct Entry
+            {
+                QCDFIntegrals::Results massless, charm, bottom;
+            };
+
+            QCDFIntegralsCache();
+
+            ~QCDFIntegralsCache();
+
+            static QCDFIntegralsCache * instance();
+
+            /*!
+             * Return the QCDF integrals for massless, c and b quark loops, computing them only if absent.
+             *
+             * @param s            Invariant dilepton mass square.
+             * @param m_c          Pole mass of the c quark.
+             * @param m_b          Pole mass of the b quark.
+             * @param m_B          Mass of the parent B meson.
+             * @param m_V          Mass of the daughter meson.
+             * @param mu           Renormalization scale.
+             * @param a_1_perp     First Gegenbauer moment for the perpendicular amplitude.
+             * @param a_2_perp     Second Gegenbauer moment for the perpendicular amplitude.
+             * @param a_1_parallel First Gegenbauer moment for the parallel amplitude.
+             * @param a_2_parallel Second Gegenbauer moment for the parallel amplitude.
+             */
+            Entry dilepton(const double & s, const double & m_c, const double & m_b, const double & m_B, const double & m_V, const double & mu,
+                    const double & a_1_perp, const double & a_2_perp,
+                    const double & a_1_parallel, const double & a_2_parallel);
+
+            /// Remove all entries.
+            void clear();
+
+            /// Return the number of entries across all shards.
+            unsigned number_of_entries() const;
+
+            /// Return the number of lookups that were served from the cache.
+            unsigned long number_of_hits() const;
+    };
 }
 
 #endif
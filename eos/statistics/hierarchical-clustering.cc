@@ -22,12 +22,16 @@
 #include <eos/utils/log.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
 #include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
+#include <numeric>
 
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
@@ -88,17 +92,59 @@ namespace eos
             divergences.resize(active_components * input_components.size());
         }
 
-        void compute_KL()
+        /*
+         * Call work(i, scratch) for all i in [0, size), in blocks of consecutive indices. Each block
+         * provides a scratch vector of the components' dimension to work. If so configured,
+         * the blocks are processed in parallel on the ThreadPool. Exceptions thrown by work propagate
+         * to the caller.
+         */
+        void for_each(const unsigned & size, const std::function<void (const unsigned &, gsl_vector *)> & work) const
         {
-            for (unsigned i = 0 ; i < input_components.size() ; ++i)
+            if (0 == size)
+                return;
+
+            const unsigned dim = input_components.front().mean()->size;
+            const unsigned blocks = config.parallelize ? std::min(size, 4 * ThreadPool::instance()->number_of_threads()) : 1;
+
+            auto block = [&] (const unsigned & b)
             {
-                for (unsigned j = 0 ; j < output_components.size() ; ++j)
+                std::vector<double> buffer(dim);
+                gsl_vector_view scratch = gsl_vector_view_array(buffer.data(), dim);
+
+                for (unsigned i = b * size / blocks, i_end = (b + 1) * size / blocks ; i < i_end ; ++i)
                 {
-                    divergences[i * output_components.size() + j] = kullback_leibler_divergence(input_components[i], output_components[j]);
+                    work(i, &scratch.vector);
                 }
+            };
+
+            if (blocks > 1)
+            {
+                ThreadPool::instance()->parallel_for(blocks, block);
+            }
+            else
+            {
+                block(0);
             }
         }
 
+        // compute the divergences and assign each input component to the closest output component, Eq. (4)
+        void compute_KL()
+        {
+            const unsigned n_output = output_components.size();
+
+            for_each(input_components.size(), [&] (const unsigned & i, gsl_vector * scratch)
+            {
+                auto divergence = divergences.begin() + i * n_output;
+                for (unsigned j = 0 ; j < n_output ; ++j, ++divergence)
+                {
+                    *divergence = kullback_leibler_divergence(input_components[i], output_components[j], scratch);
+                }
+
+                auto first = divergences.cbegin() + i * n_output;
+                mapping[i] = std::distance(first, std::min_element(first, first + n_output));
+            });
+        }
+
         /*
          * Compute the distance function d(f,g,\pi), Eq. (3)
          */
@@ -122,48 +168,49 @@ namespace eos
          *  KL(c1 || c2) mind the ordering!
          *  Use same notation as in Goldberger, Roweis, ch. 2.
          *
+         *  Only the cached decomposition of c2 is used, and no memory is allocated.
+         *
+         *  @param scratch A vector of the components' dimension, which is overwritten.
+         *
          *  @note: KL(1 || 2) >= 0, and KL(1 || 1) = 0
          */
-        static double kullback_leibler_divergence(const HierarchicalClustering::Component & c1, const HierarchicalClustering::Component & c2)
+        static double kullback_leibler_divergence(const HierarchicalClustering::Component & c1, const HierarchicalClustering::Component & c2,
+                gsl_vector * scratch)
         {
             // first contribution: ratio of determinants
-            double d = std::log(c2.determinant() / c1.determinant());
+            double d = c2.log_determinant() - c1.log_determinant();
             const unsigned dim = c1.mean()->size;
-            gsl_matrix * matrix_res = gsl_matrix_alloc(dim, dim);
 
             if (! std::isfinite(d))
             {
-                throw InternalError("HieriarchicalClustering::kullback_leibler_divergence: first contribution not finite! det(c1) = " + stringify(c1.determinant()) + ", det(c2) = " + stringify(c2.determinant()));
+                throw InternalError("HieriarchicalClustering::kullback_leibler_divergence: first contribution not finite! log(det(c1)) = " + stringify(c1.log_determinant()) + ", log(det(c2)) = " + stringify(c2.log_determinant()));
             }
 
-            // second contribution: trace of product
-            gsl_blas_dsymm(CblasLeft, CblasUpper, 1.0, c2.inverse_covariance(), c1.covariance(), 0.0, matrix_res);
+            // second contribution: trace of product, which for symmetric matrices is the sum of the element-wise products
+            const gsl_matrix * inverse_covariance = c2.inverse_covariance();
+            const gsl_matrix * covariance = c1.covariance();
             for (unsigned i = 0 ; i < dim ; ++i)
             {
-                d += gsl_matrix_get(matrix_res, i, i);
+                const double * a = inverse_covariance->data + i * inverse_covariance->tda;
+                const double * b = covariance->data + i * covariance->tda;
+                for (unsigned j = 0 ; j < dim ; ++j)
+                {
+                    d += a[j] * b[j];
+                }
             }
-            gsl_matrix_free(matrix_res);
 
             if (! std::isfinite(d))
             {
                 throw InternalError("HieriarchicalClustering::kullback_leibler_divergence: second contribution not finite!");
             }
 
-            // third contribution: \chi^2
-            gsl_vector * vector_res_left = gsl_vector_alloc(dim);
-            gsl_vector * vector_res_right = gsl_vector_alloc(dim);
-            gsl_vector_memcpy(vector_res_left, c1.mean());
-            gsl_vector_sub(vector_res_left, c2.mean());
-            gsl_vector_memcpy(vector_res_right, vector_res_left);
-            double chi_squared = 0;
-
-            // a = sigma_2^{-1} * (mu_1 - mu_2)
-            gsl_blas_dsymv(CblasUpper, 1.0, c2.inverse_covariance(), vector_res_left, 0.0, vector_res_right);
+            // third contribution: \chi^2 = |L_2^{-1} (mu_1 - mu_2)|^2, with sigma_2 = L_2 L_2^T
+            gsl_vector_memcpy(scratch, c1.mean());
+            gsl_vector_sub(scratch, c2.mean());
+            gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, c2.cholesky(), scratch);
 
-            // chi^2 = (mu_1 - mu_2) * a
-            gsl_blas_ddot(vector_res_left, vector_res_right, &chi_squared);
-            gsl_vector_free(vector_res_left);
-            gsl_vector_free(vector_res_right);
+            double chi_squared = 0;
+            gsl_blas_ddot(scratch, scratch, &chi_squared);
 
             d += chi_squared;
             if (! std::isfinite(d))
@@ -183,17 +230,18 @@ namespace eos
         // Eq. (7) and below
         void refit()
         {
-            // need temporary vector/matrix for addition
-            gsl_vector * mu_diff = gsl_vector_alloc(input_components[0].mean()->size);
-            gsl_matrix * sigma = gsl_matrix_alloc(input_components[0].mean()->size, input_components[0].mean()->size);
-
-            for (unsigned j = 0 ; j < output_components.size() ; ++j)
+            for_each(output_components.size(), [&] (const unsigned & j, gsl_vector * mu_diff)
             {
+                // need temporary matrix for addition
+                const unsigned dim = mu_diff->size;
+                std::vector<double> buffer(dim * dim, 0.0);
+                gsl_matrix_view sigma_view = gsl_matrix_view_array(buffer.data(), dim, dim);
+                gsl_matrix * sigma = &sigma_view.matrix;
+
                 // initialize values
                 output_components[j].weight() = 0;
                 gsl_vector_set_all(output_components[j].mean(), 0);
                 gsl_matrix_set_all(output_components[j].covariance(), 0);
-                gsl_matrix_set_all(sigma, 0);
 
                 // compute total weight and mean
                 for (auto i = inverse_mapping[j].cbegin() ; i != inverse_mapping[j].cend() ; ++i)
@@ -224,11 +272,11 @@ namespace eos
                 }
                 // 1 / beta_j
                 gsl_matrix_scale(output_components[j].covariance(), 1.0 / output_components[j].weight());
-            }
-            gsl_matrix_free(sigma);
-            gsl_vector_free(mu_diff);
 
-            // reset the components, s.t. inverse and determinant are recomputed
+                // recompute inverse and determinant; dead components are removed in the next step
+                if (output_components[j].weight() > 0.0)
+                    output_components[j].update();
+            });
         }
 
         // Eq. (4)
@@ -240,17 +288,72 @@ namespace eos
                 inverse_mapping[j].clear();
             }
 
-            // find smallest divergence between input component i and output component j of the cluster mixture density
+            // the smallest divergence between input component i and output component j has been found by compute_KL()
             for (unsigned i = 0 ; i < input_components.size() ; ++i)
             {
-                auto first = divergences.cbegin() + i * output_components.size();
-                auto last =  divergences.cbegin() + (i + 1) * output_components.size();
-                unsigned j = std::distance(first, std::min_element(first, last));
-                mapping[i] = j;
-                inverse_mapping[j].push_back(i);
+                inverse_mapping[mapping[i]].push_back(i);
             }
         }
 
+        /*
+         * Choose the initial output components among the input components, following the seeding of k-means++,
+         * cf. Arthur, Vassilvitskii, Proc. SODA 2007, 1027. The first component is chosen with probability
+         * proportional to the input weights, and each further component with probability proportional to the
+         * product of input weight and the divergence to the closest component chosen so far.
+         */
+        void seed(const unsigned & number_of_clusters, const unsigned long & seed)
+        {
+            if (0 == number_of_clusters)
+                throw InternalError("HierarchicalClustering::initial_guess: need at least one cluster");
+
+            if (input_components.size() < number_of_clusters)
+                throw InternalError("HierarchicalClustering::initial_guess: cannot choose " + stringify(number_of_clusters)
+                        + " clusters among " + stringify(input_components.size()) + " input components");
+
+            RandomStream stream(seed, "hierarchical-clustering");
+
+            const unsigned n_input = input_components.size();
+            std::vector<double> closest(n_input, std::numeric_limits<double>::infinity());
+            std::vector<double> cumulative(n_input);
+
+            output_components.clear();
+
+            // the probabilities for the first choice
+            for (unsigned i = 0 ; i < n_input ; ++i)
+            {
+                cumulative[i] = input_components[i].weight();
+            }
+
+            while (true)
+            {
+                std::partial_sum(cumulative.begin(), cumulative.end(), cumulative.begin());
+
+                // all inputs coincide with the chosen components, and any choice is as good as another
+                if (! (cumulative.back() > 0.0))
+                    throw InternalError("HierarchicalClustering::initial_guess: cannot choose " + stringify(number_of_clusters)
+                            + " distinct clusters");
+
+                const double u = stream.uniform() * cumulative.back();
+                const unsigned chosen = std::min<unsigned>(std::distance(cumulative.cbegin(), std::upper_bound(cumulative.cbegin(), cumulative.cend(), u)), n_input - 1);
+
+                const auto & c = input_components[chosen];
+                output_components.push_back(HierarchicalClustering::Component(c.mean(), c.covariance(), 1.0 / number_of_clusters));
+
+                if (output_components.size() == number_of_clusters)
+                    break;
+
+                // update the divergences to the closest chosen component, and the probabilities for the next choice
+                const auto & last = output_components.back();
+                for_each(n_input, [&] (const unsigned & i, gsl_vector * scratch)
+                {
+                    closest[i] = std::min(closest[i], kullback_leibler_divergence(input_components[i], last, scratch));
+                    cumulative[i] = input_components[i].weight() * closest[i];
+                });
+            }
+
+            inverse_mapping.resize(number_of_clusters);
+        }
+
         void run()
         {
             // sanity checks and setup
@@ -281,7 +384,12 @@ namespace eos
             {
                 Log::instance()->message("HierarchicalClustering::run", ll_informational)
                      << "Number of output component matches number of input components; skipping hierarchical clustering";
-                std::copy(input_components.begin(), input_components.end(), output_components.begin());
+                // copy, such that the input components are not changed by the refit
+                output_components.clear();
+                for (const auto & c : input_components)
+                {
+                    output_components.push_back(HierarchicalClustering::Component(c.mean(), c.covariance(), c.weight()));
+                }
             }
 
             double old_distance = std::numeric_limits<double>::max();
@@ -370,6 +478,12 @@ namespace eos
             throw InternalError("HierarchicalClustering::initial_guess: Weights are not normalized. Got total weight of " + stringify(total_weight, 16));
     }
 
+    void
+    HierarchicalClustering::initial_guess(const unsigned & number_of_clusters, const unsigned long & seed)
+    {
+        _imp->seed(number_of_clusters, seed);
+    }
+
     void
     HierarchicalClustering::run()
     {
@@ -416,8 +530,10 @@ namespace eos
     {
         unsigned dimension;
         gsl_matrix * covariance;
+        gsl_matrix * covariance_chol;
         gsl_matrix * inverse_covariance;
         double determinant;
+        double log_determinant;
 
         gsl_vector * mean;
 
@@ -426,6 +542,7 @@ namespace eos
         Implementation(const std::vector<double> & mean, const std::vector<double> & covariance, const double & weight) :
             dimension(mean.size()),
             covariance(gsl_matrix_alloc(dimension, dimension)),
+            covariance_chol(gsl_matrix_alloc(dimension, dimension)),
             inverse_covariance(gsl_matrix_alloc(dimension, dimension)),
             mean(gsl_vector_alloc(dimension)),
             weight(weight)
@@ -435,13 +552,27 @@ namespace eos
 
             std::copy(mean.cbegin(), mean.cend(), this->mean->data);
             std::copy(covariance.cbegin(), covariance.cend(), this->covariance->data);
-            gsl_matrix * covariance_chol = gsl_matrix_alloc(dimension, dimension);
 
+            update();
+        }
+
+        ~Implementation()
+        {
+            gsl_matrix_free(covariance);
+            gsl_matrix_free(covariance_chol);
+            gsl_matrix_free(inverse_covariance);
+            gsl_vector_free(mean);
+        }
+
+        // compute and cache the Cholesky decomposition, the inverse and the determinant of the covariance
+        void update()
+        {
             // copy covariance matrix to covariance_chol
             gsl_matrix_memcpy(covariance_chol, this->covariance);
 
-            // calculate cholesky decomposition, needed for sampling and one step for inversion
-            gsl_error_handler_t * default_gsl_error_handler = gsl_set_error_handler_off();
+            // calculate cholesky decomposition, needed for sampling and one step for inversion.
+            // This runs concurrently within the refit. Hence we rely on the GSL error handler being
+            // turned off for the entire library (cf. eos/init.cc), and check the return codes.
             if (GSL_EDOM == gsl_linalg_cholesky_decomp(covariance_chol))
             {
                 Log::instance()->message("HierarchicalClustering::Component", ll_warning)
@@ -469,7 +600,6 @@ namespace eos
                         + "or decrease initial proposal covariance. Proceed by taking square root of covariance manually");
                 }
             }
-            gsl_set_error_handler(default_gsl_error_handler);
 
             // copy cholesky decomposition to inverse_covariance
             gsl_matrix_memcpy(inverse_covariance, covariance_chol);
@@ -479,20 +609,13 @@ namespace eos
 
             // det(Sigma) = det(L)^2, and det(L) = Prod(diagonal)
             determinant = 1.0;
+            log_determinant = 0.0;
             for (unsigned i = 0 ; i < dimension ; ++i)
             {
                 determinant *= gsl_matrix_get(covariance_chol, i, i);
+                log_determinant += 2.0 * std::log(gsl_matrix_get(covariance_chol, i, i));
             }
             determinant = power_of<2>(determinant);
-
-            gsl_matrix_free(covariance_chol);
-        }
-
-        ~Implementation()
-        {
-            gsl_matrix_free(covariance);
-            gsl_matrix_free(inverse_covariance);
-            gsl_vector_free(mean);
         }
     };
 
@@ -525,12 +648,30 @@ namespace eos
         return _imp->inverse_covariance;
     }
 
+    const gsl_matrix *
+    HierarchicalClustering::Component::cholesky() const
+    {
+        return _imp->covariance_chol;
+    }
+
     const double &
     HierarchicalClustering::Component::determinant() const
     {
         return _imp->determinant;
     }
 
+    const double &
+    HierarchicalClustering::Component::log_determinant() const
+    {
+        return _imp->log_determinant;
+    }
+
+    void
+    HierarchicalClustering::Component::update()
+    {
+        _imp->update();
+    }
+
     gsl_vector *
     HierarchicalClustering::Component::mean() const
     {
@@ -556,7 +697,8 @@ namespace eos
         equal_weights(true),
         kill_components(true),
         maximum_steps(std::numeric_limits<unsigned>::max()),
-        precision(1e-4)
+        precision(1e-4),
+        parallelize(true)
     {
     }
 
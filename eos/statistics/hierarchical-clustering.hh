@@ -67,6 +67,16 @@ namespace eos
              */
             void initial_guess(const MixtureDensity & density);
 
+            /*!
+             * Choose the initial guess among the input components that have been added so far,
+             * following the seeding of k-means++. Components far from those chosen before are preferred,
+             * which typically reduces the number of steps until convergence.
+             *
+             * @param number_of_clusters The number of clusters to be determined.
+             * @param seed               The seed of the random numbers used in the choice.
+             */
+            void initial_guess(const unsigned & number_of_clusters, const unsigned long & seed);
+
             /*!
              * Perform the clustering.
              */
@@ -109,9 +119,15 @@ namespace eos
 
             gsl_matrix * covariance() const;
             const gsl_matrix * inverse_covariance() const;
+            /// The lower triangular Cholesky factor L of the covariance, with covariance = L L^T.
+            const gsl_matrix * cholesky() const;
             const double & determinant() const;
+            const double & log_determinant() const;
             gsl_vector * mean() const;
             double & weight() const;
+
+            /// Recompute the cached Cholesky factor, inverse and determinant after changes to the covariance.
+            void update();
     };
 
     std::ostream & operator<< (std::ostream & lhs, const HierarchicalClustering::Component & rhs);
@@ -160,6 +176,9 @@ namespace eos
             /// If relative change of distance between current and last step falls below precision,
             /// declare convergence.
             double precision;
+
+            /// If true, compute the divergences and refit the clusters in parallel on the ThreadPool.
+            bool parallelize;
     };
  }
 
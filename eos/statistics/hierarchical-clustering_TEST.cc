@@ -21,6 +21,7 @@
 #include <eos/statistics/hierarchical-clustering.hh>
 
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 
 #include <gsl/gsl_randist.h>
@@ -118,6 +119,97 @@ class HierarchicalClusteringTest :
                     TEST_CHECK_EQUAL(cluster, *map);
                 }
             }
+
+            // choose the initial guess via k-means++ seeding, and cluster in parallel and serially
+            {
+                static const unsigned n_clusters = 5;
+                static const unsigned n_components = 20 * n_clusters;
+                static const double radius = 5;
+
+                std::vector<double> covariance
+                {
+                    1.0, 0.5,
+                    0.5, 2.0
+                };
+
+                std::vector<double> mean(2, 0.0);
+
+                gsl_rng_set(rng, 1723);
+
+                HierarchicalClustering::MixtureDensity components;
+                for (unsigned j = 0 ; j < n_clusters ; ++j)
+                {
+                    const double angle = double(j) / n_clusters * 2 * M_PI;
+                    for (unsigned i = 0 ; i < n_components / n_clusters ; ++i)
+                    {
+                        mean[0] = radius * std::cos(angle) + gsl_ran_gaussian(rng, 0.5);
+                        mean[1] = radius * std::sin(angle) + gsl_ran_gaussian(rng, 0.5);
+
+                        components.push_back(HierarchicalClustering::Component(mean, covariance, 1.0));
+                    }
+                }
+
+                std::vector<std::vector<unsigned>> mappings;
+                for (bool parallelize : { true, false })
+                {
+                    HierarchicalClustering::Config config = HierarchicalClustering::Config::Default();
+                    config.parallelize = parallelize;
+                    HierarchicalClustering hc(config);
+                    for (const auto & c : components)
+                    {
+                        hc.add(c);
+                    }
+
+                    TEST_CHECK_THROWS(InternalError, hc.initial_guess(n_components + 1, 42));
+
+                    hc.initial_guess(n_clusters, 42);
+                    TEST_CHECK_EQUAL(std::distance(hc.begin_output(), hc.end_output()), n_clusters);
+
+                    hc.run();
+
+                    for (auto cl = hc.begin_output(); cl != hc.end_output() ; ++cl)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(cl->weight(), 0.2, 1e-14);
+                    }
+
+                    mappings.push_back(std::vector<unsigned>(hc.begin_map(), hc.end_map()));
+                }
+
+                // each component is associated with the components drawn from the same cluster, and only with those
+                const auto & mapping = mappings.front();
+                for (unsigned i = 0 ; i < n_components ; ++i)
+                {
+                    const unsigned first = i - i % (n_components / n_clusters);
+                    TEST_CHECK_EQUAL(mapping[i], mapping[first]);
+                }
+                std::vector<unsigned> clusters;
+                for (unsigned j = 0 ; j < n_clusters ; ++j)
+                {
+                    clusters.push_back(mapping[j * n_components / n_clusters]);
+                }
+                std::sort(clusters.begin(), clusters.end());
+                TEST_CHECK(std::unique(clusters.begin(), clusters.end()) == clusters.end());
+
+                // the results do not depend on the parallelization
+                TEST_CHECK(mappings.front() == mappings.back());
+            }
+
+            // the divergence is computed from the cached decomposition of the covariance
+            {
+                HierarchicalClustering::Component c(std::vector<double>{ 1.0, 2.0 }, std::vector<double>{ 4.0, 2.0, 2.0, 5.0 }, 1.0);
+
+                TEST_CHECK_RELATIVE_ERROR(c.determinant(), 16.0, 1e-14);
+                TEST_CHECK_RELATIVE_ERROR(c.log_determinant(), std::log(16.0), 1e-14);
+                TEST_CHECK_RELATIVE_ERROR(gsl_matrix_get(c.cholesky(), 0, 0), 2.0, 1e-14);
+                TEST_CHECK_RELATIVE_ERROR(gsl_matrix_get(c.cholesky(), 1, 0), 1.0, 1e-14);
+                TEST_CHECK_RELATIVE_ERROR(gsl_matrix_get(c.cholesky(), 1, 1), 2.0, 1e-14);
+
+                gsl_matrix_set(c.covariance(), 0, 0, 9.0);
+                c.update();
+                TEST_CHECK_RELATIVE_ERROR(c.determinant(), 41.0, 1e-14);
+                TEST_CHECK_RELATIVE_ERROR(gsl_matrix_get(c.inverse_covariance(), 0, 0), 5.0 / 41.0, 1e-14);
+            }
+
             gsl_rng_free(rng);
         }
 } hierarchical_clustering_test;
@@ -20,13 +20,16 @@
 
 #include <eos/statistics/histogram.hh>
 #include <eos/utils/exception.hh>
+#include <eos/utils/hdf5.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <cmath>
 #include <algorithm>
-#include <list>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 namespace eos
@@ -36,21 +39,30 @@ namespace eos
     template <>
     struct WrappedForwardIteratorTraits<Histogram<1>::ConstIteratorTag>
     {
-        typedef std::list<Histogram<1>::Bin>::const_iterator UnderlyingIterator;
+        typedef std::vector<Histogram<1>::Bin>::const_iterator UnderlyingIterator;
     };
 
     template <> struct Implementation<Histogram<1>>
     {
-        std::list<Histogram<1>::Bin> bins;
+        // sorted by their lower limits
+        std::vector<Histogram<1>::Bin> bins;
 
         unsigned entries;
 
         unsigned underflow, overflow;
 
+        // if all bins have identical width and are adjacent, the matching bin can be computed
+        bool equal_binning;
+
+        double lower, inverse_width;
+
         Implementation() :
             entries(0),
             underflow(0),
-            overflow(0)
+            overflow(0),
+            equal_binning(false),
+            lower(0.0),
+            inverse_width(0.0)
         {
         }
 
@@ -59,12 +71,49 @@ namespace eos
             return (bin.lower <= value) && (value < bin.upper);
         }
 
+        std::vector<Histogram<1>::Bin>::iterator find(const double & value)
+        {
+            if (bins.empty())
+                return bins.end();
+
+            if (equal_binning)
+            {
+                // also rejects NaN
+                const double x = (value - lower) * inverse_width;
+                if (! (x >= 0.0))
+                    return bins.end();
+
+                // clamp to the last bin, since values just below the upper border can round up to bins.size(),
+                // and correct for rounding at the bin borders
+                auto b = bins.begin() + static_cast<std::size_t>(std::min(x, bins.size() - 1.0));
+                if ((value < b->lower) && (b != bins.begin()))
+                    --b;
+                else if ((value >= b->upper) && (b + 1 != bins.end()))
+                    ++b;
+
+                return falls_into(value, *b) ? b : bins.end();
+            }
+
+            // find the last bin with lower <= value
+            auto b = std::upper_bound(bins.begin(), bins.end(), value,
+                    [] (const double & v, const Histogram<1>::Bin & bin) { return v < bin.lower; });
+            if (bins.begin() == b)
+                return bins.end();
+
+            --b;
+
+            return falls_into(value, *b) ? b : bins.end();
+        }
+
         void insert(const double & value)
         {
-            auto b = std::find_if(bins.begin(), bins.end(), std::bind(&Implementation<Histogram<1>>::falls_into, value, std::placeholders::_1));
+            auto b = find(value);
 
             if (bins.end() == b)
             {
+                if (bins.empty())
+                    throw InternalError("Histogram<1>::insert(): Histogram has no bins");
+
                 if (value < bins.front().lower)
                     ++underflow;
 
@@ -78,16 +127,13 @@ namespace eos
             ++entries;
         }
 
-        static bool is_right_of(const Histogram<1>::Bin & new_bin, const Histogram<1>::Bin & bin)
-        {
-            return ! (bin < new_bin);
-        }
-
         void insert(const Histogram<1>::Bin & bin)
         {
-            auto b = std::find_if(bins.begin(), bins.end(), std::bind(&Implementation<Histogram<1>>::is_right_of, bin, std::placeholders::_1));
+            auto b = std::lower_bound(bins.begin(), bins.end(), bin);
 
             bins.insert(b, bin);
+
+            equal_binning = false;
         }
     };
 
@@ -106,11 +152,16 @@ namespace eos
         Histogram<1> result;
 
         double bin_width = std::abs(upper - lower) / count;
+        result._imp->bins.reserve(count);
         for (unsigned i = 0 ; i < count ; ++i)
         {
             result.insert(Bin(lower + bin_width * i, lower + bin_width * (i + 1), 0.0));
         }
 
+        result._imp->equal_binning = (count > 0);
+        result._imp->lower = lower;
+        result._imp->inverse_width = 1.0 / bin_width;
+
         return result;
     }
 
@@ -132,6 +183,30 @@ namespace eos
         return _imp->entries;
     }
 
+    void
+    Histogram<1>::merge(const Histogram<1> & other)
+    {
+        const auto & other_bins = other._imp->bins;
+
+        if (_imp->bins.size() != other_bins.size())
+            throw InternalError("Histogram<1>::merge(): Histograms have different numbers of bins");
+
+        for (unsigned i = 0 ; i < other_bins.size() ; ++i)
+        {
+            if ((_imp->bins[i].lower != other_bins[i].lower) || (_imp->bins[i].upper != other_bins[i].upper))
+                throw InternalError("Histogram<1>::merge(): Histograms have different bins");
+        }
+
+        for (unsigned i = 0 ; i < other_bins.size() ; ++i)
+        {
+            _imp->bins[i].value += other_bins[i].value;
+        }
+
+        _imp->entries += other._imp->entries;
+        _imp->underflow += other._imp->underflow;
+        _imp->overflow += other._imp->overflow;
+    }
+
     Histogram<1>::ConstIterator
     Histogram<1>::begin() const
     {
@@ -182,7 +257,15 @@ namespace eos
     {
         std::vector<Histogram<2>::Bin> bins;
 
-        Implementation()
+        // if the bins form a regular grid, the matching bin can be computed
+        bool equal_binning;
+
+        std::array<double, 2> lower, inverse_width;
+
+        std::array<unsigned, 2> count;
+
+        Implementation() :
+            equal_binning(false)
         {
         }
 
@@ -196,6 +279,39 @@ namespace eos
 
         std::vector<Histogram<2>::Bin>::iterator find(const std::array<double, 2> & coordinates)
         {
+            if (equal_binning)
+            {
+                std::array<unsigned, 2> index;
+                for (unsigned d = 0 ; d < 2 ; ++d)
+                {
+                    // also rejects NaN
+                    const double x = (coordinates[d] - lower[d]) * inverse_width[d];
+                    if (! (x >= 0.0))
+                        return bins.end();
+
+                    // clamp to the last bin, see Histogram<1>
+                    index[d] = static_cast<unsigned>(std::min(x, count[d] - 1.0));
+                }
+
+                // correct for rounding at the bin borders
+                auto b = bins.begin() + index[0] * count[1] + index[1];
+                for (unsigned d = 0 ; d < 2 ; ++d)
+                {
+                    const unsigned stride = (0 == d) ? count[1] : 1;
+
+                    if ((coordinates[d] < b->lower[d]) && (index[d] > 0))
+                    {
+                        b -= stride;
+                    }
+                    else if ((coordinates[d] >= b->upper[d]) && (index[d] + 1 < count[d]))
+                    {
+                        b += stride;
+                    }
+                }
+
+                return falls_into(coordinates, *b) ? b : bins.end();
+            }
+
             // perform a binary search for a matching bin
             std::vector<Histogram<2>::Bin>::iterator l = bins.begin(), r = bins.end(), x;
 
@@ -235,6 +351,8 @@ namespace eos
             auto b = std::find_if(bins.begin(), bins.end(), std::bind(&Implementation<Histogram<2>>::is_next_of, bin, std::placeholders::_1));
 
             bins.insert(b, bin);
+
+            equal_binning = false;
         }
     };
 
@@ -251,6 +369,7 @@ namespace eos
     Histogram<2>::WithEqualBinning(const std::array<double, 2> & lower, const std::array<double, 2> & upper, const std::array<unsigned, 2> & count)
     {
         Histogram<2> result;
+        result._imp->bins.reserve(count[0] * count[1]);
 
         double x_bin_width = std::abs(upper[0] - lower[0]) / count[0];
         double y_bin_width = std::abs(upper[1] - lower[1]) / count[1];
@@ -258,12 +377,18 @@ namespace eos
         {
             for (unsigned j = 0 ; j < count[1] ; ++j)
             {
-                result.insert(Bin(std::array<double, 2>{{lower[0] + x_bin_width * i, lower[1] + y_bin_width * j}},
+                // bins are created in order, and do not need to be sorted
+                result._imp->bins.push_back(Bin(std::array<double, 2>{{lower[0] + x_bin_width * i, lower[1] + y_bin_width * j}},
                             std::array<double, 2>{{lower[0] + x_bin_width * (i + 1), lower[1] + y_bin_width * (j + 1)}},
                             0.0));
             }
         }
 
+        result._imp->equal_binning = (count[0] > 0) && (count[1] > 0);
+        result._imp->lower = lower;
+        result._imp->inverse_width = std::array<double, 2>{{ 1.0 / x_bin_width, 1.0 / y_bin_width }};
+        result._imp->count = count;
+
         return result;
     }
 
@@ -305,4 +430,479 @@ namespace eos
 
     template class WrappedForwardIterator<Histogram<2>::IteratorTag, Histogram<2>::Bin>;
     template class WrappedForwardIterator<Histogram<2>::ConstIteratorTag, const Histogram<2>::Bin>;
+
+    /* GridHistogram */
+
+    template <> struct Implementation<GridHistogram>
+    {
+        std::vector<GridHistogram::Axis> axes;
+
+        GridHistogram::Storage storage;
+
+        std::vector<double> inverse_widths;
+
+        // strides of the flat bin index, the last axis varies fastest
+        std::vector<unsigned long> strides;
+
+        unsigned long size;
+
+        std::vector<double> dense;
+
+        std::unordered_map<unsigned long, double> sparse;
+
+        unsigned long entries, outside;
+
+        // the largest number of bins that is stored densely
+        static constexpr unsigned long max_dense_size = 1ul << 28;
+
+        Implementation(const std::vector<GridHistogram::Axis> & axes, const GridHistogram::Storage & storage) :
+            axes(axes),
+            storage(storage),
+            inverse_widths(axes.size()),
+            strides(axes.size()),
+            size(1),
+            entries(0),
+            outside(0)
+        {
+            if (axes.empty())
+                throw InternalError("GridHistogram: At least one axis is required");
+
+            double total = 1.0;
+            for (int a = axes.size() - 1 ; a >= 0 ; --a)
+            {
+                if ((0 == axes[a].bins) || (! (axes[a].lower < axes[a].upper)))
+                    throw InternalError("GridHistogram: Axis #" + stringify(a) + " has an invalid binning");
+
+                inverse_widths[a] = axes[a].bins / (axes[a].upper - axes[a].lower);
+                strides[a] = size;
+                size *= axes[a].bins;
+                total *= axes[a].bins;
+            }
+
+            if (total > std::numeric_limits<unsigned long>::max() / 2)
+                throw InternalError("GridHistogram: Number of bins '" + stringify(total) + "' is too large");
+
+            if (GridHistogram::Storage::dense == storage)
+            {
+                if (size > max_dense_size)
+                    throw InternalError("GridHistogram: Number of bins '" + stringify(size) + "' is too large for dense storage; use sparse storage instead");
+
+                dense.resize(size, 0.0);
+            }
+        }
+
+        bool index(const double * point, unsigned long & result) const
+        {
+            result = 0;
+            for (unsigned a = 0 ; a < axes.size() ; ++a)
+            {
+                // also rejects NaN
+                if (! ((axes[a].lower <= point[a]) && (point[a] < axes[a].upper)))
+                    return false;
+
+                const unsigned i = std::min(static_cast<unsigned>((point[a] - axes[a].lower) * inverse_widths[a]), axes[a].bins - 1);
+                result += i * strides[a];
+            }
+
+            return true;
+        }
+
+        void add(const unsigned long & index, const double & weight)
+        {
+            if (GridHistogram::Storage::dense == storage)
+            {
+                dense[index] += weight;
+            }
+            else
+            {
+                sparse[index] += weight;
+            }
+        }
+
+        bool insert(const double * point, const double & weight)
+        {
+            unsigned long i;
+            if (! index(point, i))
+            {
+                ++outside;
+                return false;
+            }
+
+            add(i, weight);
+            ++entries;
+
+            return true;
+        }
+
+        bool compatible(const Implementation<GridHistogram> & other) const
+        {
+            if ((other.storage != storage) || (other.axes.size() != axes.size()))
+                return false;
+
+            for (unsigned a = 0 ; a < axes.size() ; ++a)
+            {
+                if ((other.axes[a].lower != axes[a].lower) || (other.axes[a].upper != axes[a].upper) || (other.axes[a].bins != axes[a].bins))
+                    return false;
+            }
+
+            return true;
+        }
+
+        void merge(const Implementation<GridHistogram> & other)
+        {
+            if (! compatible(other))
+                throw InternalError("GridHistogram::merge(): Histograms have different axes or storage");
+
+            if (GridHistogram::Storage::dense == storage)
+            {
+                for (unsigned long i = 0 ; i < size ; ++i)
+                {
+                    dense[i] += other.dense[i];
+                }
+            }
+            else
+            {
+                for (const auto & b : other.sparse)
+                {
+                    sparse[b.first] += b.second;
+                }
+            }
+
+            entries += other.entries;
+            outside += other.outside;
+        }
+    };
+
+    GridHistogram::GridHistogram(const std::vector<Axis> & axes, const Storage & storage) :
+        PrivateImplementationPattern<GridHistogram>(new Implementation<GridHistogram>(axes, storage))
+    {
+    }
+
+    GridHistogram::~GridHistogram()
+    {
+    }
+
+    GridHistogram
+    GridHistogram::clone() const
+    {
+        GridHistogram result(_imp->axes, _imp->storage);
+        *result._imp = *_imp;
+
+        return result;
+    }
+
+    bool
+    GridHistogram::insert(const double * point, const double & weight)
+    {
+        return _imp->insert(point, weight);
+    }
+
+    void
+    GridHistogram::fill(const MarkovChain::History & history, const std::vector<unsigned> & parameters)
+    {
+        if (parameters.size() != _imp->axes.size())
+            throw InternalError("GridHistogram::fill(): Expected " + stringify(_imp->axes.size()) + " parameters, got " + stringify(parameters.size()));
+
+        const auto & states = history.states;
+        if (states.empty())
+            return;
+
+        const unsigned dimension = states.front().point.size();
+        for (auto p : parameters)
+        {
+            if (p >= dimension)
+                throw InternalError("GridHistogram::fill(): Parameter index '" + stringify(p) + "' exceeds the chain's dimension '" + stringify(dimension) + "'");
+        }
+
+        auto fill_range = [&parameters, &states] (GridHistogram & histogram, unsigned long first, unsigned long last)
+        {
+            std::vector<double> point(parameters.size());
+            for (unsigned long s = first ; s < last ; ++s)
+            {
+                for (unsigned p = 0 ; p < parameters.size() ; ++p)
+                {
+                    point[p] = states[s].point[parameters[p]];
+                }
+
+                histogram._imp->insert(point.data(), 1.0);
+            }
+        };
+
+        // small histories are not worth the overhead of distributing them
+        static const unsigned long min_states_per_job = 10000;
+        const unsigned long jobs = std::min<unsigned long>(ThreadPool::instance()->number_of_threads(), states.size() / min_states_per_job);
+        if (jobs < 2)
+        {
+            fill_range(*this, 0, states.size());
+            return;
+        }
+
+        // each job fills an independent histogram of its own
+        std::vector<GridHistogram> partials;
+        partials.reserve(jobs + 1);
+        for (unsigned long j = 0 ; j < jobs ; ++j)
+        {
+            partials.push_back(GridHistogram(_imp->axes, _imp->storage));
+        }
+
+        std::vector<Ticket> tickets;
+        for (unsigned long j = 0 ; j < jobs ; ++j)
+        {
+            const unsigned long first = j * states.size() / jobs, last = (j + 1) * states.size() / jobs;
+            tickets.push_back(ThreadPool::instance()->enqueue(std::bind(fill_range, std::ref(partials[j]), first, last)));
+        }
+
+        for (auto & t : tickets)
+        {
+            t.wait();
+        }
+
+        partials.push_back(*this);
+        *_imp = *merge(partials)._imp;
+    }
+
+    void
+    GridHistogram::fill(hdf5::DataSet<hdf5::Array<1, double>> & data_set, const std::vector<unsigned> & columns, const int & weight_column)
+    {
+        if (columns.size() != _imp->axes.size())
+            throw InternalError("GridHistogram::fill(): Expected " + stringify(_imp->axes.size()) + " columns, got " + stringify(columns.size()));
+
+        const unsigned record_columns = data_set.record_size() / sizeof(double);
+        for (auto c : columns)
+        {
+            if (c >= record_columns)
+                throw InternalError("GridHistogram::fill(): Column index '" + stringify(c) + "' exceeds the number of columns '" + stringify(record_columns) + "'");
+        }
+
+        if (weight_column >= int(record_columns))
+            throw InternalError("GridHistogram::fill(): Weight column index '" + stringify(weight_column) + "' exceeds the number of columns '" + stringify(record_columns) + "'");
+
+        hdf5::PrefetchingReader<hdf5::Array<1, double>> reader(data_set);
+
+        std::vector<double> point(columns.size());
+        const void * block;
+        while (unsigned records = reader.next_block(block))
+        {
+            const double * record = static_cast<const double *>(block);
+            for (unsigned r = 0 ; r < records ; ++r, record += record_columns)
+            {
+                for (unsigned c = 0 ; c < columns.size() ; ++c)
+                {
+                    point[c] = record[columns[c]];
+                }
+
+                _imp->insert(point.data(), weight_column < 0 ? 1.0 : record[weight_column]);
+            }
+        }
+    }
+
+    void
+    GridHistogram::merge(const GridHistogram & other)
+    {
+        _imp->merge(*other._imp);
+    }
+
+    GridHistogram
+    GridHistogram::merge(const std::vector<GridHistogram> & histograms)
+    {
+        if (histograms.empty())
+            throw InternalError("GridHistogram::merge(): Need at least one histogram");
+
+        const auto & first = *histograms.front()._imp;
+        for (const auto & h : histograms)
+        {
+            if (! first.compatible(*h._imp))
+                throw InternalError("GridHistogram::merge(): Histograms have different axes or storage");
+        }
+
+        GridHistogram result(first.axes, first.storage);
+        for (const auto & h : histograms)
+        {
+            result._imp->entries += h._imp->entries;
+            result._imp->outside += h._imp->outside;
+        }
+
+        const unsigned threads = ThreadPool::instance()->number_of_threads();
+        std::vector<Ticket> tickets;
+
+        if (Storage::dense == first.storage)
+        {
+            // each job sums a contiguous range of bins over all histograms
+            const unsigned long jobs = std::max(1ul, std::min<unsigned long>(threads, first.size / 4096));
+            auto merge_range = [&histograms, &result] (unsigned long begin, unsigned long end)
+            {
+                double * target = result._imp->dense.data();
+                for (const auto & h : histograms)
+                {
+                    const double * source = h._imp->dense.data();
+                    for (unsigned long i = begin ; i < end ; ++i)
+                    {
+                        target[i] += source[i];
+                    }
+                }
+            };
+
+            if (1 == jobs)
+            {
+                merge_range(0, first.size);
+                return result;
+            }
+
+            for (unsigned long j = 0 ; j < jobs ; ++j)
+            {
+                tickets.push_back(ThreadPool::instance()->enqueue(std::bind(merge_range, j * first.size / jobs, (j + 1) * first.size / jobs)));
+            }
+
+            for (auto & t : tickets)
+            {
+                t.wait();
+            }
+
+            return result;
+        }
+
+        // sparse storage: merge pairs of histograms in parallel, halving their number in each round
+        std::vector<GridHistogram> partials;
+        for (unsigned i = 0 ; i < histograms.size() ; i += 2)
+        {
+            partials.push_back(GridHistogram(first.axes, first.storage));
+        }
+
+        auto merge_pair = [] (GridHistogram & target, const GridHistogram & a, const GridHistogram * b)
+        {
+            auto & sparse = target._imp->sparse;
+            sparse.reserve(a._imp->sparse.size() + (b ? b->_imp->sparse.size() : 0));
+
+            for (const auto & bin : a._imp->sparse)
+            {
+                sparse[bin.first] += bin.second;
+            }
+
+            if (! b)
+                return;
+
+            for (const auto & bin : b->_imp->sparse)
+            {
+                sparse[bin.first] += bin.second;
+            }
+        };
+
+        for (unsigned i = 0 ; i < partials.size() ; ++i)
+        {
+            const GridHistogram * b = (2 * i + 1 < histograms.size()) ? &histograms[2 * i + 1] : nullptr;
+            tickets.push_back(ThreadPool::instance()->enqueue(std::bind(merge_pair, std::ref(partials[i]), std::cref(histograms[2 * i]), b)));
+        }
+
+        for (auto & t : tickets)
+        {
+            t.wait();
+        }
+        tickets.clear();
+
+        for (unsigned step = 1 ; step < partials.size() ; step *= 2)
+        {
+            for (unsigned i = 0 ; i + step < partials.size() ; i += 2 * step)
+            {
+                tickets.push_back(ThreadPool::instance()->enqueue([&partials, i, step] ()
+                {
+                    auto & target = partials[i]._imp->sparse;
+                    for (const auto & bin : partials[i + step]._imp->sparse)
+                    {
+                        target[bin.first] += bin.second;
+                    }
+                }));
+            }
+
+            for (auto & t : tickets)
+            {
+                t.wait();
+            }
+            tickets.clear();
+        }
+
+        result._imp->sparse = std::move(partials.front()._imp->sparse);
+
+        return result;
+    }
+
+    const std::vector<GridHistogram::Axis> &
+    GridHistogram::axes() const
+    {
+        return _imp->axes;
+    }
+
+    GridHistogram::Storage
+    GridHistogram::storage() const
+    {
+        return _imp->storage;
+    }
+
+    double
+    GridHistogram::value(const std::vector<unsigned> & indices) const
+    {
+        if (indices.size() != _imp->axes.size())
+            throw InternalError("GridHistogram::value(): Expected " + stringify(_imp->axes.size()) + " indices, got " + stringify(indices.size()));
+
+        unsigned long index = 0;
+        for (unsigned a = 0 ; a < indices.size() ; ++a)
+        {
+            if (indices[a] >= _imp->axes[a].bins)
+                throw InternalError("GridHistogram::value(): Index '" + stringify(indices[a]) + "' is out of range for axis #" + stringify(a));
+
+            index += indices[a] * _imp->strides[a];
+        }
+
+        if (Storage::dense == _imp->storage)
+            return _imp->dense[index];
+
+        auto b = _imp->sparse.find(index);
+
+        return (_imp->sparse.end() == b) ? 0.0 : b->second;
+    }
+
+    unsigned long
+    GridHistogram::entries() const
+    {
+        return _imp->entries;
+    }
+
+    unsigned long
+    GridHistogram::outside() const
+    {
+        return _imp->outside;
+    }
+
+    void
+    GridHistogram::visit(const std::function<void (const std::vector<unsigned> &, const double &)> & f) const
+    {
+        std::vector<unsigned> indices(_imp->axes.size());
+        auto unflatten = [this, &indices] (unsigned long index)
+        {
+            for (unsigned a = 0 ; a < indices.size() ; ++a)
+            {
+                indices[a] = index / _imp->strides[a];
+                index %= _imp->strides[a];
+            }
+        };
+
+        if (Storage::dense == _imp->storage)
+        {
+            for (unsigned long i = 0 ; i < _imp->size ; ++i)
+            {
+                if (0.0 == _imp->dense[i])
+                    continue;
+
+                unflatten(i);
+                f(indices, _imp->dense[i]);
+            }
+        }
+        else
+        {
+            for (const auto & b : _imp->sparse)
+            {
+                unflatten(b.first);
+                f(indices, b.second);
+            }
+        }
+    }
 }
@@ -20,10 +20,14 @@
 #ifndef EOS_GUARD_SRC_STATISTICS_HISTROGRAM_HH
 #define EOS_GUARD_SRC_STATISTICS_HISTROGRAM_HH 1
 
+#include <eos/statistics/markov-chain.hh>
+#include <eos/utils/hdf5-fwd.hh>
 #include <eos/utils/private_implementation_pattern.hh>
 #include <eos/utils/wrapped_forward_iterator.hh>
 
 #include <array>
+#include <functional>
+#include <vector>
 
 namespace eos
 {
@@ -51,6 +55,9 @@ namespace eos
              * Named constructor.
              *
              * Creates a Histogram with pre-existing bins of identical width.
+             * The bin that matches a value is computed rather than searched for,
+             * as long as no further bins are inserted.
+             *
              * @param start    Left-most value that shall be covered by the Histogram.
              * @param end      Right-most value that shall be covered by the Histogram.
              * @param count    Number of Bins in the Histogram.
@@ -66,6 +73,14 @@ namespace eos
             void insert(const double & value);
             /// Returns the number of entries in the histogram.
             unsigned entries() const;
+
+            /*!
+             * Adds the contents of another histogram with identical bins, e.g.
+             * when filling one histogram per thread.
+             *
+             * @param other    The other Histogram.
+             */
+            void merge(const Histogram<1> & other);
             ///@}
 
             ///@name Iteration
@@ -152,6 +167,9 @@ namespace eos
              * Named constructor.
              *
              * Creates a Histogram with pre-existing bins of identical width.
+             * The bin that matches a pair of coordinates is computed rather than searched for,
+             * as long as no further bins are inserted.
+             *
              * @param start    Left-most value for each dimension that shall be covered by the Histogram.
              * @param end      Right-most value for each dimension that shall be covered by the Histogram.
              * @param count    Number of Bins for each dimension.
@@ -241,6 +259,140 @@ namespace eos
             return false;
         }
     };
+
+    /*!
+     * A histogram of arbitrary dimension with bins of identical width along each axis.
+     *
+     * The bin that matches a point is computed, i.e., insertion costs O(dimension).
+     * Bin contents are either stored densely, or in a hash map which only holds the non-empty bins.
+     * The latter is preferable if the number of bins is large compared to the number of entries.
+     *
+     * Copies of a GridHistogram share their bins. Use clone() to obtain an independent copy.
+     */
+    class GridHistogram :
+        public PrivateImplementationPattern<GridHistogram>
+    {
+        public:
+            /*!
+             * Describes the binning along one axis.
+             */
+            struct Axis
+            {
+                /// Lower (inclusive) limit of the axis.
+                double lower;
+
+                /// Upper (exclusive) limit of the axis.
+                double upper;
+
+                /// Number of bins along the axis.
+                unsigned bins;
+
+                Axis(const double & lower, const double & upper, const unsigned & bins) :
+                    lower(lower),
+                    upper(upper),
+                    bins(bins)
+                {
+                }
+            };
+
+            /// Storage scheme for the bin contents.
+            enum class Storage
+            {
+                dense,
+                sparse
+            };
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * Creates an empty GridHistogram.
+             *
+             * @param axes     The binning along each axis.
+             * @param storage  The storage scheme for the bin contents.
+             */
+            GridHistogram(const std::vector<Axis> & axes, const Storage & storage = Storage::dense);
+
+            /// Destructor.
+            ~GridHistogram();
+
+            /// Create an independent copy.
+            GridHistogram clone() const;
+            ///@}
+
+            ///@name Insertion and Retrieval
+            ///@{
+            /*!
+             * Inserts a point into the histogram's matching bin.
+             *
+             * @param point    The coordinates of the point, one for each axis.
+             * @param weight   The weight of the point.
+             *
+             * @return False if the point lies outside of the histogram's range, true otherwise.
+             */
+            bool insert(const double * point, const double & weight = 1.0);
+
+            /*!
+             * Inserts the states of a Markov chain.
+             *
+             * The states are distributed among the threads of the ThreadPool. Each thread fills
+             * a histogram of its own, and the partial histograms are merged afterwards.
+             *
+             * @param history     The history of the Markov chain.
+             * @param parameters  The indices of the parameters that correspond to the histogram's axes.
+             */
+            void fill(const MarkovChain::History & history, const std::vector<unsigned> & parameters);
+
+            /*!
+             * Inserts samples from an HDF5 data set, e.g., the samples produced by the PopulationMonteCarloSampler.
+             *
+             * The records are read in blocks, while the next block is prefetched in the background.
+             *
+             * @param data_set      The data set.
+             * @param columns       The indices of the columns that correspond to the histogram's axes.
+             * @param weight_column The index of the column that holds the samples' weights, or -1 for unweighted samples.
+             */
+            void fill(hdf5::DataSet<hdf5::Array<1, double>> & data_set, const std::vector<unsigned> & columns, const int & weight_column = -1);
+
+            /*!
+             * Adds the contents of another histogram with identical axes.
+             *
+             * @param other    The other GridHistogram.
+             */
+            void merge(const GridHistogram & other);
+
+            /*!
+             * Adds the contents of several histograms with identical axes, e.g., one per thread.
+             * The work is distributed among the threads of the ThreadPool.
+             *
+             * @param histograms  The histograms that shall be merged.
+             */
+            static GridHistogram merge(const std::vector<GridHistogram> & histograms);
+
+            /// Returns the binning along each axis.
+            const std::vector<Axis> & axes() const;
+
+            /// Returns the storage scheme.
+            Storage storage() const;
+
+            /// Returns the content of the bin with the given index along each axis.
+            double value(const std::vector<unsigned> & indices) const;
+
+            /// Returns the number of entries that fell into any bin.
+            unsigned long entries() const;
+
+            /// Returns the number of entries that fell outside of the histogram's range.
+            unsigned long outside() const;
+
+            /*!
+             * Calls a function for every non-empty bin, in no particular order.
+             *
+             * @param f    The function, which receives the bin's index along each axis and the bin's content.
+             */
+            void visit(const std::function<void (const std::vector<unsigned> &, const double &)> & f) const;
+            ///@}
+    };
 }
 
 #endif
@@ -19,8 +19,11 @@
 
 #include <test/test.hh>
 #include <eos/statistics/histogram.hh>
+#include <eos/utils/hdf5.hh>
 
+#include <cmath>
 #include <iostream>
+#include <map>
 
 using namespace test;
 using namespace eos;
@@ -67,6 +70,79 @@ class Histogram1Test :
                 TEST_CHECK_EQUAL(histogram.entries(), 3);
             }
 
+            // Test insertion of values at and beyond the borders of equally-sized bins
+            {
+                Histogram<1> histogram = Histogram<1>::WithEqualBinning(0.0, 0.7, 7);
+
+                for (unsigned i = 0 ; i < 7 ; ++i)
+                {
+                    histogram.insert(i * 0.1);
+                }
+                TEST_CHECK_EQUAL(_stringify(histogram), "[0,0.1,1][0.1,0.2,1][0.2,0.3,1][0.3,0.4,1][0.4,0.5,1][0.5,0.6,1][0.6,0.7,1]");
+                TEST_CHECK_EQUAL(histogram.entries(), 7);
+
+                TEST_CHECK_THROWS(InternalError, histogram.insert(-0.01));
+                TEST_CHECK_THROWS(InternalError, histogram.insert(0.7));
+                TEST_CHECK_EQUAL(histogram.entries(), 7);
+            }
+
+            // Test insertion of the largest value below the upper border of equally-sized bins
+            {
+                for (unsigned i = 1 ; i <= 100 ; ++i)
+                {
+                    const double lower = -0.37 * i, upper = 1.3 * i + 0.01 * i * i;
+                    const unsigned count = 3 + i % 17;
+
+                    // the upper border of the last bin, as computed by WithEqualBinning
+                    const double border = lower + std::abs(upper - lower) / count * count;
+
+                    Histogram<1> histogram = Histogram<1>::WithEqualBinning(lower, upper, count);
+                    histogram.insert(std::nextafter(border, lower));
+                    histogram.insert(lower);
+                    TEST_CHECK_EQUAL(histogram.entries(), 2);
+                    TEST_CHECK_THROWS(InternalError, histogram.insert(border));
+                }
+
+                Histogram<1> histogram = Histogram<1>::WithEqualBinning(0.0, 3.0, 3);
+                histogram.insert(std::nextafter(3.0, 0.0));
+                TEST_CHECK_EQUAL(_stringify(histogram), "[0,1,0][1,2,0][2,3,1]");
+            }
+
+            // Test insertion of values into unequally-sized bins
+            {
+                Histogram<1> histogram;
+                histogram.insert(Histogram<1>::Bin(2.0, 4.0));
+                histogram.insert(Histogram<1>::Bin(0.0, 1.0));
+                histogram.insert(Histogram<1>::Bin(1.0, 2.0));
+                histogram.insert(Histogram<1>::Bin(5.0, 8.0));
+
+                histogram.insert(0.0);
+                histogram.insert(3.9);
+                histogram.insert(2.0);
+                histogram.insert(7.0);
+                TEST_CHECK_EQUAL(_stringify(histogram), "[0,1,1][1,2,0][2,4,2][5,8,1]");
+
+                // gap between 4 and 5
+                TEST_CHECK_THROWS(InternalError, histogram.insert(4.5));
+                TEST_CHECK_EQUAL(histogram.entries(), 4);
+            }
+
+            // Test merging
+            {
+                Histogram<1> a = Histogram<1>::WithEqualBinning(0.0, 3.0, 3);
+                Histogram<1> b = Histogram<1>::WithEqualBinning(0.0, 3.0, 3);
+                a.insert(0.5);
+                b.insert(0.5);
+                b.insert(2.5);
+
+                a.merge(b);
+                TEST_CHECK_EQUAL(_stringify(a), "[0,1,2][1,2,0][2,3,1]");
+                TEST_CHECK_EQUAL(a.entries(), 3);
+
+                Histogram<1> c = Histogram<1>::WithEqualBinning(0.0, 3.0, 4);
+                TEST_CHECK_THROWS(InternalError, a.merge(c));
+            }
+
             // ToDo: Test ECDF
             {
             }
@@ -191,6 +267,26 @@ class Histogram2Test :
                 TEST_CHECK(histogram.end() == histogram.find(std::array<double, 2>{{6.0, 6.0}}));
             }
 
+            // Test finding of the largest values below the upper borders of equally-sized bins
+            {
+                for (unsigned i = 1 ; i <= 100 ; ++i)
+                {
+                    const std::array<double, 2> lower{{ -0.37 * i, 0.11 * i }}, upper{{ 1.3 * i + 0.01 * i * i, 0.7 * i }};
+                    const std::array<unsigned, 2> count{{ 3 + i % 17, 2 + i % 13 }};
+
+                    // the upper borders of the last bins, as computed by WithEqualBinning
+                    const std::array<double, 2> border{{
+                        lower[0] + std::abs(upper[0] - lower[0]) / count[0] * count[0],
+                        lower[1] + std::abs(upper[1] - lower[1]) / count[1] * count[1]
+                    }};
+
+                    Histogram<2> histogram = Histogram<2>::WithEqualBinning(lower, upper, count);
+                    TEST_CHECK(histogram.end() != histogram.find(std::array<double, 2>{{ std::nextafter(border[0], lower[0]), std::nextafter(border[1], lower[1]) }}));
+                    TEST_CHECK(histogram.end() != histogram.find(std::array<double, 2>{{ std::nextafter(border[0], lower[0]), lower[1] }}));
+                    TEST_CHECK(histogram.end() == histogram.find(std::array<double, 2>{{ border[0], lower[1] }}));
+                }
+            }
+
             // Test a common use case
             {
                 static const std::array<double, 2> start{{0.0, 0.0}}, end{{15.25, 15.25}};
@@ -208,3 +304,162 @@ class Histogram2Test :
             }
         }
 } histogram_2_test;
+
+class GridHistogramTest :
+    public TestCase
+{
+    public:
+        GridHistogramTest() :
+            TestCase("grid_histogram_test")
+        {
+        }
+
+        static std::map<std::vector<unsigned>, double> _bins(const GridHistogram & histogram)
+        {
+            std::map<std::vector<unsigned>, double> result;
+            histogram.visit([&result] (const std::vector<unsigned> & indices, const double & value) { result[indices] = value; });
+
+            return result;
+        }
+
+        virtual void run() const
+        {
+            const std::vector<GridHistogram::Axis> axes
+            {
+                GridHistogram::Axis(0.0, 1.0, 10),
+                GridHistogram::Axis(-1.0, 1.0, 4),
+                GridHistogram::Axis(0.0, 3.0, 3)
+            };
+
+            // Test insertion and retrieval
+            for (auto storage : { GridHistogram::Storage::dense, GridHistogram::Storage::sparse })
+            {
+                GridHistogram histogram(axes, storage);
+
+                double p1[3] = { 0.05, -0.9, 2.5 };
+                double p2[3] = { 0.95, 0.99, 0.0 };
+                double p3[3] = { 1.0, 0.0, 0.0 };
+                double p4[3] = { 0.5, std::numeric_limits<double>::quiet_NaN(), 0.0 };
+
+                TEST_CHECK(histogram.insert(p1));
+                TEST_CHECK(histogram.insert(p1, 2.0));
+                TEST_CHECK(histogram.insert(p2, 0.5));
+                TEST_CHECK(! histogram.insert(p3));
+                TEST_CHECK(! histogram.insert(p4));
+
+                TEST_CHECK_EQUAL(histogram.entries(), 3);
+                TEST_CHECK_EQUAL(histogram.outside(), 2);
+                TEST_CHECK_EQUAL(histogram.value({ 0, 0, 2 }), 3.0);
+                TEST_CHECK_EQUAL(histogram.value({ 9, 3, 0 }), 0.5);
+                TEST_CHECK_EQUAL(histogram.value({ 9, 3, 1 }), 0.0);
+                TEST_CHECK_THROWS(InternalError, histogram.value({ 10, 0, 0 }));
+
+                auto bins = _bins(histogram);
+                TEST_CHECK_EQUAL(bins.size(), 2);
+                TEST_CHECK_EQUAL((bins[std::vector<unsigned>{ 0, 0, 2 }]), 3.0);
+                TEST_CHECK_EQUAL((bins[std::vector<unsigned>{ 9, 3, 0 }]), 0.5);
+            }
+
+            // Test merging
+            for (auto storage : { GridHistogram::Storage::dense, GridHistogram::Storage::sparse })
+            {
+                std::vector<GridHistogram> histograms;
+                for (unsigned i = 0 ; i < 7 ; ++i)
+                {
+                    histograms.push_back(GridHistogram(axes, storage));
+
+                    for (unsigned j = 0 ; j <= i ; ++j)
+                    {
+                        double point[3] = { 0.1 * j + 0.05, -0.5, 1.5 };
+                        histograms.back().insert(point);
+                    }
+                }
+
+                GridHistogram result = GridHistogram::merge(histograms);
+                TEST_CHECK_EQUAL(result.entries(), 28);
+                for (unsigned j = 0 ; j < 7 ; ++j)
+                {
+                    TEST_CHECK_EQUAL(result.value({ j, 1, 1 }), 7.0 - j);
+                }
+
+                // the inputs remain unchanged
+                TEST_CHECK_EQUAL(histograms.front().entries(), 1);
+
+                GridHistogram copy = histograms.front().clone();
+                copy.merge(histograms.back());
+                TEST_CHECK_EQUAL(copy.entries(), 8);
+                TEST_CHECK_EQUAL(copy.value({ 0, 1, 1 }), 2.0);
+                TEST_CHECK_EQUAL(histograms.front().value({ 0, 1, 1 }), 1.0);
+
+                GridHistogram other(std::vector<GridHistogram::Axis>{ GridHistogram::Axis(0.0, 1.0, 10) }, storage);
+                TEST_CHECK_THROWS(InternalError, copy.merge(other));
+            }
+
+            // Test filling from a Markov chain's history
+            for (auto storage : { GridHistogram::Storage::dense, GridHistogram::Storage::sparse })
+            {
+                MarkovChain::History history;
+                for (unsigned i = 0 ; i < 50000 ; ++i)
+                {
+                    MarkovChain::State state;
+                    state.point = std::vector<double>{ (i % 10) * 0.1 + 0.05, 7.0, (i % 3) * 1.0 + 0.5 };
+                    history.states.push_back(state);
+                }
+
+                GridHistogram histogram(std::vector<GridHistogram::Axis>{ axes[2], axes[0] }, storage);
+                histogram.fill(history, std::vector<unsigned>{ 2, 0 });
+                TEST_CHECK_EQUAL(histogram.entries(), 50000);
+                TEST_CHECK_EQUAL(histogram.outside(), 0);
+
+                double total = 0.0;
+                histogram.visit([&total] (const std::vector<unsigned> &, const double & value) { total += value; });
+                TEST_CHECK_EQUAL(total, 50000.0);
+
+                // i % 10 == 0 and i % 3 == 0 for i % 30 == 0
+                TEST_CHECK_EQUAL(histogram.value({ 0, 0 }), 1667.0);
+
+                TEST_CHECK_THROWS(InternalError, histogram.fill(history, std::vector<unsigned>{ 3, 0 }));
+            }
+
+            // Test filling from a data set of samples
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/histogram_TEST-fill.hdf5");
+
+                hdf5::Array<1, double> sample_type
+                {
+                    "samples",
+                    { 3 },
+                };
+
+                {
+                    hdf5::File file = hdf5::File::Create(file_name);
+                    auto data_set = file.create_data_set("/data/samples", sample_type);
+
+                    std::vector<double> record(3);
+                    for (unsigned i = 0 ; i < 10000 ; ++i)
+                    {
+                        record[0] = (i % 4) * 0.25 + 0.1;
+                        record[1] = 17.0;
+                        record[2] = (i % 2) ? 0.5 : 1.5;
+                        data_set << record;
+                    }
+                }
+
+                hdf5::File file = hdf5::File::Open(file_name);
+                auto data_set = file.open_data_set("/data/samples", sample_type);
+
+                GridHistogram histogram(std::vector<GridHistogram::Axis>{ GridHistogram::Axis(0.0, 1.0, 4) });
+                histogram.fill(data_set, std::vector<unsigned>{ 0 }, 2);
+                TEST_CHECK_EQUAL(histogram.entries(), 10000);
+                TEST_CHECK_NEARLY_EQUAL(histogram.value({ 0 }), 2500 * 1.5, 1e-10);
+                TEST_CHECK_NEARLY_EQUAL(histogram.value({ 1 }), 2500 * 0.5, 1e-10);
+
+                GridHistogram outside(std::vector<GridHistogram::Axis>{ GridHistogram::Axis(0.0, 1.0, 4) }, GridHistogram::Storage::sparse);
+                outside.fill(data_set, std::vector<unsigned>{ 1 });
+                TEST_CHECK_EQUAL(outside.entries(), 0);
+                TEST_CHECK_EQUAL(outside.outside(), 10000);
+
+                TEST_CHECK_THROWS(InternalError, histogram.fill(data_set, std::vector<unsigned>{ 3 }));
+            }
+        }
+} grid_histogram_test;
@@ -24,7 +24,10 @@
 #include <eos/utils/observable_cache.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
+#include <eos/utils/trace.hh>
 #include <eos/utils/verify.hh>
+#include <eos/utils/wilson-polynomial.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <algorithm>
@@ -1238,10 +1241,39 @@ namespace eos
         // Container for all named constraints
         std::vector<Constraint> constraints;
 
+        // Wilson coefficients for polynomial surrogates; none if surrogates are not used
+        std::list<std::string> surrogate_coefficients;
+
+        double surrogate_tolerance;
+
         Implementation(const Parameters & parameters) :
             parameters(parameters),
-            cache(parameters)
+            cache(parameters),
+            surrogate_tolerance(0.0)
+        {
+        }
+
+        void make_surrogates()
         {
+            if (surrogate_coefficients.empty())
+                return;
+
+            unsigned replaced = 0;
+            for (ObservableCache::Id id = 0 ; id < cache.size() ; ++id)
+            {
+                ObservablePtr observable = cache.observable(id);
+                if (std::dynamic_pointer_cast<WilsonPolynomialSurrogate>(observable))
+                    continue;
+
+                cache.replace(id, ObservablePtr(new WilsonPolynomialSurrogate(observable, surrogate_coefficients, surrogate_tolerance)));
+                ++replaced;
+            }
+
+            if (0 != replaced)
+            {
+                Log::instance()->message("log_likelihood.make_surrogates", ll_debug)
+                    << "Replaced " << replaced << " observables by polynomial surrogates";
+            }
         }
 
         std::pair<double, double>
@@ -1277,8 +1309,8 @@ namespace eos
             // test value
             double t;
 
-            gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
-            gsl_rng_set(rng, datasets);
+            RandomStream stream(datasets, "bootstrap-p-value");
+            gsl_rng * rng = stream.rng();
 
             Log::instance()->message("log_likelihood.bootstrap_pvalue", ll_informational)
                                      << "Begin sampling " << datasets << " simulated "
@@ -1314,8 +1346,6 @@ namespace eos
                                      << "The simulated p-value is " << p
                                      << " with uncertainty " << uncertainty;
 
-            gsl_rng_free(rng);
-
             return std::make_pair(p, uncertainty);
         }
 
@@ -1326,6 +1356,8 @@ namespace eos
             // loop over all likelihood blocks
             for (auto c = constraints.cbegin(), c_end = constraints.cend() ; c != c_end ; ++c)
             {
+                ScopedTimer timer("constraint", c->name().full());
+
                 for (auto b = c->begin_blocks(), b_end = c->end_blocks() ; b != b_end ; ++b)
                 {
                     double llh = (*b)->evaluate();
@@ -1356,6 +1388,8 @@ namespace eos
         LogLikelihoodBlockPtr b = LogLikelihoodBlock::Gaussian(_imp->cache, observable, min, central, max, number_of_observations);
         _imp->constraints.push_back(
             Constraint(observable->name(), std::vector<ObservablePtr>{ observable }, std::vector<LogLikelihoodBlockPtr>{ b }));
+
+        _imp->make_surrogates();
     }
 
     void
@@ -1374,6 +1408,8 @@ namespace eos
 
         // retain a proper copy of the constraint to iterate over
         _imp->constraints.push_back(Constraint(constraint.name(), observables, blocks));
+
+        _imp->make_surrogates();
     }
 
     LogLikelihood::ConstraintIterator
@@ -1399,6 +1435,8 @@ namespace eos
     {
         LogLikelihood result(_imp->parameters.clone());
         result._imp->cache = _imp->cache.clone(result._imp->parameters);
+        result._imp->surrogate_coefficients = _imp->surrogate_coefficients;
+        result._imp->surrogate_tolerance = _imp->surrogate_tolerance;
 
         for (auto c = _imp->constraints.cbegin(), c_end = _imp->constraints.cend() ; c != c_end ; ++c)
         {
@@ -1408,6 +1446,61 @@ namespace eos
         return result;
     }
 
+    void
+    LogLikelihood::use_polynomial_surrogates(const std::list<std::string> & coefficients, const double & tolerance)
+    {
+        if (coefficients.empty())
+            throw InternalError("LogLikelihood::use_polynomial_surrogates: Need at least one Wilson coefficient");
+
+        if (! _imp->surrogate_coefficients.empty())
+            throw InternalError("LogLikelihood::use_polynomial_surrogates: Polynomial surrogates are already in use");
+
+        if (_imp->cache.parallel_update())
+        {
+            Log::instance()->message("log_likelihood.use_polynomial_surrogates", ll_warning)
+                << "Disabling parallel evaluation of the observables in favour of polynomial surrogates";
+
+            _imp->cache.enable_parallel_update(false);
+        }
+
+        _imp->surrogate_coefficients = coefficients;
+        _imp->surrogate_tolerance = tolerance;
+        _imp->make_surrogates();
+    }
+
+    double
+    LogLikelihood::polynomial_surrogates_max_deviation() const
+    {
+        double result = 0.0;
+
+        for (auto o = _imp->cache.begin(), o_end = _imp->cache.end() ; o != o_end ; ++o)
+        {
+            auto surrogate = std::dynamic_pointer_cast<WilsonPolynomialSurrogate>(*o);
+            if (! surrogate)
+                continue;
+
+            result = std::max(result, surrogate->max_deviation());
+        }
+
+        return result;
+    }
+
+    bool
+    LogLikelihood::enable_parallel_evaluation(const bool & enabled)
+    {
+        if (enabled && (! _imp->surrogate_coefficients.empty()))
+        {
+            Log::instance()->message("log_likelihood.enable_parallel_evaluation", ll_warning)
+                << "Parallel evaluation of the observables is not available in conjunction with polynomial surrogates";
+
+            return false;
+        }
+
+        _imp->cache.enable_parallel_update(enabled);
+
+        return enabled;
+    }
+
     unsigned
     LogLikelihood::number_of_observations() const
     {
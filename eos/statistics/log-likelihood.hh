@@ -35,6 +35,7 @@
 #include <gsl/gsl_vector.h>
 
 #include <cmath>
+#include <list>
 
 namespace eos
 {
@@ -374,6 +375,36 @@ namespace eos
              */
             LogLikelihood clone() const;
 
+            /*!
+             * Replace all observables, including those of constraints that are added later on, by
+             * polynomial surrogates in the given Wilson coefficients, cf. WilsonPolynomialSurrogate.
+             *
+             * The polynomials are rebuilt whenever any other parameter that an observable uses changes.
+             * Hence, this pays off when only the Wilson coefficients are varied, e.g., in scans or fits with
+             * fixed nuisance parameters. Observables that fail validation are evaluated exactly.
+             *
+             * @param coefficients The names of the Wilson coefficients.
+             * @param tolerance    The maximal relative deviation between polynomial and observable that is accepted upon validation.
+             */
+            void use_polynomial_surrogates(const std::list<std::string> & coefficients, const double & tolerance = 1.0e-6);
+
+            /*!
+             * Retrieve the largest relative deviation between any polynomial surrogate and its
+             * underlying observable found during validation so far.
+             */
+            double polynomial_surrogates_max_deviation() const;
+
+            /*!
+             * Enable or disable the parallel evaluation of the observables, cf. ObservableCache::enable_parallel_update.
+             *
+             * Since polynomial surrogates modify the Wilson coefficients while being rebuilt, parallel evaluation
+             * is not available in conjunction with use_polynomial_surrogates().
+             *
+             * @param enabled Whether the observables shall be evaluated in parallel.
+             * @return Whether the observables are evaluated in parallel.
+             */
+            bool enable_parallel_evaluation(const bool & enabled = true);
+
             /*!
              * The number of independent observations used in the likelihood.
              * @note This may differ from the number of observables in case
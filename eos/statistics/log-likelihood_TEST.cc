@@ -111,6 +111,34 @@ namespace eos
                     TEST_CHECK_NEARLY_EQUAL(llh2(), -3.116353440210579, eps);
                 }
 
+                // polynomial surrogates
+                {
+                    LogLikelihood llh(p);
+                    llh.add(ObservablePtr(new ObservableStub(p, "b->smumu::Re{c9}", k)), +3.9, +4.0, +4.1);
+                    llh.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)", k)), +4.2, +4.3, +4.4);
+                    llh.use_polynomial_surrogates(std::list<std::string>{ "b->smumu::Re{c9}", "b->smumu::Re{c10}" });
+
+                    p["b->smumu::Re{c9}"] = 4.1;
+                    p["mass::b(MSbar)"] = 4.2;
+                    TEST_CHECK_NEARLY_EQUAL(llh(), 2 * 0.88364655978937656, 1e-12);
+
+                    // changes to the Wilson coefficient use the polynomial
+                    p["b->smumu::Re{c9}"] = 3.9;
+                    TEST_CHECK_NEARLY_EQUAL(llh(), 2 * 0.88364655978937656, 1e-12);
+
+                    // changes to other parameters trigger a rebuild
+                    p["mass::b(MSbar)"] = 4.4;
+                    TEST_CHECK_NEARLY_EQUAL(llh(), 2 * 0.88364655978937656, 1e-12);
+
+                    // surrogates persist when cloning
+                    LogLikelihood clone = llh.clone();
+                    TEST_CHECK_NEARLY_EQUAL(clone(), 2 * 0.88364655978937656, 1e-12);
+
+                    TEST_CHECK(llh.polynomial_surrogates_max_deviation() < 1e-12);
+
+                    p["b->smumu::Re{c9}"] = p["b->smumu::Re{c9}"].central();
+                }
+
                 // iteration
                 {
                     std::cout << "FOO" << std::endl;
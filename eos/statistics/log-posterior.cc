@@ -259,6 +259,40 @@ namespace eos
        }
    }
 
+   void
+   LogPosterior::dump_profile(hdf5::File & file, const std::string & data_set_base) const
+   {
+       const ObservableCache & cache = _log_likelihood.observable_cache();
+       if (! cache.profiling())
+           return;
+
+       auto data_set = file.create_data_set(data_set_base + "/profile", LogPosterior::Output::profile_type());
+       auto record = LogPosterior::Output::profile_record();
+
+       // without local string variables, can get random data in char *
+       std::string name, kinematics, options;
+
+       const unsigned & n_observables = cache.size();
+       for (unsigned i = 0 ; i < n_observables ; ++i)
+       {
+           const ObservablePtr & observable = cache.observable(i);
+           const ObservableProfile & profile = cache.profile(i);
+
+           name = observable->name().full();
+           kinematics = observable->kinematics().as_string();
+           options = observable->options().as_string();
+
+           std::get<0>(record) = name.c_str();
+           std::get<1>(record) = kinematics.c_str();
+           std::get<2>(record) = options.c_str();
+           std::get<3>(record) = profile.calls;
+           std::get<4>(record) = profile.total;
+           std::get<5>(record) = profile.last;
+
+           data_set << record;
+       }
+   }
+
    std::vector<ParameterDescription>
    LogPosterior::read_descriptions(const hdf5::File & file, std::string data_set_base)
    {
@@ -807,6 +841,28 @@ namespace eos
         return std::make_tuple("name", 1.0, 2.0, 3, "prior");
     }
 
+    LogPosterior::Output::ProfileType
+    LogPosterior::Output::profile_type()
+    {
+        return
+        ProfileType
+        {
+         "observable profile",
+         hdf5::Scalar<const char *>("name"),
+         hdf5::Scalar<const char *>("kinematics"),
+         hdf5::Scalar<const char *>("options"),
+         hdf5::Scalar<unsigned long>("calls"),
+         hdf5::Scalar<double>("total"),
+         hdf5::Scalar<double>("last"),
+        };
+    }
+
+    std::tuple<const char *, const char *, const char *, unsigned long, double, double>
+    LogPosterior::Output::profile_record()
+    {
+        return std::make_tuple("name", "kinematics", "options", 0ul, 1.0, 2.0);
+    }
+
     std::vector<double>
     proposal_covariance(const LogPosterior & log_posterior,
                         double scale_reduction,
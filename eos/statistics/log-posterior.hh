@@ -122,6 +122,12 @@ namespace eos
              */
             virtual void dump_descriptions(hdf5::File & file, const std::string & data_set_base) const;
 
+            /*!
+             * Write the timings of all observables into the hdf5 file under the given group name,
+             * provided that profiling is enabled for the log(likelihood)'s ObservableCache.
+             */
+            virtual void dump_profile(hdf5::File & file, const std::string & data_set_base) const;
+
             /*!
              * Read in parameter descriptions from a previous dump.
              *
@@ -315,6 +321,11 @@ namespace eos
                                  hdf5::Scalar<int>, hdf5::Scalar<const char *>> DescriptionType;
          static DescriptionType description_type();
          static std::tuple<const char *, double, double, int, const char *> description_record();
+
+         typedef hdf5::Composite<hdf5::Scalar<const char *>, hdf5::Scalar<const char *>, hdf5::Scalar<const char *>,
+                                 hdf5::Scalar<unsigned long>, hdf5::Scalar<double>, hdf5::Scalar<double>> ProfileType;
+         static ProfileType profile_type();
+         static std::tuple<const char *, const char *, const char *, unsigned long, double, double> profile_record();
      };
 
      /*!
@@ -23,13 +23,18 @@
 #include <eos/statistics/log-posterior.hh>
 #include <eos/statistics/markov-chain-sampler.hh>
 #include <eos/statistics/rvalue.hh>
+#include <eos/utils/condition_variable.hh>
 #include <eos/utils/hdf5.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
 #include <eos/utils/thread_pool.hh>
 
 #include <algorithm>
+#include <cstdio>
 #include <map>
 #include <limits>
 #include <sys/stat.h>
@@ -60,10 +65,62 @@ namespace eos
 
         ChainGroup::RValueFunction compute_rvalue;
 
+        // statistics of all chains within one chunk of the main run
+        struct ChunkStatistics
+        {
+            std::vector<std::vector<double>> means;
+
+            std::vector<std::vector<double>> variances;
+
+            unsigned completed;
+        };
+
+        // guards the output file and the statistics of the asynchronous main run
+        Mutex main_run_mutex;
+
+        ConditionVariable main_run_finished;
+
+        std::vector<ChunkStatistics> chunk_statistics;
+
+        unsigned finished_chains;
+
+        // the phases of the sampling, as stored in checkpoints
+        enum Phase
+        {
+            prerun_phase = 0,
+            main_run_phase = 1
+        };
+
+        // the progress as restored from a checkpoint
+        Phase phase;
+
+        unsigned completed_chunks;
+
+        // phase, number of chains, prerun information, and completed chunks of the main run
+        typedef hdf5::Composite<hdf5::Scalar<unsigned>, hdf5::Scalar<unsigned>, hdf5::Scalar<int>, hdf5::Scalar<unsigned>,
+                hdf5::Scalar<unsigned>, hdf5::Scalar<double>, hdf5::Scalar<unsigned>> CheckpointType;
+
+        static CheckpointType checkpoint_type()
+        {
+            return CheckpointType
+            {
+                "checkpoint",
+                hdf5::Scalar<unsigned>("phase"),
+                hdf5::Scalar<unsigned>("number of chains"),
+                hdf5::Scalar<int>("prerun converged"),
+                hdf5::Scalar<unsigned>("prerun iterations"),
+                hdf5::Scalar<unsigned>("prerun iterations at convergence"),
+                hdf5::Scalar<double>("prerun R-value of posterior"),
+                hdf5::Scalar<unsigned>("main run chunks"),
+            };
+        }
+
         Implementation(const DensityPtr & density, const MarkovChainSampler::Config & config) :
             density(density),
             config(config),
-            compute_rvalue(config.use_strict_rvalue_definition ? &RValue::gelman_rubin : &RValue::approximation)
+            compute_rvalue(config.use_strict_rvalue_definition ? &RValue::gelman_rubin : &RValue::approximation),
+            phase(prerun_phase),
+            completed_chunks(0)
         {
             initialize();
         }
@@ -216,16 +273,11 @@ namespace eos
         }
 
         void check_rvalues_main()
-         {
+        {
             if (chains.size() < 2)
                 return;
 
-            Log::instance()->message("markov_chain_sampler.convergence", ll_informational)
-                << "Checking R-values for the last chunk of size " << config.chunk_size;
-
-             bool all_rvalues_small = true;
-
-             // calculate statistics
+            // calculate statistics
             std::vector<std::vector<double>> all_chains_means;
             std::vector<std::vector<double>> all_chains_variances;
             for (auto c = chains.begin(), c_end = chains.end() ; c != c_end; ++c)
@@ -237,38 +289,50 @@ namespace eos
                 all_chains_variances.push_back(variances);
             }
 
-             // loop over all parameters to check and get R-values
-             for (unsigned par = 0 ; par < number_of_parameters ; ++par)
-             {
-                 // keep subset of chain statistics for single parameter in here
-                 std::vector<double> chain_means, chain_variances;
+            check_rvalues_main(all_chains_means, all_chains_variances);
+        }
+
+        void check_rvalues_main(const std::vector<std::vector<double>> & all_chains_means, const std::vector<std::vector<double>> & all_chains_variances)
+        {
+            if (chains.size() < 2)
+                return;
 
-                 // read out statistics
-                 for (unsigned c = 0 ; c < chains.size() ;  ++c)
-                 {
-                     chain_means.push_back(all_chains_means[c][par]);
-                     chain_variances.push_back(all_chains_variances[c][par]);
-                 }
+            Log::instance()->message("markov_chain_sampler.convergence", ll_informational)
+                << "Checking R-values for the last chunk of size " << config.chunk_size;
+
+            bool all_rvalues_small = true;
 
-                 double rvalue = compute_rvalue(chain_means, chain_variances, config.chunk_size);
+            // loop over all parameters to check and get R-values
+            for (unsigned par = 0 ; par < number_of_parameters ; ++par)
+            {
+                // keep subset of chain statistics for single parameter in here
+                std::vector<double> chain_means, chain_variances;
+
+                // read out statistics
+                for (unsigned c = 0 ; c < chains.size() ;  ++c)
+                {
+                    chain_means.push_back(all_chains_means[c][par]);
+                    chain_variances.push_back(all_chains_variances[c][par]);
+                }
 
-                 if (rvalue > config.rvalue_criterion_param || std::isnan(rvalue))
-                 {
-                     all_rvalues_small = false;
+                double rvalue = compute_rvalue(chain_means, chain_variances, config.chunk_size);
 
-                     Log::instance()->message("markov_chain_sampler.main_run", ll_informational)
-                         << "R-value of parameter '" << chains.front().parameter_descriptions()[par].parameter->name() << "' is too large: "
-                         << rvalue << " > " << config.rvalue_criterion_param;
-                 }
-             }
+                if (rvalue > config.rvalue_criterion_param || std::isnan(rvalue))
+                {
+                    all_rvalues_small = false;
 
-             if (all_rvalues_small)
-             {
-                 Log::instance()->message("markov_chain_sampler.main_run", ll_informational)
-                     << "All R-values OK";
-             }
-         }
+                    Log::instance()->message("markov_chain_sampler.main_run", ll_informational)
+                        << "R-value of parameter '" << chains.front().parameter_descriptions()[par].parameter->name() << "' is too large: "
+                        << rvalue << " > " << config.rvalue_criterion_param;
+                }
+            }
 
+            if (all_rvalues_small)
+            {
+                Log::instance()->message("markov_chain_sampler.main_run", ll_informational)
+                    << "All R-values OK";
+            }
+        }
 
         /*
          * Dump MCMC samples and proposal density state to HDF5 file.
@@ -290,6 +354,134 @@ namespace eos
             }
         }
 
+        /*
+         * Dump the timings of each chain's observables to HDF5 file, if profiling is enabled.
+         */
+        void dump_profile()
+        {
+            hdf5::File file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
+
+            unsigned i = 0;
+            for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c, ++i)
+            {
+                // a run that is resumed after its completion has stored its profile already
+                if (file.group_exists("/profile/chain #" + stringify(i)))
+                    continue;
+
+                c->dump_profile(file, "/profile/chain #" + stringify(i));
+            }
+        }
+
+        /*
+         * Store the state of the sampler and of all chains in the checkpoint file.
+         * The checkpoint is first written to a temporary file, which then replaces the previous
+         * checkpoint, such that an interruption never leaves an incomplete checkpoint behind.
+         */
+        void write_checkpoint(const Phase & current_phase, const unsigned & chunks)
+        {
+            if (config.checkpoint_file.empty())
+                return;
+
+            const std::string temporary_file = config.checkpoint_file + ".tmp";
+
+            {
+                hdf5::File file = hdf5::File::Create(temporary_file);
+
+                auto data_set = file.create_data_set("/sampler/state", checkpoint_type());
+                auto record = std::make_tuple(unsigned(current_phase), unsigned(chains.size()), int(pre_run_info.converged),
+                        pre_run_info.iterations, pre_run_info.iterations_at_convergence, pre_run_info.rvalue_posterior, chunks);
+                data_set << record;
+
+                auto data_set_rvalues = file.create_data_set("/sampler/rvalues", hdf5::Array<1, double>("rvalues", { number_of_parameters }));
+                data_set_rvalues << pre_run_info.rvalue_parameters;
+
+                for (unsigned c = 0 ; c < chains.size() ; ++c)
+                {
+                    chains[c].dump_checkpoint(file, "/chain #" + stringify(c));
+                }
+            }
+
+            if (0 != std::rename(temporary_file.c_str(), config.checkpoint_file.c_str()))
+                throw InternalError("MarkovChainSampler: Could not replace the checkpoint '" + config.checkpoint_file
+                        + "' by '" + temporary_file + "'");
+
+            Log::instance()->message("markov_chain_sampler.checkpoint", ll_debug)
+                << "Stored checkpoint in " << config.checkpoint_file;
+        }
+
+        /*
+         * Restore the state of the sampler and of all chains from the checkpoint file, if so requested.
+         *
+         * @return true, if the state has been restored.
+         */
+        bool read_checkpoint()
+        {
+            if (config.checkpoint_file.empty() || ! config.resume || ! hdf5::File::Exists(config.checkpoint_file))
+                return false;
+
+            hdf5::File file = hdf5::File::Open(config.checkpoint_file, H5F_ACC_RDONLY);
+
+            auto data_set = file.open_data_set("/sampler/state", checkpoint_type());
+            auto record = std::make_tuple(0u, 0u, 0, 0u, 0u, 0.0, 0u);
+            data_set >> record;
+
+            if (std::get<1>(record) != chains.size())
+                throw InternalError("MarkovChainSampler: Cannot resume from checkpoint '" + config.checkpoint_file + "' with "
+                        + stringify(std::get<1>(record)) + " chains, while " + stringify(chains.size()) + " chains are configured");
+
+            phase = Phase(std::get<0>(record));
+            pre_run_info.converged = std::get<2>(record);
+            pre_run_info.iterations = std::get<3>(record);
+            pre_run_info.iterations_at_convergence = std::get<4>(record);
+            pre_run_info.rvalue_posterior = std::get<5>(record);
+            completed_chunks = std::get<6>(record);
+
+            auto data_set_rvalues = file.open_data_set("/sampler/rvalues", hdf5::Array<1, double>("rvalues", { number_of_parameters }));
+            data_set_rvalues >> pre_run_info.rvalue_parameters;
+
+            for (unsigned c = 0 ; c < chains.size() ; ++c)
+            {
+                chains[c].read_checkpoint(file, "/chain #" + stringify(c));
+            }
+
+            Log::instance()->message("markov_chain_sampler.checkpoint", ll_informational)
+                << "Resuming from checkpoint " << config.checkpoint_file << " after "
+                << (prerun_phase == phase ? stringify(pre_run_info.iterations) + " iterations of the pre-run"
+                                          : stringify(completed_chunks) + " chunks of the main run");
+
+            return true;
+        }
+
+        /*
+         * Discard all output that has been stored after the last checkpoint was written.
+         */
+        void truncate_output()
+        {
+            hdf5::File file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
+
+            const unsigned updates = config.store_prerun ? pre_run_info.iterations / config.prerun_iterations_update : 0;
+            const unsigned chunks = (config.store && (main_run_phase == phase)) ? completed_chunks : 0;
+
+            for (unsigned c = 0 ; c < chains.size() ; ++c)
+            {
+                const std::string prerun_group = "/prerun/chain #" + stringify(c);
+                if (file.group_exists(prerun_group))
+                {
+                    file.truncate(prerun_group + "/samples", updates * config.prerun_iterations_update);
+                    file.truncate(prerun_group + "/stats", updates);
+                    file.truncate(prerun_group + "/proposal", updates);
+                }
+
+                const std::string main_run_group = "/main run/chain #" + stringify(c);
+                if (file.group_exists(main_run_group))
+                {
+                    file.truncate(main_run_group + "/samples", chunks * config.chunk_size);
+                    file.truncate(main_run_group + "/stats", chunks);
+                    file.truncate(main_run_group + "/proposal", chunks);
+                }
+            }
+        }
+
         // common method to call from multiple constructors
         void initialize()
         {
@@ -313,9 +505,32 @@ namespace eos
                 }
             }
 
-            // create independent chains -> different seeds
-            gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
-            gsl_rng_set(rng, config.seed);
+            // evaluate the likelihood in parallel within each chain, if threads would be idle otherwise
+            if (config.parallelize && config.parallelize_within_chains
+                    && (config.number_of_chains < ThreadPool::instance()->number_of_threads()))
+            {
+                if (std::dynamic_pointer_cast<LogPosterior>(density))
+                {
+                    // leave the caller's density untouched; the chains inherit the setting when cloning
+                    density = density->clone();
+                    if (std::static_pointer_cast<LogPosterior>(density)->log_likelihood().enable_parallel_evaluation())
+                    {
+                        Log::instance()->message("markov_chain_sampler.initialize", ll_informational)
+                            << "Evaluating the likelihood in parallel within each chain";
+                    }
+                }
+                else
+                {
+                    Log::instance()->message("markov_chain_sampler.initialize", ll_warning)
+                        << "Parallel evaluation within chains is only available for densities of type LogPosterior";
+                }
+            }
+
+            if (config.delayed_rejection && (config.multiple_tries > 1))
+                throw InternalError("MarkovChainSampler: Delayed rejection cannot be combined with multiple-try Metropolis");
+
+            // evaluate the multiple tries in parallel within each chain, unless the chains already occupy all threads
+            const bool parallel_tries = (! config.parallelize) || (config.number_of_chains < ThreadPool::instance()->number_of_threads());
 
             /* setup chains */
 
@@ -358,10 +573,12 @@ namespace eos
                                                                             config.scale_automatic));
                 }
 
-                MarkovChain chain(density, config.seed + c, prop);
+                // create independent chains -> one random number stream per chain
+                MarkovChain chain(density, RandomStream(config.seed, "markov-chain", c), prop);
+                chain.delayed_rejection(config.delayed_rejection, config.delayed_rejection_scale);
+                chain.multiple_tries(config.multiple_tries, parallel_tries);
                 chains.push_back(chain);
             }
-            gsl_rng_free(rng);
 
             // setup prerun info
             pre_run_info =
@@ -376,31 +593,38 @@ namespace eos
         /*
          * Collect samples from posterior and check for convergence.
          */
-        void pre_run()
+        void pre_run(const bool & resumed)
         {
             Log::instance()->message("markov_chain_sampler.prerun_start", ll_informational)
                 << "Commencing the pre-run with " << config.prerun_iterations_min << ", "
                 << config.prerun_iterations_max << ", " << config.prerun_iterations_update
                 << " (min, max, update) iterations.";
 
-            // write parameter descriptions
+            // write parameter descriptions, unless they have been written before the last checkpoint
             {
                 auto file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
                 for (unsigned i = 0; i < chains.size(); ++i)
                 {
+                    if (file.group_exists("/descriptions/prerun/chain #" + stringify(i)))
+                        continue;
+
                     density->dump_descriptions(file, "/descriptions/prerun/chain #" + stringify(i));
                 }
             }
 
-            // require:chains are initialized
-            pre_run_info.converged = false;
-            pre_run_info.iterations = 0;
-
-            // set up chains
-            for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c)
+            // the chains and the prerun info have been restored from a checkpoint
+            if (! resumed)
             {
-                // save history
-                c->keep_history(true);
+                // require:chains are initialized
+                pre_run_info.converged = false;
+                pre_run_info.iterations = 0;
+
+                // set up chains
+                for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c)
+                {
+                    // save history
+                    c->keep_history(true);
+                }
             }
 
             // keep going till maxIter or  break when convergence estimated
@@ -447,6 +671,8 @@ namespace eos
 
                 Log::instance()->message("markov_chain_sampler.prerun_progress", ll_informational)
                     << "Pre-run has completed " << pre_run_info.iterations << " iterations";
+
+                write_checkpoint(prerun_phase, 0);
             }
 
             if (pre_run_info.converged)
@@ -475,12 +701,20 @@ namespace eos
          * It is assumed that chains, including their proposal,
          * are set up already.
          */
-        void main_run()
+        void main_run(const unsigned & first_chunk)
         {
             Log::instance()->message("markov_chain_sampler.mainrun_start", ll_informational)
                 << "Commencing the main-run";
 
-            for (unsigned chunk = 0 ; chunk < config.chunks ; ++chunk)
+            // checkpoints require all chains to complete the same chunk
+            if (config.parallelize && config.checkpoint_file.empty())
+            {
+                main_run_asynchronously();
+
+                return;
+            }
+
+            for (unsigned chunk = first_chunk ; chunk < config.chunks ; ++chunk)
             {
 
                 // start with empty ticket queue
@@ -535,28 +769,149 @@ namespace eos
                     c->clear();
                 }
 
+                write_checkpoint(main_run_phase, chunk + 1);
+            }
+            Log::instance()->message("markov_chain_sampler.mainrun_end", ll_informational)
+                << "Finished the main-run";
+        }
+
+        /*
+         * Run one chunk of the main run for a single chain, and schedule the chain's next chunk.
+         * Each chain proceeds independently; the R-values of a chunk are checked by the thread
+         * that completes the chunk's last chain.
+         */
+        void run_chunk(const unsigned & c, const unsigned & chunk)
+        {
+            MarkovChain & chain = chains[c];
+
+            chain.run(config.chunk_size);
+
+            std::vector<double> means, variances;
+            if (chain.history().states.size() >= config.chunk_size)
+            {
+                chain.history().mean_and_variance(chain.history().states.cend() - config.chunk_size, chain.history().states.cend(), means, variances);
+            }
+
+            {
+                Lock l(main_run_mutex);
+
+                if (config.store)
+                {
+                    hdf5::File file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
+                    chain.dump_history(file, "/main run/chain #" + stringify(c), config.chunk_size);
+                    chain.dump_proposal(file, "/main run/chain #" + stringify(c));
+                }
+
+                double efficiency = 1.0 * chain.statistics().iterations_accepted / (chain.statistics().iterations_accepted +  chain.statistics().iterations_rejected);
+
+                Log::instance()->message("markov_chain_sampler.mainrun_efficiencies", ll_debug)
+                        << "Current efficiency for chain " << c << " in chunk " << chunk << ": " << efficiency;
+
+                ChunkStatistics & statistics = chunk_statistics[chunk];
+                statistics.means[c].swap(means);
+                statistics.variances[c].swap(variances);
+
+                if (chains.size() == ++statistics.completed)
+                {
+                    Log::instance()->message("markov_chain_sampler.mainrun_progress", ll_informational)
+                        << "Main-run has completed " << (chunk + 1) * config.chunk_size << " iterations";
+
+                    // statistics are only available if the chains keep their history
+                    if (config.store)
+                        check_rvalues_main(statistics.means, statistics.variances);
+
+                    // release memory
+                    statistics = ChunkStatistics();
+                }
+            }
+
+            chain.clear();
+
+            if (chunk + 1 < config.chunks)
+            {
+                ThreadPool::instance()->enqueue(std::bind(&Implementation<MarkovChainSampler>::run_chunk, this, c, chunk + 1));
+
+                return;
             }
+
+            Lock l(main_run_mutex);
+            if (chains.size() == ++finished_chains)
+                main_run_finished.broadcast();
+        }
+
+        /*
+         * Main run without a barrier after each chunk.
+         */
+        void main_run_asynchronously()
+        {
+            if (0 == config.chunks)
+                return;
+
+            {
+                Lock l(main_run_mutex);
+
+                chunk_statistics.assign(config.chunks, ChunkStatistics{
+                    std::vector<std::vector<double>>(chains.size()),
+                    std::vector<std::vector<double>>(chains.size()),
+                    0 });
+                finished_chains = 0;
+            }
+
+            // enqueue the first chunk of each chain; subsequent chunks are enqueued once their predecessor
+            // completes, such that all chains progress even if there are more chains than threads
+            for (unsigned c = 0 ; c < chains.size() ; ++c)
+            {
+                ThreadPool::instance()->enqueue(std::bind(&Implementation<MarkovChainSampler>::run_chunk, this, c, 0u));
+            }
+
+            {
+                Lock l(main_run_mutex);
+                while (finished_chains < chains.size())
+                {
+                    main_run_finished.wait(main_run_mutex);
+                }
+            }
+
             Log::instance()->message("markov_chain_sampler.mainrun_end", ll_informational)
                 << "Finished the main-run";
         }
 
         void run()
         {
-            // overwrite file only if sampling is requested
-            setup_output();
+            // continue from the last checkpoint if so requested, and discard any output stored after it
+            const bool resumed = read_checkpoint();
 
-            if (config.need_prerun)
+            if (resumed)
             {
-                pre_run();
+                truncate_output();
+            }
+            else
+            {
+                // overwrite file only if sampling is requested
+                setup_output();
+            }
+
+            if (config.need_prerun && ! (resumed && (main_run_phase == phase)))
+            {
+                pre_run(resumed);
             }
 
             if (config.need_main_run)
             {
-                // set up chains
-                setup_main_run();
+                if (resumed && (main_run_phase == phase))
+                {
+                    main_run(completed_chunks);
+                }
+                else
+                {
+                    // set up chains
+                    setup_main_run();
 
-                main_run();
+                    main_run(0);
+                }
             }
+
+            dump_profile();
         }
 
         /*
@@ -578,6 +933,9 @@ namespace eos
                 auto file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
                 for (unsigned i = 0; i < chains.size(); ++i)
                 {
+                    if (file.group_exists("/descriptions/main run/chain #" + stringify(i)))
+                        continue;
+
                     density->dump_descriptions(file, "/descriptions/main run/chain #" + stringify(i));
                 }
             }
@@ -671,6 +1029,7 @@ namespace eos
         number_of_chains(1, std::numeric_limits<unsigned>::max(), 4),
         seed(0),
         parallelize(true),
+        parallelize_within_chains(false),
         min_efficiency(0, 1, 0.15), // incompatible with BAT defaults [0.15, 0.5]
         max_efficiency(0, 1, 0.35),
         rvalue_criterion_param(1, 100, 1.1),
@@ -685,12 +1044,16 @@ namespace eos
         proposal("MultivariateGaussian"),
         student_t_degrees_of_freedom(std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::max(), 1.0),
         store_prerun(true),
+        multiple_tries(1, std::numeric_limits<unsigned>::max(), 1),
+        delayed_rejection(false),
+        delayed_rejection_scale(std::numeric_limits<double>::epsilon(), 1.0 - std::numeric_limits<double>::epsilon(), 0.5),
         adapt_iterations(0),
         chunks(100),
         chunk_size(1000),
         need_main_run(true),
         skip_initial(0, 1, 0.1),
-        store(true)
+        store(true),
+        resume(false)
     {
     }
 
@@ -725,10 +1088,15 @@ namespace eos
                << "nchains = " << c.number_of_chains
                << ", seed = " << c.seed
                << ", parallelize = " << c.parallelize
+               << ", parallelize within chains = " << c.parallelize_within_chains
                << ", prerun min iterations = " << c.prerun_iterations_min << std::endl
                << ", prerun max iterations = " << c.prerun_iterations_max
                << ", prerun update iterations = " << c.prerun_iterations_update
-               << ", skip initial = " << c.skip_initial;
+               << ", skip initial = " << c.skip_initial << std::endl
+               << "Algorithm settings:" << std::endl
+               << "multiple tries = " << c.multiple_tries
+               << ", delayed rejection = " << c.delayed_rejection
+               << ", delayed rejection scale = " << c.delayed_rejection_scale;
         return stream;
     }
 }
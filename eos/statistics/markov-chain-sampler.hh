@@ -115,8 +115,20 @@ namespace eos
             /*!
              * If true, use as many threads as there are cores available.
              * If false, use only one thread.
+             *
+             * In the main run, each chain then proceeds from chunk to chunk independently of the
+             * other chains. The chains are scheduled dynamically, so there can be more chains than threads.
              */
             bool parallelize;
+
+            /*!
+             * If true and if there are fewer chains than threads, each chain evaluates
+             * the observables of its likelihood in parallel on the remaining threads.
+             *
+             * @note Only effective for densities of type LogPosterior, and only if
+             * parallelize is true.
+             */
+            bool parallelize_within_chains;
             ///@}
 
             ///@name Convergence options
@@ -174,6 +186,22 @@ namespace eos
             bool store_prerun;
             ///@}
 
+            ///@name Algorithm options
+            ///@{
+            /*!
+             * The number of candidates that each chain proposes per iteration, cf. MarkovChain::multiple_tries.
+             * The density is evaluated for all candidates in parallel, unless parallel chains already
+             * occupy all threads of the ThreadPool. A value of 1 selects the Metropolis-Hastings algorithm.
+             */
+            VerifiedRange<unsigned> multiple_tries;
+
+            /// Whether a rejected move is followed by a second, shrunk proposal, cf. MarkovChain::delayed_rejection.
+            bool delayed_rejection;
+
+            /// The factor by which the steps of the second proposal of delayed rejection are shrunk.
+            VerifiedRange<double> delayed_rejection_scale;
+            ///@}
+
             ///@name Main run options
             ///@{
 
@@ -199,6 +227,25 @@ namespace eos
             bool store;
             ///@}
 
+            ///@name Checkpoint options
+            ///@{
+            /*!
+             * The HDF5 file in which the state of the sampler is stored after each update of the prerun
+             * and after each chunk of the main run. If empty, no checkpoints are stored.
+             *
+             * @note With checkpoints, all chains complete each chunk of the main run before
+             * the next chunk commences.
+             */
+            std::string checkpoint_file;
+
+            /*!
+             * If true and if the checkpoint file exists, continue from the stored state, and discard
+             * all output that was stored after the checkpoint. The configuration must match the one
+             * of the interrupted run, in which case the output is identical to that of an uninterrupted run.
+             */
+            bool resume;
+            ///@}
+
             ///@name Output options
             ///@{
             /*!
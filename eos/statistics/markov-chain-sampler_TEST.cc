@@ -26,6 +26,11 @@
 #include <eos/statistics/proposal-functions.hh>
 #include <eos/utils/hdf5.hh>
 #include <eos/utils/power_of.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <cstdio>
+#include <fstream>
 
 using namespace test;
 using namespace eos;
@@ -48,6 +53,24 @@ void bin_data_set(hdf5::DataSet<T_ > & data_set, Histogram<1> & hist, const unsi
     }
 }
 
+std::vector<double> read_all_samples(const std::string & file_name, const std::string & data_set_name, const unsigned & dimension)
+{
+    auto f = hdf5::File::Open(file_name);
+    auto data_set = f.open_data_set(data_set_name, hdf5::Array<1, double>("samples", { dimension + 1 }));
+
+    std::vector<double> result(data_set.records() * (dimension + 1));
+    data_set.read_raw(0, data_set.records(), result.data());
+
+    return result;
+}
+
+void copy_file(const std::string & source, const std::string & destination)
+{
+    std::ifstream in(source, std::ios::binary);
+    std::ofstream out(destination, std::ios::binary);
+    out << in.rdbuf();
+}
+
 class MarkovChainSamplerTest :
     public TestCase
 {
@@ -84,6 +107,42 @@ class MarkovChainSamplerTest :
                 sampler.run();
             }
 
+            // more chains than threads, with asynchronous chunks in the main run
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_many-chains.hdf5");
+                std::remove(file_name.c_str());
+
+                LogPosterior log_posterior(make_log_posterior(true));
+
+                MarkovChainSampler::Config config = MarkovChainSampler::Config::Quick();
+                config.chunk_size = 100;
+                config.chunks = 3;
+                config.need_prerun = false;
+                config.number_of_chains = 2 * ThreadPool::instance()->number_of_threads() + 1;
+                config.output_file = file_name;
+                config.parallelize = true;
+                config.parallelize_within_chains = true;
+                config.proposal_initial_covariance = proposal_covariance(log_posterior, 2);
+                config.seed = 1346;
+                config.store = true;
+
+                MarkovChainSampler sampler(log_posterior.clone(), config);
+                sampler.run();
+
+                auto f = hdf5::File::Open(file_name);
+                hdf5::Array<1, double> sample_type
+                {
+                    "samples",
+                    { 1 + 1 },
+                };
+
+                for (unsigned c = 0 ; c < config.number_of_chains ; ++c)
+                {
+                    auto data_set = f.open_data_set("/main run/chain #" + stringify(c) + "/samples", sample_type);
+                    TEST_CHECK_EQUAL(data_set.records(), 300);
+                }
+            }
+
             // check pre run, main run and HDF5 storage
             {
                 static const std::string file_name(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST.hdf5");
@@ -250,5 +309,101 @@ class MarkovChainSamplerTest :
                     }
                 }
             }
+
+            // resume from checkpoints, both in the pre run and in the main run
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_resume.hdf5");
+                static const std::string reference_file_name(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_resume-reference.hdf5");
+                static const std::string checkpoint_file_name(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_resume-checkpoint.hdf5");
+                static const std::string saved_checkpoint_file_name(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_resume-saved.hdf5");
+                std::remove(checkpoint_file_name.c_str());
+
+                LogPosterior log_posterior(make_log_posterior(true));
+
+                MarkovChainSampler::Config config = MarkovChainSampler::Config::Quick();
+                config.chunk_size = 100;
+                config.chunks = 6;
+                config.number_of_chains = 2;
+                config.output_file = reference_file_name;
+                config.parallelize = true;
+                config.prerun_iterations_update = 500;
+                config.prerun_iterations_min = 1000;
+                config.proposal_initial_covariance = proposal_covariance(log_posterior, 2);
+                config.seed = 1723;
+                config.store = true;
+
+                // uninterrupted run
+                unsigned prerun_iterations = 0;
+                {
+                    MarkovChainSampler sampler(log_posterior.clone(), config);
+                    sampler.run();
+
+                    prerun_iterations = sampler.pre_run_info().iterations;
+                }
+
+                config.output_file = file_name;
+                config.checkpoint_file = checkpoint_file_name;
+                config.resume = true;
+
+                // interrupt after the first update of the pre run
+                {
+                    MarkovChainSampler::Config interrupted_config(config);
+                    interrupted_config.need_main_run = false;
+                    interrupted_config.prerun_iterations_min = 500;
+                    interrupted_config.prerun_iterations_max = 500;
+
+                    MarkovChainSampler sampler(log_posterior.clone(), interrupted_config);
+                    sampler.run();
+                }
+
+                // interrupt after two chunks of the main run, and store the checkpoint
+                {
+                    MarkovChainSampler::Config interrupted_config(config);
+                    interrupted_config.chunks = 2;
+
+                    MarkovChainSampler sampler(log_posterior.clone(), interrupted_config);
+                    sampler.run();
+
+                    copy_file(checkpoint_file_name, saved_checkpoint_file_name);
+                }
+
+                // interrupt after the third chunk, and restore the previous checkpoint, as if
+                // the run was killed after storing the samples but before storing the checkpoint
+                {
+                    MarkovChainSampler::Config interrupted_config(config);
+                    interrupted_config.chunks = 3;
+
+                    MarkovChainSampler sampler(log_posterior.clone(), interrupted_config);
+                    sampler.run();
+
+                    copy_file(saved_checkpoint_file_name, checkpoint_file_name);
+                }
+
+                // resume with the original configuration
+                {
+                    MarkovChainSampler sampler(log_posterior.clone(), config);
+                    sampler.run();
+
+                    TEST_CHECK_EQUAL(sampler.pre_run_info().iterations, prerun_iterations);
+                }
+
+                // the output is identical to that of the uninterrupted run
+                for (unsigned c = 0 ; c < config.number_of_chains ; ++c)
+                {
+                    const std::string chain = "/chain #" + stringify(c);
+
+                    auto prerun_samples = read_all_samples(file_name, "/prerun" + chain + "/samples", 1);
+                    TEST_CHECK_EQUAL(prerun_samples.size(), prerun_iterations * 2);
+                    TEST_CHECK(prerun_samples == read_all_samples(reference_file_name, "/prerun" + chain + "/samples", 1));
+
+                    auto main_run_samples = read_all_samples(file_name, "/main run" + chain + "/samples", 1);
+                    TEST_CHECK_EQUAL(main_run_samples.size(), 600 * 2);
+                    TEST_CHECK(main_run_samples == read_all_samples(reference_file_name, "/main run" + chain + "/samples", 1));
+
+                    auto modes = read_all_samples(file_name, "/main run" + chain + "/stats/mode", 1);
+                    TEST_CHECK_EQUAL(modes.size(), 6 * 2);
+                    TEST_CHECK(modes == read_all_samples(reference_file_name, "/main run" + chain + "/stats/mode", 1));
+                }
+            }
         }
 } markov_chain_sampler_test;
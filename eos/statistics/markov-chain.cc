@@ -25,7 +25,10 @@
 #include <eos/utils/hdf5.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
 #include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+#include <eos/utils/trace.hh>
 
 #include <algorithm>
 #include <cmath>
@@ -37,6 +40,18 @@
 
 namespace eos
 {
+    namespace implementation
+    {
+        // setup Mersenne-Twister RN generator using the given seed
+        std::shared_ptr<gsl_rng> mersenne_twister(const unsigned long & seed)
+        {
+            std::shared_ptr<gsl_rng> result(gsl_rng_alloc(gsl_rng_mt19937), &gsl_rng_free);
+            gsl_rng_set(result.get(), seed);
+
+            return result;
+        }
+    }
+
     template<>
     struct Implementation<MarkovChain>
     {
@@ -50,6 +65,7 @@ namespace eos
         std::vector<ParameterDescription> parameter_descriptions;
 
         // Random number generator, unique to this chain
+        std::shared_ptr<gsl_rng> rng_owner;
         gsl_rng * rng;
 
         // was the last proposed move accepted?
@@ -80,36 +96,73 @@ namespace eos
         // sample variance of log(density) (Welford's method)
         double welford_data_density;
 
+        // delayed rejection, and the factor by which the steps of the second stage are shrunk
+        bool delayed_rejection;
+        double delayed_rejection_scale;
+
+        // the rejected proposal of the first stage of delayed rejection
+        MarkovChain::State rejected;
+
+        // log of the Metropolis-Hastings ratio of the most recent proposal
+        double log_ratio;
+
+        // the number of candidates per iteration of multiple-try Metropolis, and whether to evaluate them in parallel
+        unsigned tries;
+
+        bool parallel_tries;
+
+        // one copy of the density per candidate, so that all candidates can be evaluated in parallel
+        std::vector<DensityPtr> helper_densities;
+        std::vector<std::vector<ParameterDescription>> helper_parameters;
+
+        // candidates and reference points of multiple-try Metropolis
+        std::vector<MarkovChain::State> candidates, references;
+
+        // scratch space
+        std::vector<MarkovChain::State> centers;
+        MarkovChain::State scaled;
+        std::vector<double> candidate_weights, reference_weights;
+
+        // the number of evaluations of the density during runs
+        unsigned long evaluations;
+
         // Output data types
         typedef hdf5::Array<1, double> SampleType;
         const SampleType sample_type;
 
-        Implementation(const DensityPtr & density, unsigned long seed, const std::shared_ptr<MarkovChain::ProposalFunction> & proposal_function) :
+        typedef hdf5::Composite<hdf5::Scalar<unsigned>, hdf5::Scalar<double>, hdf5::Scalar<unsigned long>> AlgorithmType;
+        const AlgorithmType algorithm_type;
+
+        Implementation(const DensityPtr & density, const std::shared_ptr<gsl_rng> & rng, const std::shared_ptr<MarkovChain::ProposalFunction> & proposal_function) :
             density(density->clone()),
+            rng_owner(rng),
+            rng(rng.get()),
+            delayed_rejection(false),
+            delayed_rejection_scale(0.5),
+            log_ratio(0.0),
+            tries(1),
+            parallel_tries(true),
+            evaluations(0),
             sample_type
             {
                 "samples",
                 { std::distance(density->begin(), density->end()) + 1ul },
+            },
+            algorithm_type
+            {
+                "algorithm",
+                hdf5::Scalar<unsigned>("multiple tries"),
+                hdf5::Scalar<double>("delayed rejection scale"),
+                hdf5::Scalar<unsigned long>("evaluations"),
             }
-
         {
             if (! proposal_function)
                 throw InternalError("MarkovChain needs a non-empty proposal function");
             this->proposal_function = proposal_function->clone(),
 
-            // setup Mersenne-Twister RN generator using default seed
-            rng = gsl_rng_alloc(gsl_rng_mt19937);
-            gsl_rng_set(rng, seed);
-
             initialize();
         }
 
-        ~Implementation<MarkovChain>()
-        {
-            // free RN generator
-            gsl_rng_free(rng);
-        }
-
         // clear this chains' history
         void clear()
         {
@@ -145,6 +198,12 @@ namespace eos
             std::copy(stats.parameters_at_mode.cbegin(), stats.parameters_at_mode.cend(), record.begin());
             record.back() = stats.mode;
             data_set_mode << record;
+
+            /* store the settings of the algorithm, and the number of evaluations so far */
+
+            auto data_set_algorithm = file.create_or_open_data_set(data_set_base_name + "/stats/algorithm", algorithm_type);
+            auto algorithm_record = std::make_tuple(tries, delayed_rejection ? delayed_rejection_scale : 0.0, evaluations);
+            data_set_algorithm << algorithm_record;
         }
 
         // store proposal density state
@@ -153,6 +212,131 @@ namespace eos
             proposal_function->dump_state(file, data_set_base_name + "/proposal");
         }
 
+        // counters and running statistics, which are not part of the regular output
+        typedef hdf5::Composite<hdf5::Scalar<unsigned>, hdf5::Scalar<unsigned>, hdf5::Scalar<unsigned>, hdf5::Scalar<unsigned>,
+                hdf5::Scalar<unsigned>, hdf5::Scalar<int>, hdf5::Scalar<double>, hdf5::Scalar<double>, hdf5::Scalar<double>,
+                hdf5::Scalar<double>, hdf5::Scalar<unsigned long>> CheckpointType;
+
+        static CheckpointType checkpoint_type()
+        {
+            return CheckpointType
+            {
+                "checkpoint",
+                hdf5::Scalar<unsigned>("iterations total"),
+                hdf5::Scalar<unsigned>("iterations accepted"),
+                hdf5::Scalar<unsigned>("iterations rejected"),
+                hdf5::Scalar<unsigned>("iterations invalid"),
+                hdf5::Scalar<unsigned>("iterations last run"),
+                hdf5::Scalar<int>("keep history"),
+                hdf5::Scalar<double>("mode"),
+                hdf5::Scalar<double>("mean of log(density)"),
+                hdf5::Scalar<double>("variance of log(density)"),
+                hdf5::Scalar<double>("welford data of log(density)"),
+                hdf5::Scalar<unsigned long>("evaluations"),
+            };
+        }
+
+        void dump_checkpoint(hdf5::File & file, const std::string & data_set_base_name) const
+        {
+            const unsigned dimension = parameter_descriptions.size();
+
+            /* store the current state and the entire history */
+
+            auto data_set_current = file.create_data_set(data_set_base_name + "/current", sample_type);
+            std::vector<double> record(dimension + 1);
+            std::copy(current.point.cbegin(), current.point.cend(), record.begin());
+            record.back() = current.log_density;
+            data_set_current << record;
+
+            auto data_set_history = file.create_data_set(data_set_base_name + "/history", sample_type);
+            std::vector<double> records(history.states.size() * (dimension + 1));
+            auto r = records.begin();
+            for (const auto & state : history.states)
+            {
+                r = std::copy(state.point.cbegin(), state.point.cend(), r);
+                *r++ = state.log_density;
+            }
+            data_set_history.write_raw(0, history.states.size(), records.data());
+
+            /* store the statistics */
+
+            auto data_set_checkpoint = file.create_data_set(data_set_base_name + "/statistics", checkpoint_type());
+            auto checkpoint_record = std::make_tuple(stats.iterations_total, stats.iterations_accepted, stats.iterations_rejected,
+                    stats.iterations_invalid, run_iterations, int(history.keep), stats.mode, stats.mean_of_log_density,
+                    stats.variance_of_log_density, welford_data_density, evaluations);
+            data_set_checkpoint << checkpoint_record;
+
+            // parameters at the mode, means, variances, and Welford data of the parameters
+            auto data_set_parameters = file.create_data_set(data_set_base_name + "/parameters", hdf5::Array<1, double>("parameters", { dimension }));
+            data_set_parameters << stats.parameters_at_mode << stats.mean_of_parameters << stats.variance_of_parameters << welford_data_parameters;
+
+            /* store the proposal function and the random number generator */
+
+            proposal_function->dump_state(file, data_set_base_name + "/proposal");
+            dump_rng_state(file, data_set_base_name + "/rng", rng);
+        }
+
+        void read_checkpoint(hdf5::File & file, const std::string & data_set_base_name)
+        {
+            const unsigned dimension = parameter_descriptions.size();
+
+            /* restore the current state and the entire history */
+
+            auto data_set_current = file.open_data_set(data_set_base_name + "/current", sample_type);
+            std::vector<double> record(dimension + 1);
+            data_set_current >> record;
+            std::copy(record.cbegin(), record.cend() - 1, current.point.begin());
+            current.log_density = record.back();
+            proposal = current;
+
+            for (unsigned i = 0 ; i != dimension ; ++i)
+            {
+                parameter_descriptions[i].parameter->set(current.point[i]);
+            }
+
+            auto data_set_history = file.open_data_set(data_set_base_name + "/history", sample_type);
+            std::vector<double> records(data_set_history.records() * (dimension + 1));
+            data_set_history.read_raw(0, data_set_history.records(), records.data());
+            history.states.clear();
+            history.states.reserve(data_set_history.records());
+            for (auto r = records.cbegin(), r_end = records.cend() ; r != r_end ; r += dimension + 1)
+            {
+                MarkovChain::State state;
+                state.point.assign(r, r + dimension);
+                state.log_density = r[dimension];
+                history.states.push_back(state);
+            }
+
+            /* restore the statistics */
+
+            auto data_set_checkpoint = file.open_data_set(data_set_base_name + "/statistics", checkpoint_type());
+            auto checkpoint_record = std::make_tuple(0u, 0u, 0u, 0u, 0u, 0, 0.0, 0.0, 0.0, 0.0, 0ul);
+            data_set_checkpoint >> checkpoint_record;
+            stats.iterations_total = std::get<0>(checkpoint_record);
+            stats.iterations_accepted = std::get<1>(checkpoint_record);
+            stats.iterations_rejected = std::get<2>(checkpoint_record);
+            stats.iterations_invalid = std::get<3>(checkpoint_record);
+            run_iterations = std::get<4>(checkpoint_record);
+            history.keep = std::get<5>(checkpoint_record);
+            stats.mode = std::get<6>(checkpoint_record);
+            stats.mean_of_log_density = std::get<7>(checkpoint_record);
+            stats.variance_of_log_density = std::get<8>(checkpoint_record);
+            welford_data_density = std::get<9>(checkpoint_record);
+            evaluations = std::get<10>(checkpoint_record);
+
+            auto data_set_parameters = file.open_data_set(data_set_base_name + "/parameters", hdf5::Array<1, double>("parameters", { dimension }));
+            data_set_parameters >> stats.parameters_at_mode >> stats.mean_of_parameters >> stats.variance_of_parameters >> welford_data_parameters;
+
+            /* restore the proposal function and the random number generator */
+
+            auto meta_record = proposal_functions::meta_record();
+            auto meta_data_set = file.open_data_set(data_set_base_name + "/proposal/meta", proposal_functions::meta_type());
+            meta_data_set >> meta_record;
+            proposal_function = proposal_functions::Factory::make(file, data_set_base_name + "/proposal", std::get<0>(meta_record), dimension);
+
+            read_rng_state(file, data_set_base_name + "/rng", rng);
+        }
+
         // calculate density etc at the proposal point
         void evaluate_proposal()
         {
@@ -189,6 +373,7 @@ namespace eos
 
             // finally evaluate the target density
             proposal.log_density = density->evaluate();
+            ++evaluations;
         }
 
         // called from ctor only at beginning
@@ -250,6 +435,8 @@ namespace eos
                 if ((proposal.point[i] < parameter_descriptions[i].min) || (proposal.point[i] > parameter_descriptions[i].max))
                 {
                     stats.iterations_invalid++;
+                    proposal.log_density = -std::numeric_limits<double>::infinity();
+                    log_ratio = -std::numeric_limits<double>::infinity();
                     return false;
                 }
             }
@@ -262,6 +449,7 @@ namespace eos
             double log_r_post = proposal.log_density - current.log_density;
             double log_r_prop = proposal_function->evaluate(current, proposal) - proposal_function->evaluate(proposal, current);
             double log_r = log_r_post + log_r_prop;
+            log_ratio = log_r;
 
             if ( ! std::isfinite(log_r))
                 throw InternalError("MarkovChain::run: isfinite failed, either from a bad density value ("
@@ -282,6 +470,251 @@ namespace eos
             current = proposal;
         }
 
+        bool in_range(const MarkovChain::State & state) const
+        {
+            for (unsigned i = 0 ; i < parameter_descriptions.size() ; ++i)
+            {
+                if ((state.point[i] < parameter_descriptions[i].min) || (state.point[i] > parameter_descriptions[i].max))
+                    return false;
+            }
+
+            return true;
+        }
+
+        /*
+         * Second stage of delayed rejection, once the proposal has been rejected.
+         *
+         * The second proposal y2 = x + s (y' - x) is drawn from the proposal function,
+         * shrunk by the factor s. It is accepted with probability
+         *
+         *   min(1, [pi(y2) q(y1 | y2) q2(x | y2) (1 - a(y2, y1))] / [pi(x) q(y1 | x) q2(y2 | x) (1 - a(x, y1))]),
+         *
+         * where y1 denotes the rejected proposal and a the acceptance probability of the first stage.
+         *
+         * @return true, if the second proposal is accepted.
+         */
+        bool accept_delayed()
+        {
+            const double & s = delayed_rejection_scale;
+
+            const double log_alpha_x_y1 = std::min(0.0, log_ratio);
+
+            // out-of-range first-stage proposals have already been counted as invalid
+            const bool counted_invalid = ! std::isfinite(log_ratio);
+
+            rejected = proposal;
+            revert();
+
+            proposal_function->propose(proposal, current, rng);
+            for (unsigned i = 0 ; i < parameter_descriptions.size() ; ++i)
+            {
+                proposal.point[i] = current.point[i] + s * (proposal.point[i] - current.point[i]);
+            }
+
+            if (! in_range(proposal))
+            {
+                if (! counted_invalid)
+                    stats.iterations_invalid++;
+
+                return false;
+            }
+
+            evaluate_proposal();
+
+            // the acceptance probability of a first-stage move from y2 to y1
+            double log_alpha_y2_y1 = -std::numeric_limits<double>::infinity();
+            if (std::isfinite(rejected.log_density))
+            {
+                log_alpha_y2_y1 = std::min(0.0, rejected.log_density - proposal.log_density
+                        + proposal_function->evaluate(proposal, rejected) - proposal_function->evaluate(rejected, proposal));
+            }
+
+            if ((0.0 == log_alpha_y2_y1) || ! std::isfinite(proposal.log_density))
+                return false;
+
+            // q2(a | b) = q(b + (a - b) / s | b) / s^dim; the factors s^-dim cancel in the ratio
+            double log_q2_x_y2, log_q2_y2_x;
+            {
+                scaled.point.resize(parameter_descriptions.size());
+
+                for (unsigned i = 0 ; i < parameter_descriptions.size() ; ++i)
+                {
+                    scaled.point[i] = proposal.point[i] + (current.point[i] - proposal.point[i]) / s;
+                }
+                log_q2_x_y2 = proposal_function->evaluate(scaled, proposal);
+
+                for (unsigned i = 0 ; i < parameter_descriptions.size() ; ++i)
+                {
+                    scaled.point[i] = current.point[i] + (proposal.point[i] - current.point[i]) / s;
+                }
+                log_q2_y2_x = proposal_function->evaluate(scaled, current);
+            }
+
+            const double log_numerator = proposal.log_density + proposal_function->evaluate(rejected, proposal)
+                    + log_q2_x_y2 + std::log1p(-std::exp(log_alpha_y2_y1));
+            const double log_denominator = current.log_density + proposal_function->evaluate(rejected, current)
+                    + log_q2_y2_x + std::log1p(-std::exp(log_alpha_x_y1));
+
+            return std::log(uniform_random_number()) < log_numerator - log_denominator;
+        }
+
+        // evaluate the density for the first count states, if enabled in parallel, using one copy of the density per state
+        void evaluate_in_parallel(std::vector<MarkovChain::State> & states, const unsigned & count)
+        {
+            for (unsigned j = 0 ; j < count ; ++j)
+            {
+                if (in_range(states[j]))
+                    ++evaluations;
+            }
+
+            auto evaluate = [&] (const unsigned & j)
+            {
+                auto & state = states[j];
+
+                if (! in_range(state))
+                {
+                    state.log_density = -std::numeric_limits<double>::infinity();
+                    return;
+                }
+
+                auto & parameters = helper_parameters[j];
+                for (unsigned i = 0 ; i < parameters.size() ; ++i)
+                {
+                    parameters[i].parameter->set(state.point[i]);
+                }
+
+                state.log_density = helper_densities[j]->evaluate();
+            };
+
+            if (! parallel_tries)
+            {
+                for (unsigned j = 0 ; j < count ; ++j)
+                {
+                    evaluate(j);
+                }
+
+                return;
+            }
+
+            ThreadPool::instance()->parallel_for(count, evaluate);
+        }
+
+        // weights log w(y_j, x) = log pi(y_j) + log q(x | y_j)
+        void multiple_try_weights(std::vector<double> & weights, const MarkovChain::State & x, const std::vector<MarkovChain::State> & y)
+        {
+            const unsigned count = y.size();
+            weights.resize(count);
+
+            auto multivariate = std::dynamic_pointer_cast<proposal_functions::Multivariate>(proposal_function);
+            if (multivariate)
+            {
+                centers.resize(count);
+                for (auto & c : centers)
+                {
+                    c.point = x.point;
+                }
+                multivariate->evaluate(weights, centers, y);
+            }
+            else
+            {
+                for (unsigned j = 0 ; j < count ; ++j)
+                {
+                    weights[j] = proposal_function->evaluate(x, y[j]);
+                }
+            }
+
+            for (unsigned j = 0 ; j < count ; ++j)
+            {
+                weights[j] = std::isfinite(y[j].log_density) ? weights[j] + y[j].log_density : -std::numeric_limits<double>::infinity();
+            }
+        }
+
+        // draw states around the given center, as a single batch if possible
+        void propose_candidates(std::vector<MarkovChain::State> & result, const MarkovChain::State & center)
+        {
+            auto multivariate = std::dynamic_pointer_cast<proposal_functions::Multivariate>(proposal_function);
+            if (multivariate)
+            {
+                multivariate->propose(result, center, rng);
+                return;
+            }
+
+            for (auto & r : result)
+            {
+                proposal_function->propose(r, center, rng);
+            }
+        }
+
+        static double log_sum_exp(const std::vector<double> & values)
+        {
+            const double max = *std::max_element(values.cbegin(), values.cend());
+
+            if (! std::isfinite(max))
+                return max;
+
+            double sum = 0.0;
+            for (const auto & v : values)
+            {
+                sum += std::exp(v - max);
+            }
+
+            return max + std::log(sum);
+        }
+
+        /*
+         * Multiple-try Metropolis with weights w(y, x) = pi(y) q(x | y).
+         *
+         * Draw candidates y_1 ... y_k ~ q(. | x), select y = y_J with probability proportional to w(y_J, x),
+         * draw reference points x_1 ... x_(k-1) ~ q(. | y), set x_k = x, and accept y with probability
+         *
+         *   min(1, sum_j w(y_j, x) / sum_j w(x_j, y)).
+         *
+         * @return true, if the selected candidate is accepted.
+         */
+        bool accept_multiple_tries()
+        {
+            propose_candidates(candidates, current);
+            evaluate_in_parallel(candidates, tries);
+            multiple_try_weights(candidate_weights, current, candidates);
+
+            const double log_candidate_sum = log_sum_exp(candidate_weights);
+            if (! std::isfinite(log_candidate_sum))
+            {
+                stats.iterations_invalid++;
+                proposal = candidates.front();
+                return false;
+            }
+
+            // select a candidate
+            const double u = uniform_random_number();
+            unsigned selected = tries - 1;
+            double cumulative = 0.0;
+            for (unsigned j = 0 ; j < tries ; ++j)
+            {
+                cumulative += std::exp(candidate_weights[j] - log_candidate_sum);
+
+                if (u < cumulative)
+                {
+                    selected = j;
+                    break;
+                }
+            }
+            proposal = candidates[selected];
+
+            // reference points around the selected candidate; the last one is replaced by the current point
+            propose_candidates(references, proposal);
+            references.back() = current;
+            evaluate_in_parallel(references, tries - 1);
+            multiple_try_weights(reference_weights, proposal, references);
+
+            const double log_reference_sum = log_sum_exp(reference_weights);
+
+            if (std::log(uniform_random_number()) < log_candidate_sum - log_reference_sum)
+                return true;
+
+            return false;
+        }
+
         static void read_history(hdf5::File & file, const std::string & data_set_base_name,
                                  const unsigned & dimension, MarkovChain::History & history)
         {
@@ -292,17 +725,64 @@ namespace eos
                 { dimension + 1 },
             };
             auto data_set = file.open_data_set(data_set_base_name + "/samples", sample_type);
-            std::vector<double> record(dimension + 1);
+            history.states.reserve(history.states.size() + data_set.records());
+
             MarkovChain::State state;
             state.point.resize(dimension);
-            for (unsigned i = 0 ; i < data_set.records() ; ++i)
+            auto append = [&] (const double * record, const unsigned & records)
             {
-                data_set >> record;
+                for (unsigned i = 0 ; i < records ; ++i, record += dimension + 1)
+                {
+                    std::copy(record, record + dimension, state.point.begin());
+                    state.log_density = record[dimension];
+                    history.states.push_back(state);
+                }
+            };
 
-                std::copy(record.begin(), record.end() - 1, state.point.begin());
-                state.log_density = record.back();
-                history.states.push_back(state);
+            // access the samples without copying if possible, otherwise stream them in blocks
+            if (data_set.mappable())
+            {
+                auto region = data_set.map(0, data_set.records());
+                append(static_cast<const double *>(region.data()), data_set.records());
+            }
+            else
+            {
+                hdf5::PrefetchingReader<SampleType> reader(data_set);
+
+                const void * block;
+                while (unsigned records = reader.next_block(block))
+                {
+                    append(static_cast<const double *>(block), records);
+                }
+            }
+        }
+
+        static unsigned read_samples(hdf5::File & file, const std::string & data_set_base_name,
+                                     const unsigned & dimension, const unsigned & min, const unsigned & max,
+                                     std::vector<std::vector<double>> & samples)
+        {
+            SampleType sample_type
+            {
+                "samples",
+                { dimension + 1 },
+            };
+            auto data_set = file.open_data_set(data_set_base_name + "/samples", sample_type);
+
+            const unsigned records = data_set.records();
+            if (min > records)
+                return records;
+
+            const unsigned count = std::min(max, records) - min;
+            std::vector<double> buffer(count * (dimension + 1));
+            data_set.read_raw(min, count, buffer.data());
+
+            samples.reserve(samples.size() + count);
+            for (auto r = buffer.cbegin(), r_end = buffer.cend() ; r != r_end ; r += dimension + 1)
+            {
+                samples.emplace_back(r, r + dimension);
             }
+
+            return records;
         }
 
         static void read_proposal(hdf5::File & file, const std::string & data_set_base_name,
@@ -386,6 +866,9 @@ namespace eos
         // set the number of iterations for next run and go
         void run(unsigned iterations)
         {
+            static const std::string trace_name("MarkovChain::run");
+            ScopedTimer timer("sampler", trace_name);
+
             Log::instance()->message("markov_chain.run", ll_debug)
                 << "Running " << iterations << " iterations";
 
@@ -397,10 +880,30 @@ namespace eos
             // loop over iterations
             for (current_iteration = 0 ; current_iteration < iterations ; ++current_iteration)
             {
+                if (tries > 1)
+                {
+                    // the density's parameters are only changed when moving, since all candidates are evaluated on copies
+                    accept_proposal = accept_multiple_tries();
+
+                    if (accept_proposal)
+                    {
+                        move();
+                        revert();
+                    }
+
+                    update();
+                    continue;
+                }
+
                 proposal_function->propose(proposal, current, rng);
 
                 accept_proposal = accept();
 
+                if (! accept_proposal && delayed_rejection)
+                {
+                    accept_proposal = accept_delayed();
+                }
+
                 if (accept_proposal)
                 {
                     // store current in the history, replace current by proposal
@@ -419,6 +922,46 @@ namespace eos
             // we are done. store how many iterations we had in total
             stats.iterations_total += iterations;
             run_iterations = iterations;
+
+            Trace::instance()->counter("markov_chain.iterations", iterations);
+        }
+
+        void set_delayed_rejection(const bool & enabled, const double & scale)
+        {
+            if (enabled && (tries > 1))
+                throw InternalError("MarkovChain::delayed_rejection: Cannot be combined with multiple-try Metropolis");
+
+            if (enabled && ((scale <= 0.0) || (scale >= 1.0)))
+                throw InternalError("MarkovChain::delayed_rejection: The scale must lie in the interval (0, 1), but is " + stringify(scale));
+
+            delayed_rejection = enabled;
+            delayed_rejection_scale = scale;
+        }
+
+        void set_multiple_tries(const unsigned & number_of_tries, const bool & parallel)
+        {
+            if (0 == number_of_tries)
+                throw InternalError("MarkovChain::multiple_tries: The number of tries must be positive");
+
+            if ((number_of_tries > 1) && delayed_rejection)
+                throw InternalError("MarkovChain::multiple_tries: Cannot be combined with delayed rejection");
+
+            tries = number_of_tries;
+            parallel_tries = parallel;
+
+            helper_densities.clear();
+            helper_parameters.clear();
+            if (1 == tries)
+                return;
+
+            for (unsigned j = 0 ; j < tries ; ++j)
+            {
+                helper_densities.push_back(density->clone());
+                helper_parameters.emplace_back(helper_densities.back()->begin(), helper_densities.back()->end());
+            }
+
+            candidates.assign(tries, current);
+            references.assign(tries, current);
         }
 
         // check consistency of configuration, throw exception
@@ -493,6 +1036,30 @@ namespace eos
                 << current;
         }
 
+        void set_state(const MarkovChain::State & state)
+        {
+            if (parameter_descriptions.size() != state.point.size())
+                throw InternalError("markov_chain::set_state: Dimension of the parameter space of the analysis"
+                                    " doesn't match the dimension of the state given.");
+
+            if (! in_range(state))
+                throw InternalError("markov_chain::set_state: State " + stringify(state.point.cbegin(), state.point.cend()) + " out of range");
+
+            current = state;
+            proposal = current;
+
+            for (unsigned i = 0 ; i != parameter_descriptions.size() ; ++i)
+            {
+                parameter_descriptions[i].parameter->set(current.point[i]);
+            }
+
+            if (current.log_density > stats.mode)
+            {
+                stats.mode = current.log_density;
+                stats.parameters_at_mode = current.point;
+            }
+        }
+
         // save points, update statistics
         void update()
         {
@@ -566,7 +1133,13 @@ namespace eos
     };
 
     MarkovChain::MarkovChain(const DensityPtr & density, unsigned long seed, const std::shared_ptr<MarkovChain::ProposalFunction> & proposal_function) :
-        PrivateImplementationPattern<MarkovChain>(new Implementation<MarkovChain>(density, seed, proposal_function))
+        PrivateImplementationPattern<MarkovChain>(new Implementation<MarkovChain>(density, implementation::mersenne_twister(seed), proposal_function))
+    {
+    }
+
+    MarkovChain::MarkovChain(const DensityPtr & density, const RandomStream & stream, const std::shared_ptr<MarkovChain::ProposalFunction> & proposal_function) :
+        PrivateImplementationPattern<MarkovChain>(new Implementation<MarkovChain>(density,
+                    std::shared_ptr<gsl_rng>(stream.rng(), [stream] (gsl_rng *) { }), proposal_function))
     {
     }
 
@@ -580,6 +1153,18 @@ namespace eos
         _imp->clear();
     }
 
+    void
+    MarkovChain::delayed_rejection(const bool & enabled, const double & scale)
+    {
+        _imp->set_delayed_rejection(enabled, scale);
+    }
+
+    void
+    MarkovChain::multiple_tries(const unsigned & tries, const bool & parallel)
+    {
+        _imp->set_multiple_tries(tries, parallel);
+    }
+
     void
     MarkovChain::dump_history(hdf5::File & file, const std::string & data_set_base_name, const unsigned & last_iterations) const
     {
@@ -592,12 +1177,36 @@ namespace eos
         _imp->dump_proposal(file, data_set);
     }
 
+    void
+    MarkovChain::dump_checkpoint(hdf5::File & file, const std::string & data_set) const
+    {
+        _imp->dump_checkpoint(file, data_set);
+    }
+
+    void
+    MarkovChain::read_checkpoint(hdf5::File & file, const std::string & data_set)
+    {
+        _imp->read_checkpoint(file, data_set);
+    }
+
+    void
+    MarkovChain::dump_profile(hdf5::File & file, const std::string & data_set) const
+    {
+        _imp->density->dump_profile(file, data_set);
+    }
+
     void
     MarkovChain::set_point(const std::vector<double> & point)
     {
         _imp->set_point(point);
     }
 
+    void
+    MarkovChain::set_state(const MarkovChain::State & state)
+    {
+        _imp->set_state(state);
+    }
+
     const MarkovChain::State &
     MarkovChain::current_state() const
     {
@@ -610,6 +1219,12 @@ namespace eos
         return _imp->proposal;
     }
 
+    unsigned long
+    MarkovChain::evaluations() const
+    {
+        return _imp->evaluations;
+    }
+
     const unsigned &
     MarkovChain::iterations_last_run() const
     {
@@ -663,6 +1278,19 @@ namespace eos
         Implementation<MarkovChain>::read_stats(file, data_base_name, dimension, stats);
     }
 
+    unsigned
+    MarkovChain::read_samples(hdf5::File & file, const std::string & data_base_name,
+                              const unsigned & min, const unsigned & max,
+                              std::vector<std::vector<double>> & samples)
+    {
+        auto meta_record = proposal_functions::meta_record();
+        auto meta_data_set = file.open_data_set(data_base_name + "/proposal/meta", proposal_functions::meta_type());
+        meta_data_set >> meta_record;
+        const unsigned & dimension = std::get<1>(meta_record);
+
+        return Implementation<MarkovChain>::read_samples(file, data_base_name, dimension, min, max, samples);
+    }
+
     void
     MarkovChain::reset(bool hard)
     {
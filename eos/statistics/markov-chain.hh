@@ -23,6 +23,7 @@
 #include <eos/utils/density-fwd.hh>
 #include <eos/utils/hdf5-fwd.hh>
 #include <eos/utils/parameters.hh>
+#include <eos/utils/random-stream.hh>
 #include <eos/utils/stringify.hh>
 
 #include <vector>
@@ -49,11 +50,20 @@ namespace eos
              * Constructor
              *
              * @density The density to sample from
-             * @param seed     The initial seed for the RNG.
+             * @param seed     The initial seed for the RNG, a Mersenne Twister.
              */
             MarkovChain(const DensityPtr & density, unsigned long seed,
                         const std::shared_ptr<MarkovChain::ProposalFunction> & proposal_function);
 
+            /*!
+             * Constructor
+             *
+             * @density The density to sample from
+             * @param stream   The stream of random numbers, which must not be shared with any other chain.
+             */
+            MarkovChain(const DensityPtr & density, const RandomStream & stream,
+                        const std::shared_ptr<MarkovChain::ProposalFunction> & proposal_function);
+
             /// Destructor.
             ~MarkovChain();
             ///@}
@@ -61,6 +71,29 @@ namespace eos
             /// Remove existing history of this chain.
             void clear();
 
+            /*!
+             * Use delayed rejection, cf. Tierney and Mira, Stat. Med. 18 (1999) 2507.
+             *
+             * If a proposed move is rejected, a second move is proposed with steps that are
+             * shrunk by the given factor, and accepted such that detailed balance is preserved.
+             *
+             * @param enabled  Whether delayed rejection shall be used.
+             * @param scale    The factor by which the steps of the second proposal are shrunk.
+             */
+            void delayed_rejection(const bool & enabled, const double & scale = 0.5);
+
+            /*!
+             * Use multiple-try Metropolis, cf. Liu, Liang and Wong, J. Am. Stat. Assoc. 95 (2000) 121.
+             *
+             * In each iteration, several candidates are proposed and the density is evaluated
+             * for all of them, by default in parallel on the ThreadPool, using one copy of the density per candidate.
+             * Cannot be combined with delayed rejection.
+             *
+             * @param tries    The number of candidates per iteration. A value of 1 restores the Metropolis-Hastings algorithm.
+             * @param parallel Whether the candidates shall be evaluated in parallel.
+             */
+            void multiple_tries(const unsigned & tries, const bool & parallel = true);
+
             /// Retrieve information regarding the current state.
             const State & current_state() const;
 
@@ -76,6 +109,37 @@ namespace eos
 
             void dump_proposal(hdf5::File & file, const std::string & data_set_name) const;
 
+            /*!
+             * Dump the complete state of the chain in the HDF5 file under the given group name, e.g. as part of
+             * a checkpoint. This comprises the current state, the history, the statistics, the proposal function
+             * and the state of the random number generator.
+             *
+             * @param file
+             * @param data_set_name All output is stored below this directory.
+             */
+            void dump_checkpoint(hdf5::File & file, const std::string & data_set_name) const;
+
+            /*!
+             * Restore the complete state of the chain from a checkpoint, as stored by dump_checkpoint().
+             * Subsequent runs continue exactly as the chain would have continued from the stored state.
+             *
+             * @param file
+             * @param data_set_name The directory in the file under which the state was stored.
+             */
+            void read_checkpoint(hdf5::File & file, const std::string & data_set_name);
+
+            /*!
+             * Dump the timings of the density's evaluations, if available, in the HDF5 file
+             * under the given group name.
+             *
+             * @param file
+             * @param data_set_name All output is stored below this directory.
+             */
+            void dump_profile(hdf5::File & file, const std::string & data_set_name) const;
+
+            /// Retrieve the number of evaluations of the density in all runs so far.
+            unsigned long evaluations() const;
+
             /// Retrieve the number of iterations used in the last run
             const unsigned & iterations_last_run() const;
 
@@ -128,6 +192,21 @@ namespace eos
                                   std::string & proposal_type,
                                   MarkovChain::Stats & stats);
 
+            /*!
+             * Read a slice of a chain's samples from hdf5 file, without restoring its proposal or statistics.
+             *
+             * @param file
+             * @param data_base_name The directory in the file under which the data is parsed.
+             * @param min The index of the first sample.
+             * @param max The index past the last sample. Clipped to the chain's length.
+             * @param samples The parameter points of the samples are appended.
+             *
+             * @return The chain's length. No samples are appended if it is smaller than min.
+             */
+            static unsigned read_samples(hdf5::File & file, const std::string & data_base_name,
+                                         const unsigned & min, const unsigned & max,
+                                         std::vector<std::vector<double>> & samples);
+
             /*!
              * Perform a number of iterations.
              *
@@ -153,6 +232,14 @@ namespace eos
              */
             void set_point(const std::vector<double> & point);
 
+            /*!
+             * Set the chain to continue its walk from the given state, without evaluating the density.
+             * The caller is responsible for the state's log(density) to match the chain's density.
+             *
+             * @param state The point in parameter space, and the log(density) at this point.
+             */
+            void set_state(const State & state);
+
             /// Retrieve statistical data that summarizes the evolution of the chain up to the current point.
             const Stats & statistics() const;
     };
@@ -204,6 +291,11 @@ namespace eos
          */
         unsigned iterations_accepted;
 
+        /*!
+         * The number of iterations in which a proposal fell outside of the parameter ranges.
+         * With delayed rejection, an iteration is counted at most once, even if both stages
+         * proposed points outside of the ranges.
+         */
         unsigned iterations_invalid;
 
         /*!
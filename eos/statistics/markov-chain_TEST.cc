@@ -22,6 +22,8 @@
 #include <eos/statistics/log-posterior_TEST.hh>
 #include <eos/statistics/markov-chain.hh>
 #include <eos/statistics/proposal-functions.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/random-stream.hh>
 #include <test/test.hh>
 
 #include <algorithm>
@@ -309,6 +311,61 @@ class MarkovChainTest :
             }
 #endif
 
+            // delayed rejection and multiple tries sample the same distribution: mean around 4.2, variance around 0.1^2
+            TEST_SECTION("delayed-rejection",
+            {
+                std::shared_ptr<MarkovChain::ProposalFunction> ppf(new proposal_functions::MultivariateGaussian(1, std::vector<double>{ 0.09 }, false));
+                MarkovChain chain(make_log_posterior(true).clone(), RandomStream(13, "test"), ppf);
+
+                TEST_CHECK_THROWS(InternalError, chain.delayed_rejection(true, 1.5));
+                chain.delayed_rejection(true, 0.2);
+                TEST_CHECK_THROWS(InternalError, chain.multiple_tries(4));
+
+                chain.run(20000);
+                TEST_CHECK_NEARLY_EQUAL(chain.statistics().mean_of_parameters.front(),     4.2,  0.01);
+                TEST_CHECK_NEARLY_EQUAL(chain.statistics().variance_of_parameters.front(), 0.01, 0.001);
+                TEST_CHECK_EQUAL(chain.statistics().iterations_accepted + chain.statistics().iterations_rejected, 20000);
+            });
+
+            // an iteration whose two stages both leave the parameter range is counted as invalid once
+            TEST_SECTION("delayed-rejection-invalid",
+            {
+                std::shared_ptr<MarkovChain::ProposalFunction> ppf(new proposal_functions::MultivariateGaussian(1, std::vector<double>{ 100.0 }, false));
+                MarkovChain chain(make_log_posterior(true).clone(), RandomStream(13, "test"), ppf);
+                chain.delayed_rejection(true, 0.9);
+
+                chain.run(1000);
+                TEST_CHECK(chain.statistics().iterations_invalid <= 1000);
+                TEST_CHECK(chain.statistics().iterations_invalid >= 900);
+            });
+
+            TEST_SECTION("multiple-tries",
+            {
+                std::shared_ptr<MarkovChain::ProposalFunction> ppf(new proposal_functions::MultivariateGaussian(1, std::vector<double>{ 0.09 }, false));
+                MarkovChain chain(make_log_posterior(true).clone(), RandomStream(13, "test"), ppf);
+
+                TEST_CHECK_THROWS(InternalError, chain.multiple_tries(0));
+                chain.multiple_tries(4);
+                TEST_CHECK_THROWS(InternalError, chain.delayed_rejection(true));
+
+                chain.run(20000);
+                TEST_CHECK_NEARLY_EQUAL(chain.statistics().mean_of_parameters.front(),     4.2,  0.01);
+                TEST_CHECK_NEARLY_EQUAL(chain.statistics().variance_of_parameters.front(), 0.01, 0.001);
+                TEST_CHECK_EQUAL(chain.statistics().iterations_accepted + chain.statistics().iterations_rejected, 20000);
+
+                // the density's parameters follow the chain
+                TEST_CHECK_EQUAL(chain.parameter_descriptions().front().parameter->evaluate(), chain.current_state().point.front());
+
+                // serial evaluation of the tries yields the same chain
+                std::shared_ptr<MarkovChain::ProposalFunction> serial_ppf(new proposal_functions::MultivariateGaussian(1, std::vector<double>{ 0.09 }, false));
+                MarkovChain serial(make_log_posterior(true).clone(), RandomStream(13, "test"), serial_ppf);
+                serial.multiple_tries(4, false);
+
+                serial.run(20000);
+                TEST_CHECK_EQUAL(serial.current_state().point.front(), chain.current_state().point.front());
+                TEST_CHECK_EQUAL(serial.statistics().iterations_accepted, chain.statistics().iterations_accepted);
+            });
+
             // changing the point of a chain by hand
             TEST_SECTION("set-point",
             {
@@ -321,6 +378,44 @@ class MarkovChainTest :
 
                 TEST_CHECK_RELATIVE_ERROR(chain.current_state().log_density,  0.88364655978937656 + 0.883646846442260436, eps);
             });
+
+            // a chain that is restored from a checkpoint continues exactly like the original chain
+            TEST_SECTION("checkpoint",
+            {
+                static const std::string filename(EOS_BUILDDIR "/eos/statistics/markov-chain_TEST-checkpoint.hdf5");
+
+                auto mvg = new proposal_functions::MultivariateGaussian(1, std::vector<double>{ 0.01 });
+                std::shared_ptr<MarkovChain::ProposalFunction> ppf(mvg);
+                MarkovChain chain(make_log_posterior(true).clone(), 13, ppf);
+                chain.keep_history(true);
+                chain.run(500);
+                ppf->adapt(chain.history().states.cbegin(), chain.history().states.cend(), chain.statistics().iterations_accepted / 500.0, 0.2, 0.35);
+
+                {
+                    hdf5::File file = hdf5::File::Create(filename);
+                    chain.dump_checkpoint(file, "/chain");
+                }
+
+                std::shared_ptr<MarkovChain::ProposalFunction> other_ppf(new proposal_functions::MultivariateGaussian(1, std::vector<double>{ 1.0 }));
+                MarkovChain restored(make_log_posterior(true).clone(), 1346, other_ppf);
+                {
+                    hdf5::File file = hdf5::File::Open(filename);
+                    restored.read_checkpoint(file, "/chain");
+                }
+
+                TEST_CHECK_EQUAL(restored.current_state().point.front(), chain.current_state().point.front());
+                TEST_CHECK_EQUAL(restored.history().states.size(),       chain.history().states.size());
+                TEST_CHECK_EQUAL(restored.statistics().iterations_total, chain.statistics().iterations_total);
+
+                chain.run(200);
+                restored.run(200);
+
+                TEST_CHECK_EQUAL(restored.history().states.size(),          chain.history().states.size());
+                TEST_CHECK_EQUAL(restored.current_state().point.front(),    chain.current_state().point.front());
+                TEST_CHECK_EQUAL(restored.statistics().iterations_accepted, chain.statistics().iterations_accepted);
+                TEST_CHECK_EQUAL(restored.statistics().mean_of_parameters.front(), chain.statistics().mean_of_parameters.front());
+                TEST_CHECK(restored.history().states.back().point == chain.history().states.back().point);
+            });
             TEST_SECTION("Multivariate::adapt",
             {
                 Parameters parameters = Parameters::Defaults();
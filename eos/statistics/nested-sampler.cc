@@ -0,0 +1,845 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/nested-sampler.hh>
+#include <eos/statistics/log-prior.hh>
+#include <eos/statistics/proposal-functions.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_randist.h>
+
+namespace eos
+{
+    namespace implementation
+    {
+        struct NestedSamplingPoint
+        {
+            std::vector<double> point;
+
+            double log_prior;
+
+            double log_likelihood;
+        };
+
+        // log(exp(a) + exp(b)), safe against overflow and against a = b = -inf
+        inline double log_sum_exp(const double & a, const double & b)
+        {
+            if (a < b)
+                return b + std::log1p(std::exp(a - b));
+
+            if (b == -std::numeric_limits<double>::infinity())
+                return a;
+
+            return a + std::log1p(std::exp(b - a));
+        }
+    }
+
+    template <>
+    struct Implementation<NestedSampler>
+    {
+        typedef implementation::NestedSamplingPoint Point;
+
+        // our configuration options
+        NestedSampler::Config config;
+
+        // number of scan parameters
+        unsigned number_of_parameters;
+
+        // the posterior, used for the output
+        LogPosteriorPtr log_posterior;
+
+        // one independent copy of the posterior for each concurrent replacement
+        std::vector<LogPosteriorPtr> workers;
+
+        // the number of evaluations of the likelihood by each worker
+        std::vector<unsigned long> worker_evaluations;
+
+        // one random number stream for each concurrent replacement
+        std::vector<RandomStream> streams;
+
+        // the live points, and the removed points together with the logarithm of their share of the prior volume
+        std::vector<Point> live;
+        std::vector<Point> dead;
+        std::vector<double> dead_log_widths;
+
+        // the logarithm of the prior volume that is enclosed by the live points
+        double log_volume;
+
+        // the completed iterations
+        unsigned iteration;
+
+        // the number of evaluations of the likelihood before the current run, e.g. when resuming from a checkpoint
+        unsigned long previous_evaluations;
+
+        // the evidence of the removed points
+        double log_evidence_dead;
+
+        // the final results
+        double log_evidence, log_evidence_uncertainty, information;
+
+        // the lower Cholesky factor of the covariance of the live points, which scales the slice sampling directions
+        gsl_matrix * scale;
+
+        Implementation(const LogPosterior & log_posterior, const NestedSampler::Config & config) :
+            config(config),
+            number_of_parameters(std::distance(log_posterior.begin(), log_posterior.end())),
+            log_posterior(log_posterior.old_clone()),
+            log_volume(0.0),
+            iteration(0),
+            previous_evaluations(0),
+            log_evidence_dead(-std::numeric_limits<double>::infinity()),
+            log_evidence(std::numeric_limits<double>::quiet_NaN()),
+            log_evidence_uncertainty(std::numeric_limits<double>::quiet_NaN()),
+            information(std::numeric_limits<double>::quiet_NaN()),
+            scale(gsl_matrix_alloc(number_of_parameters, number_of_parameters))
+        {
+            if (config.number_of_replacements > config.number_of_live_points / 2)
+                throw InternalError("NestedSampler: The number of replacements per iteration must not exceed half the number of live points");
+
+            for (unsigned j = 0 ; j < config.number_of_replacements ; ++j)
+            {
+                workers.push_back(log_posterior.old_clone());
+                streams.push_back(RandomStream(config.seed, "nested-sampling", j));
+            }
+            worker_evaluations.resize(config.number_of_replacements, 0);
+        }
+
+        ~Implementation()
+        {
+            gsl_matrix_free(scale);
+        }
+
+        // evaluate the log(prior) of a worker's posterior at the given point, which is -inf outside the parameter ranges
+        double evaluate_log_prior(const unsigned & j, const std::vector<double> & point) const
+        {
+            auto p = workers[j]->parameter_descriptions().cbegin();
+            for (auto x = point.cbegin(), x_end = point.cend() ; x != x_end ; ++x, ++p)
+            {
+                if ((*x < p->min) || (*x > p->max))
+                    return -std::numeric_limits<double>::infinity();
+
+                p->parameter->set(*x);
+            }
+
+            return workers[j]->log_prior();
+        }
+
+        // evaluate the log(likelihood) of a worker's posterior, at the point of the most recent evaluate_log_prior()
+        double evaluate_log_likelihood(const unsigned & j)
+        {
+            ++worker_evaluations[j];
+
+            return workers[j]->log_likelihood()();
+        }
+
+        template <typename F_> void for_each_worker(const F_ & work)
+        {
+            if (config.parallelize)
+            {
+                ThreadPool::instance()->parallel_for(workers.size(), work);
+            }
+            else
+            {
+                for (unsigned j = 0 ; j < workers.size() ; ++j)
+                {
+                    work(j);
+                }
+            }
+        }
+
+        // draw the initial live points from the priors
+        void initialize()
+        {
+            std::vector<LogPriorPtr> priors;
+            for (const auto & d : *log_posterior)
+            {
+                priors.push_back(log_posterior->log_prior(d.parameter->name()));
+            }
+
+            const unsigned n = config.number_of_live_points;
+            live.resize(n);
+
+            // each worker draws a contiguous block of live points; every point has its own substream
+            auto work = [&] (const unsigned & j)
+            {
+                RandomStream stream(config.seed, "nested-sampling-prior");
+                gsl_rng * rng = stream.rng();
+
+                for (unsigned i = j * n / workers.size(), i_end = (j + 1) * n / workers.size() ; i < i_end ; ++i)
+                {
+                    stream.select(i);
+
+                    Point & p = live[i];
+                    p.point.resize(number_of_parameters);
+                    for (unsigned k = 0 ; k < number_of_parameters ; ++k)
+                    {
+                        p.point[k] = priors[k]->sample(rng);
+                    }
+
+                    p.log_prior = evaluate_log_prior(j, p.point);
+                    p.log_likelihood = evaluate_log_likelihood(j);
+                }
+            };
+            for_each_worker(work);
+        }
+
+        // determine the slice sampling scale from the covariance of the surviving live points
+        void update_scale(const std::vector<Point>::const_iterator & begin, const std::vector<Point>::const_iterator & end)
+        {
+            const unsigned n = std::distance(begin, end);
+            const unsigned d = number_of_parameters;
+
+            std::vector<double> mean(d, 0.0);
+            for (auto p = begin ; p != end ; ++p)
+            {
+                for (unsigned k = 0 ; k < d ; ++k)
+                {
+                    mean[k] += p->point[k] / n;
+                }
+            }
+
+            gsl_matrix_set_zero(scale);
+            for (auto p = begin ; p != end ; ++p)
+            {
+                for (unsigned k = 0 ; k < d ; ++k)
+                {
+                    for (unsigned l = 0 ; l <= k ; ++l)
+                    {
+                        *gsl_matrix_ptr(scale, k, l) += (p->point[k] - mean[k]) * (p->point[l] - mean[l]) / (n - 1);
+                    }
+                }
+            }
+
+            for (unsigned k = 0 ; k < d ; ++k)
+            {
+                for (unsigned l = 0 ; l < k ; ++l)
+                {
+                    gsl_matrix_set(scale, l, k, gsl_matrix_get(scale, k, l));
+                }
+            }
+
+            // fall back to the standard deviations if the live points are (nearly) degenerate
+            std::vector<double> diagonal(d);
+            for (unsigned k = 0 ; k < d ; ++k)
+            {
+                diagonal[k] = gsl_matrix_get(scale, k, k);
+            }
+
+            gsl_error_handler_t * default_gsl_error_handler = gsl_set_error_handler_off();
+            if (GSL_EDOM == gsl_linalg_cholesky_decomp(scale))
+            {
+                Log::instance()->message("nested_sampler.update_scale", ll_debug)
+                    << "Covariance of the live points is not positive definite in iteration " << iteration
+                    << ", using the standard deviations instead";
+
+                gsl_matrix_set_zero(scale);
+                for (unsigned k = 0 ; k < d ; ++k)
+                {
+                    gsl_matrix_set(scale, k, k, std::sqrt(std::max(diagonal[k], std::numeric_limits<double>::epsilon())));
+                }
+            }
+            gsl_set_error_handler(default_gsl_error_handler);
+        }
+
+        /*
+         * Draw from the prior, subject to log(likelihood) > threshold, by slice sampling.
+         * Each step samples along a random direction, with the slice found by stepping out and shrinkage, cf. Neal, sec. 4.
+         */
+        void replace(const unsigned & j, const std::vector<Point>::const_iterator & begin, const std::vector<Point>::const_iterator & end,
+                const double & threshold, Point & result)
+        {
+            RandomStream & stream = streams[j];
+            stream.select(iteration);
+            gsl_rng * rng = stream.rng();
+
+            const unsigned d = number_of_parameters;
+            const unsigned survivors = std::distance(begin, end);
+
+            Point current = *(begin + std::min(unsigned(stream.uniform() * survivors), survivors - 1));
+            Point candidate = current;
+
+            std::vector<double> direction(d), normal(d);
+
+            // is the candidate inside the slice at level log_y and inside the likelihood constraint?
+            auto inside = [&] (const double & t, const double & log_y) -> bool
+            {
+                for (unsigned k = 0 ; k < d ; ++k)
+                {
+                    candidate.point[k] = current.point[k] + t * direction[k];
+                }
+
+                candidate.log_prior = evaluate_log_prior(j, candidate.point);
+                if (candidate.log_prior <= log_y)
+                    return false;
+
+                candidate.log_likelihood = evaluate_log_likelihood(j);
+
+                return candidate.log_likelihood > threshold;
+            };
+
+            static const unsigned max_step_out = 100;
+            static const unsigned max_collapses = 100;
+            unsigned collapses = 0;
+            for (unsigned step = 0, steps = config.slice_steps * d ; step < steps ; )
+            {
+                // random direction, scaled by the covariance of the live points
+                double norm = 0.0;
+                for (unsigned k = 0 ; k < d ; ++k)
+                {
+                    normal[k] = gsl_ran_ugaussian(rng);
+                    norm += normal[k] * normal[k];
+                }
+                norm = std::sqrt(norm);
+
+                for (unsigned k = 0 ; k < d ; ++k)
+                {
+                    direction[k] = 0.0;
+                    for (unsigned l = 0 ; l <= k ; ++l)
+                    {
+                        direction[k] += gsl_matrix_get(scale, k, l) * normal[l] / norm;
+                    }
+                }
+
+                const double log_y = current.log_prior + std::log(stream.uniform());
+
+                // step out
+                double left = -stream.uniform(), right = left + 1.0;
+                for (unsigned k = 0 ; (k < max_step_out) && inside(left, log_y) ; ++k)
+                {
+                    left -= 1.0;
+                }
+
+                for (unsigned k = 0 ; (k < max_step_out) && inside(right, log_y) ; ++k)
+                {
+                    right += 1.0;
+                }
+
+                // shrink
+                bool moved = false;
+                while (true)
+                {
+                    const double t = left + stream.uniform() * (right - left);
+                    if (inside(t, log_y))
+                    {
+                        current = candidate;
+                        moved = true;
+                        break;
+                    }
+
+                    if (t < 0.0)
+                        left = t;
+                    else
+                        right = t;
+
+                    // the slice has collapsed onto the current point, e.g. due to a plateau in the likelihood
+                    if (right - left < std::numeric_limits<double>::epsilon())
+                        break;
+                }
+
+                if (moved)
+                {
+                    ++step;
+                    continue;
+                }
+
+                // retry with a new direction; accepting the current point would duplicate a live point
+                ++collapses;
+                Log::instance()->message("nested_sampler.replace", ll_debug)
+                    << "Slice collapsed onto the current point in iteration " << iteration << ", retrying with a new direction";
+
+                if (max_collapses == collapses)
+                    throw InternalError("NestedSampler: Slice collapsed " + stringify(max_collapses) + " times in iteration "
+                            + stringify(iteration) + ", the likelihood may have a plateau at log(L) = " + stringify(threshold));
+            }
+
+            result = current;
+        }
+
+        void step()
+        {
+            const unsigned n = live.size();
+            const unsigned k = workers.size();
+
+            // remove the k live points with the lowest likelihood; their prior volumes shrink one after the other
+            std::partial_sort(live.begin(), live.begin() + k, live.end(),
+                    [] (const Point & a, const Point & b) { return a.log_likelihood < b.log_likelihood; });
+
+            for (unsigned j = 0 ; j < k ; ++j)
+            {
+                const double shrinkage = 1.0 / (n - j);
+                const double log_width = log_volume + std::log(-std::expm1(-shrinkage));
+
+                dead.push_back(live[j]);
+                dead_log_widths.push_back(log_width);
+                log_evidence_dead = implementation::log_sum_exp(log_evidence_dead, live[j].log_likelihood + log_width);
+
+                log_volume -= shrinkage;
+            }
+
+            // replace the removed points in parallel, starting from the survivors
+            const double threshold = live[k - 1].log_likelihood;
+            const auto survivors_begin = live.cbegin() + k, survivors_end = live.cend();
+            update_scale(survivors_begin, survivors_end);
+
+            std::vector<Point> replacements(k);
+            auto work = [&] (const unsigned & j)
+            {
+                replace(j, survivors_begin, survivors_end, threshold, replacements[j]);
+            };
+            for_each_worker(work);
+
+            std::copy(replacements.begin(), replacements.end(), live.begin());
+
+            ++iteration;
+        }
+
+        // the logarithm of the largest possible contribution of the live points to the evidence
+        double log_remaining_evidence() const
+        {
+            double max_log_likelihood = -std::numeric_limits<double>::infinity();
+            for (const auto & p : live)
+            {
+                max_log_likelihood = std::max(max_log_likelihood, p.log_likelihood);
+            }
+
+            return max_log_likelihood + log_volume;
+        }
+
+        // the logarithms of the weights of all removed points and of the live points, in this order
+        std::vector<double> log_weights() const
+        {
+            std::vector<double> result;
+            result.reserve(dead.size() + live.size());
+
+            for (unsigned i = 0 ; i < dead.size() ; ++i)
+            {
+                result.push_back(dead[i].log_likelihood + dead_log_widths[i]);
+            }
+
+            // the live points share the remaining prior volume equally
+            const double log_live_width = log_volume - std::log(live.size());
+            for (const auto & p : live)
+            {
+                result.push_back(p.log_likelihood + log_live_width);
+            }
+
+            return result;
+        }
+
+        void finalize()
+        {
+            const auto weights = log_weights();
+
+            log_evidence = -std::numeric_limits<double>::infinity();
+            for (const auto & w : weights)
+            {
+                log_evidence = implementation::log_sum_exp(log_evidence, w);
+            }
+
+            // H = int dX L / Z log(L / Z)
+            information = -log_evidence;
+            for (unsigned i = 0 ; i < weights.size() ; ++i)
+            {
+                const Point & p = (i < dead.size()) ? dead[i] : live[i - dead.size()];
+                if (weights[i] > -std::numeric_limits<double>::infinity())
+                    information += std::exp(weights[i] - log_evidence) * p.log_likelihood;
+            }
+
+            log_evidence_uncertainty = std::sqrt(std::max(information, 0.0) / live.size());
+        }
+
+        std::vector<std::vector<double>> posterior_samples() const
+        {
+            const auto weights = log_weights();
+
+            std::vector<double> probabilities(weights.size());
+            double sum = 0.0, sum2 = 0.0;
+            for (unsigned i = 0 ; i < weights.size() ; ++i)
+            {
+                probabilities[i] = std::exp(weights[i] - log_evidence);
+                sum += probabilities[i];
+                sum2 += probabilities[i] * probabilities[i];
+            }
+
+            // systematic resampling down to the effective sample size
+            const unsigned n = std::floor(sum * sum / sum2);
+            RandomStream stream(config.seed, "nested-sampling-resampling");
+
+            std::vector<std::vector<double>> result;
+            result.reserve(n);
+
+            double cumulative = 0.0, target = stream.uniform() * sum / n;
+            for (unsigned i = 0 ; (i < weights.size()) && (result.size() < n) ; ++i)
+            {
+                cumulative += probabilities[i];
+                while ((target < cumulative) && (result.size() < n))
+                {
+                    const Point & p = (i < dead.size()) ? dead[i] : live[i - dead.size()];
+
+                    std::vector<double> sample(p.point);
+                    sample.push_back(p.log_prior + p.log_likelihood);
+                    result.push_back(sample);
+
+                    target += sum / n;
+                }
+            }
+
+            return result;
+        }
+
+        typedef hdf5::Array<1, double> PointType;
+
+        typedef hdf5::Composite<hdf5::Scalar<unsigned>, hdf5::Scalar<double>, hdf5::Scalar<unsigned long>> StateType;
+
+        StateType state_type() const
+        {
+            return StateType
+            {
+                "state",
+                hdf5::Scalar<unsigned>("iteration"),
+                hdf5::Scalar<double>("log(volume)"),
+                hdf5::Scalar<unsigned long>("evaluations")
+            };
+        }
+
+        /*
+         * Store the live points as (parameters, log(prior), log(likelihood)), and the removed points
+         * with the logarithm of their prior volume appended.
+         */
+        void dump_checkpoint() const
+        {
+            // write to a temporary file first, such that an interruption does not destroy the previous checkpoint
+            const std::string temporary_file = config.checkpoint_file + ".tmp";
+
+            {
+                auto file = hdf5::File::Create(temporary_file);
+                dump_checkpoint(file);
+            }
+
+            if (0 != std::rename(temporary_file.c_str(), config.checkpoint_file.c_str()))
+                throw InternalError("NestedSampler: Could not replace the checkpoint '" + config.checkpoint_file
+                        + "' by '" + temporary_file + "'");
+        }
+
+        void dump_checkpoint(hdf5::File & file) const
+        {
+            log_posterior->dump_descriptions(file, "/descriptions");
+
+            {
+                auto data_set = file.create_data_set("/nested sampling/state", state_type());
+                auto record = std::make_tuple(iteration, log_volume, evaluations());
+                data_set << record;
+            }
+
+            {
+                auto data_set = file.create_data_set("/nested sampling/live points", PointType("live point", { number_of_parameters + 2 }));
+                std::vector<double> record(number_of_parameters + 2);
+                for (const auto & p : live)
+                {
+                    std::copy(p.point.cbegin(), p.point.cend(), record.begin());
+                    record[number_of_parameters + 0] = p.log_prior;
+                    record[number_of_parameters + 1] = p.log_likelihood;
+                    data_set << record;
+                }
+            }
+
+            {
+                auto data_set = file.create_data_set("/nested sampling/dead points", PointType("dead point", { number_of_parameters + 3 }));
+                std::vector<double> record(number_of_parameters + 3);
+                for (unsigned i = 0 ; i < dead.size() ; ++i)
+                {
+                    std::copy(dead[i].point.cbegin(), dead[i].point.cend(), record.begin());
+                    record[number_of_parameters + 0] = dead[i].log_prior;
+                    record[number_of_parameters + 1] = dead[i].log_likelihood;
+                    record[number_of_parameters + 2] = dead_log_widths[i];
+                    data_set << record;
+                }
+            }
+        }
+
+        void read_checkpoint()
+        {
+            auto file = hdf5::File::Open(config.checkpoint_file);
+
+            const auto descriptions = LogPosterior::read_descriptions(file, "/descriptions");
+            if (descriptions.size() != number_of_parameters)
+                throw InternalError("NestedSampler: Checkpoint '" + config.checkpoint_file + "' has " + stringify(descriptions.size())
+                        + " parameters, but the posterior has " + stringify(number_of_parameters));
+
+            {
+                auto data_set = file.open_data_set("/nested sampling/state", state_type());
+                auto record = std::make_tuple(0u, 0.0, 0ul);
+                data_set >> record;
+
+                iteration = std::get<0>(record);
+                log_volume = std::get<1>(record);
+                previous_evaluations = std::get<2>(record);
+            }
+
+            {
+                auto data_set = file.open_data_set("/nested sampling/live points", PointType("live point", { number_of_parameters + 2 }));
+                if (data_set.records() != config.number_of_live_points)
+                    throw InternalError("NestedSampler: Checkpoint '" + config.checkpoint_file + "' has " + stringify(data_set.records())
+                            + " live points, but the sampler is configured for " + stringify(unsigned(config.number_of_live_points)));
+
+                std::vector<double> record(number_of_parameters + 2);
+                live.clear();
+                for (unsigned i = 0 ; i < data_set.records() ; ++i)
+                {
+                    data_set >> record;
+                    live.push_back(Point{ std::vector<double>(record.cbegin(), record.cbegin() + number_of_parameters),
+                            record[number_of_parameters + 0], record[number_of_parameters + 1] });
+                }
+            }
+
+            {
+                auto data_set = file.open_data_set("/nested sampling/dead points", PointType("dead point", { number_of_parameters + 3 }));
+                std::vector<double> record(number_of_parameters + 3);
+                dead.clear();
+                dead_log_widths.clear();
+                log_evidence_dead = -std::numeric_limits<double>::infinity();
+                for (unsigned i = 0 ; i < data_set.records() ; ++i)
+                {
+                    data_set >> record;
+                    dead.push_back(Point{ std::vector<double>(record.cbegin(), record.cbegin() + number_of_parameters),
+                            record[number_of_parameters + 0], record[number_of_parameters + 1] });
+                    dead_log_widths.push_back(record[number_of_parameters + 2]);
+                    log_evidence_dead = implementation::log_sum_exp(log_evidence_dead, dead.back().log_likelihood + dead_log_widths.back());
+                }
+            }
+
+            Log::instance()->message("nested_sampler.read_checkpoint", ll_informational)
+                << "Resuming from iteration " << iteration << " of checkpoint '" << config.checkpoint_file << "'";
+        }
+
+        void dump(hdf5::File & file) const
+        {
+            const auto samples = posterior_samples();
+
+            // the layout of a MarkovChainSampler's output, as read by MarkovChain::read_samples
+            log_posterior->dump_descriptions(file, "/descriptions/prerun/chain #0");
+            log_posterior->dump_descriptions(file, "/descriptions/main run/chain #0");
+
+            {
+                auto data_set = file.create_data_set("/main run/chain #0/samples", PointType("samples", { number_of_parameters + 1 }));
+                for (const auto & s : samples)
+                {
+                    data_set << s;
+                }
+            }
+
+            // a Gaussian proposal with the posterior covariance, e.g. for subsequent MCMC runs
+            {
+                std::vector<double> mean(number_of_parameters, 0.0);
+                for (const auto & s : samples)
+                {
+                    for (unsigned k = 0 ; k < number_of_parameters ; ++k)
+                    {
+                        mean[k] += s[k] / samples.size();
+                    }
+                }
+
+                std::vector<double> covariance(number_of_parameters * number_of_parameters, 0.0);
+                for (const auto & s : samples)
+                {
+                    for (unsigned k = 0 ; k < number_of_parameters ; ++k)
+                    {
+                        for (unsigned l = 0 ; l < number_of_parameters ; ++l)
+                        {
+                            covariance[k * number_of_parameters + l] += (s[k] - mean[k]) * (s[l] - mean[l]) / (samples.size() - 1);
+                        }
+                    }
+                }
+
+                proposal_functions::MultivariateGaussian proposal(number_of_parameters, covariance, false);
+                proposal.dump_state(file, "/main run/chain #0/proposal");
+            }
+
+            auto evidence_type = hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>, hdf5::Scalar<double>>
+            (
+                "evidence",
+                hdf5::Scalar<double>("log(evidence)"),
+                hdf5::Scalar<double>("uncertainty"),
+                hdf5::Scalar<double>("information")
+            );
+            auto evidence = file.create_data_set("/nested sampling/evidence", evidence_type);
+            auto record = std::make_tuple(log_evidence, log_evidence_uncertainty, information);
+            evidence << record;
+        }
+
+        void run()
+        {
+            if (config.resume && (! config.checkpoint_file.empty()) && hdf5::File::Exists(config.checkpoint_file))
+            {
+                read_checkpoint();
+            }
+            else
+            {
+                Log::instance()->message("nested_sampler.run", ll_informational)
+                    << "Drawing " << config.number_of_live_points << " live points from the prior";
+
+                initialize();
+            }
+
+            const double log_tolerance = std::log(config.evidence_tolerance);
+            while ((iteration < config.maximum_iterations) && (log_remaining_evidence() - log_evidence_dead >= log_tolerance))
+            {
+                step();
+
+                if (0 == iteration % 100)
+                {
+                    Log::instance()->message("nested_sampler.run", ll_debug)
+                        << "Iteration " << iteration << ": log(volume) = " << log_volume
+                        << ", log(evidence) of removed points = " << log_evidence_dead;
+                }
+
+                if ((! config.checkpoint_file.empty()) && (config.checkpoint_interval > 0) && (0 == iteration % config.checkpoint_interval))
+                    dump_checkpoint();
+            }
+
+            if (! config.checkpoint_file.empty())
+                dump_checkpoint();
+
+            finalize();
+
+            Log::instance()->message("nested_sampler.run", ll_informational)
+                << "log(evidence) = " << log_evidence << " +- " << log_evidence_uncertainty
+                << ", information = " << information
+                << " after " << iteration << " iterations and " << evaluations() << " evaluations of the likelihood";
+
+            if (! config.output_file.empty())
+            {
+                //  overwrite existing file
+                auto file = hdf5::File::Create(config.output_file);
+                dump(file);
+            }
+        }
+
+        unsigned long evaluations() const
+        {
+            unsigned long result = previous_evaluations;
+            for (auto & e : worker_evaluations)
+            {
+                result += e;
+            }
+
+            return result;
+        }
+    };
+
+    NestedSampler::NestedSampler(const LogPosterior & log_posterior, const NestedSampler::Config & config) :
+        PrivateImplementationPattern<NestedSampler>(new Implementation<NestedSampler>(log_posterior, config))
+    {
+    }
+
+    NestedSampler::~NestedSampler()
+    {
+    }
+
+    void
+    NestedSampler::run()
+    {
+        _imp->run();
+    }
+
+    double
+    NestedSampler::log_evidence() const
+    {
+        return _imp->log_evidence;
+    }
+
+    double
+    NestedSampler::log_evidence_uncertainty() const
+    {
+        return _imp->log_evidence_uncertainty;
+    }
+
+    double
+    NestedSampler::information() const
+    {
+        return _imp->information;
+    }
+
+    unsigned
+    NestedSampler::iterations() const
+    {
+        return _imp->iteration;
+    }
+
+    unsigned long
+    NestedSampler::evaluations() const
+    {
+        return _imp->evaluations();
+    }
+
+    std::vector<std::vector<double>>
+    NestedSampler::posterior_samples() const
+    {
+        return _imp->posterior_samples();
+    }
+
+    /* NestedSampler::Config */
+
+    NestedSampler::Config::Config() :
+        number_of_live_points(2, std::numeric_limits<unsigned>::max(), 400),
+        seed(0),
+        parallelize(true),
+        number_of_replacements(1, std::numeric_limits<unsigned>::max(), 4),
+        slice_steps(1, std::numeric_limits<unsigned>::max(), 5),
+        evidence_tolerance(std::numeric_limits<double>::epsilon(), 1.0, 1e-3),
+        maximum_iterations(std::numeric_limits<unsigned>::max()),
+        checkpoint_interval(1000),
+        resume(false)
+    {
+    }
+
+    NestedSampler::Config
+    NestedSampler::Config::Default()
+    {
+        return NestedSampler::Config();
+    }
+
+    std::ostream & operator<<(std::ostream & stream, const NestedSampler::Config & c)
+    {
+        stream << std::boolalpha
+               << "Nested sampling settings:" << std::endl
+               << "live points = " << c.number_of_live_points
+               << ", seed = " << c.seed
+               << ", parallelize = " << c.parallelize << std::endl
+               << "replacements per iteration = " << c.number_of_replacements
+               << ", slice steps per parameter = " << c.slice_steps
+               << ", evidence tolerance = " << c.evidence_tolerance
+               << ", maximum iterations = " << c.maximum_iterations;
+        return stream;
+    }
+}
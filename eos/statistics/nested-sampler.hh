@@ -0,0 +1,181 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_STATISTICS_NESTED_SAMPLER_HH
+#define EOS_GUARD_SRC_STATISTICS_NESTED_SAMPLER_HH 1
+
+#include <eos/statistics/log-posterior.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+#include <eos/utils/verify.hh>
+
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Compute the evidence of a LogPosterior by means of nested sampling, cf. Skilling, Bayesian Anal. 1 (2006) 833.
+     *
+     * The initial live points are drawn from the priors, using LogPrior::sample. In each iteration,
+     * the live points with the lowest log(likelihood) are removed, and replaced by new points that are drawn from
+     * the prior subject to the constraint that their likelihood exceeds that of the removed points.
+     * The new points are obtained by slice sampling, cf. Neal, Ann. Statist. 31 (2003) 705, starting from randomly
+     * chosen surviving live points and along random directions that are scaled by the covariance of the live points.
+     * Several live points are replaced concurrently on the ThreadPool.
+     *
+     * The evidence is accumulated from the removed points, and the posterior samples are obtained by resampling
+     * the removed points according to their weights. The latter are stored in the same format as
+     * the samples of a MarkovChainSampler.
+     */
+    class NestedSampler :
+        public PrivateImplementationPattern<NestedSampler>
+    {
+        public:
+            class Config;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param log_posterior  The posterior to sample from.
+             * @param config         The configuration of the sampler.
+             */
+            NestedSampler(const LogPosterior & log_posterior, const NestedSampler::Config & config);
+
+            /// Destructor.
+            ~NestedSampler();
+            ///@}
+
+            ///@name Sampling
+            ///@{
+            /*!
+             * Run until the remaining live points contribute less than the requested fraction to the evidence,
+             * or until the maximal number of iterations has been reached.
+             * If so requested, continue from the state that was stored in the checkpoint file.
+             */
+            void run();
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Retrieve the logarithm of the evidence.
+            double log_evidence() const;
+
+            /// Retrieve the statistical uncertainty of the log(evidence), sqrt(H / N) with H the information.
+            double log_evidence_uncertainty() const;
+
+            /// Retrieve the information, i.e. the Kullback-Leibler divergence of the posterior from the prior, in nats.
+            double information() const;
+
+            /// Retrieve the number of completed iterations.
+            unsigned iterations() const;
+
+            /// Retrieve the number of evaluations of the likelihood.
+            unsigned long evaluations() const;
+
+            /*!
+             * Retrieve equally weighted posterior samples, obtained by resampling the removed and the remaining live points.
+             * Each sample consists of the parameter values and the log(posterior).
+             * The number of samples equals the effective sample size of the weighted points.
+             */
+            std::vector<std::vector<double>> posterior_samples() const;
+            ///@}
+    };
+
+    /*!
+     * Stores all configuration options for a NestedSampler.
+     */
+    class NestedSampler::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Named constructor
+             *
+             * NestedSampler settings with reasonably chosen default values.
+             */
+            static Config Default();
+            ///@}
+
+            ///@name Basic options
+            ///@{
+            /// Number of live points.
+            VerifiedRange<unsigned> number_of_live_points;
+
+            /*!
+             * The seed that is used to initialize the random number generator.
+             * Independent runs with identical seeds will produce identical results.
+             */
+            unsigned long seed;
+
+            /// If true, the live points are replaced in parallel on the ThreadPool.
+            bool parallelize;
+            ///@}
+
+            ///@name Run options
+            ///@{
+            /*!
+             * The number of live points that are replaced in each iteration.
+             * The results do not depend on whether or not the replacements proceed in parallel.
+             */
+            VerifiedRange<unsigned> number_of_replacements;
+
+            /// The number of slice sampling steps per parameter that lead from a surviving live point to a replacement.
+            VerifiedRange<unsigned> slice_steps;
+
+            /// Stop once the remaining live points can contribute at most this fraction to the evidence.
+            VerifiedRange<double> evidence_tolerance;
+
+            /// Stop after this number of iterations.
+            unsigned maximum_iterations;
+            ///@}
+
+            ///@name Checkpoint options
+            ///@{
+            /// The HDF5 file in which the live and the removed points are stored. If empty, nothing is stored.
+            std::string checkpoint_file;
+
+            /// The number of iterations between two checkpoints. The final state is always stored.
+            unsigned checkpoint_interval;
+
+            /// If true and if the checkpoint file exists, continue from the stored state.
+            bool resume;
+            ///@}
+
+            ///@name Output options
+            ///@{
+            /*!
+             * The HDF5 output file to store the posterior samples and the evidence. If empty, nothing is stored.
+             * The samples are stored as a single Markov chain in '/main run/chain #0', and can be read
+             * e.g. by eos-propagate-uncertainty.
+             */
+            std::string output_file;
+            ///@}
+    };
+
+    std::ostream & operator<<(std::ostream &, const NestedSampler::Config & config);
+}
+
+#endif
@@ -0,0 +1,198 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/log-posterior_TEST.hh>
+#include <eos/statistics/markov-chain.hh>
+#include <eos/statistics/nested-sampler.hh>
+#include <eos/utils/hdf5.hh>
+
+#include <cmath>
+#include <cstdio>
+
+using namespace test;
+using namespace eos;
+
+class NestedSamplerTest :
+    public TestCase
+{
+    public:
+        NestedSamplerTest() :
+            TestCase("nested_sampler_test")
+        {
+        }
+
+        /*
+         * Bimodal posterior: |m_b| is measured as 4.2 +- 0.1, with a flat prior for m_b on [-5, 5],
+         * and m_c is measured as 1.3 +- 0.1, with a flat prior for m_c on [0.8, 1.8].
+         * The modes at m_b = -4.2 and m_b = +4.2 carry equal weight, and the evidence is 2 / 10 * 1 / 1.
+         */
+        static LogPosterior make_bimodal_log_posterior()
+        {
+            Parameters parameters = Parameters::Defaults();
+            Kinematics kinematics;
+
+            LogLikelihood llh(parameters);
+            llh.add(ObservablePtr(new AbsoluteTestObservable(parameters, kinematics, "mass::b(MSbar)")), 4.1, 4.2, 4.3);
+            llh.add(ObservablePtr(new TestObservable(parameters, kinematics, "mass::c")), 1.2, 1.3, 1.4);
+
+            LogPosterior result(llh);
+            result.add(LogPrior::Flat(parameters, "mass::b(MSbar)", ParameterRange{ -5.0, +5.0 }));
+            result.add(LogPrior::Flat(parameters, "mass::c", ParameterRange{ +0.8, +1.8 }));
+
+            return result;
+        }
+
+        virtual void run() const
+        {
+            TEST_SECTION("config",
+            {
+                NestedSampler::Config config = NestedSampler::Config::Default();
+                TEST_CHECK_THROWS(VerifiedRangeUnderflow, config.number_of_live_points = 1);
+                TEST_CHECK_THROWS(VerifiedRangeUnderflow, config.number_of_replacements = 0);
+                TEST_CHECK_THROWS(VerifiedRangeOverflow,  config.evidence_tolerance = 2.0);
+
+                config.number_of_live_points = 10;
+                config.number_of_replacements = 6;
+                TEST_CHECK_THROWS(InternalError, NestedSampler(make_bimodal_log_posterior(), config));
+            });
+
+            // a likelihood without any dependence on the sampled parameter cannot be constrained further
+            TEST_SECTION("plateau",
+            {
+                Parameters parameters = Parameters::Defaults();
+                Kinematics kinematics;
+
+                LogLikelihood llh(parameters);
+                llh.add(ObservablePtr(new TestObservable(parameters, kinematics, "mass::c")), 1.2, 1.3, 1.4);
+
+                LogPosterior log_posterior(llh);
+                log_posterior.add(LogPrior::Flat(parameters, "mass::b(MSbar)", ParameterRange{ 4.0, 5.0 }));
+
+                NestedSampler::Config config = NestedSampler::Config::Default();
+                config.number_of_live_points = 20;
+                config.seed = 1723;
+
+                NestedSampler sampler(log_posterior, config);
+                TEST_CHECK_THROWS(InternalError, sampler.run());
+            });
+
+            /* sample from a bimodal posterior */
+            {
+                NestedSampler::Config config = NestedSampler::Config::Default();
+                config.number_of_live_points = 400;
+                config.number_of_replacements = 4;
+                config.seed = 1723;
+                config.output_file = EOS_BUILDDIR "/eos/statistics/nested-sampler_TEST.hdf5";
+
+                NestedSampler sampler(make_bimodal_log_posterior(), config);
+                sampler.run();
+
+                // evidence, within about three standard deviations
+                TEST_CHECK_NEARLY_EQUAL(sampler.log_evidence(), std::log(0.2), 0.3);
+                TEST_CHECK(sampler.log_evidence_uncertainty() < 0.15);
+                TEST_CHECK(sampler.information() > 0.0);
+
+                // the posterior samples visit both modes equally often
+                const auto samples = sampler.posterior_samples();
+                TEST_CHECK(samples.size() > 1000);
+
+                unsigned positive = 0;
+                double sum_b = 0.0, sum_c = 0.0;
+                for (const auto & s : samples)
+                {
+                    TEST_CHECK_EQUAL(s.size(), 3);
+
+                    if (s[0] > 0.0)
+                        ++positive;
+
+                    sum_b += std::abs(s[0]);
+                    sum_c += s[1];
+                }
+
+                const double n = samples.size();
+                TEST_CHECK_NEARLY_EQUAL(positive / n, 0.5,  0.1);
+                TEST_CHECK_NEARLY_EQUAL(sum_b / n,    4.2,  0.02);
+                TEST_CHECK_NEARLY_EQUAL(sum_c / n,    1.3,  0.02);
+
+                // the results do not depend on the scheduling of the replacements
+                {
+                    config.parallelize = false;
+                    config.output_file = "";
+
+                    NestedSampler serial(make_bimodal_log_posterior(), config);
+                    serial.run();
+
+                    TEST_CHECK_EQUAL(serial.log_evidence(), sampler.log_evidence());
+                    TEST_CHECK_EQUAL(serial.iterations(),   sampler.iterations());
+                    TEST_CHECK_EQUAL(serial.evaluations(),  sampler.evaluations());
+                }
+
+                // a run that is resumed from a checkpoint yields the same results as an uninterrupted run
+                {
+                    const std::string checkpoint_file = EOS_BUILDDIR "/eos/statistics/nested-sampler_TEST-checkpoint.hdf5";
+                    std::remove(checkpoint_file.c_str());
+
+                    // a temporary file left behind by an interrupted write is replaced
+                    {
+                        std::FILE * f = std::fopen((checkpoint_file + ".tmp").c_str(), "w");
+                        std::fputs("interrupted", f);
+                        std::fclose(f);
+                    }
+
+                    config.parallelize = true;
+                    config.checkpoint_file = checkpoint_file;
+                    config.checkpoint_interval = 100;
+                    config.maximum_iterations = 250;
+                    config.resume = true;
+
+                    NestedSampler interrupted(make_bimodal_log_posterior(), config);
+                    interrupted.run();
+                    TEST_CHECK_EQUAL(interrupted.iterations(), 250);
+
+                    // the checkpoint is written to a temporary file, which then replaces the previous checkpoint
+                    TEST_CHECK(nullptr == std::fopen((checkpoint_file + ".tmp").c_str(), "r"));
+
+                    config.maximum_iterations = NestedSampler::Config::Default().maximum_iterations;
+
+                    NestedSampler resumed(make_bimodal_log_posterior(), config);
+                    resumed.run();
+
+                    TEST_CHECK_EQUAL(resumed.log_evidence(), sampler.log_evidence());
+                    TEST_CHECK_EQUAL(resumed.iterations(),   sampler.iterations());
+                    TEST_CHECK_EQUAL(resumed.evaluations(),  sampler.evaluations());
+                }
+
+                // the output is readable by the tools for Markov chains
+                {
+                    hdf5::File file = hdf5::File::Open(EOS_BUILDDIR "/eos/statistics/nested-sampler_TEST.hdf5");
+
+                    auto descriptions = LogPosterior::read_descriptions(file, "/descriptions/prerun/chain #0");
+                    TEST_CHECK_EQUAL(descriptions.size(), 2);
+                    TEST_CHECK_EQUAL(descriptions[0].parameter->name(), "mass::b(MSbar)");
+
+                    std::vector<std::vector<double>> stored;
+                    const unsigned length = MarkovChain::read_samples(file, "/main run/chain #0", 0, samples.size(), stored);
+                    TEST_CHECK_EQUAL(length, samples.size());
+                    TEST_CHECK_EQUAL(stored.size(), samples.size());
+                    TEST_CHECK(stored.front() == std::vector<double>(samples.front().cbegin(), samples.front().cbegin() + 2));
+                }
+            }
+        }
+} nested_sampler_test;
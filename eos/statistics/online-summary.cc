@@ -0,0 +1,333 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/online-summary.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/stringify.hh>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace eos
+{
+    OnlineCovariance::OnlineCovariance(const unsigned & dimension) :
+        _dimension(dimension),
+        _size(0),
+        _mean(dimension, 0.0),
+        _comoment(dimension * (dimension + 1) / 2, 0.0),
+        _delta(dimension, 0.0)
+    {
+    }
+
+    void
+    OnlineCovariance::add(const double * sample)
+    {
+        ++_size;
+
+        for (unsigned i = 0 ; i < _dimension ; ++i)
+        {
+            _delta[i] = sample[i] - _mean[i];
+            _mean[i] += _delta[i] / _size;
+        }
+
+        // C_ij += (x_i - old mean_i) * (x_j - new mean_j)
+        auto c = _comoment.begin();
+        for (unsigned i = 0 ; i < _dimension ; ++i)
+        {
+            for (unsigned j = i ; j < _dimension ; ++j, ++c)
+            {
+                *c += _delta[i] * (sample[j] - _mean[j]);
+            }
+        }
+    }
+
+    void
+    OnlineCovariance::merge(const OnlineCovariance & other)
+    {
+        if (other._dimension != _dimension)
+            throw InternalError("OnlineCovariance::merge: dimensions do not match (" + stringify(_dimension) + " vs " + stringify(other._dimension) + ")");
+
+        if (0 == other._size)
+            return;
+
+        if (0 == _size)
+        {
+            *this = other;
+            return;
+        }
+
+        const double n = _size + other._size;
+        const double factor = double(_size) * other._size / n;
+
+        for (unsigned i = 0 ; i < _dimension ; ++i)
+        {
+            _delta[i] = other._mean[i] - _mean[i];
+            _mean[i] += _delta[i] * other._size / n;
+        }
+
+        auto c = _comoment.begin();
+        auto d = other._comoment.cbegin();
+        for (unsigned i = 0 ; i < _dimension ; ++i)
+        {
+            for (unsigned j = i ; j < _dimension ; ++j, ++c, ++d)
+            {
+                *c += *d + _delta[i] * _delta[j] * factor;
+            }
+        }
+
+        _size += other._size;
+    }
+
+    unsigned
+    OnlineCovariance::dimension() const
+    {
+        return _dimension;
+    }
+
+    unsigned long
+    OnlineCovariance::number_of_elements() const
+    {
+        return _size;
+    }
+
+    const std::vector<double> &
+    OnlineCovariance::mean() const
+    {
+        return _mean;
+    }
+
+    std::vector<double>
+    OnlineCovariance::covariance() const
+    {
+        std::vector<double> result(_dimension * _dimension, 0.0);
+
+        if (_size < 2)
+            return result;
+
+        auto c = _comoment.cbegin();
+        for (unsigned i = 0 ; i < _dimension ; ++i)
+        {
+            for (unsigned j = i ; j < _dimension ; ++j, ++c)
+            {
+                result[i * _dimension + j] = result[j * _dimension + i] = *c / (_size - 1);
+            }
+        }
+
+        return result;
+    }
+
+    QuantileSketch::QuantileSketch(const unsigned & k) :
+        _k(k),
+        _size(0),
+        _min(std::numeric_limits<double>::infinity()),
+        _max(-std::numeric_limits<double>::infinity()),
+        _levels(1),
+        _offset(false)
+    {
+        if (_k < 2)
+            throw InternalError("QuantileSketch: the capacity of each level must be at least 2");
+    }
+
+    void
+    QuantileSketch::_compress()
+    {
+        for (unsigned h = 0 ; h < _levels.size() ; ++h)
+        {
+            if (_levels[h].size() < _k)
+                continue;
+
+            if (_levels.size() == h + 1)
+                _levels.emplace_back();
+
+            auto & level = _levels[h];
+            auto & next = _levels[h + 1];
+
+            std::sort(level.begin(), level.end());
+
+            // an odd value out remains at this level
+            const bool odd = (1 == level.size() % 2);
+            const double leftover = level.back();
+            if (odd)
+                level.pop_back();
+
+            for (unsigned i = _offset ? 1 : 0 ; i < level.size() ; i += 2)
+            {
+                next.push_back(level[i]);
+            }
+            _offset = ! _offset;
+
+            level.clear();
+            if (odd)
+                level.push_back(leftover);
+        }
+    }
+
+    void
+    QuantileSketch::add(const double & value)
+    {
+        ++_size;
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+
+        _levels.front().push_back(value);
+
+        if (_levels.front().size() >= _k)
+            _compress();
+    }
+
+    void
+    QuantileSketch::merge(const QuantileSketch & other)
+    {
+        if (0 == other._size)
+            return;
+
+        _size += other._size;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+
+        if (_levels.size() < other._levels.size())
+            _levels.resize(other._levels.size());
+
+        for (unsigned h = 0 ; h < other._levels.size() ; ++h)
+        {
+            _levels[h].insert(_levels[h].end(), other._levels[h].cbegin(), other._levels[h].cend());
+        }
+
+        _compress();
+    }
+
+    unsigned long
+    QuantileSketch::number_of_elements() const
+    {
+        return _size;
+    }
+
+    double
+    QuantileSketch::quantile(const double & probability) const
+    {
+        if (0 == _size)
+            throw InternalError("QuantileSketch::quantile: no values have been added");
+
+        if (probability <= 0.0)
+            return _min;
+
+        if (probability >= 1.0)
+            return _max;
+
+        std::vector<std::pair<double, unsigned long>> weighted;
+        unsigned long total = 0;
+        for (unsigned h = 0 ; h < _levels.size() ; ++h)
+        {
+            for (const auto & v : _levels[h])
+            {
+                weighted.emplace_back(v, 1ul << h);
+                total += 1ul << h;
+            }
+        }
+
+        std::sort(weighted.begin(), weighted.end());
+
+        const double target = probability * total;
+        double cumulative = 0.0;
+        for (const auto & w : weighted)
+        {
+            cumulative += w.second;
+
+            if (cumulative >= target)
+                return w.first;
+        }
+
+        return _max;
+    }
+
+    OnlineSummary::OnlineSummary(const unsigned & dimension, const bool & covariance, const unsigned & sketch_size) :
+        _dimension(dimension),
+        _moments(dimension),
+        _sketches(dimension, QuantileSketch(sketch_size)),
+        _has_covariance(covariance),
+        _covariance(covariance ? dimension : 0)
+    {
+    }
+
+    void
+    OnlineSummary::add(const double * sample)
+    {
+        for (unsigned i = 0 ; i < _dimension ; ++i)
+        {
+            _moments[i].add(sample[i]);
+            _sketches[i].add(sample[i]);
+        }
+
+        if (_has_covariance)
+            _covariance.add(sample);
+    }
+
+    void
+    OnlineSummary::merge(const OnlineSummary & other)
+    {
+        if ((other._dimension != _dimension) || (other._has_covariance != _has_covariance))
+            throw InternalError("OnlineSummary::merge: summaries are not compatible");
+
+        for (unsigned i = 0 ; i < _dimension ; ++i)
+        {
+            _moments[i].merge(other._moments[i]);
+            _sketches[i].merge(other._sketches[i]);
+        }
+
+        if (_has_covariance)
+            _covariance.merge(other._covariance);
+    }
+
+    unsigned
+    OnlineSummary::dimension() const
+    {
+        return _dimension;
+    }
+
+    unsigned long
+    OnlineSummary::number_of_elements() const
+    {
+        return _dimension > 0 ? _moments.front().number_of_elements() : 0;
+    }
+
+    const Welford &
+    OnlineSummary::moments(const unsigned & i) const
+    {
+        return _moments.at(i);
+    }
+
+    const QuantileSketch &
+    OnlineSummary::quantiles(const unsigned & i) const
+    {
+        return _sketches.at(i);
+    }
+
+    bool
+    OnlineSummary::has_covariance() const
+    {
+        return _has_covariance;
+    }
+
+    const OnlineCovariance &
+    OnlineSummary::covariance() const
+    {
+        return _covariance;
+    }
+}
@@ -0,0 +1,169 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_STATISTICS_ONLINE_SUMMARY_HH
+#define EOS_GUARD_SRC_STATISTICS_ONLINE_SUMMARY_HH 1
+
+#include <eos/statistics/welford.hh>
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Calculate the running mean and covariance matrix of a multivariate
+     * sample. Instances that have seen disjoint samples can be merged.
+     */
+    class OnlineCovariance
+    {
+        private:
+            unsigned _dimension;
+
+            unsigned long _size;
+
+            std::vector<double> _mean;
+
+            // upper triangle of the co-moment matrix, in row-major order
+            std::vector<double> _comoment;
+
+            std::vector<double> _delta;
+
+        public:
+            /*!
+             * Constructor.
+             *
+             * @param dimension The number of components of each sample.
+             */
+            OnlineCovariance(const unsigned & dimension);
+
+            /// Add a sample with dimension() components.
+            void add(const double * sample);
+
+            /// Combine with the running covariance of a disjoint sample.
+            void merge(const OnlineCovariance & other);
+
+            unsigned dimension() const;
+
+            unsigned long number_of_elements() const;
+
+            const std::vector<double> & mean() const;
+
+            /// Return the unbiased estimate of the covariance matrix in row-major order.
+            std::vector<double> covariance() const;
+    };
+
+    /*!
+     * Estimate quantiles of a stream of values within bounded memory,
+     * by means of a hierarchy of compactors,
+     * cf. Karnin, Lang and Liberty, arXiv:1603.05346.
+     *
+     * Each level holds up to k values. Values at level h represent 2^h inputs each.
+     * Whenever a level is full, it is sorted and every other value is promoted to
+     * the next level. The rank error is of order log2(n / k) / k.
+     * Instances that have seen disjoint streams can be merged.
+     */
+    class QuantileSketch
+    {
+        private:
+            unsigned _k;
+
+            unsigned long _size;
+
+            double _min, _max;
+
+            std::vector<std::vector<double>> _levels;
+
+            // alternates which half of a level is promoted
+            bool _offset;
+
+            void _compress();
+
+        public:
+            /*!
+             * Constructor.
+             *
+             * @param k The capacity of each level.
+             */
+            QuantileSketch(const unsigned & k = 256);
+
+            void add(const double & value);
+
+            /// Combine with the sketch of a disjoint stream of values.
+            void merge(const QuantileSketch & other);
+
+            unsigned long number_of_elements() const;
+
+            /*!
+             * Estimate a quantile.
+             *
+             * @param probability The cumulative probability, in the interval [0, 1].
+             */
+            double quantile(const double & probability) const;
+    };
+
+    /*!
+     * Mergeable online summary of a multivariate sample, comprising the mean and variance
+     * and quantile estimates of each component, and optionally the covariance matrix.
+     */
+    class OnlineSummary
+    {
+        private:
+            unsigned _dimension;
+
+            std::vector<Welford> _moments;
+
+            std::vector<QuantileSketch> _sketches;
+
+            bool _has_covariance;
+
+            OnlineCovariance _covariance;
+
+        public:
+            /*!
+             * Constructor.
+             *
+             * @param dimension   The number of components of each sample.
+             * @param covariance  If true, the covariance matrix is accumulated. This costs O(dimension^2) per sample.
+             * @param sketch_size The capacity of each level of the quantile sketches.
+             */
+            OnlineSummary(const unsigned & dimension, const bool & covariance = false, const unsigned & sketch_size = 256);
+
+            /// Add a sample with dimension() components.
+            void add(const double * sample);
+
+            /// Combine with the summary of a disjoint sample.
+            void merge(const OnlineSummary & other);
+
+            unsigned dimension() const;
+
+            unsigned long number_of_elements() const;
+
+            /// Return mean and variance of the i-th component.
+            const Welford & moments(const unsigned & i) const;
+
+            /// Return the quantile sketch of the i-th component.
+            const QuantileSketch & quantiles(const unsigned & i) const;
+
+            bool has_covariance() const;
+
+            const OnlineCovariance & covariance() const;
+    };
+}
+
+#endif
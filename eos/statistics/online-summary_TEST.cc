@@ -0,0 +1,138 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/online-summary.hh>
+
+#include <random>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class OnlineSummaryTest :
+    public TestCase
+{
+    public:
+        OnlineSummaryTest() :
+            TestCase("online_summary_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1e-12;
+
+            // covariance, compared with numpy.cov results
+            {
+                std::vector<std::vector<double>> samples
+                {
+                    { 1.0,  2.0, -1.0 },
+                    { 2.0,  3.5,  0.0 },
+                    { 4.0,  1.0,  2.0 },
+                    { 0.5, -1.0,  3.0 },
+                };
+
+                OnlineCovariance all(3), first(3), second(3);
+                for (unsigned i = 0 ; i < samples.size() ; ++i)
+                {
+                    all.add(samples[i].data());
+                    (i < 1 ? first : second).add(samples[i].data());
+                }
+                first.merge(second);
+
+                for (const auto & c : { all, first })
+                {
+                    TEST_CHECK_EQUAL(c.number_of_elements(), 4u);
+                    TEST_CHECK_RELATIVE_ERROR(c.mean()[0],  1.875, eps);
+                    TEST_CHECK_RELATIVE_ERROR(c.mean()[1],  1.375, eps);
+
+                    auto covariance = c.covariance();
+                    TEST_CHECK_RELATIVE_ERROR(covariance[0 * 3 + 0],  2.39583333333333333, eps);
+                    TEST_CHECK_RELATIVE_ERROR(covariance[0 * 3 + 1],  0.72916666666666667, eps);
+                    TEST_CHECK_RELATIVE_ERROR(covariance[1 * 3 + 0],  0.72916666666666667, eps);
+                    TEST_CHECK_RELATIVE_ERROR(covariance[1 * 3 + 1],  3.5625,              eps);
+                    TEST_CHECK_RELATIVE_ERROR(covariance[0 * 3 + 2],  0.33333333333333333, eps);
+                    TEST_CHECK_RELATIVE_ERROR(covariance[1 * 3 + 2], -2.83333333333333333, eps);
+                    TEST_CHECK_RELATIVE_ERROR(covariance[2 * 3 + 2],  3.33333333333333333, eps);
+                }
+            }
+
+            // quantiles of a sketch that holds all values are exact
+            {
+                QuantileSketch q(16);
+                for (unsigned i = 1 ; i <= 10 ; ++i)
+                {
+                    q.add(11.0 - i);
+                }
+
+                TEST_CHECK_EQUAL(q.number_of_elements(), 10u);
+                TEST_CHECK_EQUAL(q.quantile(0.0),  1.0);
+                TEST_CHECK_EQUAL(q.quantile(0.5),  5.0);
+                TEST_CHECK_EQUAL(q.quantile(0.55), 6.0);
+                TEST_CHECK_EQUAL(q.quantile(1.0), 10.0);
+            }
+
+            // quantiles of a large, merged stream are approximate
+            {
+                std::mt19937 rng(1701);
+                std::normal_distribution<double> normal(0.0, 1.0);
+
+                std::vector<QuantileSketch> sketches(4, QuantileSketch(128));
+                for (unsigned i = 0 ; i < 400000 ; ++i)
+                {
+                    sketches[i % 4].add(normal(rng));
+                }
+
+                QuantileSketch q(128);
+                for (const auto & s : sketches)
+                {
+                    q.merge(s);
+                }
+
+                TEST_CHECK_EQUAL(q.number_of_elements(), 400000u);
+                TEST_CHECK_NEARLY_EQUAL(q.quantile(0.5),       0.0,      0.03);
+                TEST_CHECK_NEARLY_EQUAL(q.quantile(0.158655), -1.0,      0.03);
+                TEST_CHECK_NEARLY_EQUAL(q.quantile(0.841345), +1.0,      0.03);
+                TEST_CHECK_NEARLY_EQUAL(q.quantile(0.975),    +1.959964, 0.05);
+            }
+
+            // summary
+            {
+                OnlineSummary first(2, true), second(2, true);
+
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    const double sample[2] = { double(i), -2.0 * i };
+                    (i < 30 ? first : second).add(sample);
+                }
+
+                first.merge(second);
+
+                TEST_CHECK_EQUAL(first.number_of_elements(), 100u);
+                TEST_CHECK_RELATIVE_ERROR(first.moments(0).mean(),      49.5, eps);
+                TEST_CHECK_RELATIVE_ERROR(first.moments(1).variance(),  4.0 * 841.66666666666667, eps);
+                TEST_CHECK_EQUAL(first.quantiles(0).quantile(0.5), 49.0);
+                TEST_CHECK(first.has_covariance());
+                TEST_CHECK_RELATIVE_ERROR(first.covariance().covariance()[1], -2.0 * 841.66666666666667, eps);
+
+                TEST_CHECK_THROWS(InternalError, first.merge(OnlineSummary(2, false)));
+            }
+        }
+} online_summary_test;
@@ -0,0 +1,625 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/parallel-tempering-sampler.hh>
+#include <eos/statistics/proposal-functions.hh>
+#include <eos/statistics/welford.hh>
+#include <eos/utils/density.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/power_of.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace eos
+{
+    namespace implementation
+    {
+        /*
+         * The tempered posterior log(prior) + beta * log(likelihood).
+         *
+         * All clones share the inverse temperature, so that the sampler can change it
+         * for the MarkovChain that owns a clone.
+         */
+        class TemperedLogPosterior :
+            public Density
+        {
+            private:
+                LogPosteriorPtr _log_posterior;
+
+                std::shared_ptr<double> _beta;
+
+            public:
+                TemperedLogPosterior(const LogPosteriorPtr & log_posterior, const std::shared_ptr<double> & beta) :
+                    _log_posterior(log_posterior),
+                    _beta(beta)
+                {
+                }
+
+                virtual ~TemperedLogPosterior()
+                {
+                }
+
+                virtual double evaluate() const
+                {
+                    return _log_posterior->log_prior() + *_beta * _log_posterior->log_likelihood()();
+                }
+
+                virtual DensityPtr clone() const
+                {
+                    return DensityPtr(new TemperedLogPosterior(_log_posterior->old_clone(), _beta));
+                }
+
+                virtual Density::Iterator begin() const
+                {
+                    return _log_posterior->begin();
+                }
+
+                virtual Density::Iterator end() const
+                {
+                    return _log_posterior->end();
+                }
+
+                virtual void dump_descriptions(hdf5::File & file, const std::string & data_set_base) const
+                {
+                    _log_posterior->dump_descriptions(file, data_set_base);
+                }
+        };
+    }
+
+    template <>
+    struct Implementation<ParallelTemperingSampler>
+    {
+        // the posterior at beta = 1
+        LogPosteriorPtr log_posterior;
+
+        // a copy of the posterior, used to evaluate the prior at the replicas' states
+        LogPosteriorPtr probe;
+
+        // our configuration options
+        ParallelTemperingSampler::Config config;
+
+        // number of scan parameters
+        unsigned number_of_parameters;
+
+        // the inverse temperatures, shared with the replicas' densities
+        std::vector<std::shared_ptr<double>> betas;
+
+        // the replicas, in order of decreasing inverse temperature
+        std::vector<MarkovChain> chains;
+
+        // random numbers for the swaps
+        RandomStream stream;
+
+        // log(prior) and log(likelihood) at the replicas' current states
+        std::vector<double> log_priors, log_likelihoods;
+
+        // the probabilities to swap replicas i and i + 1 in the most recent sweep
+        std::vector<double> swap_probabilities;
+
+        // the number of accepted swaps between replicas i and i + 1, and the number of attempts
+        std::vector<unsigned long> swaps_accepted;
+        unsigned long swap_attempts;
+
+        // the number of accepted and rejected proposals of each replica since the last adaptation of the proposal functions
+        std::vector<unsigned> accepted, rejected;
+
+        // mean of the log(likelihood) of each replica in the main run
+        std::vector<Welford> mean_log_likelihoods;
+
+        double log_evidence, log_evidence_uncertainty;
+
+        Implementation(const LogPosterior & log_posterior, const ParallelTemperingSampler::Config & config) :
+            log_posterior(log_posterior.old_clone()),
+            probe(log_posterior.old_clone()),
+            config(config),
+            stream(config.seed, "parallel-tempering-swaps"),
+            swap_attempts(0),
+            log_evidence(std::numeric_limits<double>::quiet_NaN()),
+            log_evidence_uncertainty(std::numeric_limits<double>::quiet_NaN())
+        {
+            initialize();
+        }
+
+        void initialize()
+        {
+            number_of_parameters = std::distance(log_posterior->begin(), log_posterior->end());
+
+            if (0 == config.sweep_size)
+                throw InternalError("ParallelTemperingSampler: The sweep size must be positive");
+
+            if (0 == config.proposal_adaptation_sweeps)
+                throw InternalError("ParallelTemperingSampler: The number of sweeps between adaptations of the proposal functions must be positive");
+
+            // proposal covariance
+            if (config.proposal_initial_covariance.size() != power_of<2>(number_of_parameters))
+            {
+                Log::instance()->message("parallel_tempering_sampler.initialize", ll_informational)
+                    << "Determining initial proposal covariance assuming flat priors";
+
+                config.proposal_initial_covariance.assign(power_of<2>(number_of_parameters), 0.0);
+
+                unsigned par = 0;
+                for (auto & def : *log_posterior)
+                {
+                    config.proposal_initial_covariance[par + number_of_parameters * par] =
+                            power_of<2>(def.max - def.min) / 12.0;
+                    ++par;
+                }
+            }
+
+            if ((config.proposal != "MultivariateGaussian") && (config.proposal != "MultivariateStudentT"))
+            {
+                Log::instance()->message("parallel_tempering_sampler.initialize", ll_warning)
+                    << "No proposal function of name '" << config.proposal << "' registered."
+                    << "Falling back to MultivariateGaussian.";
+            }
+
+            /* setup replicas on a geometric ladder of inverse temperatures */
+
+            const unsigned n = config.number_of_replicas;
+            for (unsigned i = 0 ; i < n ; ++i)
+            {
+                const double beta = (i + 1 < n) ? std::pow(double(config.minimum_inverse_temperature), double(i) / (n - 1)) : double(config.minimum_inverse_temperature);
+                betas.push_back(std::make_shared<double>(beta));
+
+                DensityPtr density(new implementation::TemperedLogPosterior(log_posterior, betas.back()));
+                chains.push_back(MarkovChain(density, RandomStream(config.seed, "parallel-tempering", i), make_proposal()));
+            }
+
+            log_priors.resize(n);
+            log_likelihoods.resize(n);
+            swap_probabilities.resize(n - 1);
+            swaps_accepted.resize(n - 1);
+            accepted.resize(n);
+            rejected.resize(n);
+            mean_log_likelihoods.resize(n);
+
+            for (unsigned i = 0 ; i < n ; ++i)
+            {
+                update_log_likelihood(i);
+            }
+        }
+
+        ProposalFunctionPtr make_proposal() const
+        {
+            if (config.proposal == "MultivariateStudentT")
+            {
+                return ProposalFunctionPtr(new proposal_functions::MultivariateStudentT(number_of_parameters, config.proposal_initial_covariance,
+                                                                                         config.student_t_degrees_of_freedom, config.scale_automatic));
+            }
+
+            return ProposalFunctionPtr(new proposal_functions::MultivariateGaussian(number_of_parameters, config.proposal_initial_covariance,
+                                                                                     config.scale_automatic));
+        }
+
+        // split the log(density) of a replica's current state into log(prior) and log(likelihood)
+        void update_log_likelihood(const unsigned & i)
+        {
+            const MarkovChain::State & state = chains[i].current_state();
+
+            auto p = probe->parameter_descriptions().cbegin();
+            for (auto x = state.point.cbegin(), x_end = state.point.cend() ; x != x_end ; ++x, ++p)
+            {
+                p->parameter->set(*x);
+            }
+
+            log_priors[i] = probe->log_prior();
+            log_likelihoods[i] = (state.log_density - log_priors[i]) / *betas[i];
+        }
+
+        // let replica i continue from the given point, without evaluating the posterior
+        void install(const unsigned & i, const std::vector<double> & point)
+        {
+            MarkovChain::State state;
+            state.point = point;
+            state.log_density = log_priors[i] + *betas[i] * log_likelihoods[i];
+
+            chains[i].set_state(state);
+        }
+
+        // attempt to swap the states of all pairs of neighbouring replicas, beginning with the hottest pair
+        void exchange()
+        {
+            for (unsigned i = chains.size() - 1 ; i > 0 ; --i)
+            {
+                const double log_r = (*betas[i - 1] - *betas[i]) * (log_likelihoods[i] - log_likelihoods[i - 1]);
+                swap_probabilities[i - 1] = (log_r < 0.0) ? std::exp(log_r) : 1.0;
+
+                if (std::log(stream.uniform()) >= log_r)
+                    continue;
+
+                const std::vector<double> colder = chains[i - 1].current_state().point;
+                const std::vector<double> hotter = chains[i].current_state().point;
+
+                std::swap(log_priors[i - 1], log_priors[i]);
+                std::swap(log_likelihoods[i - 1], log_likelihoods[i]);
+                install(i - 1, hotter);
+                install(i, colder);
+
+                ++swaps_accepted[i - 1];
+            }
+
+            ++swap_attempts;
+        }
+
+        // run all replicas for one sweep, then attempt to swap their states
+        void sweep()
+        {
+            auto work = [this] (const unsigned & i)
+            {
+                chains[i].run(config.sweep_size);
+                accepted[i] += chains[i].statistics().iterations_accepted;
+                rejected[i] += chains[i].statistics().iterations_rejected;
+            };
+
+            if (config.parallelize)
+            {
+                ThreadPool::instance()->parallel_for(chains.size(), work);
+            }
+            else
+            {
+                for (unsigned i = 0 ; i < chains.size() ; ++i)
+                {
+                    work(i);
+                }
+            }
+
+            for (unsigned i = 0 ; i < chains.size() ; ++i)
+            {
+                update_log_likelihood(i);
+            }
+
+            exchange();
+        }
+
+        /*
+         * Adapt the inverse temperatures to equalize the swap acceptance rates, cf. Vousden, Farr and Mandel, eq. (12).
+         * The logarithm of the temperature difference of each pair of neighbours grows with the difference
+         * of its swap acceptance to that of the next hotter pair. The smallest inverse temperature remains fixed.
+         */
+        void adapt_temperatures(const unsigned & t)
+        {
+            const unsigned n = chains.size();
+            const double kappa = 1.0 / config.adaptation_time * config.adaptation_lag / (t + config.adaptation_lag);
+
+            std::vector<double> gaps(n - 1);
+            for (unsigned i = 0 ; i < n - 1 ; ++i)
+            {
+                gaps[i] = 1.0 / *betas[i + 1] - 1.0 / *betas[i];
+            }
+
+            for (unsigned i = 0 ; i < n - 2 ; ++i)
+            {
+                gaps[i] *= std::exp(kappa * (swap_probabilities[i] - swap_probabilities[i + 1]));
+            }
+
+            // keep the highest temperature fixed
+            double sum = 0.0;
+            for (auto g : gaps)
+            {
+                sum += g;
+            }
+            const double scale = (1.0 / config.minimum_inverse_temperature - 1.0) / sum;
+
+            double temperature = 1.0;
+            for (unsigned i = 1 ; i < n - 1 ; ++i)
+            {
+                temperature += gaps[i - 1] * scale;
+                *betas[i] = 1.0 / temperature;
+            }
+
+            // the replicas' states remain, but their log(density) changes
+            for (unsigned i = 1 ; i < n - 1 ; ++i)
+            {
+                install(i, chains[i].current_state().point);
+            }
+        }
+
+        void adapt_proposals()
+        {
+            for (unsigned i = 0 ; i < chains.size() ; ++i)
+            {
+                const auto & states = chains[i].history().states;
+                const double efficiency = 1.0 * accepted[i] / (accepted[i] + rejected[i]);
+
+                chains[i].proposal_function()->adapt(states.cbegin(), states.cend(), efficiency, config.min_efficiency, config.max_efficiency);
+                chains[i].clear();
+
+                Log::instance()->message("parallel_tempering_sampler.adapt_proposals", ll_debug)
+                    << "Efficiency of replica " << i << " at beta = " << *betas[i] << ": " << stringify(efficiency, 4);
+
+                accepted[i] = 0;
+                rejected[i] = 0;
+            }
+        }
+
+        /*
+         * Integrate the mean log(likelihood) over beta, using every stride-th inverse temperature.
+         * On a roughly geometric ladder, the integrand beta * <log(likelihood)> varies slowly in log(beta),
+         * which is why the trapezoidal rule is applied in log(beta).
+         */
+        double thermodynamic_integration(const unsigned & stride) const
+        {
+            // (beta, mean log(likelihood)) in order of increasing beta
+            std::vector<std::pair<double, double>> points;
+            for (unsigned i = 0 ; i < chains.size() ; i += stride)
+            {
+                points.push_back(std::make_pair(*betas[i], mean_log_likelihoods[i].mean()));
+            }
+            std::reverse(points.begin(), points.end());
+
+            // continue the integrand to beta = 0 with its value at the smallest inverse temperature
+            double result = points.front().first * points.front().second;
+            for (unsigned k = 1 ; k < points.size() ; ++k)
+            {
+                result += 0.5 * std::log(points[k].first / points[k - 1].first)
+                    * (points[k].first * points[k].second + points[k - 1].first * points[k - 1].second);
+            }
+
+            return result;
+        }
+
+        void dump(hdf5::File & file) const
+        {
+            const auto & states = chains.front().history().states;
+            if (! states.empty())
+            {
+                chains.front().dump_history(file, "/main run/chain #0", states.size());
+                chains.front().dump_proposal(file, "/main run/chain #0");
+            }
+
+            auto ladder_type = hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>, hdf5::Scalar<double>>
+            (
+                "ladder",
+                hdf5::Scalar<double>("inverse temperature"),
+                hdf5::Scalar<double>("swap acceptance"),
+                hdf5::Scalar<double>("mean log(likelihood)")
+            );
+            auto ladder = file.create_data_set("/parallel tempering/ladder", ladder_type);
+            for (unsigned i = 0 ; i < chains.size() ; ++i)
+            {
+                // the last replica has no hotter neighbour
+                const double rate = (i + 1 < chains.size()) ? 1.0 * swaps_accepted[i] / swap_attempts : 0.0;
+                auto record = std::make_tuple(*betas[i], rate, mean_log_likelihoods[i].mean());
+                ladder << record;
+            }
+
+            auto evidence_type = hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>>
+            (
+                "evidence",
+                hdf5::Scalar<double>("log(evidence)"),
+                hdf5::Scalar<double>("uncertainty")
+            );
+            auto evidence = file.create_data_set("/parallel tempering/evidence", evidence_type);
+            auto record = std::make_tuple(log_evidence, log_evidence_uncertainty);
+            evidence << record;
+        }
+
+        void run()
+        {
+            if (! config.output_file.empty())
+            {
+                //  overwrite existing file
+                auto file = hdf5::File::Create(config.output_file);
+                log_posterior->dump_descriptions(file, "/descriptions/main run/chain #0");
+            }
+
+            /* burn-in */
+
+            Log::instance()->message("parallel_tempering_sampler.run", ll_informational)
+                << "Burn-in with " << chains.size() << " replicas for " << config.burn_in_sweeps << " sweeps";
+
+            for (auto & c : chains)
+            {
+                c.keep_history(true);
+            }
+
+            for (unsigned t = 0 ; t < config.burn_in_sweeps ; ++t)
+            {
+                sweep();
+
+                if (config.adapt_temperatures)
+                    adapt_temperatures(t);
+
+                if (0 == (t + 1) % config.proposal_adaptation_sweeps)
+                    adapt_proposals();
+            }
+
+            Log::instance()->message("parallel_tempering_sampler.run", ll_informational)
+                << "Inverse temperatures after burn-in: " << stringify_container(inverse_temperatures(), 4);
+
+            /* main run */
+
+            for (unsigned i = 0 ; i < chains.size() ; ++i)
+            {
+                chains[i].clear();
+                chains[i].reset(true);
+                chains[i].keep_history(0 == i);
+
+                mean_log_likelihoods[i] = Welford();
+            }
+            std::fill(swaps_accepted.begin(), swaps_accepted.end(), 0);
+            swap_attempts = 0;
+
+            for (unsigned t = 0 ; t < config.sweeps ; ++t)
+            {
+                sweep();
+
+                for (unsigned i = 0 ; i < chains.size() ; ++i)
+                {
+                    mean_log_likelihoods[i].add(log_likelihoods[i]);
+                }
+            }
+
+            if (config.sweeps > 0)
+            {
+                log_evidence = thermodynamic_integration(1);
+                log_evidence_uncertainty = std::abs(log_evidence - thermodynamic_integration(2));
+
+                Log::instance()->message("parallel_tempering_sampler.run", ll_informational)
+                    << "Swap acceptance rates: " << stringify_container(swap_acceptance_rates(), 4);
+
+                Log::instance()->message("parallel_tempering_sampler.run", ll_informational)
+                    << "log(evidence) = " << log_evidence << " +- " << log_evidence_uncertainty
+                    << " after " << evaluations() << " evaluations of the posterior";
+            }
+
+            if (! config.output_file.empty())
+            {
+                auto file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
+                dump(file);
+            }
+        }
+
+        std::vector<double> inverse_temperatures() const
+        {
+            std::vector<double> result;
+            for (auto & b : betas)
+            {
+                result.push_back(*b);
+            }
+
+            return result;
+        }
+
+        std::vector<double> swap_acceptance_rates() const
+        {
+            std::vector<double> result;
+            for (auto & s : swaps_accepted)
+            {
+                result.push_back((swap_attempts > 0) ? 1.0 * s / swap_attempts : 0.0);
+            }
+
+            return result;
+        }
+
+        unsigned long evaluations() const
+        {
+            unsigned long result = 0;
+            for (auto & c : chains)
+            {
+                result += c.evaluations();
+            }
+
+            return result;
+        }
+    };
+
+    ParallelTemperingSampler::ParallelTemperingSampler(const LogPosterior & log_posterior, const ParallelTemperingSampler::Config & config) :
+        PrivateImplementationPattern<ParallelTemperingSampler>(new Implementation<ParallelTemperingSampler>(log_posterior, config))
+    {
+    }
+
+    ParallelTemperingSampler::~ParallelTemperingSampler()
+    {
+    }
+
+    void
+    ParallelTemperingSampler::run()
+    {
+        _imp->run();
+    }
+
+    const MarkovChain::History &
+    ParallelTemperingSampler::history() const
+    {
+        return _imp->chains.front().history();
+    }
+
+    std::vector<double>
+    ParallelTemperingSampler::inverse_temperatures() const
+    {
+        return _imp->inverse_temperatures();
+    }
+
+    std::vector<double>
+    ParallelTemperingSampler::swap_acceptance_rates() const
+    {
+        return _imp->swap_acceptance_rates();
+    }
+
+    double
+    ParallelTemperingSampler::log_evidence() const
+    {
+        return _imp->log_evidence;
+    }
+
+    double
+    ParallelTemperingSampler::log_evidence_uncertainty() const
+    {
+        return _imp->log_evidence_uncertainty;
+    }
+
+    unsigned long
+    ParallelTemperingSampler::evaluations() const
+    {
+        return _imp->evaluations();
+    }
+
+    /* ParallelTemperingSampler::Config */
+
+    ParallelTemperingSampler::Config::Config() :
+        number_of_replicas(2, std::numeric_limits<unsigned>::max(), 8),
+        seed(0),
+        parallelize(true),
+        minimum_inverse_temperature(std::numeric_limits<double>::epsilon(), 1.0 - std::numeric_limits<double>::epsilon(), 1e-3),
+        adapt_temperatures(true),
+        adaptation_lag(std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::max(), 100.0),
+        adaptation_time(std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::max(), 10.0),
+        proposal("MultivariateGaussian"),
+        student_t_degrees_of_freedom(std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::max(), 1.0),
+        scale_automatic(true),
+        min_efficiency(0, 1, 0.15),
+        max_efficiency(0, 1, 0.35),
+        proposal_adaptation_sweeps(50),
+        sweep_size(10),
+        burn_in_sweeps(1000),
+        sweeps(5000)
+    {
+    }
+
+    ParallelTemperingSampler::Config
+    ParallelTemperingSampler::Config::Default()
+    {
+        return ParallelTemperingSampler::Config();
+    }
+
+    std::ostream & operator<<(std::ostream & stream, const ParallelTemperingSampler::Config & c)
+    {
+        stream << std::boolalpha
+               << "Parallel tempering settings:" << std::endl
+               << "replicas = " << c.number_of_replicas
+               << ", seed = " << c.seed
+               << ", parallelize = " << c.parallelize
+               << ", minimum inverse temperature = " << c.minimum_inverse_temperature
+               << ", adapt temperatures = " << c.adapt_temperatures << std::endl
+               << "sweep size = " << c.sweep_size
+               << ", burn-in sweeps = " << c.burn_in_sweeps
+               << ", sweeps = " << c.sweeps;
+        return stream;
+    }
+}
@@ -0,0 +1,203 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_STATISTICS_PARALLEL_TEMPERING_SAMPLER_HH
+#define EOS_GUARD_SRC_STATISTICS_PARALLEL_TEMPERING_SAMPLER_HH 1
+
+#include <eos/statistics/log-posterior.hh>
+#include <eos/statistics/markov-chain.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+#include <eos/utils/verify.hh>
+
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Sample from a LogPosterior by means of parallel tempering, also known as replica exchange,
+     * cf. Swendsen and Wang, Phys. Rev. Lett. 57 (1986) 2607.
+     *
+     * Each replica is a MarkovChain that samples from the tempered posterior
+     *
+     *   log P_beta(x) = log prior(x) + beta * log likelihood(x),
+     *
+     * with inverse temperatures 1 = beta_0 > beta_1 > ... > beta_{N-1} > 0. The replicas run concurrently
+     * on the ThreadPool. After each sweep, the states of neighbouring replicas are exchanged in a Metropolis step,
+     * which carries states from the hot replicas, that move freely between well-separated modes,
+     * down to the replica at beta = 1.
+     *
+     * During the burn-in, the proposal functions are adapted, and the inverse temperatures are adapted such that
+     * the swap acceptance rates become equal along the ladder, cf. Vousden, Farr and Mandel, MNRAS 455 (2016) 1919.
+     * The evidence is estimated by thermodynamic integration of the mean log(likelihood) over beta.
+     */
+    class ParallelTemperingSampler :
+        public PrivateImplementationPattern<ParallelTemperingSampler>
+    {
+        public:
+            class Config;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param log_posterior  The posterior to sample from.
+             * @param config         The configuration of the sampler.
+             */
+            ParallelTemperingSampler(const LogPosterior & log_posterior, const ParallelTemperingSampler::Config & config);
+
+            /// Destructor.
+            ~ParallelTemperingSampler();
+            ///@}
+
+            ///@name Sampling
+            ///@{
+            /// Run the burn-in, followed by the main run.
+            void run();
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Retrieve the samples of the replica at beta = 1 from the main run.
+            const MarkovChain::History & history() const;
+
+            /// Retrieve the inverse temperatures, in decreasing order and beginning with beta = 1.
+            std::vector<double> inverse_temperatures() const;
+
+            /// Retrieve the fraction of accepted swaps between the replicas i and i + 1 in the main run.
+            std::vector<double> swap_acceptance_rates() const;
+
+            /// Retrieve the logarithm of the evidence, as obtained from thermodynamic integration in the main run.
+            double log_evidence() const;
+
+            /*!
+             * Retrieve an estimate of the discretization error of the log(evidence), i.e.,
+             * the difference to the integral that uses only every other inverse temperature.
+             */
+            double log_evidence_uncertainty() const;
+
+            /// Retrieve the number of evaluations of the posterior by all replicas.
+            unsigned long evaluations() const;
+            ///@}
+    };
+
+    /*!
+     * Stores all configuration options for a ParallelTemperingSampler.
+     */
+    class ParallelTemperingSampler::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Named constructor
+             *
+             * ParallelTemperingSampler settings with reasonably chosen default values.
+             */
+            static Config Default();
+            ///@}
+
+            ///@name Basic options
+            ///@{
+            /// Number of replicas, i.e., of inverse temperatures.
+            VerifiedRange<unsigned> number_of_replicas;
+
+            /*!
+             * The seed that is used to initialize the random number generator.
+             * Independent runs with identical seeds will produce identical results.
+             */
+            unsigned long seed;
+
+            /// If true, the replicas proceed in parallel on the ThreadPool.
+            bool parallelize;
+            ///@}
+
+            ///@name Temperature ladder options
+            ///@{
+            /// The smallest inverse temperature. The initial ladder is geometric between this value and 1.
+            VerifiedRange<double> minimum_inverse_temperature;
+
+            /// Whether to adapt the inverse temperatures during the burn-in.
+            bool adapt_temperatures;
+
+            /// The number of sweeps after which the adaptation of the inverse temperatures has decayed to one half.
+            VerifiedRange<double> adaptation_lag;
+
+            /// The time scale, in sweeps, on which the inverse temperatures are adapted initially.
+            VerifiedRange<double> adaptation_time;
+            ///@}
+
+            ///@name Proposal options
+            ///@{
+            /// Which local proposal function is chosen.
+            std::string proposal;
+
+            /// Initial covariance matrix for multivariate proposal
+            std::vector<double> proposal_initial_covariance;
+
+            /*!
+             *  The number of degrees of freedom for a local proposal function
+             *  of type MultivariateStudentT
+             *  @note a value of one corresponds to a (multivariate) Cauchy function
+             */
+            VerifiedRange<double> student_t_degrees_of_freedom;
+
+            /// Rescale multivariate proposal functions' covariance depending
+            /// on the dimensionality of the parameter space.
+            bool scale_automatic;
+
+            /// #accepted / #trials of each replica should be between min_efficiency and max_efficiency.
+            VerifiedRange<double> min_efficiency;
+            VerifiedRange<double> max_efficiency;
+
+            /// The number of sweeps between adaptations of the proposal functions during the burn-in.
+            unsigned proposal_adaptation_sweeps;
+            ///@}
+
+            ///@name Run options
+            ///@{
+            /// The number of iterations of each replica between two attempts to swap states.
+            unsigned sweep_size;
+
+            /// The number of sweeps of the burn-in.
+            unsigned burn_in_sweeps;
+
+            /// The number of sweeps of the main run.
+            unsigned sweeps;
+            ///@}
+
+            ///@name Output options
+            ///@{
+            /*!
+             * The HDF5 output file to store the samples of the replica at beta = 1,
+             * the temperature ladder and the evidence. If empty, nothing is stored.
+             */
+            std::string output_file;
+            ///@}
+    };
+
+    std::ostream & operator<<(std::ostream &, const ParallelTemperingSampler::Config & config);
+}
+
+#endif
@@ -0,0 +1,139 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/log-posterior_TEST.hh>
+#include <eos/statistics/parallel-tempering-sampler.hh>
+#include <eos/utils/hdf5.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+class ParallelTemperingSamplerTest :
+    public TestCase
+{
+    public:
+        ParallelTemperingSamplerTest() :
+            TestCase("parallel_tempering_sampler_test")
+        {
+        }
+
+        /*
+         * Bimodal posterior: |m_b| is measured as 4.2 +- 0.1, with a flat prior for m_b on [-5, 5].
+         * The modes at m_b = -4.2 and m_b = +4.2 carry equal weight, and the evidence is 2 / 10.
+         */
+        static LogPosterior make_bimodal_log_posterior()
+        {
+            Parameters parameters = Parameters::Defaults();
+            Kinematics kinematics;
+
+            LogLikelihood llh(parameters);
+            llh.add(ObservablePtr(new AbsoluteTestObservable(parameters, kinematics, "mass::b(MSbar)")), 4.1, 4.2, 4.3);
+
+            LogPosterior result(llh);
+            result.add(LogPrior::Flat(parameters, "mass::b(MSbar)", ParameterRange{ -5.0, +5.0 }));
+
+            return result;
+        }
+
+        virtual void run() const
+        {
+            TEST_SECTION("config",
+            {
+                ParallelTemperingSampler::Config config = ParallelTemperingSampler::Config::Default();
+                TEST_CHECK_THROWS(VerifiedRangeUnderflow, config.number_of_replicas = 1);
+                TEST_CHECK_THROWS(VerifiedRangeOverflow,  config.minimum_inverse_temperature = 1.0);
+            });
+
+            /* sample from a bimodal posterior */
+            {
+                ParallelTemperingSampler::Config config = ParallelTemperingSampler::Config::Default();
+                config.number_of_replicas = 16;
+                config.minimum_inverse_temperature = 1e-4;
+                config.seed = 1723;
+                config.burn_in_sweeps = 500;
+                config.sweeps = 4000;
+                config.output_file = EOS_BUILDDIR "/eos/statistics/parallel-tempering-sampler_TEST.hdf5";
+
+                ParallelTemperingSampler sampler(make_bimodal_log_posterior(), config);
+                sampler.run();
+
+                // the ladder remains ordered, and its end points are fixed
+                auto betas = sampler.inverse_temperatures();
+                TEST_CHECK_EQUAL(betas.size(), 16);
+                TEST_CHECK_EQUAL(betas.front(), 1.0);
+                TEST_CHECK_NEARLY_EQUAL(betas.back(), 1e-4, 1e-15);
+                for (unsigned i = 1 ; i < betas.size() ; ++i)
+                {
+                    TEST_CHECK(betas[i] < betas[i - 1]);
+                }
+
+                for (auto r : sampler.swap_acceptance_rates())
+                {
+                    TEST_CHECK(r > 0.1);
+                }
+
+                // the replica at beta = 1 visits both modes equally often
+                const auto & states = sampler.history().states;
+                TEST_CHECK_EQUAL(states.size(), 4000 * 10);
+
+                unsigned positive = 0;
+                double sum = 0.0, sum2 = 0.0;
+                for (const auto & s : states)
+                {
+                    const double x = s.point.front();
+                    if (x > 0.0)
+                        ++positive;
+
+                    sum += std::abs(x);
+                    sum2 += x * x;
+                }
+
+                const double n = states.size();
+                TEST_CHECK_NEARLY_EQUAL(positive / n,                         0.5,  0.05);
+                TEST_CHECK_NEARLY_EQUAL(sum / n,                              4.2,  0.01);
+                TEST_CHECK_NEARLY_EQUAL(sum2 / n - (sum / n) * (sum / n),     0.01, 0.002);
+
+                // thermodynamic integration
+                TEST_CHECK_NEARLY_EQUAL(sampler.log_evidence(), std::log(0.2), 0.1);
+                TEST_CHECK(sampler.log_evidence_uncertainty() < 0.2);
+
+                // the results do not depend on the scheduling of the replicas
+                {
+                    config.parallelize = false;
+                    config.output_file = "";
+
+                    ParallelTemperingSampler serial(make_bimodal_log_posterior(), config);
+                    serial.run();
+
+                    TEST_CHECK_EQUAL(serial.log_evidence(), sampler.log_evidence());
+                    TEST_CHECK(serial.history().states.back().point == states.back().point);
+                }
+
+                // the output is readable by the tools for Markov chains
+                {
+                    hdf5::File file = hdf5::File::Open(EOS_BUILDDIR "/eos/statistics/parallel-tempering-sampler_TEST.hdf5");
+                    auto data_set = file.open_data_set("/main run/chain #0/samples", hdf5::Array<1, double>("samples", { 2 }));
+                    TEST_CHECK_EQUAL(data_set.records(), 4000 * 10);
+                }
+            }
+        }
+} parallel_tempering_sampler_test;
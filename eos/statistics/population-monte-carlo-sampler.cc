@@ -31,6 +31,7 @@
 #include <eos/utils/log.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
 #include <eos/utils/stringify.hh>
 #include <eos/utils/thread_pool.hh>
 
@@ -43,6 +44,7 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <cstdio>
 #include <math.h>
 #include <iterator>
 #include <limits>
@@ -257,9 +259,14 @@ namespace eos
         // the pmc object
         pmc_simu * pmc;
 
-        // random number generator
+        // random number stream, and its GSL interface
+        RandomStream stream;
         gsl_rng * rng;
 
+        // whether the pre run continues from a checkpoint, and the step with which it continues
+        bool resumed;
+        unsigned first_step;
+
         // Workers do the hard part: calculating the posterior.
         std::vector<std::shared_ptr<pmc::Worker>> workers;
 
@@ -271,13 +278,15 @@ namespace eos
             density(density),
             config(config),
             status(),
-            pmc(NULL)
+            pmc(NULL),
+            stream(config.seed, "population-monte-carlo"),
+            rng(stream.rng()),
+            resumed((! update) && (! config.checkpoint_file.empty()) && config.resume && hdf5::File::Exists(config.checkpoint_file)),
+            first_step(0)
         {
-            // setup Mersenne-Twister RN generator using custom seed
-            rng = gsl_rng_alloc(gsl_rng_mt19937);
-            gsl_rng_set(rng, config.seed);
-
-            setup_output();
+            // keep the output of the interrupted run
+            if (! resumed)
+                setup_output();
 
             // setup PMC library
             initialize_pmc(file, update);
@@ -289,16 +298,21 @@ namespace eos
             for (unsigned i = 0; i < number_of_workers ; ++i)
                 workers.push_back(std::make_shared<pmc::Worker>(density));
 
-            auto f = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
-            density->dump_descriptions(f, "/descriptions");
-            dump_proposal("initial");
+            if (resumed)
+            {
+                read_checkpoint();
+                truncate_output();
+            }
+            else
+            {
+                auto f = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
+                density->dump_descriptions(f, "/descriptions");
+                dump_proposal("initial");
+            }
         }
 
         ~Implementation<PopulationMonteCarloSampler>()
         {
-            // free RN generator
-            gsl_rng_free(rng);
-
             // free pmc object
             pmc_simu_free(&pmc);
         }
@@ -318,17 +332,18 @@ namespace eos
             auto f = hdf5::File::Open(sample_file);
             auto samples = f.open_data_set("/data/samples",
                 PopulationMonteCarloSampler::Output::sample_type(pmc->ndim));
-            auto sample_record = PopulationMonteCarloSampler::Output::sample_record(pmc->ndim);
-            samples.set_index(min_index);
+            const unsigned record_size = pmc->ndim + 3;
+            std::vector<double> sample_records(n_samples * record_size);
+            samples.read_raw(min_index, n_samples, sample_records.data());
 
             for (unsigned i = 0 ; i < n_samples; i++)
             {
-                samples >> sample_record;
+                const double * sample_record = &sample_records[i * record_size];
 
-                std::copy(sample_record.cbegin(), sample_record.cbegin() + pmc->ndim, &pmc->X[i * pmc->ndim]);
+                std::copy(sample_record, sample_record + pmc->ndim, &pmc->X[i * pmc->ndim]);
 
                 // index of generating component
-                pmc->indices[i] = sample_record.at(pmc->ndim);
+                pmc->indices[i] = sample_record[pmc->ndim];
 
                 // ignore posterior value and weight of record
             }
@@ -648,14 +663,15 @@ namespace eos
             // proposal density
             mix_mvdens * prop = static_cast<mix_mvdens *>(pmc->proposal->data);
 
-            auto components = file.create_data_set("/data/" + group + "/components",
+            // the data set might remain from an interrupted run, cf. truncate_output()
+            auto components = file.create_or_open_data_set("/data/" + group + "/components",
                 PopulationMonteCarloSampler::Output::component_type(pmc->ndim));
             auto component_record = PopulationMonteCarloSampler::Output::component_record(pmc->ndim);
-            auto dof = components.create_attribute("dof", hdf5::Scalar<int>("dof"));
+            auto dof = components.create_or_open_attribute("dof", hdf5::Scalar<int>("dof"));
             dof = config.degrees_of_freedom;
 
             // save whether std contains the actual covariance matrix or the GSL cholesky decomposition
-            auto chol = components.create_attribute("chol", hdf5::Scalar<int>("chol"));
+            auto chol = components.create_or_open_attribute("chol", hdf5::Scalar<int>("chol"));
             chol = prop->comp[0]->chol;
 
             unsigned dead_components = 0;
@@ -697,7 +713,7 @@ namespace eos
 
             /* dump statistics information */
 
-            auto statistics = file.create_data_set("/data/" + group + "/statistics",
+            auto statistics = file.create_or_open_data_set("/data/" + group + "/statistics",
                 PopulationMonteCarloSampler::Output::statistics_type());
             auto statistics_record = std::make_tuple(status.perplexity, status.eff_sample_size, status.evidence);
             statistics << statistics_record;
@@ -706,7 +722,7 @@ namespace eos
             if (not store_samples)
                 return;
 
-            auto samples = file.create_data_set("/data/" + group + "/samples",
+            auto samples = file.create_or_open_data_set("/data/" + group + "/samples",
                 PopulationMonteCarloSampler::Output::sample_type(dim));
             auto sample_record = PopulationMonteCarloSampler::Output::sample_record(dim);
             for (int i = 0 ; i < pmc->nsamples ; i++)
@@ -777,7 +793,12 @@ namespace eos
 
             unsigned number_of_live_components = 0;
 
-            if (config.target_ncomponents > 0)
+            if (resumed)
+            {
+                // restore mmv as adapted up to the last checkpoint
+                number_of_live_components = read_checkpoint_components(mmv);
+            }
+            else if (config.target_ncomponents > 0)
             {
                 // initialize mmv by clustering and filtering
                 number_of_live_components = hierarchical_clustering(f, mmv);
@@ -981,6 +1002,7 @@ namespace eos
 
             HierarchicalClustering::Config conf = HierarchicalClustering::Config::Default();
             conf.equal_weights = true;
+            conf.parallelize = config.parallelize;
             HierarchicalClustering hc(conf);
 
             /* group chains according to R-value */
@@ -989,18 +1011,20 @@ namespace eos
 
             /* create initial guess for components by drawing local patches uniformly w/o replacement or large windows */
 
-            Log::instance()->message("PMC_sampler.hierarchical_clustering", ll_informational)
-                << "Creating initial guess for the " << config.target_ncomponents
-                << " target components to be formed from large windows"
-                << (config.group_by_r_value > 1 ? " for each of the " + stringify(chain_groups.size()) + " chain groups found" : "");
-
             HierarchicalClustering::MixtureDensity initial_components;
 
             // weight of a single component (weights sum up to one)
             const unsigned n_components_total = config.target_ncomponents * chain_groups.size();
             const double weight = 1.0 / n_components_total;
 
+            // unless it is chosen among the patches below, form the initial guess from large windows
+            if (! config.kmeans_seeding)
             {
+                Log::instance()->message("PMC_sampler.hierarchical_clustering", ll_informational)
+                    << "Creating initial guess for the " << config.target_ncomponents
+                    << " target components to be formed from large windows"
+                    << (config.group_by_r_value > 1 ? " for each of the " + stringify(chain_groups.size()) + " chain groups found" : "");
+
                 for (auto g = chain_groups.cbegin() ; g != chain_groups.cend() ; ++g)
                 {
                     // how many components should each each in group contribute
@@ -1047,7 +1071,8 @@ namespace eos
                 }
             }
 
-            hc.initial_guess(initial_components);
+            if (! config.kmeans_seeding)
+                hc.initial_guess(initial_components);
 
             /* create patches from each chain */
 
@@ -1107,6 +1132,14 @@ namespace eos
             Log::instance()->message("PMC_sampler.hierarchical_clustering", ll_informational)
                 << "Formed " << local_patches.size() << " input components centered around patch means";
 
+            if (config.kmeans_seeding)
+            {
+                Log::instance()->message("PMC_sampler.hierarchical_clustering", ll_informational)
+                    << "Choosing initial guess for the " << n_components_total << " target components among the patches";
+
+                hc.initial_guess(n_components_total, config.seed);
+            }
+
             if (config.store_input_components)
             {
                 auto file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
@@ -1195,8 +1228,16 @@ namespace eos
 
             pmc::ErrorHandler err;
 
+            if (status.converged)
+            {
+                Log::instance()->message("PMC_sampler.status", ll_informational)
+                    << "Pre-run has already converged after " << status.iterations_at_convergence + 1 << " steps";
+
+                return;
+            }
+
             // prerun to adapt proposal densities
-            for (unsigned i = 0; i < config.max_updates ; ++i)
+            for (unsigned i = first_step; i < config.max_updates ; ++i)
             {
                 dump_proposal(stringify(i));
                 //                pmc_simu_pmc_step(pmc_simu *pmc, gsl_rng *r, error **err)
@@ -1261,8 +1302,12 @@ namespace eos
                     Log::instance()->message("PMC_sampler.status", ll_informational)
                         << "Convergence achieved after " << i + 1 << " steps.";
                     status.iterations_at_convergence = i;
-                    break;
                 }
+
+                write_checkpoint(i + 1);
+
+                if (status.converged)
+                    break;
             }
 
             if (! status.converged)
@@ -1282,12 +1327,15 @@ namespace eos
             auto file = hdf5::File::Open(sample_file, H5F_ACC_RDONLY);
 
             auto data_set = file.open_data_set(base + "/samples", PopulationMonteCarloSampler::Output::sample_type(n_dim));
-            auto record = PopulationMonteCarloSampler::Output::sample_record(n_dim);
-            data_set.set_index(min);
-            for (unsigned i = min ; i < max; ++i)
+
+            const unsigned record_size = n_dim + 3;
+            std::vector<double> records((max - min) * record_size);
+            data_set.read_raw(min, max - min, records.data());
+
+            samples.reserve(max - min);
+            for (auto r = records.cbegin(), r_end = records.cend() ; r != r_end ; r += record_size)
             {
-                data_set >> record;
-                samples.push_back(std::vector<double>(record.begin(), record.end() - 3));
+                samples.push_back(std::vector<double>(r, r + n_dim));
             }
         }
 
@@ -1330,6 +1378,179 @@ namespace eos
                 dump("final");
         }
 
+        // next step of the pre run, number of samples, and status
+        typedef hdf5::Composite<hdf5::Scalar<unsigned>, hdf5::Scalar<unsigned>, hdf5::Scalar<int>, hdf5::Scalar<unsigned>,
+                hdf5::Scalar<double>, hdf5::Scalar<double>, hdf5::Scalar<double>> CheckpointType;
+
+        static CheckpointType checkpoint_type()
+        {
+            return CheckpointType
+            {
+                "checkpoint",
+                hdf5::Scalar<unsigned>("next step"),
+                hdf5::Scalar<unsigned>("samples"),
+                hdf5::Scalar<int>("converged"),
+                hdf5::Scalar<unsigned>("iterations at convergence"),
+                hdf5::Scalar<double>("perplexity"),
+                hdf5::Scalar<double>("eff. sample size"),
+                hdf5::Scalar<double>("evidence"),
+            };
+        }
+
+        // the parameters of each component that are not part of Output::ComponentType
+        typedef hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<int>, hdf5::Scalar<int>, hdf5::Scalar<double>> ComponentParametersType;
+
+        static ComponentParametersType component_parameters_type()
+        {
+            return ComponentParametersType
+            {
+                "component parameters",
+                hdf5::Scalar<double>("df"),
+                hdf5::Scalar<int>("chol"),
+                hdf5::Scalar<int>("band limit"),
+                hdf5::Scalar<double>("det(L)"),
+            };
+        }
+
+        /*
+         * Store the proposal density, the status, and the state of the random number generator
+         * in the checkpoint file, such that the pre run can continue with the given step.
+         *
+         * The checkpoint is first written to a temporary file, which then replaces the previous checkpoint.
+         */
+        void write_checkpoint(const unsigned & next_step)
+        {
+            if (config.checkpoint_file.empty())
+                return;
+
+            const std::string temporary_file = config.checkpoint_file + ".tmp";
+
+            {
+                hdf5::File file = hdf5::File::Create(temporary_file);
+
+                auto data_set = file.create_data_set("/pmc/state", checkpoint_type());
+                auto record = std::make_tuple(next_step, unsigned(pmc->nsamples), int(status.converged), status.iterations_at_convergence,
+                        status.perplexity, status.eff_sample_size, status.evidence);
+                data_set << record;
+
+                mix_mvdens * mmv = static_cast<mix_mvdens *>(pmc->proposal->data);
+
+                auto components = file.create_data_set("/pmc/components", PopulationMonteCarloSampler::Output::component_type(pmc->ndim));
+                auto component_record = PopulationMonteCarloSampler::Output::component_record(pmc->ndim);
+                auto parameters = file.create_data_set("/pmc/component parameters", component_parameters_type());
+
+                for (unsigned i = 0 ; i < mmv->ncomp ; ++i)
+                {
+                    const mvdens * mv = mmv->comp[i];
+
+                    std::get<0>(component_record) = mmv->wght[i];
+                    std::copy(mv->mean, mv->mean + pmc->ndim, std::get<1>(component_record).begin());
+                    std::copy(mv->std, mv->std + pmc->ndim * pmc->ndim, std::get<2>(component_record).begin());
+                    components << component_record;
+
+                    parameters << std::make_tuple(double(mv->df), int(mv->chol), int(mv->band_limit), double(mv->detL));
+                }
+
+                dump_rng_state(file, "/rng", rng);
+            }
+
+            if (0 != std::rename(temporary_file.c_str(), config.checkpoint_file.c_str()))
+                throw InternalError("PopulationMonteCarloSampler: Could not replace the checkpoint '" + config.checkpoint_file
+                        + "' by '" + temporary_file + "'");
+
+            Log::instance()->message("PMC_sampler.checkpoint", ll_debug)
+                << "Stored checkpoint in " << config.checkpoint_file;
+        }
+
+        /*
+         * Allocate and fill the mixture density from the checkpoint file.
+         *
+         * @return the number of live components.
+         */
+        unsigned read_checkpoint_components(mix_mvdens * & mmv)
+        {
+            const unsigned n_dim = std::distance(density->begin(), density->end());
+
+            hdf5::File file = hdf5::File::Open(config.checkpoint_file, H5F_ACC_RDONLY);
+
+            auto components = file.open_data_set("/pmc/components", PopulationMonteCarloSampler::Output::component_type(n_dim));
+            auto component_record = PopulationMonteCarloSampler::Output::component_record(n_dim);
+            auto parameters = file.open_data_set("/pmc/component parameters", component_parameters_type());
+            auto parameters_record = std::make_tuple(0.0, 0, 0, 0.0);
+
+            pmc::ErrorHandler err;
+            mmv = mix_mvdens_alloc(components.records(), n_dim, err);
+            pmc::check_error(err);
+
+            unsigned number_of_live_components = 0;
+            for (unsigned i = 0 ; i < mmv->ncomp ; ++i)
+            {
+                mvdens * mv = mmv->comp[i];
+
+                components >> component_record;
+                mmv->wght[i] = std::get<0>(component_record);
+                std::copy(std::get<1>(component_record).cbegin(), std::get<1>(component_record).cend(), mv->mean);
+                std::copy(std::get<2>(component_record).cbegin(), std::get<2>(component_record).cend(), mv->std);
+
+                parameters >> parameters_record;
+                mv->df = std::get<0>(parameters_record);
+                mv->chol = std::get<1>(parameters_record);
+                mv->band_limit = std::get<2>(parameters_record);
+                mv->detL = std::get<3>(parameters_record);
+
+                if (mmv->wght[i] > 0)
+                    ++number_of_live_components;
+            }
+
+            return number_of_live_components;
+        }
+
+        /*
+         * Restore the status, the sample size and the state of the random number generator from the checkpoint file.
+         * The proposal density has already been restored by initialize_pmc().
+         */
+        void read_checkpoint()
+        {
+            hdf5::File file = hdf5::File::Open(config.checkpoint_file, H5F_ACC_RDONLY);
+
+            auto data_set = file.open_data_set("/pmc/state", checkpoint_type());
+            auto record = std::make_tuple(0u, 0u, 0, 0u, 0.0, 0.0, 0.0);
+            data_set >> record;
+
+            first_step = std::get<0>(record);
+            status.converged = std::get<2>(record);
+            status.iterations_at_convergence = std::get<3>(record);
+            status.perplexity = std::get<4>(record);
+            status.eff_sample_size = std::get<5>(record);
+            status.evidence = std::get<6>(record);
+
+            pmc::ErrorHandler err;
+            pmc_simu_realloc(pmc, std::get<1>(record), err);
+            pmc::check_error(err);
+
+            read_rng_state(file, "/rng", rng);
+
+            Log::instance()->message("PMC_sampler.checkpoint", ll_informational)
+                << "Resuming from checkpoint " << config.checkpoint_file << " after " << first_step << " steps of the pre-run";
+        }
+
+        /*
+         * Discard all output that has been stored after the last checkpoint was written.
+         */
+        void truncate_output()
+        {
+            hdf5::File file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
+
+            const std::string groups[] = { "/data/" + stringify(first_step), "/data/final" };
+            for (const auto & group : groups)
+            {
+                if (! file.group_exists(group))
+                    continue;
+
+                file.truncate(group, 0);
+            }
+        }
+
         void setup_output() const
         {
             if (config.output_file.empty())
@@ -1438,21 +1659,23 @@ namespace eos
             /* parse samples */
 
             auto samples_data_set = f.open_data_set("/data/samples", PopulationMonteCarloSampler::Output::sample_type(pmc->ndim));
-            auto sample_record = PopulationMonteCarloSampler::Output::sample_record(pmc->ndim);
-            for (unsigned i = 0 ; i < samples_data_set.records() ; ++i)
             {
-                samples_data_set >> sample_record;
-                std::copy(sample_record.cbegin(), sample_record.cbegin() + pmc->ndim, &pmc->X[i * pmc->ndim]);
-                pmc->indices[i] = sample_record.at(pmc->ndim);
+                const unsigned record_size = pmc->ndim + 3;
+                std::vector<double> sample_records(samples_data_set.records() * record_size);
+                samples_data_set.read_raw(0, samples_data_set.records(), sample_records.data());
+
+                for (unsigned i = 0 ; i < samples_data_set.records() ; ++i)
+                {
+                    const double * sample_record = &sample_records[i * record_size];
+                    std::copy(sample_record, sample_record + pmc->ndim, &pmc->X[i * pmc->ndim]);
+                    pmc->indices[i] = sample_record[pmc->ndim];
+                }
             }
 
             /* parse weights */
 
             auto weights_data_set = f.open_data_set("/data/weights", PopulationMonteCarloSampler::Output::weight_type());
-            auto weight_record = PopulationMonteCarloSampler::Output::weight_record();
-
             auto ignores_data_set = f.open_data_set("/data/broken", PopulationMonteCarloSampler::Output::ignore_type());
-            auto ignore_record = PopulationMonteCarloSampler::Output::ignore_record();
 
             if (n_samples != weights_data_set.records())
                 throw InternalError("PMC::initialize: mismatch between size of /data/samples and /data/weights ("
@@ -1461,10 +1684,17 @@ namespace eos
                 throw InternalError("PMC::initialize: mismatch between size of /data/samples and /data/broken ("
                         + stringify(n_samples) + " vs " + stringify(ignores_data_set.records()) + ")");
 
+            std::vector<PopulationMonteCarloSampler::Output::WeightType::Type> weight_records(n_samples);
+            weights_data_set.read(0, n_samples, weight_records.begin());
+
+            // the in-file representation of the ignore flags is a single byte
+            std::vector<signed char> ignore_records(n_samples);
+            ignores_data_set.read_raw(0, n_samples, ignore_records.data());
+
             for (unsigned i = 0 ; i < n_samples ; ++i)
             {
-                weights_data_set >> weight_record;
-                ignores_data_set >> ignore_record;
+                const auto & weight_record = weight_records[i];
+                const auto & ignore_record = ignore_records[i];
 
                 double * x = &(pmc->X[i * pmc->ndim]);
 
@@ -1626,6 +1856,7 @@ namespace eos
          store_hc_initial(false),
          store_input_components(false),
          target_ncomponents(0),
+         kmeans_seeding(false),
          adjust_sample_size(false),
          max_updates(10),
          samples_per_component(10000),
@@ -1641,6 +1872,7 @@ namespace eos
          maximum_relative_std_deviation(0, 1, 0.10),
          final_samples(20000),
          store(true),
+         resume(false),
          print_steps(0, 100, 5)
      {
      }
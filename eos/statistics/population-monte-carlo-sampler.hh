@@ -228,6 +228,13 @@ namespace eos
              */
             unsigned target_ncomponents;
 
+            /*!
+             * If true, choose the initial guess for the clustering among the patches,
+             * following the seeding of k-means++, rather than forming it from large
+             * windows of the chains.
+             */
+            bool kmeans_seeding;
+
             ///@}
 
             ///@name Pre run options
@@ -296,6 +303,21 @@ namespace eos
             bool store;
             ///@}
 
+            ///@name Checkpoint options
+            ///@{
+            /*!
+             * The HDF5 file in which the state of the pre run is stored after each update of the proposal density.
+             * If empty, no checkpoints are written.
+             */
+            std::string checkpoint_file;
+
+            /*!
+             * If true and if the checkpoint file exists, continue the pre run from the stored state
+             * rather than starting from the initial proposal density.
+             */
+            bool resume;
+            ///@}
+
             ///@name Output options
             ///@{
 
@@ -23,8 +23,11 @@
 #include <eos/statistics/markov-chain-sampler.hh>
 #include <eos/utils/hdf5.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/stringify.hh>
 #include <test/test.hh>
 
+#include <cstdio>
+
 using namespace test;
 using namespace eos;
 
@@ -146,6 +149,8 @@ class PopulationMonteCarloSamplerTest :
                 static const std::string pmc_output_hc = EOS_BUILDDIR "/eos/statistics/pmc_sampler_TEST-output-hc.hdf5";
                 static const std::string pmc_output_resume = EOS_BUILDDIR "/eos/statistics/pmc_sampler_TEST-output-resume.hdf5";
                 static const std::string pmc_output_split = EOS_BUILDDIR "/eos/statistics/pmc_sampler_TEST-output-split.hdf5";
+                static const std::string pmc_output_checkpoint = EOS_BUILDDIR "/eos/statistics/pmc_sampler_TEST-output-checkpoint.hdf5";
+                static const std::string pmc_checkpoint = EOS_BUILDDIR "/eos/statistics/pmc_sampler_TEST-checkpoint.hdf5";
 
                 PopulationMonteCarloSampler::Config pmc_config = PopulationMonteCarloSampler::Config::Default();
                 pmc_config.max_updates = 5;
@@ -167,6 +172,78 @@ class PopulationMonteCarloSamplerTest :
                     TEST_CHECK(pmc_sampler.status().converged);
                 }
 
+                // resume the complete run from a checkpoint of its pre run
+                {
+                    std::remove(pmc_checkpoint.c_str());
+
+                    PopulationMonteCarloSampler::Config temp_config(pmc_config);
+                    temp_config.output_file = pmc_output_checkpoint;
+                    temp_config.skip_initial = 0.2;
+                    temp_config.patch_length = 400;
+                    temp_config.target_ncomponents = 2;
+                    temp_config.checkpoint_file = pmc_checkpoint;
+                    temp_config.resume = true;
+
+                    // interrupt after two updates of the proposal density
+                    {
+                        PopulationMonteCarloSampler::Config interrupted_config(temp_config);
+                        interrupted_config.max_updates = 2;
+                        interrupted_config.final_samples = 0;
+
+                        PopulationMonteCarloSampler pmc_sampler(log_posterior.clone(), hdf5::File::Open(mcmc_file_name), interrupted_config);
+                        pmc_sampler.run();
+
+                        TEST_CHECK(hdf5::File::Exists(pmc_checkpoint));
+                        TEST_CHECK(! hdf5::File::Exists(pmc_checkpoint + ".tmp"));
+                    }
+
+                    // continue with the components, the step and the state of the RNG from the checkpoint
+                    {
+                        PopulationMonteCarloSampler pmc_sampler(log_posterior.clone(), hdf5::File::Open(mcmc_file_name), temp_config);
+                        pmc_sampler.run();
+                        TEST_CHECK(pmc_sampler.status().converged);
+                    }
+
+                    // the output is identical to that of the complete run
+                    hdf5::File file = hdf5::File::Open(pmc_output);
+                    hdf5::File file_checkpoint = hdf5::File::Open(pmc_output_checkpoint);
+
+                    for (unsigned step = 0 ; step < pmc_config.max_updates ; ++step)
+                    {
+                        const std::string group = "/data/" + stringify(step);
+
+                        TEST_CHECK_EQUAL(file.group_exists(group), file_checkpoint.group_exists(group));
+                        if (! file.group_exists(group))
+                            break;
+
+                        auto data_set = file.open_data_set(group + "/statistics", PopulationMonteCarloSampler::Output::statistics_type());
+                        auto data_set_checkpoint = file_checkpoint.open_data_set(group + "/statistics", PopulationMonteCarloSampler::Output::statistics_type());
+                        auto record = PopulationMonteCarloSampler::Output::statistics_record();
+                        auto record_checkpoint = PopulationMonteCarloSampler::Output::statistics_record();
+                        data_set >> record;
+                        data_set_checkpoint >> record_checkpoint;
+
+                        TEST_CHECK_RELATIVE_ERROR(std::get<0>(record), std::get<0>(record_checkpoint), 1e-13); // perplexity
+                        TEST_CHECK_RELATIVE_ERROR(std::get<2>(record), std::get<2>(record_checkpoint), 1e-13); // evidence
+                    }
+
+                    auto data_set = file.open_data_set("/data/final/samples", PopulationMonteCarloSampler::Output::sample_type(2));
+                    auto data_set_checkpoint = file_checkpoint.open_data_set("/data/final/samples", PopulationMonteCarloSampler::Output::sample_type(2));
+                    TEST_CHECK_EQUAL(data_set.records(), data_set_checkpoint.records());
+
+                    auto record = PopulationMonteCarloSampler::Output::sample_record(2);
+                    auto record_checkpoint = PopulationMonteCarloSampler::Output::sample_record(2);
+                    for (unsigned i = 0 ; i < data_set.records() ; ++i)
+                    {
+                        data_set >> record;
+                        data_set_checkpoint >> record_checkpoint;
+
+                        TEST_CHECK_EQUAL(record[0], record_checkpoint[0]);
+                        TEST_CHECK_EQUAL(record[1], record_checkpoint[1]);
+                        TEST_CHECK_RELATIVE_ERROR(record[4], record_checkpoint[4], 1e-13); // weight
+                    }
+                }
+
                 // save initial status for later resumption
                 {
                 	PopulationMonteCarloSampler::Config temp_config(pmc_config);
@@ -20,11 +20,17 @@
 #include <eos/statistics/log-prior.hh>
 #include <eos/statistics/prior-sampler.hh>
 #include <eos/utils/hdf5.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/memoise.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
+#include <eos/utils/stringify.hh>
 #include <eos/utils/thread_pool.hh>
 
+#include <algorithm>
+
 #include <gsl/gsl_randist.h>
 
 namespace eos
@@ -39,6 +45,24 @@ namespace eos
     {
         typedef std::function<void (void)> Function;
 
+        // Data sets that are shared among all workers. Access is serialised by the mutex.
+        struct Output
+        {
+            Mutex mutex;
+
+            std::shared_ptr<hdf5::DataSet<hdf5::Array<1, double>>> observables;
+            unsigned observables_offset;
+
+            std::shared_ptr<hdf5::DataSet<hdf5::Array<1, double>>> parameters;
+            unsigned parameters_offset;
+
+            Output() :
+                observables_offset(0),
+                parameters_offset(0)
+            {
+            }
+        };
+
         struct Worker
         {
             ObservableSet observables;
@@ -49,23 +73,22 @@ namespace eos
             // Parameter, minimum, maximum, nuisance
             std::vector<ParameterDescription> parameter_descriptions;
 
-            // Random number generator seed
-            unsigned seed;
+            // Random number stream; each sample draws from a substream of its own
+            RandomStream stream;
 
-            // the sampling output, one vector for each iteration
-            SamplesList observable_samples;
-            SamplesList parameter_samples;
+            // the sampling output of the current batch, one row per iteration
+            std::vector<double> observable_samples;
+            std::vector<double> parameter_samples;
 
-            hdf5::Array<1, double> observable_type;
-            hdf5::Array<1, double> parameter_type;
+            // summary of all observable values computed by this worker
+            OnlineSummary summary;
 
             Worker(const ObservableSet & observables,
                    const std::vector<LogPriorPtr> & priors,
                    const std::vector<ParameterDescription> & parameter_descriptions,
-                   unsigned seed) :
-                       seed(seed),
-                       observable_type("observables", { observables.size() }),
-                       parameter_type("parameters", { parameter_descriptions.size() })
+                   const PriorSampler::Config & config) :
+                       stream(config.seed, "prior-sampler"),
+                       summary(observables.size(), config.compute_covariance)
             {
                 // need to clone, so parameters that are fixed by hand have correct value
                 // cast away const-ness
@@ -92,102 +115,86 @@ namespace eos
                 }
             }
 
-            void dump_history(const std::shared_ptr<hdf5::File> & file, const bool & store_parameters)
+            void dump_batch(Output & output, const unsigned & first, const unsigned & count)
             {
-                // write observables
-                auto observable_data_set = file->create_or_open_data_set("/data/observables", observable_type);
-                for (auto o = observable_samples.cbegin(), o_end = observable_samples.cend() ; o != o_end ; ++o)
-                {
-                    observable_data_set << *o;
-                }
+                Lock l(output.mutex);
 
-                // write parameters
-                if ( ! store_parameters)
-                    return;
+                if (output.observables)
+                    output.observables->write_raw(output.observables_offset + first, count, observable_samples.data());
 
-                auto parameter_data_set = file->create_or_open_data_set("/data/parameters", parameter_type);
-                for (auto p = parameter_samples.cbegin(), p_end = parameter_samples.cend() ; p != p_end ; ++p)
-                {
-                    parameter_data_set << *p;
-                }
+                if (output.parameters)
+                    output.parameters->write_raw(output.parameters_offset + first, count, parameter_samples.data());
             }
 
             /*!
-             * Compute observables for every sample in range
+             * Compute observables for a range of samples, and write them to disk in batches.
+             *
+             * If parameter samples are given, their values are used for the leading parameters. All other
+             * parameter values are drawn from the priors.
+             *
+             * @param given      The parameter samples, or nullptr if all parameter values shall be drawn.
+             * @param first      The index of the worker's first sample.
+             * @param count      The number of samples.
+             * @param batch_size The number of samples per batch.
+             * @param output     The shared output data sets.
              */
-            void compute_observables(      SamplesList::const_iterator & first,
-                    const SamplesList::const_iterator & last)
+            void run(const SamplesList * given, const unsigned & first, const unsigned & count,
+                    const unsigned & batch_size, Output & output)
             {
                 Log::instance()->message("prior_sampler.run", ll_informational)
                             << "Computing " << observables.size() << " observables for "
-                            << std::distance(first, last) << " parameter samples";
-
-                // setup random number generator
-                gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
-                gsl_rng_set(rng, seed);
-
-                // loop over samples
-                for (; first != last; ++first)
-                {
-                    // read and update parameter values, one at a time
-                    auto def = parameter_descriptions.begin();
-                    for (auto p = first->cbegin() ; p != first->cend() ; ++p, ++def)
-                    {
-                        def->parameter->set(*p);
-                    }
+                            << count << (given ? " given" : " drawn") << " parameter samples";
 
-                    auto p = priors.cbegin();
-                    std::advance(p, std::distance(first->cbegin(), first->cend()));
-                    for (auto p_end = priors.cend() ; p != p_end ; ++p, ++def)
-                    {
-                        def->parameter->set((*p)->sample(rng));
-                    }
-
-                    // calculate all observables
-                    std::vector<double> observable_sample;
-                    for (auto & o : observables)
-                        observable_sample.push_back(o->evaluate());
-                    observable_samples.push_back(observable_sample);
-                }
-
-                // free RN generator
-                gsl_rng_free(rng);
-            }
-
-            /*!
-             * Draw random vector from the priors.
-             *
-             * @param iterations The number of samples.
-             */
-            void draw_samples(unsigned iterations)
-            {
-                Log::instance()->message("prior_sampler.run", ll_informational)
-                            << "Drawing " << iterations << " parameter samples";
+                const unsigned n_parameters = priors.size(), n_observables = observables.size();
 
-                // setup random number generator
-                gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
-                gsl_rng_set(rng, seed);
+                gsl_rng * rng = stream.rng();
 
-                for (unsigned i = 0 ; i < iterations ; ++i)
+                for (unsigned batch_begin = 0 ; batch_begin < count ; batch_begin += batch_size)
                 {
-                    std::vector<double> parameter_sample;
+                    const unsigned batch_count = std::min(batch_size, count - batch_begin);
+
+                    parameter_samples.resize(batch_count * n_parameters);
+                    observable_samples.resize(batch_count * n_observables);
 
-                    // draw a sample
-                    unsigned index = 0;
-                    for (auto prior = priors.begin(), i_end = priors.end() ; prior != i_end ; ++prior, ++index)
+                    for (unsigned i = 0 ; i < batch_count ; ++i)
                     {
-                        double p = (**prior).sample(rng);
-//TODO: Fred, please check rebase starting here
-                        parameter_descriptions[index].parameter->set(p);
-                        parameter_sample.push_back(p);
+                        double * parameter_sample = &parameter_samples[i * n_parameters];
+                        double * observable_sample = &observable_samples[i * n_observables];
+
+                        // read and update parameter values, one at a time
+                        unsigned j = 0;
+                        if (given)
+                        {
+                            for (const auto & p : (*given)[first + batch_begin + i])
+                            {
+                                parameter_descriptions[j].parameter->set(p);
+                                parameter_sample[j] = p;
+                                ++j;
+                            }
+                        }
+
+                        // draw the remaining parameter values, independently of the partitioning into workers
+                        stream.select(first + batch_begin + i);
+                        for ( ; j < n_parameters ; ++j)
+                        {
+                            const double p = priors[j]->sample(rng);
+                            parameter_descriptions[j].parameter->set(p);
+                            parameter_sample[j] = p;
+                        }
+
+                        // calculate all observables
+                        j = 0;
+                        for (auto & o : observables)
+                        {
+                            observable_sample[j] = o->evaluate();
+                            ++j;
+                        }
+
+                        summary.add(observable_sample);
                     }
 
-//TODO: Fred, to here
-                    parameter_samples.push_back(parameter_sample);
+                    dump_batch(output, first + batch_begin, batch_count);
                 }
-
-                // free RN generator
-                gsl_rng_free(rng);
             }
         };
 
@@ -215,6 +222,9 @@ namespace eos
         // tickets for parallel computations
         std::vector<Ticket> tickets;
 
+        // summary of all observable values computed in the last run
+        OnlineSummary summary;
+
         Implementation(const ObservableSet & observables, const PriorSampler::Config & config) :
             config(config),
             observables(observables),
@@ -229,10 +239,20 @@ namespace eos
                 "parameter description",
                 hdf5::Scalar<double>("min"),
                 hdf5::Scalar<double>("max"),
-            }
+            },
+            summary(0)
         {
             if ( ! config.output_file)
                 throw InternalError("PriorSampler(): Missing valid output file");
+
+            if (0 == config.batch_size)
+                throw InternalError("PriorSampler(): Batch size must be positive");
+
+            for (const auto & q : config.quantiles)
+            {
+                if ((q < 0.0) || (q > 1.0))
+                    throw InternalError("PriorSampler(): Quantile probability '" + stringify(q) + "' is not in the interval [0, 1]");
+            }
         }
 
         bool add(const LogPriorPtr & prior)
@@ -293,6 +313,22 @@ namespace eos
                 config.store_parameters = false;
             }
 
+            // append to existing data sets
+            Output output;
+            if (config.store_observables)
+            {
+                output.observables = std::make_shared<hdf5::DataSet<hdf5::Array<1, double>>>(
+                        config.output_file->create_or_open_data_set("/data/observables", PriorSampler::observables_type(observables.size())));
+                output.observables_offset = output.observables->records();
+            }
+
+            if (config.store_parameters)
+            {
+                output.parameters = std::make_shared<hdf5::DataSet<hdf5::Array<1, double>>>(
+                        config.output_file->create_or_open_data_set("/data/parameters", hdf5::Array<1, double>("parameters", { priors.size() })));
+                output.parameters_offset = output.parameters->records();
+            }
+
             // create one Worker per chunk
             std::vector<std::shared_ptr<Worker>> workers;
             const unsigned average_samples_per_worker = config.n_samples / config.n_workers;
@@ -300,8 +336,7 @@ namespace eos
 
             for (unsigned chunk = 0 ; chunk < config.n_workers; ++chunk)
             {
-                workers.push_back(std::make_shared<Worker>(observables, this->priors, this->parameter_descriptions,
-                        config.seed + chunk));
+                workers.push_back(std::make_shared<Worker>(observables, this->priors, this->parameter_descriptions, config));
 
                 unsigned samples_per_worker = average_samples_per_worker;
 
@@ -309,21 +344,13 @@ namespace eos
                 if (chunk == config.n_workers - 1)
                     samples_per_worker += remainder;
 
-                auto first = samples.cbegin() + chunk * average_samples_per_worker;
-                auto last  = first + samples_per_worker;
-                if (draw)
-                {
-                    workers.back()->draw_samples(samples_per_worker);
-                    first = workers.back()->parameter_samples.cbegin();
-                    last  = workers.back()->parameter_samples.cend();
-                }
-
-                Function f = std::bind(&Worker::compute_observables, workers.back().get(), first, last);
+                // make sure to pass the pointer, instead of a reference from *w, to bind.
+                // Else copies are created, which lead to a double freeing upon calling the destructor the 2nd time.
+                Function f = std::bind(&Worker::run, workers.back().get(), draw ? nullptr : &samples,
+                        chunk * average_samples_per_worker, samples_per_worker, config.batch_size, std::ref(output));
 
                 if (config.parallelize)
                 {
-                    // make sure to pass the pointer, instead of a reference from *w, to bind.
-                    // Else copies are created, which lead to a double freeing upon calling the destructor the 2nd time.
                     tickets.push_back(ThreadPool::instance()->enqueue(f));
                 }
                 else
@@ -338,35 +365,90 @@ namespace eos
                 t->wait();
             }
 
-            // retrieve data and delete workers
-            for (auto w = workers.begin(), w_end = workers.end() ; w != w_end ; ++w)
+            // all tickets finished
+            tickets.clear();
+
+            // merge the summaries in a fixed order
+            summary = workers.front()->summary;
+            for (auto w = workers.begin() + 1, w_end = workers.end() ; w != w_end ; ++w)
             {
-                (**w).dump_history(config.output_file, config.store_parameters);
+                summary.merge((**w).summary);
             }
 
-            // all tickets finished
-            tickets.clear();
+            dump_summary();
 
             Log::instance()->message("prior_sampler.run", ll_informational)
                         << "Observable computations completed.";
         }
 
+        void
+        dump_summary()
+        {
+            hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>> moments_type
+            {
+                "moments",
+                hdf5::Scalar<double>("mean"),
+                hdf5::Scalar<double>("variance"),
+            };
+
+            // the summary describes the last run only; discard that of an earlier run into the same file
+            if (config.output_file->group_exists("/summary/observables"))
+                config.output_file->truncate("/summary/observables", 0);
+
+            auto moments_data_set = config.output_file->create_or_open_data_set("/summary/observables/moments", moments_type);
+            for (unsigned i = 0 ; i < summary.dimension() ; ++i)
+            {
+                moments_data_set << std::make_tuple(summary.moments(i).mean(), summary.moments(i).variance());
+            }
+
+            auto attr_samples = moments_data_set.create_or_open_attribute("samples", hdf5::Scalar<unsigned long>("samples"));
+            attr_samples = summary.number_of_elements();
+
+            if ((! config.quantiles.empty()) && (summary.number_of_elements() > 0))
+            {
+                hdf5::Array<1, double> quantiles_type("quantiles", { config.quantiles.size() });
+
+                auto probabilities_data_set = config.output_file->create_or_open_data_set("/summary/observables/probabilities", quantiles_type);
+                probabilities_data_set << config.quantiles;
+
+                auto quantiles_data_set = config.output_file->create_or_open_data_set("/summary/observables/quantiles", quantiles_type);
+                std::vector<double> record(config.quantiles.size());
+                for (unsigned i = 0 ; i < summary.dimension() ; ++i)
+                {
+                    std::transform(config.quantiles.cbegin(), config.quantiles.cend(), record.begin(),
+                            [&] (const double & p) { return summary.quantiles(i).quantile(p); });
+                    quantiles_data_set << record;
+                }
+            }
+
+            if (summary.has_covariance())
+            {
+                auto covariance_data_set = config.output_file->create_or_open_data_set("/summary/observables/covariance",
+                        hdf5::Array<1, double>("covariance", { summary.dimension() * summary.dimension() }));
+                covariance_data_set << summary.covariance().covariance();
+            }
+        }
+
         void
         setup_output()
         {
+            // discard the descriptions of an earlier run into the same file
+            if (config.output_file->group_exists("/descriptions"))
+                config.output_file->truncate("/descriptions", 0);
+
             // write parameter descriptions
             unsigned counter = 0;
             for (auto d = parameter_descriptions.cbegin(), d_end = parameter_descriptions.cend() ; d != d_end ; ++d, ++counter)
             {
-                auto components = config.output_file->create_data_set("/descriptions/parameters/" + stringify(counter),
+                auto components = config.output_file->create_or_open_data_set("/descriptions/parameters/" + stringify(counter),
                     parameter_descriptions_type);
                 auto record = std::make_tuple(d->min, d->max);
                 components << record;
 
-                auto attr_name = components.create_attribute("name", hdf5::Scalar<const char *>("name"));
+                auto attr_name = components.create_or_open_attribute("name", hdf5::Scalar<const char *>("name"));
                 attr_name = d->parameter->name().c_str();
 
-                auto attr_prior = components.create_attribute("prior", hdf5::Scalar<const char *>("prior"));
+                auto attr_prior = components.create_or_open_attribute("prior", hdf5::Scalar<const char *>("prior"));
                 attr_prior = priors[std::distance(parameter_descriptions.cbegin(), d)]->as_string().c_str();
             }
 
@@ -377,7 +459,7 @@ namespace eos
             counter = 0;
             for (auto o = observables.begin(), o_end = observables.end() ; o != o_end ; ++o, ++counter)
             {
-                auto components = config.output_file->create_data_set("/descriptions/observables/" + stringify(counter),
+                auto components = config.output_file->create_or_open_data_set("/descriptions/observables/" + stringify(counter),
                     observable_description_type);
                 auto record = std::make_tuple(0.0, 0.0);
                 try
@@ -389,16 +471,16 @@ namespace eos
                 }
                 components << record;
 
-                auto attr_name = components.create_attribute("name", hdf5::Scalar<const char *>("name"));
+                auto attr_name = components.create_or_open_attribute("name", hdf5::Scalar<const char *>("name"));
                 attr_name = (**o).name().str().c_str();
 
-                auto attr_options = components.create_attribute("options", hdf5::Scalar<const char *>("options"));
+                auto attr_options = components.create_or_open_attribute("options", hdf5::Scalar<const char *>("options"));
                 attr_options = (**o).options().as_string().c_str();
 
-                auto attr_kinematics = components.create_attribute("kinematics", hdf5::Scalar<const char *>("kinematics"));
+                auto attr_kinematics = components.create_or_open_attribute("kinematics", hdf5::Scalar<const char *>("kinematics"));
                 attr_kinematics = (**o).kinematics().as_string().c_str();
 
-                auto attr_sm_prediction = components.create_attribute("SM prediction", hdf5::Scalar<double>("SM prediction"));
+                auto attr_sm_prediction = components.create_or_open_attribute("SM prediction", hdf5::Scalar<double>("SM prediction"));
                 double value = (**o).evaluate();
                 attr_sm_prediction = value;
             }
@@ -444,12 +526,22 @@ namespace eos
         _imp->run(samples, defs);
     }
 
+    const OnlineSummary &
+    PriorSampler::summary() const
+    {
+        return _imp->summary;
+    }
+
     PriorSampler::Config::Config() :
         n_samples(100000),
         n_workers(4),
         parallelize(true),
         seed(1234623),
-        store_parameters(false)
+        store_parameters(false),
+        store_observables(true),
+        batch_size(1000),
+        compute_covariance(false),
+        quantiles{ 0.025, 0.158655, 0.5, 0.841345, 0.975 }
     {
     }
 
@@ -21,6 +21,7 @@
 #define EOS_GUARD_SRC_STATISTICS_PRIOR_SAMPLER_HH 1
 
 #include <eos/statistics/log-prior-fwd.hh>
+#include <eos/statistics/online-summary.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/private_implementation_pattern.hh>
 #include <eos/utils/hdf5-fwd.hh>
@@ -33,7 +34,9 @@ namespace eos
      * Perform simple uncertainty propagation by defining parameters to be varied,
      * and the observables whose variation one is interested in.
      * Parameter values are sampled directly from 1D priors.
-     * All observable values are stored to disk.
+     * Observable values are stored to disk in batches as they are computed, and
+     * are summarised online by their means, variances, quantiles and optionally
+     * their covariance.
      */
     class PriorSampler :
         public PrivateImplementationPattern<PriorSampler>
@@ -83,6 +86,11 @@ namespace eos
              * @note No new samples are drawn from the priors.
              */
             void run(const SamplesList & samples, const std::vector<ParameterDescription> & );
+
+            /*!
+             * Retrieve the online summary of all observable values computed in the last run.
+             */
+            const OnlineSummary & summary() const;
     };
 
     /*!
@@ -105,7 +113,12 @@ namespace eos
             /// Number of worker threads
             unsigned n_workers;
 
-            /// The file where the observables are stored.
+            /*!
+             * The file where the observables are stored.
+             *
+             * Several runs may write to the same file. Their samples are appended, while the
+             * descriptions and the summary are those of the last run.
+             */
             std::shared_ptr<hdf5::File> output_file;
 
             /*!
@@ -122,6 +135,21 @@ namespace eos
              * If false, only the observable values are stored.
              */
             bool store_parameters;
+
+            /*!
+             * If true, the observable values are stored.
+             * If false, only their summary is stored.
+             */
+            bool store_observables;
+
+            /// Number of samples that each worker computes before writing them to disk.
+            unsigned batch_size;
+
+            /// If true, the covariance matrix of the observables is computed as part of the summary.
+            bool compute_covariance;
+
+            /// Cumulative probabilities of the quantiles that are estimated as part of the summary.
+            std::vector<double> quantiles;
     };
 }
 
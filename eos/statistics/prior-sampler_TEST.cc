@@ -23,6 +23,8 @@
 #include <eos/utils/hdf5.hh>
 #include <test/test.hh>
 
+#include <algorithm>
+
 using namespace test;
 using namespace eos;
 
@@ -80,9 +82,9 @@ class PriorSamplerTest :
                 data_obs >> obs_record;
 
                 // parameters == observables
-                TEST_CHECK_NEARLY_EQUAL(obs_record[0], 4.17890395364246,   eps);
-                TEST_CHECK_NEARLY_EQUAL(obs_record[1], 1.47760548938249,   eps);
-                TEST_CHECK_NEARLY_EQUAL(obs_record[2], 0.0720324489288032, eps);
+                TEST_CHECK_NEARLY_EQUAL(obs_record[0], 4.157077577139722,   eps);
+                TEST_CHECK_NEARLY_EQUAL(obs_record[1], 1.124329567007796,   eps);
+                TEST_CHECK_NEARLY_EQUAL(obs_record[2], 0.00351735653821379, eps);
 
                 hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>> par_type
                 {
@@ -97,6 +99,162 @@ class PriorSamplerTest :
                 // proper parameter?
                 TEST_CHECK_EQUAL(std::get<0>(par_record), 3.5);
                 TEST_CHECK_EQUAL(std::get<1>(par_record), 4.5);
+
+                // summary matches the stored samples
+                std::vector<double> samples(3 * n_samples);
+                data_obs.read_raw(0, n_samples, samples.data());
+                double mean = 0.0;
+                for (unsigned i = 0 ; i < n_samples ; ++i)
+                {
+                    mean += samples[3 * i + 1] / n_samples;
+                }
+
+                hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>> moments_type
+                {
+                    "moments",
+                    hdf5::Scalar<double>("mean"),
+                    hdf5::Scalar<double>("variance"),
+                };
+                auto data_moments = file.open_data_set("/summary/observables/moments", moments_type);
+                TEST_CHECK_EQUAL(data_moments.records(), 3);
+
+                auto moments_record = std::make_tuple(0.0, 0.0);
+                data_moments.set_index(1);
+                data_moments >> moments_record;
+                TEST_CHECK_NEARLY_EQUAL(std::get<0>(moments_record), mean, eps);
+
+                auto data_quantiles = file.open_data_set("/summary/observables/quantiles", hdf5::Array<1, double>("quantiles", { 5 }));
+                TEST_CHECK_EQUAL(data_quantiles.records(), 3);
+            }
+
+            // only store the summary, and write in several batches per worker
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/prior-sampler_TEST-summary.hdf5");
+
+                PriorSampler::Config config = PriorSampler::Config::Default();
+                config.n_samples = 10000;
+                config.seed = 1;
+                config.store_observables = false;
+                config.batch_size = 64;
+                config.compute_covariance = true;
+                config.output_file.reset(new hdf5::File(hdf5::File::Create(file_name)));
+
+                Parameters p = Parameters::Defaults();
+
+                ObservableSet o;
+                o.add(ObservablePtr(new ObservableStub(p, "mass::c")));
+                o.add(ObservablePtr(new ObservableStub(p, "mass::s(2GeV)")));
+
+                PriorSampler sampler(o, config);
+                sampler.add(LogPrior::Flat(p, "mass::c", ParameterRange{ 1, 2 }));
+                sampler.add(LogPrior::Flat(p, "mass::s(2GeV)", ParameterRange{ 0, 0.1 }));
+                sampler.run();
+
+                const OnlineSummary & summary = sampler.summary();
+                TEST_CHECK_EQUAL(summary.number_of_elements(), 10000u);
+                TEST_CHECK_NEARLY_EQUAL(summary.moments(0).mean(),                1.5,        0.01);
+                TEST_CHECK_NEARLY_EQUAL(summary.moments(1).variance(),            0.01 / 12,  0.0001);
+                TEST_CHECK_NEARLY_EQUAL(summary.quantiles(0).quantile(0.975),     1.975,      0.01);
+                TEST_CHECK_NEARLY_EQUAL(summary.covariance().covariance()[1],     0.0,        0.001);
+            }
+
+            // the samples do not depend on the number of workers
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/prior-sampler_TEST-workers.hdf5");
+
+                std::vector<std::vector<double>> results;
+                for (unsigned n_workers : { 1u, 3u })
+                {
+                    PriorSampler::Config config = PriorSampler::Config::Default();
+                    config.n_samples = 10;
+                    config.n_workers = n_workers;
+                    config.seed = 1;
+                    config.output_file.reset(new hdf5::File(hdf5::File::Create(file_name)));
+
+                    Parameters p = Parameters::Defaults();
+
+                    ObservableSet o;
+                    o.add(ObservablePtr(new ObservableStub(p, "mass::c")));
+
+                    PriorSampler sampler(o, config);
+                    sampler.add(LogPrior::Flat(p, "mass::c", ParameterRange{ 1, 2 }));
+                    sampler.run();
+
+                    auto file = hdf5::File::Open(file_name);
+                    auto data_obs = file.open_data_set("/data/observables", PriorSampler::observables_type(1));
+
+                    results.push_back(std::vector<double>(config.n_samples));
+                    data_obs.read_raw(0, config.n_samples, results.back().data());
+                }
+
+                for (unsigned i = 0 ; i < results.front().size() ; ++i)
+                {
+                    TEST_CHECK_EQUAL(results[0][i], results[1][i]);
+                }
+            }
+
+            // a second run into the same file appends its samples and replaces the summary
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/prior-sampler_TEST-append.hdf5");
+
+                PriorSampler::Config config = PriorSampler::Config::Default();
+                config.n_samples = 10;
+                config.seed = 1;
+                config.output_file.reset(new hdf5::File(hdf5::File::Create(file_name)));
+
+                Parameters p = Parameters::Defaults();
+
+                ObservableSet o;
+                o.add(ObservablePtr(new ObservableStub(p, "mass::c")));
+
+                PriorSampler first(o, config);
+                first.add(LogPrior::Flat(p, "mass::c", ParameterRange{ 1, 2 }));
+                first.run();
+
+                config.n_samples = 20;
+                config.seed = 2;
+
+                PriorSampler second(o, config);
+                second.add(LogPrior::Flat(p, "mass::c", ParameterRange{ 3, 4 }));
+                second.run();
+
+                auto file = hdf5::File::Open(file_name);
+
+                auto data_obs = file.open_data_set("/data/observables", PriorSampler::observables_type(1));
+                TEST_CHECK_EQUAL(data_obs.records(), 30u);
+
+                std::vector<double> samples(30);
+                data_obs.read_raw(0, 30, samples.data());
+                TEST_CHECK(std::all_of(samples.cbegin(), samples.cbegin() + 10, [] (const double & x) { return (1.0 <= x) && (x <= 2.0); }));
+                TEST_CHECK(std::all_of(samples.cbegin() + 10, samples.cend(), [] (const double & x) { return (3.0 <= x) && (x <= 4.0); }));
+
+                hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>> par_type
+                {
+                    "parameter description",
+                    hdf5::Scalar<double>("min"),
+                    hdf5::Scalar<double>("max"),
+                };
+                auto data_par = file.open_data_set("/descriptions/parameters/0", par_type);
+                TEST_CHECK_EQUAL(data_par.records(), 1u);
+                auto par = std::make_tuple(0.0, 0.0);
+                data_par >> par;
+                TEST_CHECK_EQUAL(std::get<0>(par), 3.0);
+                TEST_CHECK_EQUAL(std::get<1>(par), 4.0);
+
+                hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>> moments_type
+                {
+                    "moments",
+                    hdf5::Scalar<double>("mean"),
+                    hdf5::Scalar<double>("variance"),
+                };
+                auto data_moments = file.open_data_set("/summary/observables/moments", moments_type);
+                TEST_CHECK_EQUAL(data_moments.records(), 1u);
+                auto moments = std::make_tuple(0.0, 0.0);
+                data_moments >> moments;
+                TEST_CHECK_NEARLY_EQUAL(std::get<0>(moments), second.summary().moments(0).mean(), 1e-15);
+
+                auto attr_samples = data_moments.open_attribute("samples", hdf5::Scalar<unsigned long>("samples"));
+                TEST_CHECK_EQUAL(attr_samples.value(), 20u);
             }
         }
 } prior_sampler_test;
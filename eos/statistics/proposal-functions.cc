@@ -25,6 +25,7 @@
 #include <eos/utils/hdf5.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/power_of.hh>
+#include <eos/utils/random-stream.hh>
 
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
@@ -194,6 +195,7 @@ namespace eos
                 p->covariance_scale = std::get<0>(scalars);
                 p->cooling_power = std::get<1>(scalars);
                 p->adaptations = std::get<2>(scalars);
+                p->read_sample_covariance(file, data_set_base_name);
 
                 return ProposalFunctionPtr(p);
             }
@@ -230,6 +232,7 @@ namespace eos
                 p->covariance_scale = std::get<0>(scalars);
                 p->cooling_power = std::get<1>(scalars);
                 p->adaptations = std::get<2>(scalars);
+                p->read_sample_covariance(file, data_set_base_name);
 
                 return ProposalFunctionPtr(p);
             }
@@ -500,6 +503,27 @@ namespace eos
             std::iota(_index_list.begin(), _index_list.end(), 0);
         }
 
+        Multivariate::Multivariate(const Multivariate & other) :
+            MarkovChain::ProposalFunction(other),
+            _tmp_left(gsl_vector_alloc(other._dimension)),
+            _tmp_right(gsl_vector_alloc(other._dimension)),
+            _tmp_sample_covariance_current(gsl_matrix_alloc(other._dimension, other._dimension)),
+            _covariance(gsl_matrix_alloc(other._dimension, other._dimension)),
+            _covariance_inverse(gsl_matrix_alloc(other._dimension, other._dimension)),
+            _covariance_chol(gsl_matrix_alloc(other._dimension, other._dimension)),
+            _dimension(other._dimension),
+            _index_list(other._index_list),
+            adaptations(other.adaptations),
+            covariance_scale(other.covariance_scale),
+            cooling_power(other.cooling_power),
+            norm(other.norm)
+        {
+            gsl_matrix_memcpy(_tmp_sample_covariance_current, other._tmp_sample_covariance_current);
+            gsl_matrix_memcpy(_covariance, other._covariance);
+            gsl_matrix_memcpy(_covariance_inverse, other._covariance_inverse);
+            gsl_matrix_memcpy(_covariance_chol, other._covariance_chol);
+        }
+
         const double Multivariate::covariance_scale_min = 1e-4;
         const double Multivariate::covariance_scale_max = 100;
         const double Multivariate::covariance_scale_update_factor = 1.5;
@@ -635,6 +659,58 @@ namespace eos
             _compute_norm();
         }
 
+        void
+        Multivariate::_draw_batch(const unsigned & count, gsl_rng * rng) const
+        {
+            _batch_left.resize(count * _dimension);
+
+            // generate standard normals, one proposal per row
+            draw_standard_normal(rng, _batch_left.data(), _batch_left.size());
+
+            // transform all rows to N(0, Sigma) at once: Z -> Z L^T
+            gsl_matrix_view z = gsl_matrix_view_array(_batch_left.data(), count, _dimension);
+            gsl_blas_dtrmm(CblasRight, CblasLower, CblasTrans, CblasNonUnit, 1.0, _covariance_chol, &z.matrix);
+        }
+
+        void
+        Multivariate::_chi_squared_batch(const std::vector<MarkovChain::State> & x, const std::vector<MarkovChain::State> & y) const
+        {
+            if (x.size() != y.size())
+                throw InternalError("prop::Multivariate: number of states do not match ("
+                    + stringify(x.size()) + " vs " + stringify(y.size()) + ").");
+
+            const unsigned count = x.size();
+            _batch_left.resize(count * _dimension);
+            _batch_right.resize(count * _dimension);
+
+            // center around zero, one pair per row
+            for (unsigned i = 0 ; i < count ; ++i)
+            {
+                const double * xp = x[i].point.data(), * yp = y[i].point.data();
+                double * d = _batch_left.data() + i * _dimension;
+                for (unsigned j = 0 ; j < _dimension ; ++j)
+                {
+                    d[j] = xp[j] - yp[j];
+                }
+            }
+
+            // \chi^2 from bilinear forms, using one matrix-matrix product for all pairs
+            gsl_matrix_view d = gsl_matrix_view_array(_batch_left.data(), count, _dimension);
+            gsl_matrix_view t = gsl_matrix_view_array(_batch_right.data(), count, _dimension);
+            gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &d.matrix, _covariance_inverse, 0.0, &t.matrix);
+
+            for (unsigned i = 0 ; i < count ; ++i)
+            {
+                const double * dp = _batch_left.data() + i * _dimension, * tp = _batch_right.data() + i * _dimension;
+                double chi_squared = 0.0;
+                for (unsigned j = 0 ; j < _dimension ; ++j)
+                {
+                    chi_squared += dp[j] * tp[j];
+                }
+                _batch_right[i] = chi_squared;
+            }
+        }
+
         const gsl_matrix *
         Multivariate::covariance() const
         {
@@ -659,15 +735,42 @@ namespace eos
                 std::copy(_covariance->data, _covariance->data + _dimension * _dimension, record.begin());
                 data_set << record;
             }
-            H5E_BEGIN_TRY
+
+            /* store the sample covariance, from which the next adaptation proceeds */
             {
-                // the meta set has only one line, so do nothing if it exists already
-                try
+                auto data_set = file.create_or_open_data_set(data_set_base_name + "/sample covariance", covariance_type(_dimension));
+                std::vector<double> record(_dimension * _dimension);
+                std::copy(_tmp_sample_covariance_current->data, _tmp_sample_covariance_current->data + _dimension * _dimension, record.begin());
+                data_set << record;
+            }
+
+            // the meta set has only one line, so do nothing if it is filled already
+            {
+                auto meta_data_set = file.create_or_open_data_set(data_set_base_name + "/meta", proposal_functions::meta_type());
+                if (0 == meta_data_set.records())
                 {
-                    auto meta_data_set = file.create_data_set(data_set_base_name + "/meta", proposal_functions::meta_type());
                     auto meta_record = std::make_tuple(proposal_type_name.c_str(), _dimension);
                     meta_data_set << meta_record;
                 }
+            }
+        }
+
+        void
+        Multivariate::read_sample_covariance(hdf5::File & file, const std::string & data_set_base_name)
+        {
+            H5E_BEGIN_TRY
+            {
+                // proposals stored by earlier versions lack the sample covariance
+                try
+                {
+                    auto data_set = file.open_data_set(data_set_base_name + "/sample covariance", covariance_type(_dimension));
+                    std::vector<double> record(_dimension * _dimension);
+
+                    // jump to last record
+                    data_set.end();
+                    data_set >> record;
+                    std::copy(record.cbegin(), record.cend(), _tmp_sample_covariance_current->data);
+                }
                 catch (HDF5Error &)
                 {
                 }
@@ -832,12 +935,7 @@ namespace eos
         ProposalFunctionPtr
         MultivariateGaussian::clone() const
         {
-            std::vector<double> cov(_covariance->data, _covariance->data + _dimension * _dimension);
-            MultivariateGaussian * mvg = new MultivariateGaussian(_dimension, cov);
-            mvg->_copy(*this);
-            mvg->_compute_norm();
-
-            return ProposalFunctionPtr(mvg);
+            return ProposalFunctionPtr(new MultivariateGaussian(*this));
         }
 
         void
@@ -873,7 +971,7 @@ namespace eos
         MultivariateGaussian::propose(MarkovChain::State & proposal, const MarkovChain::State & current, gsl_rng * rng) const
         {
             // generate standard normals
-            std::generate(_tmp_left->data, _tmp_left->data + _dimension, std::bind(gsl_ran_ugaussian, rng));
+            draw_standard_normal(rng, _tmp_left->data, _dimension);
 
             // transform
             gsl_blas_dtrmv(CblasLower, CblasNoTrans, CblasNonUnit, _covariance_chol, _tmp_left);
@@ -884,6 +982,33 @@ namespace eos
             }
         }
 
+        void
+        MultivariateGaussian::propose(std::vector<MarkovChain::State> & proposals, const MarkovChain::State & current, gsl_rng * rng) const
+        {
+            _draw_batch(proposals.size(), rng);
+
+            for (unsigned k = 0 ; k < proposals.size() ; ++k)
+            {
+                const double * delta = _batch_left.data() + k * _dimension;
+                for (unsigned i = 0 ; i < _dimension ; ++i)
+                {
+                    proposals[k].point[i] = current.point[i] + delta[i];
+                }
+            }
+        }
+
+        void
+        MultivariateGaussian::evaluate(std::vector<double> & result, const std::vector<MarkovChain::State> & x, const std::vector<MarkovChain::State> & y) const
+        {
+            _chi_squared_batch(x, y);
+
+            result.resize(x.size());
+            for (unsigned k = 0 ; k < x.size() ; ++k)
+            {
+                result[k] = norm - _batch_right[k] / 2.0;
+            }
+        }
+
         void
         MultivariateStudentT::_compute_norm()
         {
@@ -929,13 +1054,7 @@ namespace eos
         ProposalFunctionPtr
         MultivariateStudentT::clone() const
         {
-            std::vector<double> cov(_covariance->data, _covariance->data + _dimension * _dimension);
-            MultivariateStudentT * mvt = new MultivariateStudentT(_dimension, cov, dof);
-
-            mvt->_copy(*this);
-            mvt->_compute_norm();
-
-            return ProposalFunctionPtr(mvt);
+            return ProposalFunctionPtr(new MultivariateStudentT(*this));
         }
 
         void
@@ -969,7 +1088,7 @@ namespace eos
         MultivariateStudentT::propose(MarkovChain::State & proposal, const MarkovChain::State & current, gsl_rng * rng) const
         {
             // generate standard normals
-            std::generate(_tmp_left->data, _tmp_left->data + _dimension, std::bind(gsl_ran_ugaussian, rng));
+            draw_standard_normal(rng, _tmp_left->data, _dimension);
 
             // transform to N(0, Sigma)
             gsl_blas_dtrmv(CblasLower, CblasNoTrans, CblasNonUnit, _covariance_chol, _tmp_left);
@@ -984,6 +1103,36 @@ namespace eos
             }
         }
 
+        void
+        MultivariateStudentT::propose(std::vector<MarkovChain::State> & proposals, const MarkovChain::State & current, gsl_rng * rng) const
+        {
+            // transform to N(0, Sigma)
+            _draw_batch(proposals.size(), rng);
+
+            for (unsigned k = 0 ; k < proposals.size() ; ++k)
+            {
+                // correct for degrees of freedom, and add mean
+                const double scale = std::sqrt(dof / gsl_ran_chisq(rng, dof));
+                const double * delta = _batch_left.data() + k * _dimension;
+                for (unsigned i = 0 ; i < _dimension ; ++i)
+                {
+                    proposals[k].point[i] = current.point[i] + scale * delta[i];
+                }
+            }
+        }
+
+        void
+        MultivariateStudentT::evaluate(std::vector<double> & result, const std::vector<MarkovChain::State> & x, const std::vector<MarkovChain::State> & y) const
+        {
+            _chi_squared_batch(x, y);
+
+            result.resize(x.size());
+            for (unsigned k = 0 ; k < x.size() ; ++k)
+            {
+                result[k] = norm - 0.5 * (dof + _dimension) * std::log(1.0 + _batch_right[k] / dof);
+            }
+        }
+
         BlockDecomposition::PriorsType
         BlockDecomposition::priors_type()
         {
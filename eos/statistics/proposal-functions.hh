@@ -167,11 +167,27 @@ namespace eos
 
                 std::vector<unsigned> _index_list;
 
+                // scratch space for batches, reused across calls
+                mutable std::vector<double> _batch_left;
+                mutable std::vector<double> _batch_right;
+
                 void _compute_cholesky_and_inverse();
                 virtual void _compute_norm() = 0;
                 void _copy(const Multivariate &);
                 void _dump_covariance(hdf5::File & file, const std::string & data_set_base_name, const std::string & proposal_type_name) const;
 
+                /*!
+                 * Draw count points from N(0, Sigma) into _batch_left, one per row.
+                 * All standard normals are transformed in a single triangular matrix-matrix product.
+                 */
+                void _draw_batch(const unsigned & count, gsl_rng * rng) const;
+
+                /// Compute the chi^2 of the differences x[i] - y[i] into _batch_right.
+                void _chi_squared_batch(const std::vector<MarkovChain::State> & x, const std::vector<MarkovChain::State> & y) const;
+
+                /// Copy constructor, which copies the decomposed covariance rather than recomputing it.
+                Multivariate(const Multivariate & other);
+
             public:
                 /// The dimension of the space for which samples are proposed
                 unsigned dimension() const;
@@ -221,6 +237,39 @@ namespace eos
 
                 virtual ~Multivariate();
 
+                Multivariate & operator= (const Multivariate &) = delete;
+
+                /*!
+                 * Restore the running estimate of the sample covariance, if it was stored along with the proposal covariance.
+                 * Without it, further adaptations start from the proposal covariance.
+                 *
+                 * @param file               The HDF5 file.
+                 * @param data_set_base_name The directory in the file under which the proposal was stored.
+                 */
+                void read_sample_covariance(hdf5::File & file, const std::string & data_set_base_name);
+
+                using MarkovChain::ProposalFunction::evaluate;
+                using MarkovChain::ProposalFunction::propose;
+
+                /*!
+                 * Evaluate the proposal density for several pairs of states at once.
+                 *
+                 * @param result  Holds evaluate(x[i], y[i]) on return.
+                 * @param x       The proposed states.
+                 * @param y       The states around which was proposed.
+                 */
+                virtual void evaluate(std::vector<double> & result, const std::vector<MarkovChain::State> & x, const std::vector<MarkovChain::State> & y) const = 0;
+
+                /*!
+                 * Propose several states around the same current state at once.
+                 * For a single proposal, the same random numbers are used as by propose(proposal, current, rng).
+                 *
+                 * @param proposals  The proposed states. Their number is determined by the size of the vector.
+                 * @param current    The current state.
+                 * @param rng        The random number generator.
+                 */
+                virtual void propose(std::vector<MarkovChain::State> & proposals, const MarkovChain::State & current, gsl_rng * rng) const = 0;
+
                 /*!
                  * @note Expect history to have only the most recent part, to which proposal
                  * function has not adapted yet. Accordingly, the efficiency
@@ -274,7 +323,11 @@ namespace eos
 
                 virtual double evaluate(const MarkovChain::State & x, const MarkovChain::State & y) const;
 
+                virtual void evaluate(std::vector<double> & result, const std::vector<MarkovChain::State> & x, const std::vector<MarkovChain::State> & y) const;
+
                 virtual void propose(MarkovChain::State & x, const MarkovChain::State & y, gsl_rng * rng) const;
+
+                virtual void propose(std::vector<MarkovChain::State> & proposals, const MarkovChain::State & current, gsl_rng * rng) const;
         };
 
         class MultivariateStudentT :
@@ -303,7 +356,11 @@ namespace eos
 
                 virtual double evaluate(const MarkovChain::State & x, const MarkovChain::State & y) const;
 
+                virtual void evaluate(std::vector<double> & result, const std::vector<MarkovChain::State> & x, const std::vector<MarkovChain::State> & y) const;
+
                 virtual void propose(MarkovChain::State & x, const MarkovChain::State & y, gsl_rng * rng) const;
+
+                virtual void propose(std::vector<MarkovChain::State> & proposals, const MarkovChain::State & current, gsl_rng * rng) const;
         };
 
         struct MultivariateAccess
@@ -23,6 +23,7 @@
 #include <eos/statistics/proposal-functions.hh>
 #include <eos/utils/hdf5.hh>
 #include <eos/utils/power_of.hh>
+#include <eos/utils/random-stream.hh>
 #include <algorithm>
 
 using namespace test;
@@ -191,6 +192,58 @@ class ProposalFunctionsTest :
                 TEST_CHECK_EQUAL(mvt->covariance()->data[1], mvt_clone->covariance()->data[1]);
                 TEST_CHECK_EQUAL(mvt->covariance()->data[3], mvt_clone->covariance()->data[3]);
                 TEST_CHECK_EQUAL(mvt->adaptations, mvt_clone->adaptations);
+                TEST_CHECK_EQUAL(mvt->norm, mvt_clone->norm);
+            }
+
+            // batches of proposals and evaluations
+            {
+                std::vector<double> cov{ 0.0049, 0.0021, 0.0021, 0.01 };
+
+                std::vector<MultivariateProposalPtr> mvs
+                {
+                    MultivariateProposalPtr(new MultivariateGaussian(2, cov)),
+                    MultivariateProposalPtr(new MultivariateStudentT(2, cov, 5.0))
+                };
+
+                for (auto & mv : mvs)
+                {
+                    MarkovChain::State current;
+                    current.point = std::vector<double>{ 4.3, 1.1 };
+
+                    // a batch of one uses the same random numbers as a single proposal
+                    {
+                        RandomStream a(1346, "test"), b(1346, "test");
+
+                        MarkovChain::State single = current;
+                        mv->propose(single, current, a.rng());
+
+                        std::vector<MarkovChain::State> batch(1, current);
+                        mv->propose(batch, current, b.rng());
+
+                        TEST_CHECK_NEARLY_EQUAL(single.point[0], batch[0].point[0], 1e-14);
+                        TEST_CHECK_NEARLY_EQUAL(single.point[1], batch[0].point[1], 1e-14);
+                    }
+
+                    std::vector<MarkovChain::State> proposals(7, current);
+                    {
+                        RandomStream stream(1346, "test");
+                        mv->propose(proposals, current, stream.rng());
+                    }
+
+                    TEST_CHECK(proposals[0].point != proposals[1].point);
+
+                    std::vector<MarkovChain::State> currents(proposals.size(), current);
+                    std::vector<double> values;
+                    mv->evaluate(values, proposals, currents);
+
+                    TEST_CHECK_EQUAL(values.size(), proposals.size());
+                    for (unsigned k = 0 ; k < proposals.size() ; ++k)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(values[k], mv->evaluate(proposals[k], current), 1e-13);
+                    }
+
+                    TEST_CHECK_THROWS(InternalError, mv->evaluate(values, proposals, std::vector<MarkovChain::State>(1, current)));
+                }
             }
 
             // check sampling of single gaussian
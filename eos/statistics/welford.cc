@@ -53,6 +53,30 @@ namespace eos
         }
     }
 
+    void
+    Welford::merge(const Welford & other)
+    {
+        if (0 == other.size)
+            return;
+
+        if (0 == size)
+        {
+            *this = other;
+            return;
+        }
+
+        const double n = size + other.size;
+        const double delta = other.new_mean - new_mean;
+
+        new_mean = new_mean + delta * other.size / n;
+        new_sum = new_sum + other.new_sum + delta * delta * size * other.size / n;
+        size += other.size;
+
+        // setup for next iteration
+        old_mean = new_mean;
+        old_sum = new_sum;
+    }
+
     double
     Welford::mean() const
     {
@@ -41,6 +41,12 @@ namespace eos
 
             void add(const double & value);
 
+            /*!
+             * Combine with the running mean and variance of a disjoint set of values,
+             * cf. Chan, Golub and LeVeque, The American Statistician 37 (1983), p. 242.
+             */
+            void merge(const Welford & other);
+
             double mean() const;
 
             unsigned number_of_elements() const;
@@ -52,5 +52,26 @@ class WelfordTest :
                 TEST_CHECK_RELATIVE_ERROR(w.mean(), 209.16066666666665697, eps);
                 TEST_CHECK_RELATIVE_ERROR(w.variance(), 42427.57164133333571954, eps);
             }
+
+            // merging gives the same result as adding all values to one instance
+            {
+                std::vector<double> samples { 1.23, 413.132, 213.12, -4.5, 17.0 };
+
+                Welford all, first, second, empty;
+                for (unsigned i = 0 ; i < samples.size() ; ++i)
+                {
+                    all.add(samples[i]);
+                    (i < 2 ? first : second).add(samples[i]);
+                }
+
+                first.merge(second);
+                first.merge(empty);
+                empty.merge(first);
+
+                TEST_CHECK_EQUAL(first.number_of_elements(), 5u);
+                TEST_CHECK_RELATIVE_ERROR(first.mean(),     all.mean(),     eps);
+                TEST_CHECK_RELATIVE_ERROR(first.variance(), all.variance(), eps);
+                TEST_CHECK_RELATIVE_ERROR(empty.variance(), all.variance(), eps);
+            }
         }
 } welford_test;
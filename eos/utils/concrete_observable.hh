@@ -23,20 +23,145 @@
 #include <eos/observable-impl.hh>
 #include <eos/utils/apply.hh>
 #include <eos/utils/join.hh>
+#include <eos/utils/observable_term.hh>
 #include <eos/utils/tuple-maker.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <array>
 #include <functional>
 #include <string>
+#include <typeinfo>
+#include <vector>
 
 namespace eos
 {
+    namespace impl
+    {
+        /*
+         * A single call of a decay's member function at fixed kinematics. Terms of different
+         * observables are equivalent if they call the same member function with the same
+         * kinematics on decays that were constructed from the same Parameters and Options.
+         */
+        template <typename Decay_, typename ... Args_>
+        class ConcreteObservableTerm :
+            public ObservableTerm
+        {
+            public:
+                typedef double (Decay_::* Function)(const Args_ & ...) const;
+
+            private:
+                Parameters _parameters;
+
+                Kinematics _kinematics;
+
+                Options _options;
+
+                Function _function;
+
+                std::function<double (const Decay_ *, const Args_ & ...)> _call;
+
+                std::tuple<const Decay_ *, typename ConvertTo<Args_, KinematicVariable>::Type ...> _argument_tuple;
+
+                std::vector<KinematicVariable> _variables;
+
+                const unsigned long & _revision;
+
+                // The arguments as of the creation of the latest handle
+                mutable std::tuple<const Decay_ *, typename ConvertTo<Args_, double>::Type ...> _bound_arguments;
+
+                static double evaluate_bound(const void * data)
+                {
+                    auto term = static_cast<const ConcreteObservableTerm *>(data);
+                    auto function = term->_function;
+
+                    return TupleApplicator<double, 1 + sizeof...(Args_)>::apply(
+                            [function] (const Decay_ * decay, const Args_ & ... args) { return (decay->*function)(args ...); },
+                            term->_bound_arguments);
+                }
+
+            public:
+                ConcreteObservableTerm(const Parameters & parameters,
+                        const Kinematics & kinematics,
+                        const Options & options,
+                        const Decay_ * decay,
+                        const Function & function,
+                        const std::tuple<typename ConvertTo<Args_, const char *>::Type ...> & kinematics_names) :
+                    _parameters(parameters),
+                    _kinematics(kinematics),
+                    _options(options),
+                    _function(function),
+                    _call(std::mem_fn(function)),
+                    _argument_tuple(TupleMaker<sizeof...(Args_)>::make(kinematics, kinematics_names, decay)),
+                    _revision(_kinematics.revision()),
+                    _bound_arguments(_argument_tuple)
+                {
+                    for (const auto & name : make_array<const std::string>(kinematics_names))
+                    {
+                        _variables.push_back(kinematics[name]);
+                    }
+                }
+
+                virtual double evaluate() const
+                {
+                    std::tuple<const Decay_ *, typename ConvertTo<Args_, double>::Type ...> values = _argument_tuple;
+
+                    return apply(_call, values);
+                }
+
+                virtual std::size_t hash() const
+                {
+                    std::size_t result = typeid(Decay_).hash_code();
+
+                    auto combine = [&result] (const std::size_t & value)
+                    {
+                        result ^= value + 0x9e3779b9 + (result << 6) + (result >> 2);
+                    };
+
+                    combine(std::hash<std::string>()(_options.as_string()));
+
+                    for (const auto & v : _variables)
+                    {
+                        combine(std::hash<double>()(v.evaluate()));
+                    }
+
+                    return result;
+                }
+
+                virtual bool equivalent(const ObservableTerm & other) const
+                {
+                    auto o = dynamic_cast<const ConcreteObservableTerm *>(&other);
+
+                    if (! o)
+                        return false;
+
+                    if ((_function != o->_function) || (_parameters != o->_parameters) || (_options != o->_options))
+                        return false;
+
+                    for (unsigned i = 0 ; i < _variables.size() ; ++i)
+                    {
+                        if (_variables[i].evaluate() != o->_variables[i].evaluate())
+                            return false;
+                    }
+
+                    return true;
+                }
+
+                virtual ObservableHandle handle() const
+                {
+                    _bound_arguments = _argument_tuple;
+
+                    return ObservableHandle(this, &ConcreteObservableTerm::evaluate_bound, sizeof...(Args_) > 0 ? &_revision : nullptr);
+                }
+        };
+    }
+
     template <typename Decay_, typename ... Args_>
     class ConcreteObservable :
-        public Observable
+        public Observable,
+        public ComposedObservable
     {
         public:
+            typedef double (Decay_::* Function)(const Args_ & ...) const;
 
         private:
             QualifiedName _name;
@@ -49,18 +174,18 @@ namespace eos
 
             Decay_ _decay;
 
-            std::function<double (const Decay_ *, const Args_ & ...)> _function;
+            Function _function;
 
             std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> _kinematics_names;
 
-            std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, KinematicVariable>::Type ...> _argument_tuple;
+            std::shared_ptr<const impl::ConcreteObservableTerm<Decay_, Args_ ...>> _term;
 
         public:
             ConcreteObservable(const QualifiedName & name,
                     const Parameters & parameters,
                     const Kinematics & kinematics,
                     const Options & options,
-                    const std::function<double (const Decay_ *, const Args_ & ...)> & function,
+                    const Function & function,
                     const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names) :
                 _name(name),
                 _parameters(parameters),
@@ -69,7 +194,7 @@ namespace eos
                 _decay(parameters, options),
                 _function(function),
                 _kinematics_names(kinematics_names),
-                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, &_decay))
+                _term(new impl::ConcreteObservableTerm<Decay_, Args_ ...>(_parameters, _kinematics, _options, &_decay, _function, _kinematics_names))
             {
                 uses(_decay);
             }
@@ -81,9 +206,7 @@ namespace eos
 
             virtual double evaluate() const
             {
-                std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, double>::Type ...> values = _argument_tuple;
-
-                return apply(_function, values);
+                return _term->evaluate();
             };
 
             virtual Parameters parameters()
@@ -110,6 +233,16 @@ namespace eos
             {
                 return ObservablePtr(new ConcreteObservable(_name, parameters, _kinematics.clone(), _options, _function, _kinematics_names));
             }
+
+            virtual std::vector<ObservableTermPtr> terms() const
+            {
+                return { _term };
+            }
+
+            virtual double compose(const std::vector<double> & values) const
+            {
+                return values[0];
+            }
     };
 
     template <typename Decay_, typename ... Args_>
@@ -121,7 +254,7 @@ namespace eos
 
             std::string _latex;
 
-            std::function<double (const Decay_ *, const Args_ & ...)> _function;
+            typename ConcreteObservable<Decay_, Args_ ...>::Function _function;
 
             std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> _kinematics_names;
 
@@ -131,7 +264,7 @@ namespace eos
 
         public:
             ConcreteObservableEntry(const QualifiedName & name, const std::string & latex,
-                    const std::function<double (const Decay_ *, const Args_ & ...)> & function,
+                    const typename ConcreteObservable<Decay_, Args_ ...>::Function & function,
                     const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names,
                     const Options & forced_options) :
                 _name(name),
@@ -194,15 +327,16 @@ namespace eos
         static_assert(sizeof...(Args_) == impl::TupleSize<Tuple_>::size, "Need as many function arguments as kinematics names!");
 
         return std::make_shared<ConcreteObservableEntry<Decay_, Args_ ...>>(name, latex,
-                std::function<double (const Decay_ *, const Args_ & ...)>(std::mem_fn(function)),
-                kinematics_names, forced_options);
+                function, kinematics_names, forced_options);
     }
 
     template <typename Decay_, typename ... Args_>
     class ConcreteObservableRatio :
-        public Observable
+        public Observable,
+        public ComposedObservable
     {
         public:
+            typedef double (Decay_::* Function)(const Args_ & ...) const;
 
         private:
             QualifiedName _name;
@@ -215,21 +349,21 @@ namespace eos
 
             Decay_ _decay_numerator, _decay_denominator;
 
-            std::function<double (const Decay_ *, const Args_ & ...)> _numerator, _denominator;
+            Function _numerator, _denominator;
 
             std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> _kinematics_names_numerator, _kinematics_names_denominator;
 
-            std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, KinematicVariable>::Type ...> _argument_tuple_numerator, _argument_tuple_denominator;
+            std::shared_ptr<const impl::ConcreteObservableTerm<Decay_, Args_ ...>> _term_numerator, _term_denominator;
 
         public:
             ConcreteObservableRatio(const QualifiedName & name,
                     const Parameters & parameters,
                     const Kinematics & kinematics,
                     const Options & options,
-                    const std::function<double (const Decay_ *, const Args_ & ...)> & numerator,
+                    const Function & numerator,
                     const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names_numerator,
                     const Options & forced_options_numerator,
-                    const std::function<double (const Decay_ *, const Args_ & ...)> & denominator,
+                    const Function & denominator,
                     const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names_denominator,
                     const Options & forced_options_denominator) :
                 _name(name),
@@ -244,8 +378,10 @@ namespace eos
                 _denominator(denominator),
                 _kinematics_names_numerator(kinematics_names_numerator),
                 _kinematics_names_denominator(kinematics_names_denominator),
-                _argument_tuple_numerator(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names_numerator, &_decay_numerator)),
-                _argument_tuple_denominator(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names_denominator, &_decay_denominator))
+                _term_numerator(new impl::ConcreteObservableTerm<Decay_, Args_ ...>(_parameters, _kinematics, options + _forced_options_numerator,
+                        &_decay_numerator, _numerator, _kinematics_names_numerator)),
+                _term_denominator(new impl::ConcreteObservableTerm<Decay_, Args_ ...>(_parameters, _kinematics, options + _forced_options_denominator,
+                        &_decay_denominator, _denominator, _kinematics_names_denominator))
             {
                 uses(_decay_numerator);
                 uses(_decay_denominator);
@@ -260,10 +396,7 @@ namespace eos
 
             virtual double evaluate() const
             {
-                std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, double>::Type ...> values_numerator   = _argument_tuple_numerator;
-                std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, double>::Type ...> values_denominator = _argument_tuple_denominator;
-
-                return apply(_numerator, values_numerator) / apply(_denominator, values_denominator);
+                return _term_numerator->evaluate() / _term_denominator->evaluate();
             };
 
             virtual Parameters parameters()
@@ -294,6 +427,16 @@ namespace eos
                         _numerator,   _kinematics_names_numerator,   _forced_options_numerator,
                         _denominator, _kinematics_names_denominator, _forced_options_denominator));
             }
+
+            virtual std::vector<ObservableTermPtr> terms() const
+            {
+                return { _term_numerator, _term_denominator };
+            }
+
+            virtual double compose(const std::vector<double> & values) const
+            {
+                return values[0] / values[1];
+            }
     };
 
     template <typename Decay_, typename ... Args_>
@@ -305,7 +448,7 @@ namespace eos
 
             std::string _latex;
 
-            std::function<double (const Decay_ *, const Args_ & ...)> _numerator, _denominator;
+            typename ConcreteObservableRatio<Decay_, Args_ ...>::Function _numerator, _denominator;
 
             Options _forced_options_numerator, _forced_options_denominator;
 
@@ -315,10 +458,10 @@ namespace eos
 
         public:
             ConcreteObservableRatioEntry(const QualifiedName & name, const std::string & latex,
-                    const std::function<double (const Decay_ *, const Args_ & ...)> & numerator,
+                    const typename ConcreteObservableRatio<Decay_, Args_ ...>::Function & numerator,
                     const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names_numerator,
                     const Options & forced_options_numerator,
-                    const std::function<double (const Decay_ *, const Args_ & ...)> & denominator,
+                    const typename ConcreteObservableRatio<Decay_, Args_ ...>::Function & denominator,
                     const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names_denominator,
                     const Options & forced_options_denominator) :
                 _name(name),
@@ -389,10 +532,10 @@ namespace eos
         static_assert(sizeof...(Args_) == impl::TupleSize<Tuple_>::size, "Need as many function arguments as kinematics names!");
 
         return std::make_shared<ConcreteObservableRatioEntry<Decay_, Args_ ...>>(name, latex,
-                std::function<double (const Decay_ *, const Args_ & ...)>(std::mem_fn(numerator)),
+                numerator,
                 kinematics_names_numerator,
                 forced_options_numerator,
-                std::function<double (const Decay_ *, const Args_ & ...)>(std::mem_fn(denominator)),
+                denominator,
                 kinematics_names_denominator,
                 forced_options_denominator
                 );
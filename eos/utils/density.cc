@@ -49,6 +49,11 @@ namespace eos
         }
     }
 
+    void
+    Density::dump_profile(hdf5::File &, const std::string &) const
+    {
+    }
+
     Density::Output::DescriptionType
     Density::Output::description_type()
     {
@@ -60,6 +60,12 @@ namespace eos
              */
             virtual void dump_descriptions(hdf5::File & file, const std::string & data_set_base) const;
 
+            /*!
+             * Write the timings of the density's evaluations into the hdf5 file under the given data set name,
+             * if available. The default implementation does not write anything.
+             */
+            virtual void dump_profile(hdf5::File & file, const std::string & data_set_base) const;
+
             struct Output;
     };
 
@@ -37,6 +37,10 @@ namespace eos
 
         class File;
 
+        class MappedRegion;
+
+        template <typename T_> class PrefetchingReader;
+
         struct Type;
         template <unsigned rank_, typename T_> class Array;
         template <typename ... T_> class Composite;
@@ -26,6 +26,14 @@
 
 #include <hdf5.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 namespace eos
 {
     HDF5Error::HDF5Error(const std::string & message) :
@@ -196,6 +204,57 @@ namespace eos
         }
     };
 
+    template <> struct Implementation<hdf5::MappedRegion>
+    {
+        void * address;
+
+        size_t length;
+
+        const char * data;
+
+        hsize_t size;
+
+        Implementation(const std::string & filename, const haddr_t & offset, const hsize_t & size) :
+            address(MAP_FAILED),
+            length(0),
+            data(nullptr),
+            size(size)
+        {
+            if (0 == size)
+                return;
+
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (-1 == fd)
+                throw HDF5Error("Cannot open '" + filename + "' for mapping: " + std::strerror(errno));
+
+            // the offset passed to mmap must be a multiple of the page size
+            const haddr_t page_size = ::sysconf(_SC_PAGESIZE);
+            const haddr_t aligned_offset = offset - (offset % page_size);
+
+            length = size + (offset - aligned_offset);
+            address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, aligned_offset);
+            int error = errno;
+            ::close(fd);
+
+            if (MAP_FAILED == address)
+                throw HDF5Error("Cannot map '" + filename + "': " + std::strerror(error));
+
+            data = static_cast<const char *>(address) + (offset - aligned_offset);
+        }
+
+        ~Implementation()
+        {
+            if (MAP_FAILED == address)
+                return;
+
+            if (0 != ::munmap(address, length))
+            {
+                Log::instance()->message("[hdf5::MappedRegion::dtor]", ll_error)
+                    << "munmap failed: " << std::strerror(errno);
+            }
+        }
+    };
+
     namespace hdf5
     {
         /* Type System */
@@ -296,6 +355,134 @@ namespace eos
             H5Dread(_imp->data_set_id, _imp->type_id, _imp->space_id_memory_element, _imp->space_id_file, H5P_DEFAULT, buffer);
         }
 
+        void
+        DataSetHandle::write_many(hsize_t start, hsize_t count, const void * buffer)
+        {
+            if (0 == count)
+                return;
+
+            if (start + count > _imp->capacity)
+            {
+                hsize_t new_capacity = std::max(start + count, _imp->capacity + 1000);
+                hsize_t max_capacity = H5S_UNLIMITED;
+
+                herr_t ret = H5Sset_extent_simple(_imp->space_id_file, 1, &new_capacity, &max_capacity);
+                if (0 > ret)
+                    throw HDF5Error("H5Sset_extent_simple failed and returned " + stringify(ret));
+
+                ret = H5Dset_extent(_imp->data_set_id, &new_capacity);
+                if (0 > ret)
+                    throw HDF5Error("H5Dset_extent failed and returned " + stringify(ret));
+
+                _imp->capacity = new_capacity;
+            }
+
+            hid_t space_id_memory = H5Screate_simple(1, &count, nullptr);
+            if (H5I_INVALID_HID == space_id_memory)
+                throw HDF5Error("H5Screate_simple failed and returned " + stringify(space_id_memory));
+
+            select(start, count);
+
+            herr_t ret = H5Dwrite(_imp->data_set_id, _imp->type_id, space_id_memory, _imp->space_id_file, H5P_DEFAULT, buffer);
+            H5Sclose(space_id_memory);
+
+            if (0 > ret)
+                throw HDF5Error("H5Dwrite failed and returned " + stringify(ret));
+
+            _imp->size = std::max(_imp->size, start + count);
+        }
+
+        void
+        DataSetHandle::read_many(hsize_t start, hsize_t count, void * buffer, hsize_t stride)
+        {
+            if (0 == count)
+                return;
+
+            if (start + count > _imp->size)
+                throw HDF5Error("Cannot read records [" + stringify(start) + ", " + stringify(start + count) + ") from a data set with "
+                        + stringify(_imp->size) + " records");
+
+            if (0 == stride)
+                throw HDF5Error("Cannot read records with a stride of zero");
+
+            // describe the (possibly strided) destination in memory
+            hsize_t extent = (count - 1) * stride + 1;
+            hid_t space_id_memory = H5Screate_simple(1, &extent, nullptr);
+            if (H5I_INVALID_HID == space_id_memory)
+                throw HDF5Error("H5Screate_simple failed and returned " + stringify(space_id_memory));
+
+            hsize_t memory_start = 0, block = 1;
+            H5Sselect_hyperslab(space_id_memory, H5S_SELECT_SET, &memory_start, &stride, &count, &block);
+
+            select(start, count);
+
+            herr_t ret = H5Dread(_imp->data_set_id, _imp->type_id, space_id_memory, _imp->space_id_file, H5P_DEFAULT, buffer);
+            H5Sclose(space_id_memory);
+
+            if (0 > ret)
+                throw HDF5Error("H5Dread failed and returned " + stringify(ret));
+        }
+
+        bool
+        DataSetHandle::mappable() const
+        {
+            // the data must be stored in a single block, without compression or other filters
+            hid_t dcpl_id = H5Dget_create_plist(_imp->data_set_id);
+            if (H5I_INVALID_HID == dcpl_id)
+                return false;
+
+            bool result = (H5D_CONTIGUOUS == H5Pget_layout(dcpl_id)) && (0 == H5Pget_nfilters(dcpl_id)) && (0 == H5Pget_external_count(dcpl_id));
+            H5Pclose(dcpl_id);
+
+            if (! result)
+                return false;
+
+            // the data must already be allocated within the file
+            if (HADDR_UNDEF == H5Dget_offset(_imp->data_set_id))
+                return false;
+
+            // the file must be a single plain file
+            hid_t fapl_id = H5Fget_access_plist(_imp->file_handle.id());
+            result = (H5FD_SEC2 == H5Pget_driver(fapl_id));
+            H5Pclose(fapl_id);
+
+            return result;
+        }
+
+        MappedRegion
+        DataSetHandle::map(hsize_t start, hsize_t count) const
+        {
+            if (! mappable())
+                throw HDF5Error("Cannot map a data set that is not stored contiguously and unfiltered");
+
+            if (start + count > _imp->size)
+                throw HDF5Error("Cannot map records [" + stringify(start) + ", " + stringify(start + count) + ") of a data set with "
+                        + stringify(_imp->size) + " records");
+
+            const hid_t file_id = _imp->file_handle.id();
+
+            // pending writes must reach the file before it is mapped
+            if (! _imp->file_handle.read_only())
+                H5Fflush(file_id, H5F_SCOPE_LOCAL);
+
+            // addresses within an HDF5 file are relative to the end of the user block
+            hsize_t user_block_size = 0;
+            hid_t fcpl_id = H5Fget_create_plist(file_id);
+            H5Pget_userblock(fcpl_id, &user_block_size);
+            H5Pclose(fcpl_id);
+
+            ssize_t length = H5Fget_name(file_id, nullptr, 0);
+            if (0 > length)
+                throw HDF5Error("H5Fget_name failed and returned " + stringify(length));
+
+            std::vector<char> filename(length + 1, '\0');
+            H5Fget_name(file_id, filename.data(), filename.size());
+
+            const hsize_t record_size = H5Tget_size(_imp->type_id);
+
+            return MappedRegion(std::string(filename.data()), user_block_size + H5Dget_offset(_imp->data_set_id) + start * record_size, count * record_size);
+        }
+
         AttributeHandle
         DataSetHandle::create_attribute(const std::string & name, const hid_t & type_id)
         {
@@ -322,6 +509,27 @@ namespace eos
             return AttributeHandle(*this, attr_id);
         }
 
+        MappedRegion::MappedRegion(const std::string & filename, const haddr_t & offset, const hsize_t & size) :
+            PrivateImplementationPattern<hdf5::MappedRegion>(new Implementation<hdf5::MappedRegion>(filename, offset, size))
+        {
+        }
+
+        MappedRegion::~MappedRegion()
+        {
+        }
+
+        const void *
+        MappedRegion::data() const
+        {
+            return _imp->data;
+        }
+
+        hsize_t
+        MappedRegion::size() const
+        {
+            return _imp->size;
+        }
+
         AttributeHandle::AttributeHandle(const DataSetHandle & data_set_handle, const hid_t & attribute_id) :
             PrivateImplementationPattern<hdf5::AttributeHandle>(new Implementation<hdf5::AttributeHandle>(data_set_handle, attribute_id))
         {
@@ -400,6 +608,8 @@ namespace eos
                 hid_t file_id = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
                 if (H5I_INVALID_HID == file_id)
                     return false;
+
+                H5Fclose(file_id);
             }
             H5E_END_TRY;
 
@@ -507,6 +717,8 @@ namespace eos
             hid_t group_id = H5Gopen2(_handle.id(), name.c_str(), H5P_DEFAULT);
             if (H5I_INVALID_HID == group_id)
                 return false;
+
+            H5Gclose(group_id);
             }
             H5E_END_TRY;
 
@@ -524,5 +736,56 @@ namespace eos
 
             return info.nlinks;
         }
+
+        void
+        File::truncate(const std::string & name, const unsigned & records)
+        {
+            hid_t object_id = H5Oopen(_handle.id(), name.c_str(), H5P_DEFAULT);
+            if (H5I_INVALID_HID == object_id)
+                throw HDF5Error("H5Oopen failed to open '" + name + "' and returned " + stringify(object_id));
+
+            H5I_type_t type = H5Iget_type(object_id);
+            H5Oclose(object_id);
+
+            if (H5I_GROUP == type)
+            {
+                for (unsigned i = 0, i_end = number_of_objects(name) ; i < i_end ; ++i)
+                {
+                    ssize_t length = H5Lget_name_by_idx(_handle.id(), name.c_str(), H5_INDEX_NAME, H5_ITER_INC, i, nullptr, 0, H5P_DEFAULT);
+                    if (0 > length)
+                        throw HDF5Error("H5Lget_name_by_idx failed for '" + name + "' and returned " + stringify(length));
+
+                    std::vector<char> child(length + 1, '\0');
+                    H5Lget_name_by_idx(_handle.id(), name.c_str(), H5_INDEX_NAME, H5_ITER_INC, i, child.data(), child.size(), H5P_DEFAULT);
+
+                    truncate(name + "/" + child.data(), records);
+                }
+
+                return;
+            }
+
+            if (H5I_DATASET != type)
+                return;
+
+            hid_t set_id = H5Dopen2(_handle.id(), name.c_str(), H5P_DEFAULT);
+            if (H5I_INVALID_HID == set_id)
+                throw HDF5Error("H5Dopen2 failed to open '" + name + "' and returned " + stringify(set_id));
+
+            hid_t space_id = H5Dget_space(set_id);
+            hsize_t size = 0;
+            H5Sget_simple_extent_dims(space_id, &size, nullptr);
+            H5Sclose(space_id);
+
+            herr_t ret = 0;
+            if (size > records)
+            {
+                hsize_t dimension = records;
+                ret = H5Dset_extent(set_id, &dimension);
+            }
+            H5Dclose(set_id);
+
+            if (0 > ret)
+                throw HDF5Error("H5Dset_extent failed for '" + name + "' and returned " + stringify(ret));
+        }
     }
 }
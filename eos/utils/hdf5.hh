@@ -24,10 +24,14 @@
 #include <eos/utils/exception.hh>
 #include <eos/utils/hdf5-fwd.hh>
 #include <eos/utils/private_implementation_pattern.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
 #include <eos/utils/wrapped_forward_iterator.hh>
 #include <hdf5.h>
 
+#include <algorithm>
 #include <cstring>
+#include <exception>
 #include <vector>
 
 namespace eos
@@ -65,6 +69,11 @@ namespace eos
             static hid_t type_id() { return H5T_STD_U32LE; }
         };
 
+        template <> struct DataType<unsigned long>
+        {
+            static hid_t type_id() { return H5T_STD_U64LE; }
+        };
+
         template <> struct DataType<int>
         {
             static hid_t type_id() { return H5T_STD_I32LE; }
@@ -212,7 +221,7 @@ namespace eos
                 virtual void copy_from_hdf5(const void * src, void * dest) const
                 {
                     std::vector<T_> * _dest = reinterpret_cast<std::vector<T_> *>(dest);
-                    _dest->reserve(_elements);
+                    _dest->resize(_elements);
 
                     ::memcpy(&(*_dest)[0], src, _elements * sizeof(T_));
                 }
@@ -384,6 +393,36 @@ namespace eos
 
                 void read_one(void * buffer);
 
+                /*!
+                 * Write a range of records with a single call to the HDF5 library. The data set is extended as needed.
+                 *
+                 * @param start  Index of the first record.
+                 * @param count  Number of records.
+                 * @param buffer Source of the records in their in-file representation.
+                 */
+                void write_many(hsize_t start, hsize_t count, const void * buffer);
+
+                /*!
+                 * Read a range of records with a single call to the HDF5 library.
+                 *
+                 * @param start  Index of the first record.
+                 * @param count  Number of records.
+                 * @param buffer Destination for the records in their in-file representation.
+                 * @param stride Distance between the beginnings of two consecutive records in the destination, in units of records.
+                 */
+                void read_many(hsize_t start, hsize_t count, void * buffer, hsize_t stride = 1);
+
+                /// Return whether the data set is stored contiguously and unfiltered in a plain file, and can therefore be memory-mapped.
+                bool mappable() const;
+
+                /*!
+                 * Map a range of records into memory without copying them.
+                 *
+                 * @param start Index of the first record.
+                 * @param count Number of records.
+                 */
+                MappedRegion map(hsize_t start, hsize_t count) const;
+
                 AttributeHandle create_attribute(const std::string & name, const hid_t & type_id);
 
                 AttributeHandle open_attribute(const std::string & name, const hid_t & type_id);
@@ -409,6 +448,29 @@ namespace eos
                 void read(void * buffer) const;
         };
 
+        /*!
+         * MappedRegion represents a read-only, memory-mapped range of records within a
+         * contiguous and unfiltered data set. The records are not copied, and are presented
+         * in their in-file representation.
+         */
+        class MappedRegion :
+            public PrivateImplementationPattern<MappedRegion>
+        {
+            private:
+                MappedRegion(const std::string & filename, const haddr_t & offset, const hsize_t & size);
+
+            public:
+                friend class DataSetHandle;
+
+                ~MappedRegion();
+
+                /// Pointer to the first mapped record.
+                const void * data() const;
+
+                /// Size of the mapped range in bytes.
+                hsize_t size() const;
+        };
+
         class File
         {
             private:
@@ -534,6 +596,18 @@ namespace eos
 
                 /// List how many objects, i.e. groups or data sets, are in a subdirectory.
                 unsigned number_of_objects(const std::string & name);
+
+                /*!
+                 * Discard all records past the given number, e.g. those appended after a checkpoint was written.
+                 * If name refers to a group, all data sets below it are truncated. Data sets with fewer records
+                 * remain unchanged.
+                 *
+                 * @note No DataSet<> of any affected data set may be open at the same time.
+                 *
+                 * @param name    Absolute name of the data set or group.
+                 * @param records The number of records that shall be kept.
+                 */
+                void truncate(const std::string & name, const unsigned & records);
                 ///@}
         };
 
@@ -582,6 +656,7 @@ namespace eos
 
             public:
                 friend class hdf5::File;
+                friend class hdf5::PrefetchingReader<T_>;
                 friend DataSet<T_> & operator<< <> (DataSet<T_> &, const typename T_::Type &);
                 friend DataSet<T_> & operator>> <> (DataSet<T_> &, typename T_::Type &);
 
@@ -604,6 +679,18 @@ namespace eos
                     return _handle.size();
                 }
 
+                /// Size of one record in its in-file representation, in bytes
+                hsize_t record_size() const
+                {
+                    return _type->size();
+                }
+
+                /// Return whether the records can be accessed via map(), i.e., whether they are stored contiguously and unfiltered.
+                bool mappable() const
+                {
+                    return _handle.mappable();
+                }
+
                 ///@name Data Access
                 ///@{
 
@@ -625,6 +712,73 @@ namespace eos
                     _index = index;
                 }
 
+                /*!
+                 * Read a range of records with a single call to the HDF5 library.
+                 *
+                 * @param start  Index of the first record.
+                 * @param count  Number of records.
+                 * @param result Output iterator to which the records are written, e.g. a pointer into a caller-provided buffer.
+                 *
+                 * @note The current index used by operator>> is not affected.
+                 */
+                template <typename OutputIterator_> OutputIterator_ read(const unsigned & start, const unsigned & count, OutputIterator_ result)
+                {
+                    const hsize_t size = _type->size();
+                    std::vector<char> buffer(count * size);
+                    _handle.read_many(start, count, buffer.data());
+
+                    RecordType record;
+                    for (unsigned i = 0 ; i < count ; ++i, ++result)
+                    {
+                        _type->copy_from_hdf5(&buffer[i * size], &record);
+                        *result = record;
+                    }
+
+                    return result;
+                }
+
+                /*!
+                 * Read a range of records in their in-file representation with a single call to the HDF5 library,
+                 * e.g., into a caller-provided array of doubles for a data set of Array<1, double>.
+                 *
+                 * @param start  Index of the first record.
+                 * @param count  Number of records.
+                 * @param buffer Destination with room for at least ((count - 1) * stride + 1) records.
+                 * @param stride Distance between the beginnings of two consecutive records in the destination, in units of records.
+                 */
+                void read_raw(const unsigned & start, const unsigned & count, void * buffer, const unsigned & stride = 1)
+                {
+                    _handle.read_many(start, count, buffer, stride);
+                }
+
+                /*!
+                 * Write a range of records in their in-file representation with a single call to the HDF5 library.
+                 * Records beyond the current end of the data set are allowed, such that several writers can fill
+                 * disjoint ranges in any order.
+                 *
+                 * @param start  Index of the first record.
+                 * @param count  Number of records.
+                 * @param buffer Source of the records.
+                 */
+                void write_raw(const unsigned & start, const unsigned & count, const void * buffer)
+                {
+                    _handle.write_many(start, count, buffer);
+                }
+
+                /*!
+                 * Map a range of records into memory without copying them. The records are presented
+                 * in their in-file representation, as for read_raw().
+                 *
+                 * @param start  Index of the first record.
+                 * @param count  Number of records.
+                 *
+                 * @note Only available if mappable() returns true.
+                 */
+                MappedRegion map(const unsigned & start, const unsigned & count) const
+                {
+                    return _handle.map(start, count);
+                }
+
                 ///@}
 
                 ///@name Attribute Access
@@ -695,6 +849,174 @@ namespace eos
             return lhs;
         }
 
+        /*!
+         * PrefetchingReader<> streams a range of records from a DataSet<> in blocks. While the caller
+         * consumes one block, the next block is read in the background using the ThreadPool.
+         *
+         * @note The HDF5 library is not necessarily thread safe. Neither the data set nor any other HDF5 object
+         * must be accessed by the caller while a PrefetchingReader<> is in use. PrefetchingReader<> must not be
+         * used from within a job of the ThreadPool.
+         */
+        template <typename T_> class PrefetchingReader
+        {
+            public:
+                typedef typename T_::Type RecordType;
+
+            private:
+                DataSet<T_> & _data_set;
+
+                hsize_t _record_size;
+
+                unsigned _block_size;
+
+                // index of the first record of the next block to be fetched, and index past the last record
+                unsigned _next, _end;
+
+                std::vector<char> _current, _prefetched;
+
+                unsigned _current_records, _prefetched_records, _position;
+
+                Ticket _ticket;
+
+                bool _pending;
+
+                std::exception_ptr _error;
+
+                void _prefetch()
+                {
+                    const unsigned start = _next, count = std::min(_block_size, _end - _next);
+                    if (0 == count)
+                        return;
+
+                    _next += count;
+                    _prefetched_records = count;
+                    _pending = true;
+                    _ticket = ThreadPool::instance()->enqueue([this, start, count] ()
+                    {
+                        try
+                        {
+                            _data_set._handle.read_many(start, count, _prefetched.data());
+                        }
+                        catch (...)
+                        {
+                            _error = std::current_exception();
+                        }
+                    });
+                }
+
+                bool _advance()
+                {
+                    if (! _pending)
+                        return false;
+
+                    _ticket.wait();
+                    _pending = false;
+
+                    if (_error)
+                        std::rethrow_exception(_error);
+
+                    std::swap(_current, _prefetched);
+                    _current_records = _prefetched_records;
+                    _position = 0;
+
+                    _prefetch();
+
+                    return true;
+                }
+
+            public:
+                ///@name Basic Functions
+                ///@{
+                /*!
+                 * Constructor.
+                 *
+                 * @param data_set   The data set from which shall be read.
+                 * @param start      Index of the first record.
+                 * @param end        Index past the last record.
+                 * @param block_size Number of records that are read at once.
+                 */
+                PrefetchingReader(DataSet<T_> & data_set, const unsigned & start, const unsigned & end, const unsigned & block_size = 4096) :
+                    _data_set(data_set),
+                    _record_size(data_set.record_size()),
+                    _block_size(block_size),
+                    _next(start),
+                    _end(end),
+                    _current(block_size * _record_size),
+                    _prefetched(block_size * _record_size),
+                    _current_records(0),
+                    _prefetched_records(0),
+                    _position(0),
+                    _pending(false)
+                {
+                    if ((start > end) || (end > data_set.records()))
+                        throw HDF5Error("PrefetchingReader: Invalid range of records [" + stringify(start) + ", " + stringify(end) + ")");
+
+                    if (0 == block_size)
+                        throw HDF5Error("PrefetchingReader: Block size must be positive");
+
+                    _prefetch();
+                }
+
+                /// Constructor for reading all records of a data set.
+                PrefetchingReader(DataSet<T_> & data_set, const unsigned & block_size = 4096) :
+                    PrefetchingReader(data_set, 0, data_set.records(), block_size)
+                {
+                }
+
+                /// Destructor.
+                ~PrefetchingReader()
+                {
+                    if (_pending)
+                        _ticket.wait();
+                }
+
+                PrefetchingReader(const PrefetchingReader &) = delete;
+
+                PrefetchingReader & operator= (const PrefetchingReader &) = delete;
+                ///@}
+
+                ///@name Data Access
+                ///@{
+                /*!
+                 * Retrieve the remaining records of the current block in their in-file representation.
+                 *
+                 * @param data Set to the first record. The records remain valid until the next call to next() or next_block().
+                 *
+                 * @return The number of records, or zero if all records have been retrieved.
+                 */
+                unsigned next_block(const void * & data)
+                {
+                    if ((_position == _current_records) && (! _advance()))
+                        return 0;
+
+                    data = &_current[_position * _record_size];
+
+                    const unsigned result = _current_records - _position;
+                    _position = _current_records;
+
+                    return result;
+                }
+
+                /*!
+                 * Retrieve the next record.
+                 *
+                 * @param record The record to which the data shall be copied.
+                 *
+                 * @return False if all records have been retrieved, true otherwise.
+                 */
+                bool next(RecordType & record)
+                {
+                    if ((_position == _current_records) && (! _advance()))
+                        return false;
+
+                    _data_set._type->copy_from_hdf5(&_current[_position * _record_size], &record);
+                    ++_position;
+
+                    return true;
+                }
+                ///@}
+        };
+
         template <typename T_> class Attribute
         {
             public:
@@ -22,6 +22,8 @@
 #include <test/test.hh>
 #include <eos/utils/hdf5.hh>
 
+#include <iterator>
+
 using namespace test;
 using namespace eos;
 
@@ -171,3 +173,235 @@ class HDF5AttributeTest:
         }
 } hdf5_attribute_test;
 
+
+class HDF5BulkReadTest:
+    public TestCase
+{
+    public:
+        HDF5BulkReadTest() :
+            TestCase("hdf5_bulk_read_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const std::string filename(EOS_BUILDDIR "/eos/utils/hdf5_TEST-bulk.hdf5");
+            std::remove(filename.c_str());
+
+            hdf5::Array<1, double> sample_type("samples", { 3 });
+
+            hdf5::Composite<hdf5::Scalar<double>, hdf5::Array<1, double>> record_type
+            {
+                "component",
+                hdf5::Scalar<double>("weight"),
+                hdf5::Array<1, double>("means", { 2 }),
+            };
+
+            static const unsigned records = 1000;
+
+            // Create a chunked data set, as done by all of EOS' own output
+            {
+                hdf5::File file = hdf5::File::Create(filename);
+                auto samples = file.create_data_set("/samples", sample_type);
+                auto components = file.create_data_set("/components", record_type);
+
+                for (unsigned i = 0 ; i < records ; ++i)
+                {
+                    samples << std::vector<double>{ double(i), -double(i), 0.5 * i };
+                    components << std::make_tuple(double(i), std::vector<double>{ 2.0 * i, 3.0 * i });
+                }
+            }
+
+            // Create a contiguous data set, as could be written by other programs
+            {
+                hid_t file_id = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+                hsize_t dimensions = records;
+                hid_t space_id = H5Screate_simple(1, &dimensions, nullptr);
+                hid_t set_id = H5Dcreate2(file_id, "/contiguous", sample_type.type_id(), space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+                std::vector<double> data(3 * records);
+                for (unsigned i = 0 ; i < records ; ++i)
+                {
+                    data[3 * i + 0] = i;
+                    data[3 * i + 1] = -double(i);
+                    data[3 * i + 2] = 0.5 * i;
+                }
+                H5Dwrite(set_id, sample_type.type_id(), H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+
+                H5Dclose(set_id);
+                H5Sclose(space_id);
+                H5Fclose(file_id);
+            }
+
+            // Write disjoint ranges of records out of order
+            {
+                hdf5::File file = hdf5::File::Open(filename, H5F_ACC_RDWR);
+                auto data_set = file.create_data_set("/ranges", sample_type);
+
+                std::vector<double> second(3 * 1500, 2.0), first(3 * 1500, 1.0);
+                data_set.write_raw(1500, 1500, second.data());
+                data_set.write_raw(0, 1500, first.data());
+
+                TEST_CHECK_EQUAL(data_set.records(), 3000);
+            }
+
+            hdf5::File file = hdf5::File::Open(filename, H5F_ACC_RDONLY);
+
+            {
+                auto data_set = file.open_data_set("/ranges", sample_type);
+                TEST_CHECK_EQUAL(data_set.records(), 3000);
+
+                std::vector<double> record;
+                data_set.set_index(1499);
+                data_set >> record;
+                TEST_CHECK_EQUAL(record[2], 1.0);
+                data_set >> record;
+                TEST_CHECK_EQUAL(record[0], 2.0);
+            }
+
+            // read records
+            {
+                auto components = file.open_data_set("/components", record_type);
+
+                std::vector<std::tuple<double, std::vector<double>>> result;
+                components.read(100, 50, std::back_inserter(result));
+
+                TEST_CHECK_EQUAL(result.size(), 50);
+                for (unsigned i = 0 ; i < 50 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(std::get<0>(result[i]),    100.0 + i);
+                    TEST_CHECK_EQUAL(std::get<1>(result[i]).size(), 2);
+                    TEST_CHECK_EQUAL(std::get<1>(result[i])[0], 2.0 * (100 + i));
+                    TEST_CHECK_EQUAL(std::get<1>(result[i])[1], 3.0 * (100 + i));
+                }
+
+                TEST_CHECK_THROWS(HDF5Error, components.read(990, 11, std::back_inserter(result)));
+            }
+
+            // read raw records into a contiguous and a strided buffer
+            {
+                auto samples = file.open_data_set("/samples", sample_type);
+                TEST_CHECK(! samples.mappable());
+
+                std::vector<double> contiguous(3 * records);
+                samples.read_raw(0, records, contiguous.data());
+                for (unsigned i = 0 ; i < records ; ++i)
+                {
+                    TEST_CHECK_EQUAL(contiguous[3 * i + 0], i);
+                    TEST_CHECK_EQUAL(contiguous[3 * i + 2], 0.5 * i);
+                }
+
+                std::vector<double> strided(3 * 2 * 10, -1.0);
+                samples.read_raw(500, 10, strided.data(), 2);
+                for (unsigned i = 0 ; i < 10 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(strided[6 * i + 0], 500.0 + i);
+                    TEST_CHECK_EQUAL(strided[6 * i + 1], -500.0 - i);
+                    TEST_CHECK_EQUAL(strided[6 * i + 3], -1.0);
+                }
+            }
+
+            // map records
+            {
+                auto contiguous = file.open_data_set("/contiguous", sample_type);
+                TEST_CHECK(contiguous.mappable());
+
+                auto region = contiguous.map(10, 20);
+                TEST_CHECK_EQUAL(region.size(), 20 * 3 * sizeof(double));
+
+                const double * data = static_cast<const double *>(region.data());
+                for (unsigned i = 0 ; i < 20 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(data[3 * i + 0], 10.0 + i);
+                    TEST_CHECK_EQUAL(data[3 * i + 1], -10.0 - i);
+                }
+
+                auto samples = file.open_data_set("/samples", sample_type);
+                TEST_CHECK_THROWS(HDF5Error, samples.map(0, 10));
+            }
+
+            // prefetch records
+            {
+                auto samples = file.open_data_set("/samples", sample_type);
+
+                {
+                    hdf5::PrefetchingReader<hdf5::Array<1, double>> reader(samples, 7, 907, 64);
+
+                    std::vector<double> record;
+                    unsigned i = 7;
+                    while (reader.next(record))
+                    {
+                        TEST_CHECK_EQUAL(record[0], i);
+                        TEST_CHECK_EQUAL(record[2], 0.5 * i);
+                        ++i;
+                    }
+                    TEST_CHECK_EQUAL(i, 907);
+                }
+
+                {
+                    hdf5::PrefetchingReader<hdf5::Array<1, double>> reader(samples, 100);
+
+                    unsigned total = 0, blocks = 0;
+                    const void * block;
+                    while (unsigned count = reader.next_block(block))
+                    {
+                        const double * data = static_cast<const double *>(block);
+                        TEST_CHECK_EQUAL(data[0], total);
+
+                        total += count;
+                        ++blocks;
+                    }
+                    TEST_CHECK_EQUAL(total, records);
+                    TEST_CHECK_EQUAL(blocks, 10);
+                }
+            }
+
+            // truncate single data sets and entire groups
+            {
+                static const std::string filename_truncate(EOS_BUILDDIR "/eos/utils/hdf5_TEST-truncate.hdf5");
+                hdf5::File file = hdf5::File::Create(filename_truncate);
+
+                {
+                    auto samples = file.create_data_set("/samples", sample_type);
+                    for (unsigned i = 0 ; i < records ; ++i)
+                    {
+                        samples << std::vector<double>{ double(i), -double(i), 0.5 * i };
+                    }
+
+                    auto first = file.create_data_set("/group/first", sample_type);
+                    auto second = file.create_data_set("/group/subgroup/second", sample_type);
+                    for (unsigned i = 0 ; i < 20 ; ++i)
+                    {
+                        first << std::vector<double>{ double(i), 0.0, 0.0 };
+                        second << std::vector<double>{ double(i), 0.0, 0.0 };
+                    }
+                }
+
+                file.truncate("/samples", 100);
+                TEST_CHECK_EQUAL(file.open_data_set("/samples", sample_type).records(), 100);
+
+                // nothing to discard
+                file.truncate("/samples", 200);
+                TEST_CHECK_EQUAL(file.open_data_set("/samples", sample_type).records(), 100);
+
+                file.truncate("/group", 5);
+                TEST_CHECK_EQUAL(file.open_data_set("/group/first", sample_type).records(), 5);
+                TEST_CHECK_EQUAL(file.open_data_set("/group/subgroup/second", sample_type).records(), 5);
+
+                // appending continues after the last kept record
+                {
+                    auto first = file.open_data_set("/group/first", sample_type);
+                    first << std::vector<double>{ 42.0, 0.0, 0.0 };
+                }
+
+                auto first = file.open_data_set("/group/first", sample_type);
+                std::vector<std::vector<double>> kept(2);
+                first.read(4, 2, kept.begin());
+                TEST_CHECK_EQUAL(first.records(), 6);
+                TEST_CHECK_EQUAL(kept[0][0], 4.0);
+                TEST_CHECK_EQUAL(kept[1][0], 42.0);
+
+                TEST_CHECK_THROWS(HDF5Error, file.truncate("/non-existing", 5));
+            }
+        }
+} hdf5_bulk_read_test;
@@ -44,6 +44,9 @@ namespace eos
         std::vector<std::string> variables_names;
 
         std::vector<KinematicVariable> variables;
+
+        // Changes whenever the value of any variable changes
+        unsigned long revision = 0;
     };
 
     Kinematics::Kinematics() :
@@ -155,11 +158,13 @@ namespace eos
             _imp->variables_data.push_back(value);
             _imp->variables_names.push_back(name);
             _imp->variables.push_back(KinematicVariable(_imp, index));
+            ++_imp->revision;
 
             return KinematicVariable(_imp, index);
         }
 
         _imp->variables_data[i->second] = value;
+        ++_imp->revision;
 
         return KinematicVariable(_imp, i->second);
     }
@@ -173,6 +178,13 @@ namespace eos
             throw UnknownKinematicVariableError(name);
 
         _imp->variables_data[i->second] = value;
+        ++_imp->revision;
+    }
+
+    const unsigned long &
+    Kinematics::revision() const
+    {
+        return _imp->revision;
     }
 
     Kinematics::KinematicVariableIterator
@@ -224,6 +236,7 @@ namespace eos
     KinematicVariable::operator= (const double & value)
     {
         _imp->variables_data[_index] = value;
+        ++_imp->revision;
 
         return *this;
     }
@@ -232,6 +245,7 @@ namespace eos
     KinematicVariable::set(const double & value)
     {
         _imp->variables_data[_index] = value;
+        ++_imp->revision;
     }
 
     const std::string &
@@ -111,6 +111,14 @@ namespace eos
              * @param name  The name of the KinematicVariable that shall be retrieved.
              */
             KinematicVariable operator[] (const std::string & variable) const;
+
+            /*!
+             * Retrieve the revision of the variables' values, which changes whenever any value changes.
+             *
+             * The reference remains valid as long as this object, any of its copies, or any of its
+             * KinematicVariable objects exist.
+             */
+            const unsigned long & revision() const;
             ///@}
 
             ///@name Iteration over our kinematic variables
@@ -57,6 +57,25 @@ class KinematicsTest :
                 TEST_CHECK_EQUAL(17.0, kinematics["foo"]);
             }
 
+            // Revisions
+            {
+                Kinematics kinematics{ { "foo", 1.0 } };
+                const unsigned long & revision = kinematics.revision();
+                const unsigned long initial = revision;
+
+                kinematics.set("foo", 2.0);
+                TEST_CHECK(initial != revision);
+
+                const unsigned long second = revision;
+                kinematics["foo"] = 3.0;
+                TEST_CHECK(second != revision);
+
+                // copies share the revision, clones do not
+                Kinematics copy = kinematics;
+                TEST_CHECK(&revision == &copy.revision());
+                TEST_CHECK(&revision != &kinematics.clone().revision());
+            }
+
             // Equality/Inequality
             {
                 Kinematics a, b;
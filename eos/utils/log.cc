@@ -28,6 +28,7 @@
 #include <eos/utils/mutex.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 
+#include <atomic>
 #include <iostream>
 #include <time.h>
 
@@ -118,9 +119,11 @@ namespace eos
 
     template <> struct Implementation<Log>
     {
+        // Guards the output stream and the program name
         Mutex mutex;
 
-        LogLevel log_level;
+        // Read without locking to filter messages
+        std::atomic<LogLevel> log_level;
 
         std::ostream * stream;
 
@@ -134,29 +137,32 @@ namespace eos
 
         void message(const std::string & id, const LogLevel & l, const std::string & m)
         {
-            if (l > log_level)
+            if (l > log_level.load(std::memory_order_relaxed))
                 return;
 
-            *stream << program_name << '@' << ::time(0) << ": ";
+            // Each thread formats its messages into its own buffer, and only
+            // holds the lock while the complete line is written out.
+            static thread_local std::string buffer;
+            buffer.clear();
 
             do
             {
                 switch (l)
                 {
                     case ll_debug:
-                        *stream << "[DEBUG " << id << "] ";
+                        buffer.append("[DEBUG ");
                         continue;
 
                     case ll_error:
-                        *stream << "[ERROR " << id << "] ";
+                        buffer.append("[ERROR ");
                         continue;
 
                     case ll_warning:
-                        *stream << "[WARNING " << id << "] ";
+                        buffer.append("[WARNING ");
                         continue;
 
                     case ll_informational:
-                        *stream << "[INFO " << id << "] ";
+                        buffer.append("[INFO ");
                         continue;
 
                     case ll_silent:
@@ -170,7 +176,16 @@ namespace eos
             }
             while (false);
 
-            *stream << m << std::endl;
+            buffer.append(id);
+            buffer.append("] ");
+            buffer.append(m);
+            buffer.append(1, '\n');
+
+            Lock ll(mutex);
+
+            *stream << program_name << '@' << ::time(0) << ": ";
+            stream->write(buffer.data(), buffer.size());
+            stream->flush();
         }
     };
 
@@ -185,20 +200,22 @@ namespace eos
     {
     }
 
-    const LogLevel &
+    LogLevel
     Log::get_log_level() const
     {
-        Lock l(_imp->mutex);
+        return _imp->log_level.load(std::memory_order_relaxed);
+    }
 
-        return _imp->log_level;
+    bool
+    Log::enabled(const LogLevel & log_level) const
+    {
+        return log_level <= _imp->log_level.load(std::memory_order_relaxed);
     }
 
     void
     Log::set_log_level(const LogLevel & log_level)
     {
-        Lock l(_imp->mutex);
-
-        _imp->log_level = log_level;
+        _imp->log_level.store(log_level, std::memory_order_relaxed);
     }
 
     void
@@ -220,8 +237,6 @@ namespace eos
     void
     Log::_message(const std::string & id, const LogLevel & l, const std::string & m)
     {
-        Lock ll(_imp->mutex);
-
         _imp->message(id, l, m);
     }
 
@@ -235,13 +250,15 @@ namespace eos
     LogMessageHandler::LogMessageHandler(Log * const log, const LogLevel & log_level, const std::string & id) :
         _log(log),
         _log_level(log_level),
-        _id(id)
+        _active(log->enabled(log_level))
     {
+        if (_active)
+            _id = id;
     }
 
     LogMessageHandler::~LogMessageHandler()
     {
-        if ((! std::uncaught_exception()) && (! _message.empty()))
+        if (_active && (! std::uncaught_exception()) && (! _message.empty()))
         {
             _log->_message(_id, _log_level, _message);
         }
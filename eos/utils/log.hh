@@ -85,7 +85,15 @@ namespace eos
             ///@{
 
             /// Get the current log level
-            const LogLevel & get_log_level() const;
+            LogLevel get_log_level() const;
+
+            /*!
+             * Return whether messages of a given log level will be emitted.
+             *
+             * This check does not lock, and is cheap enough to guard the construction
+             * of expensive messages.
+             */
+            bool enabled(const LogLevel &) const;
 
             /*!
              * Set the log level.
@@ -119,6 +127,7 @@ namespace eos
         private:
             Log * _log;
             LogLevel _log_level;
+            bool _active;
             std::string _id;
             std::string _message;
 
@@ -147,10 +156,13 @@ namespace eos
 
             /*!
              * Append to our message.
+             *
+             * Nothing is stringified if the message's log level is filtered.
              */
             template <typename T_> LogMessageHandler & operator<< (const T_ & t)
             {
-                _append(stringify(t));
+                if (_active)
+                    _append(stringify(t));
 
                 return *this;
             }
@@ -21,6 +21,8 @@
 #include <eos/utils/exception.hh>
 #include <eos/utils/log.hh>
 
+#include <sstream>
+
 using namespace test;
 using namespace eos;
 
@@ -107,3 +109,55 @@ class LogLevelTest :
             }
         }
 } log_level_test;
+
+namespace
+{
+    struct CountingStringification
+    {
+        static unsigned count;
+    };
+
+    unsigned CountingStringification::count = 0;
+
+    std::ostream & operator<< (std::ostream & lhs, const CountingStringification &)
+    {
+        ++CountingStringification::count;
+
+        return lhs << "counted";
+    }
+}
+
+class LogMessageTest :
+    public TestCase
+{
+    public:
+        LogMessageTest() :
+            TestCase("log_message_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            std::stringstream stream;
+            Log::instance()->set_log_stream(&stream);
+            Log::instance()->set_log_level(ll_warning);
+
+            TEST_CHECK(Log::instance()->enabled(ll_error));
+            TEST_CHECK(Log::instance()->enabled(ll_warning));
+            TEST_CHECK(! Log::instance()->enabled(ll_informational));
+            TEST_CHECK(! Log::instance()->enabled(ll_debug));
+
+            // filtered messages are not stringified
+            Log::instance()->message("log_test", ll_debug) << CountingStringification();
+            TEST_CHECK_EQUAL(0u, CountingStringification::count);
+            TEST_CHECK(stream.str().empty());
+
+            // emitted messages are
+            Log::instance()->message("log_test", ll_warning) << CountingStringification();
+            TEST_CHECK_EQUAL(1u, CountingStringification::count);
+            TEST_CHECK(std::string::npos != stream.str().find("[WARNING log_test] counted\n"));
+
+            Log::instance()->set_log_stream(&std::cerr);
+            Log::instance()->set_log_level(ll_error);
+        }
+} log_message_test;
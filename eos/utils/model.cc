@@ -50,6 +50,21 @@ namespace eos
         return i->second(parameters, options);
     }
 
+    LeptonFlavour
+    lepton_flavour_from_option(const std::string & value)
+    {
+        if ("e" == value)
+            return LeptonFlavour::electron;
+
+        if ("mu" == value)
+            return LeptonFlavour::muon;
+
+        if ("tau" == value)
+            return LeptonFlavour::tau;
+
+        throw InvalidOptionValueError("l", value, "e, mu, tau");
+    }
+
     NoSuchModelError::NoSuchModelError(const std::string & name) :
         Exception("No such model: '" + name + "'")
     {
@@ -47,6 +47,26 @@ namespace eos
         ///@}
     }
 
+    /*!
+     * Lepton flavours, as used to select the semileptonic Wilson coefficients.
+     *
+     * Observables resolve the lepton flavour once upon construction, so that
+     * the models do not need to compare strings when returning Wilson coefficients.
+     */
+    enum class LeptonFlavour
+    {
+        electron,
+        muon,
+        tau
+    };
+
+    /*!
+     * Resolve the lepton flavour from the value of the option 'l'.
+     *
+     * @param value One of 'e', 'mu', or 'tau'.
+     */
+    LeptonFlavour lepton_flavour_from_option(const std::string & value);
+
     /*!
      * Base classes for individual model components.
      */
@@ -100,7 +120,7 @@ namespace eos
     {
         public:
             /* b->s Wilson coefficients */
-            virtual WilsonCoefficients<BToS> wilson_coefficients_b_to_s(const double & mu, const std::string & lepton_flavour, const bool & cp_conjugate = false) const = 0;
+            virtual WilsonCoefficients<BToS> wilson_coefficients_b_to_s(const double & mu, const LeptonFlavour & lepton_flavour, const bool & cp_conjugate = false) const = 0;
     };
 
     /*!
@@ -110,7 +130,7 @@ namespace eos
     {
         public:
             /* b->u Wilson coefficients */
-            virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_u(const std::string & lepton_flavour, const bool & cp_conjugate = false) const = 0;
+            virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_u(const LeptonFlavour & lepton_flavour, const bool & cp_conjugate = false) const = 0;
     };
 
     /*!
@@ -120,7 +140,7 @@ namespace eos
     {
     public:
         /* b->c Wilson coefficients */
-        virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_c(const std::string & lepton_flavour, const bool & cp_conjugate = false) const = 0;
+        virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_c(const LeptonFlavour & lepton_flavour, const bool & cp_conjugate = false) const = 0;
     };
 
     /*!
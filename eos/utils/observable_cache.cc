@@ -20,16 +20,54 @@
 
 #include <eos/utils/observable_cache.hh>
 #include <eos/utils/observable_set.hh>
+#include <eos/utils/observable_term.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/thread_pool.hh>
+#include <eos/utils/trace.hh>
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <limits>
 #include <map>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace eos
 {
+    namespace impl
+    {
+        // The single term of an observable that does not expose its terms. It is only equivalent to itself.
+        class OpaqueObservableTerm :
+            public ObservableTerm
+        {
+            private:
+                ObservablePtr _observable;
+
+            public:
+                OpaqueObservableTerm(const ObservablePtr & observable) :
+                    _observable(observable)
+                {
+                }
+
+                virtual double evaluate() const
+                {
+                    return _observable->evaluate();
+                }
+
+                virtual std::size_t hash() const
+                {
+                    return std::hash<const Observable *>()(_observable.get());
+                }
+
+                virtual bool equivalent(const ObservableTerm & other) const
+                {
+                    return this == &other;
+                }
+        };
+    }
+
     template <> struct
     Implementation<ObservableCache>
     {
@@ -42,8 +80,46 @@ namespace eos
         // Store values of observables
         std::vector<double> predictions;
 
+        // Store timings of observables, if profiling is enabled
+        bool profiling;
+
+        std::vector<ObservableProfile> profiles;
+
+        // Evaluate the observables on the ThreadPool, if enabled
+        bool parallel;
+
+        /*
+         * The evaluation graph: each node is a term of at least one observable. Equivalent terms of
+         * several observables are merged into one node, which is evaluated only once per update and
+         * is accounted for in the profile of the first observable that uses it.
+         */
+        bool graph_valid;
+
+        std::vector<ObservableTermPtr> nodes;
+
+        std::vector<ObservableHandle> node_handles;
+
+        std::vector<ObservableCache::Id> node_owners;
+
+        std::vector<double> node_values;
+
+        std::vector<double> node_timings;
+
+        // For each observable: its composition (or nullptr if opaque) and the nodes of its terms
+        std::vector<const ComposedObservable *> compositions;
+
+        std::vector<std::vector<unsigned>> observable_nodes;
+
+        // Terms that have been merged into an existing node, and their handles to detect changes of their kinematics
+        std::vector<ObservableTermPtr> merged_terms;
+
+        std::vector<ObservableHandle> merged_handles;
+
         Implementation(const Parameters & parameters) :
-            parameters(parameters)
+            parameters(parameters),
+            profiling(false),
+            parallel(false),
+            graph_valid(false)
         {
         }
 
@@ -59,10 +135,161 @@ namespace eos
             if (result.second)
             {
                 predictions.push_back(std::numeric_limits<double>::quiet_NaN());
+                profiles.push_back(ObservableProfile{ 0, 0.0, 0.0 });
+                graph_valid = false;
             }
 
             return result.first;
         }
+
+        void build_graph()
+        {
+            nodes.clear();
+            node_handles.clear();
+            node_owners.clear();
+            compositions.clear();
+            observable_nodes.clear();
+            merged_terms.clear();
+            merged_handles.clear();
+
+            // nodes by hash value of their terms
+            std::unordered_multimap<std::size_t, unsigned> index;
+
+            for (ObservableCache::Id id = 0, size = observables.size() ; id < size ; ++id)
+            {
+                const ObservablePtr & observable = observables[id];
+                const ComposedObservable * composition = dynamic_cast<const ComposedObservable *>(observable.get());
+
+                std::vector<ObservableTermPtr> terms;
+                if (composition)
+                {
+                    terms = composition->terms();
+                }
+                else
+                {
+                    terms.push_back(ObservableTermPtr(new impl::OpaqueObservableTerm(observable)));
+                }
+
+                std::vector<unsigned> term_nodes;
+                for (const auto & term : terms)
+                {
+                    const std::size_t hash = term->hash();
+
+                    auto range = index.equal_range(hash);
+                    auto i = std::find_if(range.first, range.second, [&] (const std::pair<const std::size_t, unsigned> & n) { return nodes[n.second]->equivalent(*term); });
+
+                    if (range.second == i)
+                    {
+                        index.emplace(hash, nodes.size());
+                        term_nodes.push_back(nodes.size());
+                        nodes.push_back(term);
+                        node_handles.push_back(term->handle());
+                        node_owners.push_back(id);
+                    }
+                    else
+                    {
+                        term_nodes.push_back(i->second);
+                        merged_terms.push_back(term);
+                        merged_handles.push_back(term->handle());
+                    }
+                }
+
+                compositions.push_back(composition);
+                observable_nodes.push_back(term_nodes);
+            }
+
+            node_values.assign(nodes.size(), std::numeric_limits<double>::quiet_NaN());
+            node_timings.assign(nodes.size(), 0.0);
+            graph_valid = true;
+        }
+
+        // Any change of the kinematics since the graph has been built invalidates some of the handles.
+        bool graph_current() const
+        {
+            auto valid = [] (const ObservableHandle & h) { return h.valid(); };
+
+            return std::all_of(node_handles.cbegin(), node_handles.cend(), valid)
+                && std::all_of(merged_handles.cbegin(), merged_handles.cend(), valid);
+        }
+
+        void evaluate(const unsigned & n)
+        {
+            ScopedTimer timer("observable", observables[node_owners[n]]->name().full());
+
+            if (! profiling)
+            {
+                node_values[n] = node_handles[n].evaluate();
+
+                return;
+            }
+
+            auto begin = std::chrono::steady_clock::now();
+            node_values[n] = node_handles[n].evaluate();
+            auto end = std::chrono::steady_clock::now();
+
+            node_timings[n] = std::chrono::duration<double>(end - begin).count();
+        }
+
+        void update()
+        {
+            if (! graph_valid || ! graph_current())
+                build_graph();
+
+            // evaluate all nodes
+            if (parallel && (nodes.size() > 1))
+            {
+                ThreadPool::instance()->parallel_for(nodes.size(),
+                        std::bind(&Implementation<ObservableCache>::evaluate, this, std::placeholders::_1));
+            }
+            else
+            {
+                for (unsigned n = 0, size = nodes.size() ; n < size ; ++n)
+                {
+                    evaluate(n);
+                }
+            }
+
+            // compose the predictions from the values of the nodes
+            std::vector<double> values;
+            for (ObservableCache::Id id = 0, size = predictions.size() ; id < size ; ++id)
+            {
+                const std::vector<unsigned> & term_nodes = observable_nodes[id];
+
+                if (! compositions[id])
+                {
+                    predictions[id] = node_values[term_nodes.front()];
+
+                    continue;
+                }
+
+                values.clear();
+                for (const auto & n : term_nodes)
+                {
+                    values.push_back(node_values[n]);
+                }
+
+                predictions[id] = compositions[id]->compose(values);
+            }
+
+            if (! profiling)
+                return;
+
+            for (auto & profile : profiles)
+            {
+                profile.last = 0.0;
+                ++profile.calls;
+            }
+
+            for (unsigned n = 0, size = nodes.size() ; n < size ; ++n)
+            {
+                profiles[node_owners[n]].last += node_timings[n];
+            }
+
+            for (auto & profile : profiles)
+            {
+                profile.total += profile.last;
+            }
+        }
     };
 
     ObservableCache::ObservableCache(const Parameters & parameters) :
@@ -80,16 +307,56 @@ namespace eos
         return _imp->add(observable);
     }
 
+    void
+    ObservableCache::replace(const ObservableCache::Id & id, const ObservablePtr & observable)
+    {
+        if (observable->parameters() != _imp->parameters)
+            throw InternalError("ObservableCache::replace(): Mismatch of Parameters between cache and replacement observable detected.");
+
+        _imp->observables[id] = observable;
+        _imp->graph_valid = false;
+    }
+
     void
     ObservableCache::update()
     {
-        // evaluate all observables
-        auto p = _imp->predictions.begin();
+        _imp->update();
+    }
 
-        for (auto o = _imp->observables.begin(), o_end = _imp->observables.end() ; o != o_end ; ++o, ++p)
-        {
-            *p = (*o)->evaluate();
-        }
+    void
+    ObservableCache::enable_parallel_update(const bool & enabled)
+    {
+        _imp->parallel = enabled;
+    }
+
+    bool
+    ObservableCache::parallel_update() const
+    {
+        return _imp->parallel;
+    }
+
+    void
+    ObservableCache::enable_profiling(const bool & enabled)
+    {
+        _imp->profiling = enabled;
+    }
+
+    bool
+    ObservableCache::profiling() const
+    {
+        return _imp->profiling;
+    }
+
+    const ObservableProfile &
+    ObservableCache::profile(const ObservableCache::Id & id) const
+    {
+        return _imp->profiles[id];
+    }
+
+    void
+    ObservableCache::reset_profile()
+    {
+        std::fill(_imp->profiles.begin(), _imp->profiles.end(), ObservableProfile{ 0, 0.0, 0.0 });
     }
 
     Parameters
@@ -132,6 +399,8 @@ namespace eos
     ObservableCache::clone(const Parameters & parameters) const
     {
         ObservableCache result(parameters);
+        result._imp->profiling = _imp->profiling;
+        result._imp->parallel = _imp->parallel;
 
         for (auto o = _imp->observables.begin(), o_end = _imp->observables.end() ; o != o_end ; ++o)
         {
@@ -139,6 +408,7 @@ namespace eos
         }
 
         result.update();
+        result.reset_profile();
 
         return result;
     }
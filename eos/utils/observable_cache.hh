@@ -28,6 +28,21 @@
 
 namespace eos
 {
+    /*!
+     * Timings for the evaluations of a single observable within an ObservableCache.
+     */
+    struct ObservableProfile
+    {
+        /// Number of evaluations.
+        unsigned long calls;
+
+        /// Cumulative wall time of all evaluations in seconds.
+        double total;
+
+        /// Wall time of the last evaluation in seconds.
+        double last;
+    };
+
     class ObservableCache :
         public PrivateImplementationPattern<ObservableCache>
     {
@@ -56,9 +71,64 @@ namespace eos
              */
             Id add(const ObservablePtr & observable);
 
-            /// Update the predictions for all observables.
+            /*!
+             * Replace the observable associated with a given Id, e.g. by a surrogate of
+             * itself. The Id remains valid.
+             *
+             * @param id         The ObservableCache::Id whose associated observable shall be replaced.
+             * @param observable The replacement observable, which must use the cache's Parameters object.
+             */
+            void replace(const ObservableCache::Id & id, const ObservablePtr & observable);
+
+            /*!
+             * Update the predictions for all observables.
+             *
+             * Observables that are composed of terms (see ComposedObservable) share equivalent
+             * terms with each other, e.g. the same decay width in a branching ratio and in the
+             * denominator of a ratio of branching ratios. Each such term is evaluated only once.
+             * The terms are evaluated through ObservableHandle objects, whose kinematics are only
+             * resolved anew after a change of any kinematic variable.
+             *
+             * Exceptions thrown by the observables propagate to the caller, also for parallel updates.
+             * The predictions are undefined in that case until the next successful update.
+             */
             void update();
 
+            /*!
+             * Enable or disable the evaluation of the observables' terms in parallel on the ThreadPool
+             * within update(). Parallel updates are disabled by default.
+             *
+             * @param enabled Whether update() shall evaluate the observables in parallel.
+             *
+             * @note The observables must not modify any parameters while being evaluated.
+             */
+            void enable_parallel_update(const bool & enabled = true);
+
+            /// Return whether update() evaluates the observables in parallel.
+            bool parallel_update() const;
+
+            /*!
+             * Enable or disable profiling of the observables' evaluations in update().
+             * Profiling is disabled by default.
+             *
+             * @param enabled Whether update() shall record the timings of each observable.
+             */
+            void enable_profiling(const bool & enabled = true);
+
+            /// Return whether update() records the timings of each observable.
+            bool profiling() const;
+
+            /*!
+             * Retrieve the timings recorded for a given observable. The time spent on a term that is
+             * shared among several observables is accounted for by the first of these observables.
+             *
+             * @param id The unique ObservableCache::Id whose associated observable's timings shall be retrieved.
+             */
+            const ObservableProfile & profile(const ObservableCache::Id & id) const;
+
+            /// Discard all timings recorded so far.
+            void reset_profile();
+
             /// Retrieve the cache's common Parameters object.
             Parameters parameters() const;
 
@@ -84,7 +154,11 @@ namespace eos
             Iterator end() const;
             ///@}
 
-            /// Clone this cache whilst keeping the observables in the given order, i.e. all ids remain valid.
+            /*!
+             * Clone this cache whilst keeping the observables in the given order, i.e. all ids remain valid.
+             * Profiling and parallel updates remain enabled for the clone if enabled for this cache,
+             * albeit without any recorded timings.
+             */
             ObservableCache clone(const Parameters & parameters) const;
     };
 }
@@ -0,0 +1,290 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/observable.hh>
+#include <eos/utils/observable_cache.hh>
+#include <eos/utils/observable_stub.hh>
+#include <eos/utils/observable_term.hh>
+
+#include <string>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+// An observable whose evaluation fails for negative values of its parameter
+class ThrowingObservableStub :
+    public ObservableStub
+{
+    public:
+        ThrowingObservableStub(const Parameters & parameters, const QualifiedName & name) :
+            ObservableStub(parameters, name)
+        {
+        }
+
+        virtual double evaluate() const
+        {
+            const double result = ObservableStub::evaluate();
+
+            if (result < 0.0)
+                throw InternalError("ThrowingObservableStub: negative value");
+
+            return result;
+        }
+};
+
+class ObservableCacheTest :
+    public TestCase
+{
+    public:
+        ObservableCacheTest() :
+            TestCase("observable_cache_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // predictions
+            {
+                Parameters p = Parameters::Defaults();
+                ObservableCache cache(p);
+
+                auto id_b = cache.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)")));
+                auto id_c = cache.add(ObservablePtr(new ObservableStub(p, "mass::c")));
+                TEST_CHECK_EQUAL(id_b, cache.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)"))));
+                TEST_CHECK_EQUAL(2, cache.size());
+
+                p["mass::b(MSbar)"] = 4.5;
+                p["mass::c"] = 1.5;
+                cache.update();
+
+                TEST_CHECK_EQUAL(4.5, cache[id_b]);
+                TEST_CHECK_EQUAL(1.5, cache[id_c]);
+            }
+
+            // profiling
+            {
+                Parameters p = Parameters::Defaults();
+                ObservableCache cache(p);
+
+                auto id_b = cache.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)")));
+                auto id_c = cache.add(ObservablePtr(new ObservableStub(p, "mass::c")));
+
+                // disabled by default
+                TEST_CHECK(! cache.profiling());
+                cache.update();
+                TEST_CHECK_EQUAL(0, cache.profile(id_b).calls);
+                TEST_CHECK_EQUAL(0.0, cache.profile(id_b).total);
+
+                cache.enable_profiling();
+                TEST_CHECK(cache.profiling());
+                cache.update();
+                cache.update();
+                cache.update();
+
+                TEST_CHECK_EQUAL(3, cache.profile(id_b).calls);
+                TEST_CHECK_EQUAL(3, cache.profile(id_c).calls);
+                TEST_CHECK(cache.profile(id_b).total >= cache.profile(id_b).last);
+                TEST_CHECK(cache.profile(id_b).last >= 0.0);
+
+                // observables added later start from scratch
+                auto id_s = cache.add(ObservablePtr(new ObservableStub(p, "mass::s(2GeV)")));
+                cache.update();
+                TEST_CHECK_EQUAL(4, cache.profile(id_b).calls);
+                TEST_CHECK_EQUAL(1, cache.profile(id_s).calls);
+
+                // clones inherit the setting, but not the timings
+                ObservableCache clone = cache.clone(p.clone());
+                TEST_CHECK(clone.profiling());
+                TEST_CHECK_EQUAL(0, clone.profile(id_b).calls);
+
+                cache.reset_profile();
+                TEST_CHECK_EQUAL(0, cache.profile(id_b).calls);
+                TEST_CHECK_EQUAL(0.0, cache.profile(id_b).total);
+                TEST_CHECK_EQUAL(0.0, cache.profile(id_b).last);
+
+                cache.enable_profiling(false);
+                cache.update();
+                TEST_CHECK_EQUAL(0, cache.profile(id_b).calls);
+            }
+
+            // parallel updates
+            {
+                Parameters p = Parameters::Defaults();
+                ObservableCache cache(p);
+
+                std::vector<std::string> names
+                {
+                    "mass::b(MSbar)", "mass::c", "mass::s(2GeV)", "mass::t(pole)",
+                    "mass::B_d", "mass::B_u", "mass::K_d", "mass::K_u"
+                };
+                std::vector<ObservableCache::Id> ids;
+                for (const auto & n : names)
+                {
+                    ids.push_back(cache.add(ObservablePtr(new ObservableStub(p, n))));
+                }
+
+                TEST_CHECK(! cache.parallel_update());
+                cache.enable_parallel_update();
+                cache.enable_profiling();
+                TEST_CHECK(cache.parallel_update());
+
+                // clones inherit the setting
+                TEST_CHECK(cache.clone(p.clone()).parallel_update());
+
+                for (unsigned i = 0 ; i < 10 ; ++i)
+                {
+                    for (unsigned j = 0 ; j < names.size() ; ++j)
+                    {
+                        p[names[j]] = 1.0 + i + 0.1 * j;
+                    }
+
+                    cache.update();
+
+                    for (unsigned j = 0 ; j < names.size() ; ++j)
+                    {
+                        TEST_CHECK_EQUAL(1.0 + i + 0.1 * j, cache[ids[j]]);
+                    }
+                }
+
+                for (const auto & id : ids)
+                {
+                    TEST_CHECK_EQUAL(10, cache.profile(id).calls);
+                }
+            }
+
+            // exceptions during updates propagate to the caller
+            {
+                Parameters p = Parameters::Defaults();
+                ObservableCache cache(p);
+
+                std::vector<ObservableCache::Id> ids;
+                for (const auto & n : { "mass::b(MSbar)", "mass::c", "mass::s(2GeV)", "mass::t(pole)" })
+                {
+                    ids.push_back(cache.add(ObservablePtr(new ThrowingObservableStub(p, n))));
+                }
+
+                for (const bool parallel : { false, true })
+                {
+                    cache.enable_parallel_update(parallel);
+
+                    p["mass::c"] = -1.0;
+                    TEST_CHECK_THROWS(InternalError, cache.update());
+
+                    // the cache remains usable
+                    p["mass::c"] = 1.5;
+                    cache.update();
+                    TEST_CHECK_EQUAL(1.5, cache[ids[1]]);
+                }
+            }
+
+            // terms shared among observables
+            {
+                Parameters p = Parameters::Defaults();
+                Kinematics k{ { "q2", 5.0 } };
+                Kinematics k_mu{ { "q2", 5.0 } };
+                Options o{ { "model", "SM" } };
+
+                auto ratio  = Observable::make("B->Dlnu::R_D(q2)", p, k,    o);
+                auto br_tau = Observable::make("B->Dlnu::dBR/dq2", p, k,    o + Options{ { "l", "tau" } });
+                auto br_mu  = Observable::make("B->Dlnu::dBR/dq2", p, k_mu, o + Options{ { "l", "mu" } });
+
+                ObservableCache cache(p);
+                auto id_ratio  = cache.add(ratio);
+                auto id_br_tau = cache.add(br_tau);
+                auto id_br_mu  = cache.add(br_mu);
+                cache.enable_profiling();
+
+                cache.update();
+                TEST_CHECK_EQUAL(cache[id_ratio], cache[id_br_tau] / cache[id_br_mu]);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_ratio],  ratio->evaluate(),  1e-14);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_br_tau], br_tau->evaluate(), 1e-14);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_br_mu],  br_mu->evaluate(),  1e-14);
+
+                // both branching ratios are taken from the ratio's terms
+                TEST_CHECK_EQUAL(1,   cache.profile(id_br_tau).calls);
+                TEST_CHECK_EQUAL(0.0, cache.profile(id_br_tau).last);
+                TEST_CHECK_EQUAL(0.0, cache.profile(id_br_mu).last);
+
+                // shared terms follow changes of the parameters
+                p["CKM::abs(V_cb)"] = 0.9 * p["CKM::abs(V_cb)"];
+                cache.update();
+                TEST_CHECK_RELATIVE_ERROR(cache[id_br_tau], br_tau->evaluate(), 1e-14);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_br_mu],  br_mu->evaluate(),  1e-14);
+
+                // terms are no longer shared once their kinematics differ
+                k_mu.set("q2", 6.0);
+                cache.update();
+                TEST_CHECK_RELATIVE_ERROR(cache[id_ratio],  ratio->evaluate(),  1e-14);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_br_mu],  br_mu->evaluate(),  1e-14);
+                TEST_CHECK(cache[id_ratio] != cache[id_br_tau] / cache[id_br_mu]);
+                TEST_CHECK_EQUAL(0.0, cache.profile(id_br_tau).last);
+                TEST_CHECK(cache.profile(id_br_mu).last > 0.0);
+
+                // terms are shared again once their kinematics agree, regardless of which kinematics change
+                k.set("q2", 6.0);
+                cache.update();
+                TEST_CHECK_EQUAL(cache[id_ratio], cache[id_br_tau] / cache[id_br_mu]);
+                TEST_CHECK_EQUAL(0.0, cache.profile(id_br_mu).last);
+
+                k.set("q2", 7.0);
+                cache.update();
+                TEST_CHECK_RELATIVE_ERROR(cache[id_ratio],  ratio->evaluate(),  1e-14);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_br_tau], br_tau->evaluate(), 1e-14);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_br_mu],  br_mu->evaluate(),  1e-14);
+
+                // parallel updates yield the same predictions
+                const double serial = cache[id_br_mu];
+                cache.enable_parallel_update();
+                cache.update();
+                TEST_CHECK_EQUAL(serial, cache[id_br_mu]);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_ratio],  ratio->evaluate(),  1e-14);
+            }
+
+            // handles
+            {
+                Parameters p = Parameters::Defaults();
+                Kinematics k{ { "q2", 5.0 } };
+
+                auto observable = Observable::make("B->Dlnu::dBR/dq2", p, k, Options{ { "l", "mu" } });
+                auto terms = std::dynamic_pointer_cast<const ComposedObservable>(observable)->terms();
+                TEST_CHECK_EQUAL(1, terms.size());
+
+                ObservableHandle handle = terms.front()->handle();
+                TEST_CHECK(handle.valid());
+                TEST_CHECK_EQUAL(observable->evaluate(), handle.evaluate());
+
+                // the kinematics are bound when creating the handle
+                const double value = handle.evaluate();
+                k.set("q2", 6.0);
+                TEST_CHECK(! handle.valid());
+                TEST_CHECK_EQUAL(value, handle.evaluate());
+
+                handle = terms.front()->handle();
+                TEST_CHECK(handle.valid());
+                TEST_CHECK_EQUAL(observable->evaluate(), handle.evaluate());
+
+                // parameters are not bound
+                p["CKM::abs(V_cb)"] = 0.9 * p["CKM::abs(V_cb)"];
+                TEST_CHECK(handle.valid());
+                TEST_CHECK_EQUAL(observable->evaluate(), handle.evaluate());
+            }
+        }
+} observable_cache_test;
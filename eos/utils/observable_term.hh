@@ -0,0 +1,149 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_UTILS_OBSERVABLE_TERM_HH
+#define EOS_GUARD_SRC_UTILS_OBSERVABLE_TERM_HH 1
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace eos
+{
+    class ObservableTerm;
+
+    typedef std::shared_ptr<const ObservableTerm> ObservableTermPtr;
+
+    /*!
+     * ObservableHandle is a lightweight means to evaluate an ObservableTerm. The term's kinematic
+     * variables are resolved to plain numbers when the handle is created, and each evaluation
+     * dispatches through a single function pointer.
+     *
+     * A handle becomes invalid as soon as any kinematic variable of its term changes, and must then be
+     * recreated through ObservableTerm::handle(). It must not outlive the term from which it was created.
+     */
+    class ObservableHandle
+    {
+        public:
+            typedef double (* Function)(const void *);
+
+        private:
+            const void * _data;
+
+            Function _function;
+
+            const unsigned long * _revision;
+
+            unsigned long _bound_revision;
+
+        public:
+            /*!
+             * Constructor.
+             *
+             * @param data     The data to be passed to the function.
+             * @param function The function that evaluates the term.
+             * @param revision The revision of the kinematics that the data is bound to, or nullptr if the data does not depend on any kinematics.
+             */
+            ObservableHandle(const void * data, Function function, const unsigned long * revision) :
+                _data(data),
+                _function(function),
+                _revision(revision),
+                _bound_revision(revision ? *revision : 0)
+            {
+            }
+
+            /// Evaluate the term at the current parameter point.
+            inline double evaluate() const
+            {
+                return _function(_data);
+            }
+
+            /// Return whether the kinematics are unchanged since the creation of this handle.
+            inline bool valid() const
+            {
+                return (! _revision) || (*_revision == _bound_revision);
+            }
+    };
+
+    static_assert(std::is_trivially_copyable<ObservableHandle>::value, "ObservableHandle must be trivially copyable");
+
+    /*!
+     * ObservableTerm represents a single, self-contained evaluation from which an observable
+     * is composed, e.g. one call of a decay's member function at fixed kinematics.
+     *
+     * Equivalent terms yield identical values at any parameter point. ObservableCache
+     * evaluates each set of equivalent terms only once per update.
+     */
+    class ObservableTerm
+    {
+        public:
+            virtual ~ObservableTerm();
+
+            /// Evaluate the term at the current parameter point.
+            virtual double evaluate() const = 0;
+
+            /// Retrieve a hash value. Equivalent terms must yield identical hash values.
+            virtual std::size_t hash() const = 0;
+
+            /*!
+             * Return whether this term is equivalent to another term, given the current values
+             * of the kinematic variables.
+             *
+             * @param other The term to compare with.
+             */
+            virtual bool equivalent(const ObservableTerm & other) const = 0;
+
+            /*!
+             * Create a handle for the evaluation of this term at the current kinematics.
+             *
+             * The default implementation dispatches to evaluate().
+             *
+             * @note Creating a handle may rebind data that is shared by all handles of this term, and must
+             * therefore not happen concurrently with the evaluation of any of them.
+             */
+            virtual ObservableHandle handle() const;
+    };
+
+    /*!
+     * ComposedObservable is the interface of observables whose value is a function of one or
+     * more ObservableTerm objects, such as a ratio of two decay widths.
+     */
+    class ComposedObservable
+    {
+        public:
+            virtual ~ComposedObservable();
+
+            /*!
+             * Retrieve the terms from which this observable is composed.
+             *
+             * @note The terms refer to data owned by the observable, and must not outlive it.
+             */
+            virtual std::vector<ObservableTermPtr> terms() const = 0;
+
+            /*!
+             * Compute the value of this observable from the values of its terms.
+             *
+             * @param values The values of the terms, in the order returned by terms().
+             */
+            virtual double compose(const std::vector<double> & values) const = 0;
+    };
+}
+
+#endif
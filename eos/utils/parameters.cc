@@ -242,7 +242,7 @@ namespace eos
             parameters_map(other.parameters_map)
         {
             parameters.reserve(other.parameters.size());
-            for (unsigned i = 0 ; i != parameters.size() ; ++i)
+            for (unsigned i = 0 ; i != other.parameters.size() ; ++i)
             {
                 parameters.push_back(Parameter(parameters_data, i));
             }
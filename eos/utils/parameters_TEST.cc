@@ -20,6 +20,8 @@
 #include <test/test.hh>
 #include <eos/utils/parameters.hh>
 
+#include <iterator>
+
 using namespace test;
 using namespace eos;
 
@@ -70,6 +72,10 @@ class ParametersTest :
                 m_c_original = 0.0;
                 TEST_CHECK_EQUAL(m_c_original(), 0.0);
                 TEST_CHECK_EQUAL(m_c_clone(), m_c_clone.central());
+
+                // access by id
+                TEST_CHECK_EQUAL(clone[m_c_clone.id()].name(), "mass::c");
+                TEST_CHECK_EQUAL(std::distance(clone.begin(), clone.end()), std::distance(original.begin(), original.end()));
             }
         }
 } parameters_test;
@@ -1,8 +1,10 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 #include <eos/utils/complex.hh>
+#include <eos/utils/polylog.hh>
 #include <eos/utils/power_of.hh>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <limits>
@@ -15,7 +17,7 @@ namespace eos
 
     namespace dilog_impl
     {
-        std::array<complex<double>, max_iterations> series_coefficient_f1
+        const std::array<double, max_iterations> series_coefficient_f1
         {{
             +1.6449340668482264365,       0.0,
             -0.25,                       -0.013888888888888888889,
@@ -107,6 +109,43 @@ namespace eos
 
             return result;
         }
+
+        // used by the batch evaluation
+        struct Traits
+        {
+            static const int order = 2;
+
+            static const std::array<double, max_iterations> & series_coefficients()
+            {
+                return series_coefficient_f1;
+            }
+
+            static bool special(const complex<double> & z, complex<double> & result)
+            {
+                if (z == complex<double>(0.0, 0.0))
+                    result = complex<double>(0.0);
+                else if (z == complex<double>(1.0, 0.0))
+                    result = M_PI * M_PI / 6.0;
+                else if (z == complex<double>(-1.0, 0.0))
+                    result = -M_PI * M_PI / 12.0;
+                else
+                    return false;
+
+                return true;
+            }
+
+            // Li_2(z) for |z| > 2.0, given the series part f0(1 / z)
+            static complex<double> inverse(const complex<double> & z, const complex<double> & f0_inverse_z)
+            {
+                return g(z) - f0_inverse_z;
+            }
+
+            // Li_2(z) for 0.5 <= |z| <= 2.0, given the polynomial part of f1(z) and ln(-ln(z))
+            static complex<double> log_series(const complex<double> & polynomial, const complex<double> & lnz, const complex<double> & lnlnz)
+            {
+                return polynomial + lnz * (1.0 - lnlnz);
+            }
+        };
     }
 
     // Calculation of the dilogarithm based on [C2006]
@@ -133,7 +172,7 @@ namespace eos
 
     namespace trilog_impl
     {
-        std::array<complex<double>, max_iterations> series_coefficient_f1
+        const std::array<double, max_iterations> series_coefficient_f1
         {{
             +1.2020569031595943,         +1.6449340668482264,
              0.0,                        -0.083333333333333333,
@@ -225,6 +264,45 @@ namespace eos
 
             return result;
         }
+
+        // used by the batch evaluation
+        struct Traits
+        {
+            static const int order = 3;
+
+            static const std::array<double, max_iterations> & series_coefficients()
+            {
+                return series_coefficient_f1;
+            }
+
+            static bool special(const complex<double> & z, complex<double> & result)
+            {
+                static const double aperys_constant = 1.2020569031595942854;
+
+                if (z == complex<double>(0.0, 0.0))
+                    result = complex<double>(0.0);
+                else if (z == complex<double>(1.0, 0.0))
+                    result = aperys_constant;
+                else if (z == complex<double>(-1.0, 0.0))
+                    result = -3.0 / 4.0 * aperys_constant;
+                else
+                    return false;
+
+                return true;
+            }
+
+            // Li_3(z) for |z| > 2.0, given the series part f0(1 / z)
+            static complex<double> inverse(const complex<double> & z, const complex<double> & f0_inverse_z)
+            {
+                return g(z) + f0_inverse_z;
+            }
+
+            // Li_3(z) for 0.5 <= |z| <= 2.0, given the polynomial part of f1(z) and ln(-ln(z))
+            static complex<double> log_series(const complex<double> & polynomial, const complex<double> & lnz, const complex<double> & lnlnz)
+            {
+                return polynomial + 0.5 * lnz * lnz * (3.0 / 2.0 - lnlnz);
+            }
+        };
     }
 
     // Calculation of the trilogarithm based on [C2006]
@@ -251,4 +329,176 @@ namespace eos
         return trilog_impl::f1(z);
     }
 
+
+    namespace polylog_impl
+    {
+        // the batch evaluation proceeds in blocks of at most this many arguments
+        static const std::size_t block_size = 32;
+
+        // number of terms of the power series in z (or 1 / z) that are used for |z| < 0.5 (or |z| > 2.0)
+        static const std::size_t power_series_degree = 44;
+
+        enum class Region
+        {
+            special,
+            power_series,
+            inverse_power_series,
+            log_series
+        };
+
+        // coefficients 1 / (k + 1)^n of the power series of Li_n(z) / z
+        template <int n_>
+        std::array<double, power_series_degree> power_series_coefficients()
+        {
+            std::array<double, power_series_degree> result;
+
+            for (std::size_t k = 0 ; k < power_series_degree ; ++k)
+            {
+                result[k] = 1.0 / power_of<n_>(double(k + 1));
+            }
+
+            return result;
+        }
+
+        // Horner scheme for c[0] + c[1] x + ... + c[N - 1] x^(N - 1), evaluated for n arguments x
+        // that are stored with separate real and imaginary parts. The inner loop runs over the
+        // arguments without branching, so that the compiler can vectorize it.
+        template <std::size_t N_>
+        void horner(const std::array<double, N_> & c, const double * x_re, const double * x_im, double * result_re, double * result_im, const std::size_t & n)
+        {
+            for (std::size_t i = 0 ; i < n ; ++i)
+            {
+                result_re[i] = c[N_ - 1];
+                result_im[i] = 0.0;
+            }
+
+            for (std::size_t k = N_ - 1 ; k-- > 0 ; )
+            {
+                for (std::size_t i = 0 ; i < n ; ++i)
+                {
+                    const double re = result_re[i] * x_re[i] - result_im[i] * x_im[i] + c[k];
+                    const double im = result_re[i] * x_im[i] + result_im[i] * x_re[i];
+
+                    result_re[i] = re;
+                    result_im[i] = im;
+                }
+            }
+        }
+
+        /*
+         * Batch evaluation of Li_n(z), using the same regions and expansions as the evaluation of
+         * a single argument. Instead of iterating the series until convergence for each argument
+         * separately, the arguments are first sorted into the regions, and the series are then
+         * evaluated with a fixed number of terms for all arguments of a region at once.
+         */
+        template <typename Traits_>
+        void evaluate(const complex<double> * z, complex<double> * result, const std::size_t & n)
+        {
+            static const std::array<double, power_series_degree> ps_coefficients = power_series_coefficients<Traits_::order>();
+
+            std::array<Region, block_size> region;
+            std::array<std::size_t, block_size> slot;
+
+            // arguments and results of the power series (ps) and the series in ln(z) (ls)
+            std::array<double, block_size> ps_re, ps_im, ps_result_re, ps_result_im;
+            std::array<double, block_size> ls_re, ls_im, ls_result_re, ls_result_im;
+
+            for (std::size_t offset = 0 ; offset < n ; offset += block_size)
+            {
+                const std::size_t m = std::min(block_size, n - offset);
+                std::size_t n_ps = 0, n_ls = 0;
+
+                // sort the arguments into the regions
+                for (std::size_t i = 0 ; i < m ; ++i)
+                {
+                    const complex<double> x = z[offset + i];
+
+                    if (Traits_::special(x, result[offset + i]))
+                    {
+                        region[i] = Region::special;
+                        continue;
+                    }
+
+                    const double abs_x = std::abs(x);
+                    if (abs_x < 0.5)
+                    {
+                        region[i] = Region::power_series;
+                        slot[i] = n_ps;
+                        ps_re[n_ps] = x.real();
+                        ps_im[n_ps] = x.imag();
+                        ++n_ps;
+                    }
+                    else if (abs_x > 2.0)
+                    {
+                        const complex<double> inverse_x = 1.0 / x;
+
+                        region[i] = Region::inverse_power_series;
+                        slot[i] = n_ps;
+                        ps_re[n_ps] = inverse_x.real();
+                        ps_im[n_ps] = inverse_x.imag();
+                        ++n_ps;
+                    }
+                    else
+                    {
+                        const complex<double> lnx = std::log(x);
+
+                        region[i] = Region::log_series;
+                        slot[i] = n_ls;
+                        ls_re[n_ls] = lnx.real();
+                        ls_im[n_ls] = lnx.imag();
+                        ++n_ls;
+                    }
+                }
+
+                // evaluate the series for all arguments of a region at once
+                horner(ps_coefficients, ps_re.data(), ps_im.data(), ps_result_re.data(), ps_result_im.data(), n_ps);
+                horner(Traits_::series_coefficients(), ls_re.data(), ls_im.data(), ls_result_re.data(), ls_result_im.data(), n_ls);
+
+                // assemble the results
+                for (std::size_t i = 0 ; i < m ; ++i)
+                {
+                    const std::size_t j = slot[i];
+
+                    switch (region[i])
+                    {
+                        case Region::special:
+                            break;
+
+                        case Region::power_series:
+                            result[offset + i] = complex<double>(ps_re[j], ps_im[j]) * complex<double>(ps_result_re[j], ps_result_im[j]);
+                            break;
+
+                        case Region::inverse_power_series:
+                            result[offset + i] = Traits_::inverse(z[offset + i],
+                                    complex<double>(ps_re[j], ps_im[j]) * complex<double>(ps_result_re[j], ps_result_im[j]));
+                            break;
+
+                        case Region::log_series:
+                        {
+                            const complex<double> lnx(ls_re[j], ls_im[j]);
+                            complex<double> lnlnx = std::log(-lnx);
+
+                            if ((lnx.imag() == 0.0) && (lnx.real() > 0.0))
+                                lnlnx = std::conj(lnlnx);
+
+                            result[offset + i] = Traits_::log_series(complex<double>(ls_result_re[j], ls_result_im[j]), lnx, lnlnx);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    dilog(const complex<double> * z, complex<double> * result, const std::size_t & n)
+    {
+        polylog_impl::evaluate<dilog_impl::Traits>(z, result, n);
+    }
+
+    void
+    trilog(const complex<double> * z, complex<double> * result, const std::size_t & n)
+    {
+        polylog_impl::evaluate<trilog_impl::Traits>(z, result, n);
+    }
 }
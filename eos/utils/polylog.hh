@@ -5,11 +5,45 @@
 
 #include <eos/utils/complex.hh>
 
+#include <array>
+#include <cstddef>
+
 namespace eos
 {
     complex<double> dilog(const complex<double> & z) __attribute__ ((pure));
 
     complex<double> trilog(const complex<double> & z) __attribute__ ((pure));
+
+    ///@name Batch evaluation
+    ///@{
+    /*!
+     * Evaluate the di- or trilogarithm for n arguments z[0], ..., z[n - 1] at once, and store
+     * the values in result[0], ..., result[n - 1]. The arguments and the results may be stored in the same array.
+     *
+     * The results agree with the evaluation of a single argument, up to rounding errors.
+     */
+    void dilog(const complex<double> * z, complex<double> * result, const std::size_t & n);
+
+    void trilog(const complex<double> * z, complex<double> * result, const std::size_t & n);
+
+    template <std::size_t n_>
+    std::array<complex<double>, n_> dilog(const std::array<complex<double>, n_> & z)
+    {
+        std::array<complex<double>, n_> result;
+        dilog(z.data(), result.data(), n_);
+
+        return result;
+    }
+
+    template <std::size_t n_>
+    std::array<complex<double>, n_> trilog(const std::array<complex<double>, n_> & z)
+    {
+        std::array<complex<double>, n_> result;
+        trilog(z.data(), result.data(), n_);
+
+        return result;
+    }
+    ///@}
 }
 
 #endif
@@ -20,7 +20,9 @@
 #include <test/test.hh>
 #include <eos/utils/polylog.hh>
 
+#include <array>
 #include <fstream>
+#include <vector>
 
 #include <iomanip>
 
@@ -88,5 +90,41 @@ class PolylogarithmTest :
             TEST_CHECK_RELATIVE_ERROR(real(trilog(-c2)),  +real(trilog(z)),    eps); // has no imaginary part
             TEST_CHECK_RELATIVE_ERROR(real(dilog(-c05)),  +real(dilog(zbar)),  eps); // has no imaginary part
             TEST_CHECK_RELATIVE_ERROR(real(trilog(-c05)), +real(trilog(zbar)), eps); // has no imaginary part
+
+            // check that the batch evaluation agrees with the evaluation of single arguments
+            {
+                std::vector<complex<double>> z_values{ z, zbar, 0.0, 1.0, -1.0, complex<double>(2.0, +0.0), complex<double>(2.0, -0.0) };
+                for (double r : { 1e-8, 0.1, 0.49, 0.5, 0.51, 0.9, 1.0, 1.3, 1.99, 2.0, 2.01, 3.5, 1e8 })
+                {
+                    for (double phi = -M_PI ; phi < M_PI ; phi += M_PI / 8.0)
+                    {
+                        z_values.push_back(std::polar(r, phi));
+                    }
+                }
+
+                std::vector<complex<double>> dilog_values(z_values.size()), trilog_values(z_values.size());
+                dilog(z_values.data(), dilog_values.data(), z_values.size());
+                trilog(z_values.data(), trilog_values.data(), z_values.size());
+
+                for (std::size_t i = 0 ; i < z_values.size() ; ++i)
+                {
+                    TEST_CHECK_NEARLY_EQUAL(real(dilog(z_values[i])),  real(dilog_values[i]),  eps);
+                    TEST_CHECK_NEARLY_EQUAL(imag(dilog(z_values[i])),  imag(dilog_values[i]),  eps);
+                    TEST_CHECK_NEARLY_EQUAL(real(trilog(z_values[i])), real(trilog_values[i]), eps);
+                    TEST_CHECK_NEARLY_EQUAL(imag(trilog(z_values[i])), imag(trilog_values[i]), eps);
+                }
+
+                // in-place evaluation, and evaluation of fixed-size arrays
+                std::array<complex<double>, 3> z_array{{ z_values[7], z_values[100], z_values[200] }};
+                std::array<complex<double>, 3> dilog_array = dilog(z_array);
+                trilog(z_array.data(), z_array.data(), z_array.size());
+
+                TEST_CHECK_EQUAL(dilog_array[0], dilog_values[7]);
+                TEST_CHECK_EQUAL(dilog_array[1], dilog_values[100]);
+                TEST_CHECK_EQUAL(dilog_array[2], dilog_values[200]);
+                TEST_CHECK_EQUAL(z_array[0],     trilog_values[7]);
+                TEST_CHECK_EQUAL(z_array[1],     trilog_values[100]);
+                TEST_CHECK_EQUAL(z_array[2],     trilog_values[200]);
+            }
         }
 } polylogarithm_test;
@@ -0,0 +1,321 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/utils/exception.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/random-stream.hh>
+
+#include <cmath>
+#include <cstring>
+
+#include <gsl/gsl_randist.h>
+
+namespace eos
+{
+    namespace implementation
+    {
+        // cf. Steele, Lea and Flood, 'Fast splittable pseudorandom number generators', OOPSLA 2014
+        inline uint64_t splitmix64(uint64_t x)
+        {
+            x += 0x9E3779B97F4A7C15ull;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+
+            return x ^ (x >> 31);
+        }
+
+        // FNV-1a
+        inline uint64_t hash(const std::string & s)
+        {
+            uint64_t result = 0xCBF29CE484222325ull;
+            for (unsigned char c : s)
+            {
+                result ^= c;
+                result *= 0x100000001B3ull;
+            }
+
+            return result;
+        }
+
+        inline uint64_t derive(const uint64_t & id, const uint64_t & index)
+        {
+            return splitmix64(id ^ splitmix64(index));
+        }
+
+        struct Philox4x32State
+        {
+            Philox4x32::Key key;
+
+            // the upper half of the counter
+            uint64_t id;
+
+            // the lower half of the counter, i.e., the index of the next block
+            uint64_t position;
+
+            Philox4x32::Counter buffer;
+
+            // the number of words of the buffer that have been used
+            unsigned used;
+
+            Philox4x32::Counter counter(const uint64_t & block) const
+            {
+                return Philox4x32::Counter{{ uint32_t(block), uint32_t(block >> 32), uint32_t(id), uint32_t(id >> 32) }};
+            }
+
+            void seed(const uint64_t & seed)
+            {
+                const uint64_t k = splitmix64(seed);
+                key = Philox4x32::Key{{ uint32_t(k), uint32_t(k >> 32) }};
+                id = 0;
+                position = 0;
+                used = 4;
+            }
+
+            uint32_t next()
+            {
+                if (4 == used)
+                {
+                    buffer = Philox4x32::generate(counter(position++), key);
+                    used = 0;
+                }
+
+                return buffer[used++];
+            }
+        };
+
+        void philox4x32_set(void * state, unsigned long seed)
+        {
+            static_cast<Philox4x32State *>(state)->seed(seed);
+        }
+
+        unsigned long philox4x32_get(void * state)
+        {
+            return static_cast<Philox4x32State *>(state)->next();
+        }
+
+        double philox4x32_get_double(void * state)
+        {
+            return static_cast<Philox4x32State *>(state)->next() / 4294967296.0;
+        }
+
+        const gsl_rng_type philox4x32_type =
+        {
+            "eos-philox4x32",
+            0xFFFFFFFFul,
+            0ul,
+            sizeof(Philox4x32State),
+            &philox4x32_set,
+            &philox4x32_get,
+            &philox4x32_get_double
+        };
+
+        // map two words onto the interval (0, 1) with 53 bit resolution
+        inline double to_open_unit_interval(const uint32_t & hi, const uint32_t & lo)
+        {
+            const uint64_t x = (uint64_t(hi >> 5) << 26) | (lo >> 6);
+
+            return (x + 0.5) / 9007199254740992.0;
+        }
+
+        void philox4x32_normal(Philox4x32State & state, double * result, const std::size_t & n)
+        {
+            static const double two_pi = 2.0 * M_PI;
+
+            state.used = 4;
+
+            const uint64_t first = state.position;
+            const std::size_t blocks = (n + 1) / 2;
+            for (std::size_t b = 0 ; b < blocks ; ++b)
+            {
+                const auto words = Philox4x32::generate(state.counter(first + b), state.key);
+
+                const double u1 = implementation::to_open_unit_interval(words[0], words[1]);
+                const double u2 = implementation::to_open_unit_interval(words[2], words[3]);
+
+                const double r = std::sqrt(-2.0 * std::log(u1));
+                const double phi = two_pi * u2;
+
+                result[2 * b] = r * std::cos(phi);
+                if (2 * b + 1 < n)
+                    result[2 * b + 1] = r * std::sin(phi);
+            }
+            state.position += blocks;
+        }
+    }
+
+    const gsl_rng_type * eos_rng_philox4x32 = &implementation::philox4x32_type;
+
+    template <> struct Implementation<RandomStream>
+    {
+        gsl_rng * rng;
+
+        // the seed, and the id that substreams are derived from
+        uint64_t seed, id;
+
+        Implementation(const uint64_t & seed, const uint64_t & id) :
+            rng(gsl_rng_alloc(eos_rng_philox4x32)),
+            seed(seed),
+            id(id)
+        {
+            if (! rng)
+                throw InternalError("RandomStream: Could not allocate new gsl_rng");
+
+            state().seed(seed);
+            state().id = id;
+        }
+
+        ~Implementation()
+        {
+            gsl_rng_free(rng);
+        }
+
+        implementation::Philox4x32State & state()
+        {
+            return *static_cast<implementation::Philox4x32State *>(rng->state);
+        }
+    };
+
+    RandomStream::RandomStream(Implementation<RandomStream> * imp) :
+        PrivateImplementationPattern<RandomStream>(imp)
+    {
+    }
+
+    RandomStream::RandomStream(const uint64_t & seed, const std::string & purpose, const uint64_t & index) :
+        PrivateImplementationPattern<RandomStream>(new Implementation<RandomStream>(seed,
+                    implementation::derive(implementation::hash(purpose), index)))
+    {
+    }
+
+    RandomStream::~RandomStream()
+    {
+    }
+
+    RandomStream
+    RandomStream::substream(const uint64_t & index) const
+    {
+        return RandomStream(new Implementation<RandomStream>(_imp->seed, implementation::derive(_imp->id, index)));
+    }
+
+    void
+    RandomStream::select(const uint64_t & index)
+    {
+        auto & state = _imp->state();
+        state.id = implementation::derive(_imp->id, index);
+        state.position = 0;
+        state.used = 4;
+    }
+
+    uint64_t
+    RandomStream::id() const
+    {
+        return _imp->id;
+    }
+
+    gsl_rng *
+    RandomStream::rng() const
+    {
+        return _imp->rng;
+    }
+
+    double
+    RandomStream::uniform()
+    {
+        return _imp->state().next() / 4294967296.0;
+    }
+
+    void
+    RandomStream::uniform(double * result, const std::size_t & n)
+    {
+        auto & state = _imp->state();
+        state.used = 4;
+
+        // the blocks are independent of each other, which allows the compiler to interleave them
+        const uint64_t first = state.position;
+        const std::size_t blocks = n / 2;
+        for (std::size_t b = 0 ; b < blocks ; ++b)
+        {
+            const auto words = Philox4x32::generate(state.counter(first + b), state.key);
+
+            result[2 * b + 0] = implementation::to_open_unit_interval(words[0], words[1]);
+            result[2 * b + 1] = implementation::to_open_unit_interval(words[2], words[3]);
+        }
+        state.position += blocks;
+
+        if (n % 2)
+        {
+            const auto words = Philox4x32::generate(state.counter(state.position++), state.key);
+
+            result[n - 1] = implementation::to_open_unit_interval(words[0], words[1]);
+        }
+    }
+
+    void
+    RandomStream::normal(double * result, const std::size_t & n)
+    {
+        implementation::philox4x32_normal(_imp->state(), result, n);
+    }
+
+    void
+    draw_standard_normal(gsl_rng * rng, double * result, const std::size_t & n)
+    {
+        if (eos_rng_philox4x32 == rng->type)
+        {
+            implementation::philox4x32_normal(*static_cast<implementation::Philox4x32State *>(rng->state), result, n);
+            return;
+        }
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            result[i] = gsl_ran_ugaussian(rng);
+        }
+    }
+
+    void
+    dump_rng_state(hdf5::File & file, const std::string & name, const gsl_rng * rng)
+    {
+        // store the state as 32 bit words, padded with zeros
+        const std::size_t size = gsl_rng_size(rng);
+        std::vector<unsigned> record((size + sizeof(unsigned) - 1) / sizeof(unsigned), 0u);
+        std::memcpy(record.data(), gsl_rng_state(rng), size);
+
+        auto data_set = file.create_data_set(name, hdf5::Array<1, unsigned>("state", { record.size() }));
+        data_set << record;
+
+        auto type = data_set.create_attribute("type", hdf5::Scalar<const char *>("type"));
+        type = gsl_rng_name(rng);
+    }
+
+    void
+    read_rng_state(hdf5::File & file, const std::string & name, gsl_rng * rng)
+    {
+        const std::size_t size = gsl_rng_size(rng);
+        std::vector<unsigned> record((size + sizeof(unsigned) - 1) / sizeof(unsigned), 0u);
+
+        auto data_set = file.open_data_set(name, hdf5::Array<1, unsigned>("state", { record.size() }));
+
+        const std::string type = data_set.open_attribute("type", hdf5::Scalar<const char *>("type")).value();
+        if (type != gsl_rng_name(rng))
+            throw InternalError("read_rng_state: Cannot restore the state of a generator of type '" + std::string(gsl_rng_name(rng))
+                    + "' from the state of a generator of type '" + type + "'");
+
+        data_set >> record;
+        std::memcpy(gsl_rng_state(rng), record.data(), size);
+    }
+}
@@ -0,0 +1,194 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_UTILS_RANDOM_STREAM_HH
+#define EOS_GUARD_SRC_UTILS_RANDOM_STREAM_HH 1
+
+#include <eos/utils/hdf5-fwd.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <gsl/gsl_rng.h>
+
+namespace eos
+{
+    /*!
+     * The counter-based pseudo-random number generator Philox4x32-10,
+     * cf. Salmon, Moraes, Dror and Shaw, 'Parallel random numbers: as easy as 1, 2, 3', SC11.
+     *
+     * Each pair of a 128 bit counter and a 64 bit key is mapped onto 128 random bits.
+     * No state needs to be kept besides the counter.
+     */
+    struct Philox4x32
+    {
+        typedef std::array<uint32_t, 4> Counter;
+
+        typedef std::array<uint32_t, 2> Key;
+
+        static Counter generate(const Counter & counter, const Key & key)
+        {
+            static const uint32_t m0 = 0xD2511F53u, m1 = 0xCD9E8D57u;
+            static const uint32_t w0 = 0x9E3779B9u, w1 = 0xBB67AE85u;
+
+            uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+            uint32_t k0 = key[0], k1 = key[1];
+
+            for (unsigned round = 0 ; round < 10 ; ++round)
+            {
+                const uint64_t p0 = uint64_t(m0) * c0, p1 = uint64_t(m1) * c2;
+
+                const uint32_t hi0 = p0 >> 32, lo0 = p0, hi1 = p1 >> 32, lo1 = p1;
+
+                c0 = hi1 ^ c1 ^ k0;
+                c1 = lo1;
+                c2 = hi0 ^ c3 ^ k1;
+                c3 = lo0;
+
+                k0 += w0;
+                k1 += w1;
+            }
+
+            return Counter{{ c0, c1, c2, c3 }};
+        }
+    };
+
+    /*!
+     * An independent stream of pseudo-random numbers, based on Philox4x32.
+     *
+     * A stream is identified by a seed and a 64 bit stream id. The seed determines the generator's key,
+     * and the stream id occupies the upper half of the counter. Streams with different ids are therefore
+     * statistically independent, and the numbers drawn from any one stream do not depend on
+     * which thread draws them or in which order the streams are used.
+     *
+     * Stream ids are derived from a purpose, e.g. 'markov-chain', and an index, e.g. the index of the chain.
+     * Each stream can be split further into substreams, e.g. one for each sample or batch.
+     *
+     * Copies of a RandomStream share their state.
+     */
+    class RandomStream :
+        public PrivateImplementationPattern<RandomStream>
+    {
+        private:
+            RandomStream(Implementation<RandomStream> * imp);
+
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param seed     The seed, which determines the generator's key.
+             * @param purpose  The purpose of the stream, e.g. 'markov-chain'.
+             * @param index    The index of the stream among all streams of the same purpose.
+             */
+            RandomStream(const uint64_t & seed, const std::string & purpose, const uint64_t & index = 0);
+
+            /// Destructor.
+            ~RandomStream();
+
+            /*!
+             * Create an independent stream.
+             *
+             * @param index    The index of the substream.
+             */
+            RandomStream substream(const uint64_t & index) const;
+
+            /*!
+             * Reposition to the beginning of a substream. Subsequent draws are identical to those from
+             * substream(index), without the cost of creating a new stream.
+             *
+             * @param index    The index of the substream.
+             */
+            void select(const uint64_t & index);
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Return the id of the stream.
+            uint64_t id() const;
+
+            /*!
+             * Return a GSL random number generator that draws from this stream, e.g. for use with gsl_ran_*.
+             * The generator remains owned by the stream.
+             */
+            gsl_rng * rng() const;
+            ///@}
+
+            ///@name Drawing
+            ///@{
+            /// Draw a pseudo-random number in the range [0.0, 1.0) with 32 bit resolution.
+            double uniform();
+
+            /*!
+             * Draw pseudo-random numbers in the range (0.0, 1.0) with 53 bit resolution.
+             * Each call begins with a fresh block of the generator.
+             *
+             * @param result   The array that shall hold the numbers.
+             * @param n        The number of numbers to be drawn.
+             */
+            void uniform(double * result, const std::size_t & n);
+
+            /*!
+             * Draw pseudo-random numbers from the standard normal distribution, using the Box-Muller transform.
+             * Each call begins with a fresh block of the generator.
+             *
+             * @param result   The array that shall hold the numbers.
+             * @param n        The number of numbers to be drawn.
+             */
+            void normal(double * result, const std::size_t & n);
+            ///@}
+    };
+
+    /// The GSL random number generator type that is used by RandomStream.
+    extern const gsl_rng_type * eos_rng_philox4x32;
+
+    /*!
+     * Draw pseudo-random numbers from the standard normal distribution using any GSL random number generator.
+     * Generators of type eos_rng_philox4x32 take the bulk path of RandomStream::normal().
+     *
+     * @param rng      The random number generator.
+     * @param result   The array that shall hold the numbers.
+     * @param n        The number of numbers to be drawn.
+     */
+    void draw_standard_normal(gsl_rng * rng, double * result, const std::size_t & n);
+
+    /*!
+     * Store the complete state of any GSL random number generator, e.g. as part of a checkpoint.
+     *
+     * @param file     The HDF5 file.
+     * @param name     The absolute name of the data set that shall hold the state.
+     * @param rng      The random number generator.
+     */
+    void dump_rng_state(hdf5::File & file, const std::string & name, const gsl_rng * rng);
+
+    /*!
+     * Restore the state of a GSL random number generator as stored by dump_rng_state().
+     * Subsequent draws are identical to those that would have followed the stored state.
+     *
+     * @param file     The HDF5 file.
+     * @param name     The absolute name of the data set that holds the state.
+     * @param rng      The random number generator, which must be of the same type as the stored one.
+     */
+    void read_rng_state(hdf5::File & file, const std::string & name, gsl_rng * rng);
+}
+
+#endif
@@ -0,0 +1,210 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/random-stream.hh>
+
+#include <cmath>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class Philox4x32Test :
+    public TestCase
+{
+    public:
+        Philox4x32Test() :
+            TestCase("philox4x32_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // known answers, cf. the Random123 distribution
+            {
+                auto r = Philox4x32::generate(Philox4x32::Counter{{ 0, 0, 0, 0 }}, Philox4x32::Key{{ 0, 0 }});
+                TEST_CHECK_EQUAL(r[0], 0x6627e8d5u);
+                TEST_CHECK_EQUAL(r[1], 0xe169c58du);
+                TEST_CHECK_EQUAL(r[2], 0xbc57ac4cu);
+                TEST_CHECK_EQUAL(r[3], 0x9b00dbd8u);
+            }
+
+            {
+                auto r = Philox4x32::generate(Philox4x32::Counter{{ 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu }},
+                        Philox4x32::Key{{ 0xffffffffu, 0xffffffffu }});
+                TEST_CHECK_EQUAL(r[0], 0x408f276du);
+                TEST_CHECK_EQUAL(r[1], 0x41c83b0eu);
+                TEST_CHECK_EQUAL(r[2], 0xa20bc7c6u);
+                TEST_CHECK_EQUAL(r[3], 0x6d5451fdu);
+            }
+
+            {
+                auto r = Philox4x32::generate(Philox4x32::Counter{{ 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u }},
+                        Philox4x32::Key{{ 0xa4093822u, 0x299f31d0u }});
+                TEST_CHECK_EQUAL(r[0], 0xd16cfe09u);
+                TEST_CHECK_EQUAL(r[1], 0x94fdccebu);
+                TEST_CHECK_EQUAL(r[2], 0x5001e420u);
+                TEST_CHECK_EQUAL(r[3], 0x24126ea1u);
+            }
+        }
+} philox4x32_test;
+
+class RandomStreamTest :
+    public TestCase
+{
+    public:
+        RandomStreamTest() :
+            TestCase("random_stream_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // streams are reproducible, and differ by seed, purpose and index
+            {
+                RandomStream a(1723, "test"), b(1723, "test"), c(1724, "test"), d(1723, "other"), e(1723, "test", 1);
+
+                std::vector<double> va, vb, vc, vd, ve;
+                for (unsigned i = 0 ; i < 16 ; ++i)
+                {
+                    va.push_back(a.uniform());
+                    vb.push_back(b.uniform());
+                    vc.push_back(c.uniform());
+                    vd.push_back(d.uniform());
+                    ve.push_back(e.uniform());
+                }
+
+                TEST_CHECK(va == vb);
+                TEST_CHECK(va != vc);
+                TEST_CHECK(va != vd);
+                TEST_CHECK(va != ve);
+            }
+
+            // the GSL interface draws from the same stream
+            {
+                RandomStream a(1723, "test"), b(1723, "test");
+
+                for (unsigned i = 0 ; i < 9 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(a.uniform(), gsl_rng_uniform(b.rng()));
+                }
+            }
+
+            // the state of the GSL interface can be stored and restored
+            {
+                static const std::string filename(EOS_BUILDDIR "/eos/utils/random-stream_TEST-state.hdf5");
+
+                RandomStream a(1723, "test"), b(1346, "other");
+                for (unsigned i = 0 ; i < 5 ; ++i)
+                {
+                    gsl_rng_uniform(a.rng());
+                }
+
+                {
+                    hdf5::File file = hdf5::File::Create(filename);
+                    dump_rng_state(file, "/rng", a.rng());
+                }
+
+                {
+                    hdf5::File file = hdf5::File::Open(filename);
+                    read_rng_state(file, "/rng", b.rng());
+                }
+
+                for (unsigned i = 0 ; i < 9 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(gsl_rng_uniform(a.rng()), gsl_rng_uniform(b.rng()));
+                }
+            }
+
+            // substreams do not depend on the order of their use
+            {
+                RandomStream base(42, "test");
+
+                std::vector<double> first(8), second(8), again(8);
+                base.substream(7).uniform(first.data(), first.size());
+                base.substream(3).uniform(second.data(), second.size());
+                base.substream(7).uniform(again.data(), again.size());
+
+                TEST_CHECK(first == again);
+                TEST_CHECK(first != second);
+
+                // select() is equivalent to creating a substream
+                base.select(3);
+                base.uniform(again.data(), again.size());
+                TEST_CHECK(second == again);
+
+                base.select(7);
+                base.uniform(again.data(), again.size());
+                TEST_CHECK(first == again);
+            }
+
+            // bulk uniform draws
+            {
+                RandomStream stream(5, "test");
+
+                static const unsigned n = 100001;
+                std::vector<double> u(n);
+                stream.uniform(u.data(), n);
+
+                double sum = 0.0, sum2 = 0.0;
+                for (auto x : u)
+                {
+                    TEST_CHECK((0.0 < x) && (x < 1.0));
+                    sum += x;
+                    sum2 += x * x;
+                }
+
+                TEST_CHECK_NEARLY_EQUAL(sum / n, 0.5, 0.005);
+                TEST_CHECK_NEARLY_EQUAL(sum2 / n - power_of_2(sum / n), 1.0 / 12.0, 0.002);
+
+                // subsequent draws continue with the next block
+                std::vector<double> v(2);
+                stream.uniform(v.data(), 2);
+                TEST_CHECK(v[0] != u[n - 1]);
+            }
+
+            // bulk normal draws
+            {
+                RandomStream stream(5, "test");
+
+                static const unsigned n = 100001;
+                std::vector<double> z(n);
+                stream.normal(z.data(), n);
+
+                double sum = 0.0, sum2 = 0.0, sum4 = 0.0;
+                for (auto x : z)
+                {
+                    sum += x;
+                    sum2 += x * x;
+                    sum4 += x * x * x * x;
+                }
+
+                TEST_CHECK_NEARLY_EQUAL(sum / n, 0.0, 0.01);
+                TEST_CHECK_NEARLY_EQUAL(sum2 / n, 1.0, 0.02);
+                TEST_CHECK_NEARLY_EQUAL(sum4 / n, 3.0, 0.1);
+            }
+        }
+
+        static double power_of_2(const double & x)
+        {
+            return x * x;
+        }
+} random_stream_test;
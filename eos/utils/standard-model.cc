@@ -622,7 +622,7 @@ namespace implementation
 }
 
     WilsonCoefficients<BToS>
-    SMComponent<components::DeltaBS1>::wilson_coefficients_b_to_s(const double & mu, const std::string & /*lepton_flavour*/, const bool & /*cp_conjugate*/) const
+    SMComponent<components::DeltaBS1>::wilson_coefficients_b_to_s(const double & mu, const LeptonFlavour & /*lepton_flavour*/, const bool & /*cp_conjugate*/) const
     {
         /*
          * In the SM all Wilson coefficients are real-valued -> all weak phases are zero.
@@ -641,6 +641,7 @@ namespace implementation
 
         // only evolve the wilson coefficients for 5 active flavors
         static const double nf = 5.0;
+        static const WilsonCoefficientsEvolution<BToS> evolution(nf, QCD::beta_function_nf_5);
 
         // calculate all alpha_s values
         const double alpha_s_mu_0c = QCD::alpha_s(_mu_0c__deltabs1, _alpha_s_Z__deltabs1, _m_Z__deltabs1, QCD::beta_function_nf_5);
@@ -680,14 +681,14 @@ namespace implementation
         const double log_c = 2.0 * std::log(_mu_0c__deltabs1 / _m_W__deltabs1), log_t = std::log(_mu_0t__deltabs1 / m_t_mu_0t);
         const double x_c = power_of<2>(m_t_mu_0c / _m_W__deltabs1), x_t = power_of<2>(m_t_mu_0t / _m_W__deltabs1);
 
-        WilsonCoefficients<BToS> downscaled_charm = evolve(implementation::initial_scale_wilson_coefficients_b_to_s_charm_sector_qcd0(),
+        WilsonCoefficients<BToS> downscaled_charm = evolution.evolve(implementation::initial_scale_wilson_coefficients_b_to_s_charm_sector_qcd0(),
                 implementation::initial_scale_wilson_coefficients_b_to_s_charm_sector_qcd1(log_c, _sw2__deltabs1),
                 implementation::initial_scale_wilson_coefficients_b_to_s_charm_sector_qcd2(x_c, log_c, _sw2__deltabs1),
-                alpha_s_mu_0c, alpha_s, nf, QCD::beta_function_nf_5);
-        WilsonCoefficients<BToS> downscaled_top = evolve(implementation::initial_scale_wilson_coefficients_b_to_s_top_sector_qcd0(),
+                alpha_s_mu_0c, alpha_s);
+        WilsonCoefficients<BToS> downscaled_top = evolution.evolve(implementation::initial_scale_wilson_coefficients_b_to_s_top_sector_qcd0(),
                 implementation::initial_scale_wilson_coefficients_b_to_s_top_sector_qcd1(x_t, _sw2__deltabs1),
                 implementation::initial_scale_wilson_coefficients_b_to_s_top_sector_qcd2(x_t, log_t, _sw2__deltabs1),
-                alpha_s_mu_0t, alpha_s, nf, QCD::beta_function_nf_5);
+                alpha_s_mu_0t, alpha_s);
 
         WilsonCoefficients<BToS> wc = downscaled_top;
         wc._sm_like_coefficients = wc._sm_like_coefficients + complex<double>(-1.0, 0.0) * downscaled_charm._sm_like_coefficients;
@@ -700,7 +701,7 @@ namespace implementation
     }
 
     WilsonCoefficients<ChargedCurrent>
-    SMComponent<components::DeltaBU1>::wilson_coefficients_b_to_u(const std::string & lepton_flavour, const bool & /* cp_conjugate */) const
+    SMComponent<components::DeltaBU1>::wilson_coefficients_b_to_u(const LeptonFlavour & /* lepton_flavour */, const bool & /* cp_conjugate */) const
     {
         WilsonCoefficients<ChargedCurrent> wc;
         wc._coefficients.fill(complex<double>(0.0));
@@ -714,7 +715,7 @@ namespace implementation
     }
 
     WilsonCoefficients<ChargedCurrent>
-    SMComponent<components::DeltaBC1>::wilson_coefficients_b_to_c(const std::string & lepton_flavour, const bool & /* cp_conjugate */) const
+    SMComponent<components::DeltaBC1>::wilson_coefficients_b_to_c(const LeptonFlavour & /* lepton_flavour */, const bool & /* cp_conjugate */) const
     {
         WilsonCoefficients<ChargedCurrent> wc;
         wc._coefficients.fill(complex<double>(0.0));
@@ -120,7 +120,7 @@ namespace eos
             SMComponent(const Parameters &, ParameterUser &);
 
             /* b->s Wilson coefficients */
-            virtual WilsonCoefficients<BToS> wilson_coefficients_b_to_s(const double & mu, const std::string & lepton_flavour, const bool & cp_conjugate) const;
+            virtual WilsonCoefficients<BToS> wilson_coefficients_b_to_s(const double & mu, const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const;
     };
 
     template <> class SMComponent<components::DeltaBU1> :
@@ -130,7 +130,7 @@ namespace eos
             SMComponent(const Parameters &, ParameterUser &);
 
             /* b->u Wilson coefficients */
-            virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_u(const std::string & lepton_flavour, const bool & cp_conjugate) const;
+            virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_u(const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const;
     };
 
     template <> class SMComponent<components::DeltaBC1> :
@@ -140,7 +140,7 @@ namespace eos
         SMComponent(const Parameters &, ParameterUser &);
 
         /* b->c Wilson coefficients */
-        virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_c(const std::string & lepton_flavour, const bool & cp_conjugate) const;
+        virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_c(const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const;
     };
 
     class StandardModel :
@@ -354,7 +354,7 @@ class WilsonCoefficientsBToSTest :
                 parameters["mu"] = mu;
                 TEST_CHECK_NEARLY_EQUAL(+0.2209967815, model.alpha_s(mu), eps);
 
-                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
                 TEST_CHECK_RELATIVE_ERROR(-0.279801085, real(wc.c1()),  eps);
                 TEST_CHECK_RELATIVE_ERROR(+1.009683640, real(wc.c2()),  eps);
                 TEST_CHECK_RELATIVE_ERROR(-0.005775920, real(wc.c3()),  eps);
@@ -388,7 +388,7 @@ class WilsonCoefficientsBToSTest :
                 parameters["mu"] = mu;
                 TEST_CHECK_NEARLY_EQUAL(+0.2233419372, model.alpha_s(mu), eps);
 
-                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
                 TEST_CHECK_RELATIVE_ERROR(-0.28768333, real(wc.c1()),  eps);
                 TEST_CHECK_RELATIVE_ERROR(+1.01013250, real(wc.c2()),  eps);
                 TEST_CHECK_RELATIVE_ERROR(-0.00600697, real(wc.c3()),  eps);
@@ -423,7 +423,7 @@ class WilsonCoefficientsBToSTest :
                 parameters["mu"] = mu;
                 TEST_CHECK_NEARLY_EQUAL(+0.2263282172, model.alpha_s(mu), eps);
 
-                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
                 TEST_CHECK_RELATIVE_ERROR(parameters["b->s::c1"],           real(wc.c1()),  eps);
                 TEST_CHECK_RELATIVE_ERROR(parameters["b->s::c2"],           real(wc.c2()),  eps);
                 TEST_CHECK_RELATIVE_ERROR(parameters["b->s::c3"],           real(wc.c3()),  eps);
@@ -25,12 +25,90 @@
 #include <eos/utils/thread.hh>
 #include <eos/utils/thread_pool.hh>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <list>
+#include <memory>
 
 #include <unistd.h>
 
 namespace eos
 {
+    namespace implementation
+    {
+        // Work shared between the threads of a parallel loop. Held by shared pointer,
+        // since helper jobs might only start once the loop has completed.
+        struct ParallelWork
+        {
+            std::function<void (const unsigned &)> work;
+
+            const unsigned size;
+
+            std::atomic<unsigned> next;
+
+            std::atomic<unsigned> completed;
+
+            // The first exception thrown by any work item. Once set, the remaining items are skipped.
+            std::atomic<bool> failed;
+
+            std::exception_ptr exception;
+
+            Mutex mutex;
+
+            ConditionVariable finished;
+
+            ParallelWork(const std::function<void (const unsigned &)> & work, const unsigned & size) :
+                work(work),
+                size(size),
+                next(0),
+                completed(0),
+                failed(false)
+            {
+            }
+
+            void run()
+            {
+                for (unsigned i = next++ ; i < size ; i = next++)
+                {
+                    if (! failed)
+                    {
+                        try
+                        {
+                            work(i);
+                        }
+                        catch (...)
+                        {
+                            Lock l(mutex);
+
+                            if (! exception)
+                                exception = std::current_exception();
+
+                            failed = true;
+                        }
+                    }
+
+                    // items count as completed even if they fail or are skipped
+                    if (size == ++completed)
+                    {
+                        Lock l(mutex);
+                        finished.broadcast();
+                    }
+                }
+            }
+
+            void wait()
+            {
+                Lock l(mutex);
+
+                while (completed < size)
+                {
+                    finished.wait(mutex);
+                }
+            }
+        };
+    }
+
     template <>
     struct Implementation<ThreadPool>
     {
@@ -96,6 +174,8 @@ namespace eos
                 }
 
                 (*job)();
+                delete job;
+
                 {
                     Lock l(*job_mutex);
                     pending_jobs -= 1;
@@ -143,6 +223,11 @@ namespace eos
             {
                 delete *t;
             }
+
+            for (auto & item : queue)
+            {
+                delete item.second;
+            }
         }
     };
 
@@ -190,6 +275,28 @@ namespace eos
         _imp->job_capacity->wait(*_imp->job_mutex);
     }
 
+    void
+    ThreadPool::parallel_for(const unsigned & size, const std::function<void (const unsigned &)> & work)
+    {
+        auto parallel_work = std::make_shared<implementation::ParallelWork>(work, size);
+
+        // The calling thread takes part in the work and only waits for items that are
+        // being processed by helpers. Hence the loop completes even if no helper ever runs,
+        // e.g. because all threads of the pool are busy.
+        unsigned helpers = std::min<unsigned>(_imp->number_of_threads, size);
+        helpers = (helpers > 0) ? helpers - 1 : 0;
+        for (unsigned i = 0 ; i < helpers ; ++i)
+        {
+            enqueue(std::bind(&implementation::ParallelWork::run, parallel_work));
+        }
+
+        parallel_work->run();
+        parallel_work->wait();
+
+        if (parallel_work->exception)
+            std::rethrow_exception(parallel_work->exception);
+    }
+
     unsigned
     ThreadPool::number_of_threads() const
     {
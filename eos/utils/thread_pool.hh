@@ -43,6 +43,18 @@ namespace eos
 
             void wait_for_free_capacity();
 
+            /*!
+             * Call work(i) for all i in [0, size) in parallel, and wait until all calls have returned.
+             *
+             * The calling thread takes part in the work, which makes it safe to use from within jobs of the pool.
+             * If any call of work throws, the remaining work items are skipped, and the first exception
+             * is rethrown in the calling thread once all calls in progress have returned.
+             *
+             * @param size The number of work items.
+             * @param work The function that processes a single work item.
+             */
+            void parallel_for(const unsigned & size, const std::function<void (const unsigned &)> & work);
+
             unsigned number_of_threads() const;
     };
 }
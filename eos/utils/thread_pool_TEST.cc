@@ -0,0 +1,96 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <atomic>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class ThreadPoolTest :
+    public TestCase
+{
+    public:
+        ThreadPoolTest() :
+            TestCase("thread_pool_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // parallel loops
+            {
+                std::vector<unsigned> results(1000, 0);
+                ThreadPool::instance()->parallel_for(results.size(), [&] (const unsigned & i) { results[i] = i * i; });
+
+                for (unsigned i = 0 ; i < results.size() ; ++i)
+                {
+                    TEST_CHECK_EQUAL(i * i, results[i]);
+                }
+
+                // nested loops
+                std::atomic<unsigned> count(0);
+                ThreadPool::instance()->parallel_for(10, [&] (const unsigned &)
+                {
+                    ThreadPool::instance()->parallel_for(10, [&] (const unsigned &) { ++count; });
+                });
+                TEST_CHECK_EQUAL(100, count);
+
+                // empty loops
+                ThreadPool::instance()->parallel_for(0, [&] (const unsigned &) { ++count; });
+                TEST_CHECK_EQUAL(100, count);
+            }
+
+            // exceptions propagate to the calling thread
+            {
+                for (unsigned failing : { 0u, 7u, 99u })
+                {
+                    std::atomic<unsigned> count(0);
+                    try
+                    {
+                        ThreadPool::instance()->parallel_for(100, [&] (const unsigned & i)
+                        {
+                            ++count;
+
+                            if (i == failing)
+                                throw InternalError("failure in item " + stringify(i));
+                        });
+
+                        TEST_CHECK_FAILED("parallel_for did not throw");
+                    }
+                    catch (InternalError & e)
+                    {
+                        TEST_CHECK_EQUAL_STR("Internal Error: failure in item " + stringify(failing), e.what());
+                    }
+
+                    TEST_CHECK(count <= 100);
+                }
+
+                // the pool remains usable
+                std::atomic<unsigned> count(0);
+                ThreadPool::instance()->parallel_for(100, [&] (const unsigned &) { ++count; });
+                TEST_CHECK_EQUAL(100, count);
+            }
+        }
+} thread_pool_test;
@@ -0,0 +1,400 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/utils/exception.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/trace.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace eos
+{
+    namespace implementation
+    {
+        // Set whenever tracing is enabled; kept outside of the singleton such that
+        // checking it does not instantiate the singleton.
+        std::atomic<bool> trace_enabled(nullptr != std::getenv("EOS_TRACE_FILE"));
+
+        struct TraceEvent
+        {
+            // 'X' for a complete event, 'C' for a counter event
+            char phase;
+
+            const char * category;
+
+            std::string name;
+
+            // timestamp and duration in microseconds
+            double timestamp, duration;
+
+            // value of a counter after the increment
+            double value;
+        };
+
+        // Number of events per thread that are kept for the export by default
+        constexpr std::size_t default_trace_capacity = 1u << 16;
+
+        void record(TraceSummary & summary, const double & value)
+        {
+            if (0 == summary.count)
+            {
+                summary.min = value;
+                summary.max = value;
+            }
+            else
+            {
+                summary.min = std::min(summary.min, value);
+                summary.max = std::max(summary.max, value);
+            }
+
+            summary.count += 1;
+            summary.total += value;
+        }
+
+        void merge(TraceSummary & summary, const TraceSummary & other)
+        {
+            if (0 == other.count)
+                return;
+
+            if (0 == summary.count)
+            {
+                summary = other;
+                return;
+            }
+
+            summary.count += other.count;
+            summary.total += other.total;
+            summary.min = std::min(summary.min, other.min);
+            summary.max = std::max(summary.max, other.max);
+        }
+
+        struct TraceBuffer
+        {
+            unsigned thread_id;
+
+            // ring buffer of the most recent events; once full, the oldest event
+            // at index 'next' is overwritten
+            std::vector<TraceEvent> events;
+
+            std::size_t next;
+
+            // aggregates per category and name, looked up without allocation for known names
+            std::map<std::string, std::map<std::string, TraceSummary, std::less<>>, std::less<>> timings;
+
+            std::map<std::string, TraceSummary, std::less<>> counters;
+
+            TraceBuffer(const unsigned & thread_id) :
+                thread_id(thread_id),
+                next(0)
+            {
+            }
+
+            void push(const char & phase, const char * category, const std::string & name,
+                    const double & timestamp, const double & duration, const double & value,
+                    const std::size_t & capacity)
+            {
+                if (0 == capacity)
+                    return;
+
+                if (events.size() < capacity)
+                {
+                    events.push_back(TraceEvent{ phase, category, name, timestamp, duration, value });
+                    return;
+                }
+
+                // overwrite the oldest event, reusing the storage of its name
+                TraceEvent & e = events[next];
+                e.phase = phase;
+                e.category = category;
+                e.name.assign(name);
+                e.timestamp = timestamp;
+                e.duration = duration;
+                e.value = value;
+
+                next = (next + 1) % events.size();
+            }
+
+            void clear()
+            {
+                events.clear();
+                next = 0;
+                timings.clear();
+                counters.clear();
+            }
+        };
+
+        template <typename Map_, typename Key_>
+        typename Map_::mapped_type & lookup(Map_ & map, const Key_ & key)
+        {
+            auto i = map.find(key);
+            if (map.end() == i)
+                i = map.emplace(std::string(key), typename Map_::mapped_type()).first;
+
+            return i->second;
+        }
+
+        std::string escape_json(const std::string & s)
+        {
+            std::string result;
+            result.reserve(s.size());
+
+            for (char c : s)
+            {
+                if (('"' == c) || ('\\' == c))
+                    result.append(1, '\\');
+
+                result.append(1, c);
+            }
+
+            return result;
+        }
+    }
+
+    template class InstantiationPolicy<Trace, Singleton>;
+
+    template <> struct Implementation<Trace>
+    {
+        // Guards the list of per-thread buffers only
+        Mutex mutex;
+
+        std::vector<std::shared_ptr<implementation::TraceBuffer>> buffers;
+
+        Trace::Clock::time_point epoch;
+
+        std::string filename;
+
+        std::atomic<std::size_t> capacity;
+
+        Implementation() :
+            epoch(Trace::Clock::now()),
+            capacity(implementation::default_trace_capacity)
+        {
+            const char * envvar = std::getenv("EOS_TRACE_FILE");
+            if (envvar)
+            {
+                filename = std::string(envvar);
+            }
+        }
+
+        ~Implementation()
+        {
+            implementation::trace_enabled.store(false);
+        }
+
+        implementation::TraceBuffer & buffer()
+        {
+            // Registration happens once per thread; the buffer is shared with the list
+            // of buffers such that its events survive the thread.
+            static thread_local std::shared_ptr<implementation::TraceBuffer> result;
+
+            if (! result)
+            {
+                Lock l(mutex);
+
+                result = std::make_shared<implementation::TraceBuffer>(buffers.size());
+                buffers.push_back(result);
+            }
+
+            return *result;
+        }
+
+        double microseconds(const Trace::Clock::time_point & t) const
+        {
+            return std::chrono::duration<double, std::micro>(t - epoch).count();
+        }
+    };
+
+    Trace::Trace() :
+        PrivateImplementationPattern<Trace>(new Implementation<Trace>)
+    {
+    }
+
+    Trace::~Trace()
+    {
+        if (! _imp->filename.empty())
+        {
+            try
+            {
+                dump(_imp->filename);
+            }
+            catch (Exception & e)
+            {
+                Log::instance()->message("trace.dtor", ll_error)
+                    << "Could not write trace file '" << _imp->filename << "': " << e.what();
+            }
+        }
+    }
+
+    bool
+    Trace::enabled()
+    {
+        return implementation::trace_enabled.load(std::memory_order_relaxed);
+    }
+
+    void
+    Trace::enable(const bool & enabled)
+    {
+        implementation::trace_enabled.store(enabled);
+    }
+
+    std::size_t
+    Trace::size() const
+    {
+        Lock l(_imp->mutex);
+
+        std::size_t result = 0;
+        for (const auto & b : _imp->buffers)
+        {
+            result += b->events.size();
+        }
+
+        return result;
+    }
+
+    void
+    Trace::clear()
+    {
+        Lock l(_imp->mutex);
+
+        for (auto & b : _imp->buffers)
+        {
+            b->clear();
+        }
+    }
+
+    void
+    Trace::set_capacity(const std::size_t & capacity)
+    {
+        Lock l(_imp->mutex);
+
+        _imp->capacity.store(capacity);
+
+        for (auto & b : _imp->buffers)
+        {
+            b->clear();
+            b->events.shrink_to_fit();
+        }
+    }
+
+    void
+    Trace::timing(const char * category, const std::string & name, const Clock::time_point & begin, const Clock::time_point & end)
+    {
+        if (! enabled())
+            return;
+
+        double timestamp = _imp->microseconds(begin);
+        double duration = std::chrono::duration<double, std::micro>(end - begin).count();
+
+        auto & buffer = _imp->buffer();
+        implementation::record(implementation::lookup(implementation::lookup(buffer.timings, category), name), duration * 1.0e-6);
+
+        buffer.push('X', category, name, timestamp, duration, 0.0, _imp->capacity.load(std::memory_order_relaxed));
+    }
+
+    void
+    Trace::counter(const std::string & name, const double & increment)
+    {
+        if (! enabled())
+            return;
+
+        auto & buffer = _imp->buffer();
+        auto & summary = implementation::lookup(buffer.counters, name);
+        implementation::record(summary, increment);
+
+        // counter events carry the running value per thread
+        buffer.push('C', "counter", name, _imp->microseconds(Clock::now()), 0.0, summary.total, _imp->capacity.load(std::memory_order_relaxed));
+    }
+
+    std::map<std::string, TraceSummary>
+    Trace::summary() const
+    {
+        Lock l(_imp->mutex);
+
+        std::map<std::string, TraceSummary> result;
+
+        for (const auto & b : _imp->buffers)
+        {
+            for (const auto & c : b->timings)
+            {
+                for (const auto & t : c.second)
+                {
+                    implementation::merge(result[c.first + ':' + t.first], t.second);
+                }
+            }
+
+            for (const auto & c : b->counters)
+            {
+                implementation::merge(result[c.first], c.second);
+            }
+        }
+
+        return result;
+    }
+
+    void
+    Trace::dump(const std::string & filename) const
+    {
+        std::ofstream file(filename);
+        if (! file)
+            throw InternalError("Trace::dump: Cannot open file '" + filename + "' for writing");
+
+        Lock l(_imp->mutex);
+
+        file << "{\"traceEvents\":[";
+
+        bool first = true;
+        for (const auto & b : _imp->buffers)
+        {
+            // write the events in chronological order, starting with the oldest
+            for (std::size_t i = 0, n = b->events.size() ; i < n ; ++i)
+            {
+                const auto & e = b->events[(b->next + i) % n];
+
+                if (! first)
+                    file << ',';
+
+                first = false;
+
+                file << "\n{\"ph\":\"" << e.phase << "\",\"pid\":0,\"tid\":" << b->thread_id
+                     << ",\"cat\":\"" << e.category << "\",\"name\":\"" << implementation::escape_json(e.name)
+                     << "\",\"ts\":" << e.timestamp;
+
+                if ('X' == e.phase)
+                {
+                    file << ",\"dur\":" << e.duration << '}';
+                }
+                else
+                {
+                    file << ",\"args\":{\"value\":" << e.value << "}}";
+                }
+            }
+        }
+
+        file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+}
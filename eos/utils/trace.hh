@@ -0,0 +1,192 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_UTILS_TRACE_HH
+#define EOS_GUARD_SRC_UTILS_TRACE_HH 1
+
+#include <eos/utils/instantiation_policy.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace eos
+{
+    /*!
+     * Summary of all timings or counts that have been recorded under a common name.
+     */
+    struct TraceSummary
+    {
+        /// Number of recorded timings or counter increments.
+        unsigned long count;
+
+        /// Total duration in seconds, or the sum of all counter increments.
+        double total;
+
+        /// Shortest duration in seconds, or the smallest counter increment.
+        double min;
+
+        /// Longest duration in seconds, or the largest counter increment.
+        double max;
+    };
+
+    /*!
+     * Facility to record scoped timings and counters, e.g., for the evaluation of
+     * observables or constraints, and to export them as a Chrome trace.
+     *
+     * Tracing is disabled by default, in which case recording costs a single check
+     * of an atomic flag. If the environment variable EOS_TRACE_FILE is set, tracing is enabled
+     * at startup and the trace is written to the named file at program exit.
+     *
+     * Each thread records into its own buffer, which does not require any locking.
+     * Timings and counters are aggregated per name as they are recorded, while only
+     * the most recent events are kept for the export; the memory used per thread is
+     * therefore bounded regardless of the number of recorded events.
+     */
+    class Trace :
+        public InstantiationPolicy<Trace, Singleton>,
+        public PrivateImplementationPattern<Trace>
+    {
+        private:
+            ///@name Basic Functions
+            ///@{
+            /// Constructor.
+            Trace();
+            ///@}
+
+        public:
+            friend class InstantiationPolicy<Trace, Singleton>;
+
+            typedef std::chrono::steady_clock Clock;
+
+            ///@name Basic Functions
+            ///@{
+            /// Destructor.
+            ~Trace();
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Return whether events are being recorded.
+            static bool enabled();
+
+            /// Return the number of events that are currently kept for the export, summed over all threads.
+            std::size_t size() const;
+
+            /// Enable or disable the recording of events.
+            void enable(const bool & enabled);
+
+            /// Discard all recorded events.
+            void clear();
+
+            /*!
+             * Set the number of most recent events per thread that are kept for the export.
+             * All recorded events are discarded.
+             *
+             * @param capacity The maximal number of events per thread.
+             *
+             * @note Must not be called while other threads are recording.
+             */
+            void set_capacity(const std::size_t & capacity);
+
+            /*!
+             * Record a completed timing.
+             *
+             * @param category The category of the event, e.g. 'observable' or 'constraint'.
+             * @param name     The name of the event, e.g. the observable's or constraint's name.
+             * @param begin    The point in time at which the timing began.
+             * @param end      The point in time at which the timing ended.
+             */
+            void timing(const char * category, const std::string & name, const Clock::time_point & begin, const Clock::time_point & end);
+
+            /*!
+             * Increment a counter.
+             *
+             * @param name      The name of the counter.
+             * @param increment The value by which the counter shall be incremented.
+             */
+            void counter(const std::string & name, const double & increment = 1.0);
+
+            /*!
+             * Summarise all timings and counters recorded so far, keyed by '<category>:<name>'
+             * for timings and by '<name>' for counters. The summary includes events that
+             * are no longer kept for the export.
+             *
+             * @note Must not be called while other threads are recording.
+             */
+            std::map<std::string, TraceSummary> summary() const;
+
+            /*!
+             * Write the most recent events per thread to a file in the Chrome trace event format.
+             * The result can be inspected with chrome://tracing or compatible tools.
+             *
+             * @param filename The name of the file.
+             *
+             * @note Must not be called while other threads are recording.
+             */
+            void dump(const std::string & filename) const;
+            ///@}
+    };
+
+    /*!
+     * Records the time spent in a scope if tracing is enabled.
+     */
+    class ScopedTimer
+    {
+        private:
+            const char * _category;
+
+            const std::string * _name;
+
+            Trace::Clock::time_point _begin;
+
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param category The category of the timing.
+             * @param name     The name of the timing. Must outlive the ScopedTimer.
+             */
+            ScopedTimer(const char * category, const std::string & name) :
+                _category(category),
+                _name(Trace::enabled() ? &name : nullptr)
+            {
+                if (_name)
+                    _begin = Trace::Clock::now();
+            }
+
+            /// Destructor.
+            ~ScopedTimer()
+            {
+                if (_name)
+                    Trace::instance()->timing(_category, *_name, _begin, Trace::Clock::now());
+            }
+
+            ScopedTimer(const ScopedTimer &) = delete;
+
+            ScopedTimer & operator= (const ScopedTimer &) = delete;
+            ///@}
+    };
+}
+
+#endif
@@ -0,0 +1,133 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/trace.hh>
+
+#include <fstream>
+#include <sstream>
+
+using namespace test;
+using namespace eos;
+
+class TraceTest :
+    public TestCase
+{
+    public:
+        TraceTest() :
+            TestCase("trace_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const std::string name("foo");
+
+            // nothing is recorded while disabled
+            {
+                Trace::instance()->enable(false);
+                Trace::instance()->clear();
+
+                {
+                    ScopedTimer timer("test", name);
+                }
+                Trace::instance()->counter("bar", 2.0);
+
+                TEST_CHECK(Trace::instance()->summary().empty());
+            }
+
+            // timings and counters are recorded while enabled
+            {
+                Trace::instance()->enable(true);
+                TEST_CHECK(Trace::enabled());
+
+                for (unsigned i = 0 ; i < 3 ; ++i)
+                {
+                    ScopedTimer timer("test", name);
+                }
+                Trace::instance()->counter("bar", 2.0);
+                Trace::instance()->counter("bar", 3.0);
+
+                auto summary = Trace::instance()->summary();
+                TEST_CHECK_EQUAL(2u,  summary.size());
+                TEST_CHECK_EQUAL(3u,  summary["test:foo"].count);
+                TEST_CHECK(summary["test:foo"].total >= 0.0);
+                TEST_CHECK(summary["test:foo"].min <= summary["test:foo"].max);
+                TEST_CHECK_EQUAL(2u,  summary["bar"].count);
+                TEST_CHECK_EQUAL(5.0, summary["bar"].total);
+                TEST_CHECK_EQUAL(2.0, summary["bar"].min);
+                TEST_CHECK_EQUAL(3.0, summary["bar"].max);
+            }
+
+            // export to the Chrome trace event format
+            {
+                Trace::instance()->dump("trace_TEST.json");
+                Trace::instance()->enable(false);
+
+                std::ifstream file("trace_TEST.json");
+                std::stringstream contents;
+                contents << file.rdbuf();
+
+                TEST_CHECK_EQUAL(0u, contents.str().find("{\"traceEvents\":["));
+                TEST_CHECK(std::string::npos != contents.str().find("\"ph\":\"X\",\"pid\":0,\"tid\":0,\"cat\":\"test\",\"name\":\"foo\""));
+                TEST_CHECK(std::string::npos != contents.str().find("\"ph\":\"C\",\"pid\":0,\"tid\":0,\"cat\":\"counter\",\"name\":\"bar\""));
+            }
+
+            // memory stays bounded, while the summary covers all events
+            {
+                Trace::instance()->set_capacity(16);
+                Trace::instance()->enable(true);
+                TEST_CHECK_EQUAL(0u, Trace::instance()->size());
+
+                for (unsigned i = 0 ; i < 10000 ; ++i)
+                {
+                    ScopedTimer timer("test", name);
+                    Trace::instance()->counter("bar");
+                }
+
+                TEST_CHECK_EQUAL(16u, Trace::instance()->size());
+
+                auto summary = Trace::instance()->summary();
+                TEST_CHECK_EQUAL(2u,      summary.size());
+                TEST_CHECK_EQUAL(10000u,  summary["test:foo"].count);
+                TEST_CHECK_EQUAL(10000u,  summary["bar"].count);
+                TEST_CHECK_EQUAL(10000.0, summary["bar"].total);
+
+                // the export holds the most recent events only
+                Trace::instance()->dump("trace_TEST.json");
+                Trace::instance()->enable(false);
+
+                std::ifstream file("trace_TEST.json");
+                std::stringstream contents;
+                contents << file.rdbuf();
+
+                TEST_CHECK(std::string::npos == contents.str().find("\"value\":1}"));
+                TEST_CHECK(std::string::npos != contents.str().find("\"value\":10000}"));
+
+                unsigned events = 0;
+                for (auto i = contents.str().find("\"ph\":") ; std::string::npos != i ; i = contents.str().find("\"ph\":", i + 1))
+                {
+                    ++events;
+                }
+                TEST_CHECK_EQUAL(16u, events);
+
+                Trace::instance()->set_capacity(1u << 16);
+            }
+        }
+} trace_test;
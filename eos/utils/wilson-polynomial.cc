@@ -18,10 +18,16 @@
  */
 
 #include <eos/observable.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/stringify.hh>
 #include <eos/utils/wilson-polynomial.hh>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
 
 namespace eos
 {
@@ -311,6 +317,251 @@ namespace eos
         return ObservablePtr(new WilsonPolynomialHTLikeRatio(numerator, denominator1, denominator2, parameters));
     }
 
+    /* WilsonPolynomialSurrogate */
+    template <>
+    struct Implementation<WilsonPolynomialSurrogate>
+    {
+        ObservablePtr observable;
+
+        Parameters parameters;
+
+        // All coefficients as requested by the user, kept for cloning
+        std::list<std::string> coefficient_names;
+
+        // Subset of the coefficients that the observable actually uses
+        std::list<std::string> used_coefficient_names;
+
+        std::vector<Parameter> coefficients;
+
+        // Remaining parameters, and their values for which the polynomial was last built
+        std::vector<Parameter> hadronic_parameters;
+
+        std::vector<double> hadronic_values;
+
+        double tolerance;
+
+        WilsonPolynomial polynomial;
+
+        bool built;
+
+        bool eligible;
+
+        double max_deviation;
+
+        Implementation(const ObservablePtr & observable, const std::list<std::string> & coefficient_names, const double & tolerance) :
+            observable(observable),
+            parameters(observable->parameters()),
+            coefficient_names(coefficient_names),
+            tolerance(tolerance),
+            polynomial(Constant(0.0)),
+            built(false),
+            eligible(true),
+            max_deviation(0.0)
+        {
+            std::set<Parameter::Id> used_ids;
+            for (auto i = observable->begin(), i_end = observable->end() ; i != i_end ; ++i)
+            {
+                used_ids.insert(*i);
+            }
+
+            // Observables that do not declare their parameters are assumed to use all of them
+            if (used_ids.empty())
+            {
+                for (auto p = parameters.begin(), p_end = parameters.end() ; p != p_end ; ++p)
+                {
+                    used_ids.insert(p->id());
+                }
+            }
+
+            std::set<Parameter::Id> coefficient_ids;
+            for (auto n = coefficient_names.cbegin(), n_end = coefficient_names.cend() ; n != n_end ; ++n)
+            {
+                Parameter p = parameters[*n];
+                coefficient_ids.insert(p.id());
+
+                if (used_ids.cend() == used_ids.find(p.id()))
+                    continue;
+
+                used_coefficient_names.push_back(*n);
+                coefficients.push_back(p);
+            }
+
+            for (auto i = used_ids.cbegin(), i_end = used_ids.cend() ; i != i_end ; ++i)
+            {
+                if (coefficient_ids.cend() != coefficient_ids.find(*i))
+                    continue;
+
+                hadronic_parameters.push_back(parameters[*i]);
+            }
+
+            hadronic_values.resize(hadronic_parameters.size(), std::numeric_limits<double>::quiet_NaN());
+        }
+
+        bool stale()
+        {
+            bool result = ! built;
+
+            auto v = hadronic_values.begin();
+            for (auto p = hadronic_parameters.cbegin(), p_end = hadronic_parameters.cend() ; p != p_end ; ++p, ++v)
+            {
+                double value = p->evaluate();
+                if (value == *v)
+                    continue;
+
+                *v = value;
+                result = true;
+            }
+
+            return result;
+        }
+
+        double deviation() const
+        {
+            WilsonPolynomialEvaluator evaluator;
+
+            double exact = observable->evaluate();
+            double approximation = polynomial.accept_returning<double>(evaluator);
+
+            double result = std::abs(approximation - exact);
+            if (0.0 != exact)
+                result /= std::abs(exact);
+
+            return result;
+        }
+
+        void rebuild()
+        {
+            std::vector<double> values;
+            for (auto c = coefficients.cbegin(), c_end = coefficients.cend() ; c != c_end ; ++c)
+            {
+                values.push_back(c->evaluate());
+            }
+
+            polynomial = make_polynomial(observable, used_coefficient_names);
+            built = true;
+
+            // make_polynomial resets the coefficients to their central values; validate at
+            // the current point and at a point that is not part of the probing grid
+            double result = 0.0;
+            for (auto shift : { 0.0, 0.5 })
+            {
+                for (unsigned i = 0 ; i < coefficients.size() ; ++i)
+                {
+                    coefficients[i] = values[i] + shift;
+                }
+
+                result = std::max(result, deviation());
+
+                // a NaN deviation also fails the check below
+                if (std::isnan(result))
+                    break;
+            }
+
+            for (unsigned i = 0 ; i < coefficients.size() ; ++i)
+            {
+                coefficients[i] = values[i];
+            }
+
+            max_deviation = std::max(max_deviation, result);
+
+            if (! (result <= tolerance))
+            {
+                eligible = false;
+
+                Log::instance()->message("wilson_polynomial_surrogate.rebuild", ll_warning)
+                    << "Observable '" << observable->name().full() << "' deviates from its polynomial by " << result
+                    << " (tolerance " << tolerance << "); falling back to exact evaluation";
+            }
+        }
+
+        double evaluate()
+        {
+            if (eligible && stale())
+            {
+                rebuild();
+            }
+
+            if (! eligible)
+                return observable->evaluate();
+
+            WilsonPolynomialEvaluator evaluator;
+
+            return polynomial.accept_returning<double>(evaluator);
+        }
+    };
+
+    WilsonPolynomialSurrogate::WilsonPolynomialSurrogate(const ObservablePtr & observable, const std::list<std::string> & coefficients,
+            const double & tolerance) :
+        PrivateImplementationPattern<WilsonPolynomialSurrogate>(new Implementation<WilsonPolynomialSurrogate>(observable, coefficients, tolerance))
+    {
+        uses(static_cast<const ParameterUser &>(*observable));
+        uses(static_cast<const ReferenceUser &>(*observable));
+    }
+
+    WilsonPolynomialSurrogate::~WilsonPolynomialSurrogate()
+    {
+    }
+
+    const QualifiedName &
+    WilsonPolynomialSurrogate::name() const
+    {
+        return _imp->observable->name();
+    }
+
+    double
+    WilsonPolynomialSurrogate::evaluate() const
+    {
+        return _imp->evaluate();
+    }
+
+    Kinematics
+    WilsonPolynomialSurrogate::kinematics()
+    {
+        return _imp->observable->kinematics();
+    }
+
+    Parameters
+    WilsonPolynomialSurrogate::parameters()
+    {
+        return _imp->parameters;
+    }
+
+    Options
+    WilsonPolynomialSurrogate::options()
+    {
+        return _imp->observable->options();
+    }
+
+    ObservablePtr
+    WilsonPolynomialSurrogate::clone() const
+    {
+        return ObservablePtr(new WilsonPolynomialSurrogate(_imp->observable->clone(), _imp->coefficient_names, _imp->tolerance));
+    }
+
+    ObservablePtr
+    WilsonPolynomialSurrogate::clone(const Parameters & parameters) const
+    {
+        return ObservablePtr(new WilsonPolynomialSurrogate(_imp->observable->clone(parameters), _imp->coefficient_names, _imp->tolerance));
+    }
+
+    ObservablePtr
+    WilsonPolynomialSurrogate::observable() const
+    {
+        return _imp->observable;
+    }
+
+    bool
+    WilsonPolynomialSurrogate::eligible() const
+    {
+        return _imp->eligible;
+    }
+
+    double
+    WilsonPolynomialSurrogate::max_deviation() const
+    {
+        return _imp->max_deviation;
+    }
+
     /* WilsonPolynomialCloner */
     WilsonPolynomialCloner::WilsonPolynomialCloner(const Parameters & parameters) :
         _parameters(parameters)
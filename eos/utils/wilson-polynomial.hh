@@ -22,6 +22,7 @@
 
 #include <eos/observable.hh>
 #include <eos/utils/one-of.hh>
+#include <eos/utils/private_implementation_pattern.hh>
 
 #include <list>
 #include <string>
@@ -73,6 +74,55 @@ namespace eos
     ObservablePtr make_polynomial_ht_like_ratio(const WilsonPolynomial & numerator, const WilsonPolynomial & denominator,
             const WilsonPolynomial & denominator2, const Parameters & parameters);
 
+    /*!
+     * Observable that replaces an expensive observable by its WilsonPolynomial
+     * in a given set of Wilson coefficients.
+     *
+     * The polynomial is built lazily and rebuilt whenever any of the remaining
+     * (i.e., hadronic or nuisance) parameters used by the underlying observable
+     * change their value. As long as only the Wilson coefficients vary, each
+     * evaluation costs only the evaluation of the polynomial.
+     *
+     * Every (re)build is validated against the underlying observable at the current
+     * parameter point and at a shifted point in the Wilson coefficients. If the
+     * relative deviation exceeds the tolerance, the observable is considered
+     * ineligible and all further evaluations are passed on to the underlying observable.
+     */
+    class WilsonPolynomialSurrogate :
+        public Observable,
+        public PrivateImplementationPattern<WilsonPolynomialSurrogate>
+    {
+        public:
+            /*!
+             * Constructor.
+             *
+             * @param observable   The observable that shall be replaced.
+             * @param coefficients The names of the Wilson coefficients in which the observable is polynomial.
+             * @param tolerance    The maximal relative deviation that is accepted upon validation.
+             */
+            WilsonPolynomialSurrogate(const ObservablePtr & observable, const std::list<std::string> & coefficients,
+                    const double & tolerance);
+
+            ~WilsonPolynomialSurrogate();
+
+            virtual const QualifiedName & name() const;
+            virtual double evaluate() const;
+            virtual Kinematics kinematics();
+            virtual Parameters parameters();
+            virtual Options options();
+            virtual ObservablePtr clone() const;
+            virtual ObservablePtr clone(const Parameters & parameters) const;
+
+            /// Retrieve the underlying observable.
+            ObservablePtr observable() const;
+
+            /// Return whether the polynomial is used, i.e., whether all validations so far have passed.
+            bool eligible() const;
+
+            /// Retrieve the largest relative deviation between polynomial and observable found during validation.
+            double max_deviation() const;
+    };
+
     class WilsonPolynomialCloner
     {
         private:
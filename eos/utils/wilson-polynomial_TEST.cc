@@ -180,3 +180,110 @@ class WilsonPolynomialClonerTest :
             TEST_CHECK_EQUAL(p.accept_returning<double>(evaluator), c.accept_returning<double>(evaluator));
         }
 } wilson_polynomial_cloner_test;
+
+struct WilsonPolynomialSurrogateTestObservable :
+    public Observable
+{
+    QualifiedName n;
+    Parameters p;
+    Kinematics k;
+    UsedParameter m_b;
+    UsedParameter re_c9;
+    UsedParameter re_c10;
+    bool cubic;
+    std::shared_ptr<unsigned> evaluations;
+
+    WilsonPolynomialSurrogateTestObservable(const Parameters & p, const Kinematics & k, const bool & cubic) :
+        n("WilsonPolynomial::SurrogateTestObservable"),
+        p(p),
+        k(k),
+        m_b(p["mass::b(MSbar)"], *this),
+        re_c9(p["b->smumu::Re{c9}"], *this),
+        re_c10(p["b->smumu::Re{c10}"], *this),
+        cubic(cubic),
+        evaluations(new unsigned(0))
+    {
+    }
+
+    virtual const QualifiedName & name() const { return n; }
+    virtual Parameters parameters() { return p; }
+    virtual Kinematics kinematics() { return k; }
+    virtual Options options() { return Options(); }
+    virtual ObservablePtr clone() const { return ObservablePtr(new WilsonPolynomialSurrogateTestObservable(p.clone(), k.clone(), cubic)); }
+    virtual ObservablePtr clone(const Parameters & p) const { return ObservablePtr(new WilsonPolynomialSurrogateTestObservable(p, k.clone(), cubic)); }
+
+    virtual double evaluate() const
+    {
+        ++(*evaluations);
+
+        double result = m_b * (1.0 + 0.3 * re_c9 + re_c9 * re_c9 - 0.7 * re_c9 * re_c10 + 2.0 * re_c10 * re_c10);
+
+        if (cubic)
+            result += re_c9 * re_c9 * re_c9;
+
+        return result;
+    }
+};
+
+class WilsonPolynomialSurrogateTest :
+    public TestCase
+{
+    public:
+        WilsonPolynomialSurrogateTest() :
+            TestCase("wilson_polynomial_surrogate_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1e-10;
+            static const std::list<std::string> coefficients{ "b->smumu::Re{c9}", "b->smumu::Re{c10}", "b->smumu::Im{c10}" };
+
+            // polynomial observable
+            {
+                Parameters parameters = Parameters::Defaults();
+                auto o = std::make_shared<WilsonPolynomialSurrogateTestObservable>(parameters, Kinematics(), false);
+                WilsonPolynomialSurrogate s(o, coefficients, 1e-8);
+
+                parameters["b->smumu::Re{c9}"] = 3.1;
+                parameters["b->smumu::Re{c10}"] = -4.2;
+                TEST_CHECK_NEARLY_EQUAL(o->evaluate(), s.evaluate(), eps);
+                TEST_CHECK(s.eligible());
+                TEST_CHECK(s.max_deviation() < 1e-8);
+
+                // the first evaluation builds the polynomial, and leaves the coefficients unchanged
+                TEST_CHECK_EQUAL(3.1,  parameters["b->smumu::Re{c9}"]());
+                TEST_CHECK_EQUAL(-4.2, parameters["b->smumu::Re{c10}"]());
+
+                // changing only the Wilson coefficients does not evaluate the observable
+                unsigned evaluations = *o->evaluations;
+                parameters["b->smumu::Re{c9}"] = -0.4;
+                parameters["b->smumu::Re{c10}"] = 1.7;
+                double value = s.evaluate();
+                TEST_CHECK_EQUAL(evaluations, *o->evaluations);
+                TEST_CHECK_NEARLY_EQUAL(o->evaluate(), value, eps);
+
+                // changing a hadronic parameter triggers a rebuild
+                evaluations = *o->evaluations;
+                parameters["mass::b(MSbar)"] = 4.5;
+                value = s.evaluate();
+                TEST_CHECK(evaluations < *o->evaluations);
+                TEST_CHECK_NEARLY_EQUAL(o->evaluate(), value, eps);
+            }
+
+            // non-polynomial observable
+            {
+                Parameters parameters = Parameters::Defaults();
+                auto o = std::make_shared<WilsonPolynomialSurrogateTestObservable>(parameters, Kinematics(), true);
+                WilsonPolynomialSurrogate s(o, coefficients, 1e-8);
+
+                parameters["b->smumu::Re{c9}"] = 3.1;
+                TEST_CHECK_NEARLY_EQUAL(o->evaluate(), s.evaluate(), eps);
+                TEST_CHECK(! s.eligible());
+                TEST_CHECK(s.max_deviation() > 1e-8);
+
+                parameters["b->smumu::Re{c9}"] = -2.3;
+                TEST_CHECK_NEARLY_EQUAL(o->evaluate(), s.evaluate(), eps);
+            }
+        }
+} wilson_polynomial_surrogate_test;
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2019 Danny van Dyk
  * Copyright (c) 2010 Christoph Bobeth
  *
  * This file is part of the EOS project. EOS is free software;
@@ -18,10 +18,11 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-#include <eos/utils/matrix.hh>
-#include <eos/utils/model.hh>
+#include <eos/utils/exception.hh>
 #include <eos/utils/power_of.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qcd.hh>
+#include <eos/utils/stringify.hh>
 #include <eos/utils/wilson_coefficients.hh>
 
 #include <array>
@@ -38,16 +39,22 @@ namespace eos
         _scalar_tensor_coefficients.fill(0.0);
     }
 
-    WilsonCoefficients<BToS> evolve(const std::array<complex<double>, 15> & wc_qcd_0,
-            const std::array<complex<double>, 15> & wc_qcd_1,
-            const std::array<complex<double>, 15> & wc_qcd_2,
-            const double & alpha_s_0, const double & alpha_s, const double & nf, const QCD::BetaFunction & beta)
+    namespace rgeimplementation
     {
-        using std::array;
-        typedef array<array<complex<double>, 15>, 15> Matrix;
+        typedef std::array<std::array<double, 15>, 15> RealMatrix;
+
+        /*
+         * Complex-valued vector with its real and imaginary parts stored separately,
+         * so that products with the real-valued matrices below vectorise.
+         */
+        struct SplitVector
+        {
+            std::array<double, 15> re;
+            std::array<double, 15> im;
+        };
 
         // diagonalisation matrix of gamma_qcd_0
-        static const Matrix V
+        constexpr RealMatrix V
         {{
             {{  0, 0, 0, 0, 0.9409878113450298, -0.007502261560628922, 0, 0, 0, 0, -0.00034192561587966793, 0.002764024590670891, -0.8282780998098398, 0, 0 }},
             {{  0, 0, 0, 0, -0.3136626037816766, 0.0025007538535429742, 0, 0, 0, 0, -0.00022795041058644593, 0.0018426830604472593, -0.5521853998732265, 0, 0}},
@@ -69,7 +76,7 @@ namespace eos
         }};
 
         // inverse of diagonalisation matrix
-        static const Matrix V_inverse
+        constexpr RealMatrix V_inverse
         {{
             {{0, 0, 0, 0, 0, 0, 1.2078355801181289, 1.6104474401575037, 4.83134232047253, 6.441789760630009, 0, 0, 0, 0, 0 }},
             {{0.11836177258012, -0.04688112148115692, 0.4728978854883222, 0.140543610478892, 3.57455465561306, -1.5186169423711846, -0.13622538926921474, -1.1495429772208166, 4.200426850366367, -5.351534257227639, -0.10164668578015348, 0, 0, 1, 0 }},
@@ -89,7 +96,7 @@ namespace eos
             {{0, 0, 0, 0, 0, 0, -1.5078942929387142, 0.25131571548978476, -6.0315771717548765, 1.005262861959134, 0, 0, 0, 0, 0 }}
         }};
 
-        static const Matrix G_qcd_1
+        constexpr RealMatrix G_qcd_1
         {{
             {{ -257.778, 0., 0., 0., 0., -176.973, 0., 0., 0., 0., 98.4601, 0., 0., 0., -16.0202 }},
             {{ 123.984, -77.3333, 0., 56.1243, 6.05517, 153.89, -20.1579, 105.229, 0., 0., -67.1537, -4.22676, -6.90668, -0.494136, 11.9667 }},
@@ -108,143 +115,362 @@ namespace eos
             {{ -3.12107, 0., 0., 0., 0., 190.81, 0., 0., 0., 0., -175.6, 0., 0., 0., 108.722 }}
         }};
 
-        static const double zeta_3 = 1.2020569031595943;
-        double u11 = -1927.0 / 2 + 257.0 / 9 * nf + 40.0 / 9 * nf * nf + (224 + 160.0 / 3 * nf) * zeta_3;
-        double u12 = 475.0 / 9 + 362.0 / 27 * nf - 40.0 / 27 * nf * nf - (896.0 / 3 + 320.0 / 9 * nf) * zeta_3;
-        double u21 = 307.0 / 2 + 361.0 / 3 * nf - 20.0 / 3 * nf * nf - (1344 + 160* nf) * zeta_3;
-        double u22 = 1298.0 / 3 - 76.0 / 3 * nf - 224* zeta_3;
-        double u13 = 269107.0 / 13122 - 2288.0 / 729 * nf - 1360.0 / 81* zeta_3;
-        double u14 = -2425817.0 / 13122 + 30815.0 / 4374 * nf - 776.0 / 81* zeta_3;
-        double u23 = 69797.0 / 2187 + 904.0 / 243 * nf + 2720.0 / 27* zeta_3;
-        double u24 = 1457549.0 / 8748 - 22067.0 / 729 * nf - 2768.0 / 27* zeta_3;
-        double u33 = -4203068.0 / 2187 + 14012.0 / 243 * nf - 608.0 / 27* zeta_3;
-        double u34 = -18422762.0 / 2187 + 888605.0 / 2916 * nf + 272.0 / 27 * nf * nf
-                    + (39824.0 / 27 + 160. * nf) * zeta_3;
-        double u43 = -5875184.0 / 6561 + 217892.0 / 2187 * nf + 472.0 / 81 * nf * nf
-                    + (27520.0 / 81 + 1360.0 / 9 * nf) * zeta_3;
-        double u44 = -70274587.0 / 13122 + 8860733.0 / 17496 * nf - 4010.0 / 729 * nf * nf
-                    + (16592.0 / 81 + 2512.0 / 27 * nf) * zeta_3;
-        double u53 = -194951552.0 / 2187 + 358672.0 / 81 * nf - 2144.0 / 81 * nf * nf + 87040.0 / 27* zeta_3;
-        double u54 = -130500332.0 / 2187 - 2949616.0 / 729 * nf + 3088.0 / 27 * nf * nf
-                    + (238016.0 / 27 + 640. * nf) * zeta_3;
-        double u63 = 162733912.0 / 6561 - 2535466.0 / 2187 * nf + 17920.0 / 243 * nf * nf
-                    + (174208.0 / 81 + 12160.0 / 9 * nf) * zeta_3;
-        double u64 = 13286236.0 / 6561 - 1826023.0 / 4374 * nf - 159548.0 / 729 * nf * nf
-                    - (24832.0 / 81 + 9440.0 / 27 * nf) * zeta_3;
-        double u15 = -343783.0 / 52488 + 392.0 / 729 * nf + 124.0 / 81* zeta_3;
-        double u16 = -37573.0 / 69984 + 35.0 / 972 * nf + 100.0 / 27* zeta_3;
-        double u25 = -37889.0 / 8748 - 28.0 / 243 * nf - 248.0 / 27* zeta_3;
-        double u26 = 366919.0 / 11664 - 35.0 / 162 * nf - 110.0 / 9* zeta_3;
-        double u35 = 674281.0 / 4374 - 1352.0 / 243 * nf - 496.0 / 27* zeta_3;
-        double u36 = 9284531.0 / 11664 - 2798.0 / 81 * nf - 26.0 / 27* nf * nf
-                    - (1921.0 / 9 + 20* nf) * zeta_3;
-        double u45 = 2951809.0 / 52488 - 31175.0 / 8748 * nf - 52.0 / 81* nf * nf
-                    - (3154.0 / 81 + 136.0 / 9* nf) * zeta_3;
-        double u46 = 3227801.0 / 8748 - 105293.0 / 11664 * nf - 65.0 / 54* nf * nf
-                    + (200.0 / 27 - 220.0 / 9* nf) * zeta_3;
-        double u55 = 14732222.0 / 2187 - 27428.0 / 81 * nf + 272.0 / 81* nf * nf
-                    - 13984.0 / 27* zeta_3;
-        double u56 = 16521659.0 / 2916 + 8081.0 / 54 * nf - 316.0 / 27* nf * nf
-                    - (22420.0 / 9 + 200* nf) * zeta_3;
-        double u65 = -22191107.0 / 13122 + 395783.0 / 4374 * nf - 1720.0 / 243* nf * nf
-                    - (33832.0 / 81 + 1360.0 / 9 * nf) * zeta_3;
-        double u66 = -32043361.0 / 8748 + 3353393.0 / 5832 * nf - 533.0 / 81* nf * nf
-                    + (9248.0 / 27 - 1120.0 / 9* nf) * zeta_3;
-        static const double u17 = -13234.0 / 2187;
-        static const double u18 = 13957.0 / 2916;
-        static const double u19 = -1359190.0 / 19683 + 6976.0 / 243 * zeta_3;
-        static const double u27 = 20204.0 / 729;
-        static const double u28 = 14881.0 / 972;
-        static const double u29 = -229696.0 / 6561 - 3584.0 / 81 * zeta_3;
-        static const double u37 = 92224.0 / 729;
-        static const double u38 = 66068.0 / 243;
-        static const double u39 = -1290092.0 / 6561 + 3200.0 / 81 * zeta_3;
-        static const double u47 = -184190.0 / 2187;
-        static const double u48 = -1417901.0 / 5832;
-        static const double u49 = -819971.0 / 19683 - 19936.0 / 243 * zeta_3;
-        static const double u57 = 1571264.0 / 729;
-        static const double u58 = 3076372.0 / 243;
-        static const double u59 = -16821944.0 / 6561 + 30464.0 / 81 * zeta_3;
-        static const double u67 = -1792768.0 / 2187;
-        static const double u68 = -3029846.0 / 729;
-        static const double u69 = -17787368.0 / 19683 - 286720.0 / 243 * zeta_3;
-        static const double u99 = -9769.0 / 27;
-        Matrix gamma_qcd_2_transposed
-        {{
-            {{ u11, u21, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ u12, u22, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ u13, u23, u33, u43, u53, u63, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ u14, u24, u34, u44, u54, u64, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ u15, u25, u35, u45, u55, u65, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ u16, u26, u36, u46, u56, u66, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ u17, u27, u37, u47, u57, u67, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ u18, u28, u38, u48, u58, u68, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
-            {{ u19, u29, u39, u49, u59, u69, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, u99, 0.0 }},
-            {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, u99 }},
-        }};
-        Matrix G_qcd_2 = V_inverse * gamma_qcd_2_transposed * V;
-
-        static const array<complex<double>, 15> gamma_qcd_0_eigenvalues
+        constexpr std::array<double, 15> gamma_qcd_0_eigenvalues
         {{
             -16.000000000000000, -15.3333333333333334, -15.333333333333334, -13.790720905057988, -8.000000000000005,
             - 7.999999999999997, - 6.4858257980688645, + 6.265491004149404, - 6.000000000000000, -4.666666666666667,
             + 4.000000000000004, + 4.0000000000000000, + 3.999999999999999, + 2.233277921199660, +2.000000000000003
         }};
 
-        WilsonCoefficients<BToS> result;
-        result._alpha_s = alpha_s;
-        complex<double> eta = alpha_s_0 / alpha_s;
+        // y = m * x
+        inline void multiply(const RealMatrix & m, const SplitVector & x, SplitVector & y)
+        {
+            for (unsigned i(0) ; i < 15 ; ++i)
+            {
+                double re = 0.0, im = 0.0;
+                for (unsigned j(0) ; j < 15 ; ++j)
+                {
+                    re += m[i][j] * x.re[j];
+                    im += m[i][j] * x.im[j];
+                }
+
+                y.re[i] = re;
+                y.im[i] = im;
+            }
+        }
 
-        array<complex<double>, 15> a;
-        Matrix H_qcd_0, H_qcd_1, H_qcd_2;
-        for (unsigned i(0) ; i < a.size() ; ++i)
+        // z = x - m * y
+        inline void multiply_subtract(const SplitVector & x, const RealMatrix & m, const SplitVector & y, SplitVector & z)
         {
-            a[i] = gamma_qcd_0_eigenvalues[i] / 2.0 / beta[0];
+            SplitVector t;
+            multiply(m, y, t);
+
+            for (unsigned i(0) ; i < 15 ; ++i)
+            {
+                z.re[i] = x.re[i] - t.re[i];
+                z.im[i] = x.im[i] - t.im[i];
+            }
         }
 
-        for (unsigned i(0) ; i < a.size() ; ++i)
+        // r = x * y
+        inline RealMatrix multiply(const RealMatrix & x, const RealMatrix & y)
         {
-            for (unsigned j(0) ; j < a.size() ; ++j)
+            RealMatrix r;
+            for (unsigned i(0) ; i < 15 ; ++i)
             {
-                H_qcd_0[i][j] = 0.0;
-                H_qcd_1[i][j] = -G_qcd_1[i][j] / (2.0 * beta[0]) / (1.0 + a[i] - a[j]);
+                r[i].fill(0.0);
+                for (unsigned k(0) ; k < 15 ; ++k)
+                {
+                    for (unsigned j(0) ; j < 15 ; ++j)
+                    {
+                        r[i][j] += x[i][k] * y[k][j];
+                    }
+                }
             }
-            H_qcd_0[i][i] = std::pow(eta, a[i]);
-            H_qcd_1[i][i] += beta[1] / beta[0] * a[i];
+
+            return r;
         }
 
-        // Need complete H_qcd_1 to compute H_qcd_2!
-        for (unsigned i(0) ; i < a.size() ; ++i)
+        inline SplitVector split(const std::array<complex<double>, 15> & x)
         {
-            for (unsigned j(0) ; j < a.size() ; ++j)
+            SplitVector result;
+            for (unsigned i(0) ; i < 15 ; ++i)
             {
-                H_qcd_2[i][j] = -G_qcd_2[i][j] / (2.0 * beta[0]) / (2.0 + a[i] - a[j]);
-                H_qcd_2[i][j] += -beta[1] / beta[0] * (1.0 + a[i] - a[j]) / (2.0 + a[i] - a[j]) * H_qcd_1[i][j];
+                result.re[i] = real(x[i]);
+                result.im[i] = imag(x[i]);
+            }
+
+            return result;
+        }
+    }
+
+    template <>
+    struct Implementation<WilsonCoefficientsEvolution<BToS>>
+    {
+        typedef rgeimplementation::RealMatrix RealMatrix;
+        typedef rgeimplementation::SplitVector SplitVector;
 
-                for (unsigned k(0) ; k < a.size() ; ++k)
+        // the exponents of eta in H_qcd_0
+        std::array<double, 15> a;
+
+        // H_qcd_1, H_qcd_2, and H_qcd_2 - H_qcd_1 * H_qcd_1 in the eigenbasis of gamma_qcd_0
+        RealMatrix H_qcd_1, H_qcd_2, K_qcd_2;
+
+        /*
+         * The initial scale Wilson coefficients, rotated into the eigenbasis of gamma_qcd_0 and
+         * combined such that no quantity that is independent of the low scale is computed twice.
+         */
+        struct Projections
+        {
+            SplitVector y_0, d_1, d_2;
+        };
+
+        Implementation(const double & nf, const QCD::BetaFunction & beta)
+        {
+            using namespace rgeimplementation;
+
+            static const double zeta_3 = 1.2020569031595943;
+            double u11 = -1927.0 / 2 + 257.0 / 9 * nf + 40.0 / 9 * nf * nf + (224 + 160.0 / 3 * nf) * zeta_3;
+            double u12 = 475.0 / 9 + 362.0 / 27 * nf - 40.0 / 27 * nf * nf - (896.0 / 3 + 320.0 / 9 * nf) * zeta_3;
+            double u21 = 307.0 / 2 + 361.0 / 3 * nf - 20.0 / 3 * nf * nf - (1344 + 160* nf) * zeta_3;
+            double u22 = 1298.0 / 3 - 76.0 / 3 * nf - 224* zeta_3;
+            double u13 = 269107.0 / 13122 - 2288.0 / 729 * nf - 1360.0 / 81* zeta_3;
+            double u14 = -2425817.0 / 13122 + 30815.0 / 4374 * nf - 776.0 / 81* zeta_3;
+            double u23 = 69797.0 / 2187 + 904.0 / 243 * nf + 2720.0 / 27* zeta_3;
+            double u24 = 1457549.0 / 8748 - 22067.0 / 729 * nf - 2768.0 / 27* zeta_3;
+            double u33 = -4203068.0 / 2187 + 14012.0 / 243 * nf - 608.0 / 27* zeta_3;
+            double u34 = -18422762.0 / 2187 + 888605.0 / 2916 * nf + 272.0 / 27 * nf * nf
+                        + (39824.0 / 27 + 160. * nf) * zeta_3;
+            double u43 = -5875184.0 / 6561 + 217892.0 / 2187 * nf + 472.0 / 81 * nf * nf
+                        + (27520.0 / 81 + 1360.0 / 9 * nf) * zeta_3;
+            double u44 = -70274587.0 / 13122 + 8860733.0 / 17496 * nf - 4010.0 / 729 * nf * nf
+                        + (16592.0 / 81 + 2512.0 / 27 * nf) * zeta_3;
+            double u53 = -194951552.0 / 2187 + 358672.0 / 81 * nf - 2144.0 / 81 * nf * nf + 87040.0 / 27* zeta_3;
+            double u54 = -130500332.0 / 2187 - 2949616.0 / 729 * nf + 3088.0 / 27 * nf * nf
+                        + (238016.0 / 27 + 640. * nf) * zeta_3;
+            double u63 = 162733912.0 / 6561 - 2535466.0 / 2187 * nf + 17920.0 / 243 * nf * nf
+                        + (174208.0 / 81 + 12160.0 / 9 * nf) * zeta_3;
+            double u64 = 13286236.0 / 6561 - 1826023.0 / 4374 * nf - 159548.0 / 729 * nf * nf
+                        - (24832.0 / 81 + 9440.0 / 27 * nf) * zeta_3;
+            double u15 = -343783.0 / 52488 + 392.0 / 729 * nf + 124.0 / 81* zeta_3;
+            double u16 = -37573.0 / 69984 + 35.0 / 972 * nf + 100.0 / 27* zeta_3;
+            double u25 = -37889.0 / 8748 - 28.0 / 243 * nf - 248.0 / 27* zeta_3;
+            double u26 = 366919.0 / 11664 - 35.0 / 162 * nf - 110.0 / 9* zeta_3;
+            double u35 = 674281.0 / 4374 - 1352.0 / 243 * nf - 496.0 / 27* zeta_3;
+            double u36 = 9284531.0 / 11664 - 2798.0 / 81 * nf - 26.0 / 27* nf * nf
+                        - (1921.0 / 9 + 20* nf) * zeta_3;
+            double u45 = 2951809.0 / 52488 - 31175.0 / 8748 * nf - 52.0 / 81* nf * nf
+                        - (3154.0 / 81 + 136.0 / 9* nf) * zeta_3;
+            double u46 = 3227801.0 / 8748 - 105293.0 / 11664 * nf - 65.0 / 54* nf * nf
+                        + (200.0 / 27 - 220.0 / 9* nf) * zeta_3;
+            double u55 = 14732222.0 / 2187 - 27428.0 / 81 * nf + 272.0 / 81* nf * nf
+                        - 13984.0 / 27* zeta_3;
+            double u56 = 16521659.0 / 2916 + 8081.0 / 54 * nf - 316.0 / 27* nf * nf
+                        - (22420.0 / 9 + 200* nf) * zeta_3;
+            double u65 = -22191107.0 / 13122 + 395783.0 / 4374 * nf - 1720.0 / 243* nf * nf
+                        - (33832.0 / 81 + 1360.0 / 9 * nf) * zeta_3;
+            double u66 = -32043361.0 / 8748 + 3353393.0 / 5832 * nf - 533.0 / 81* nf * nf
+                        + (9248.0 / 27 - 1120.0 / 9* nf) * zeta_3;
+            static const double u17 = -13234.0 / 2187;
+            static const double u18 = 13957.0 / 2916;
+            static const double u19 = -1359190.0 / 19683 + 6976.0 / 243 * zeta_3;
+            static const double u27 = 20204.0 / 729;
+            static const double u28 = 14881.0 / 972;
+            static const double u29 = -229696.0 / 6561 - 3584.0 / 81 * zeta_3;
+            static const double u37 = 92224.0 / 729;
+            static const double u38 = 66068.0 / 243;
+            static const double u39 = -1290092.0 / 6561 + 3200.0 / 81 * zeta_3;
+            static const double u47 = -184190.0 / 2187;
+            static const double u48 = -1417901.0 / 5832;
+            static const double u49 = -819971.0 / 19683 - 19936.0 / 243 * zeta_3;
+            static const double u57 = 1571264.0 / 729;
+            static const double u58 = 3076372.0 / 243;
+            static const double u59 = -16821944.0 / 6561 + 30464.0 / 81 * zeta_3;
+            static const double u67 = -1792768.0 / 2187;
+            static const double u68 = -3029846.0 / 729;
+            static const double u69 = -17787368.0 / 19683 - 286720.0 / 243 * zeta_3;
+            static const double u99 = -9769.0 / 27;
+            RealMatrix gamma_qcd_2_transposed
+            {{
+                {{ u11, u21, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ u12, u22, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ u13, u23, u33, u43, u53, u63, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ u14, u24, u34, u44, u54, u64, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ u15, u25, u35, u45, u55, u65, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ u16, u26, u36, u46, u56, u66, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ u17, u27, u37, u47, u57, u67, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ u18, u28, u38, u48, u58, u68, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }},
+                {{ u19, u29, u39, u49, u59, u69, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, u99, 0.0 }},
+                {{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, u99 }},
+            }};
+            const RealMatrix G_qcd_2 = multiply(multiply(V_inverse, gamma_qcd_2_transposed), V);
+
+            for (unsigned i(0) ; i < a.size() ; ++i)
+            {
+                a[i] = gamma_qcd_0_eigenvalues[i] / 2.0 / beta[0];
+            }
+
+            for (unsigned i(0) ; i < a.size() ; ++i)
+            {
+                for (unsigned j(0) ; j < a.size() ; ++j)
                 {
-                    H_qcd_2[i][j] += (1.0 + a[i] - a[k]) / (2.0 + a[i] - a[j]) * H_qcd_1[i][k] * H_qcd_1[k][j];
+                    H_qcd_1[i][j] = -G_qcd_1[i][j] / (2.0 * beta[0]) / (1.0 + a[i] - a[j]);
                 }
+                H_qcd_1[i][i] += beta[1] / beta[0] * a[i];
             }
 
-            H_qcd_2[i][i] += beta[2] / 2.0 / beta[0] * a[i];
+            // Need complete H_qcd_1 to compute H_qcd_2!
+            const RealMatrix H_qcd_1_squared = multiply(H_qcd_1, H_qcd_1);
+            for (unsigned i(0) ; i < a.size() ; ++i)
+            {
+                for (unsigned j(0) ; j < a.size() ; ++j)
+                {
+                    H_qcd_2[i][j] = -G_qcd_2[i][j] / (2.0 * beta[0]) / (2.0 + a[i] - a[j]);
+                    H_qcd_2[i][j] += -beta[1] / beta[0] * (1.0 + a[i] - a[j]) / (2.0 + a[i] - a[j]) * H_qcd_1[i][j];
+
+                    for (unsigned k(0) ; k < a.size() ; ++k)
+                    {
+                        H_qcd_2[i][j] += (1.0 + a[i] - a[k]) / (2.0 + a[i] - a[j]) * H_qcd_1[i][k] * H_qcd_1[k][j];
+                    }
+                }
+
+                H_qcd_2[i][i] += beta[2] / 2.0 / beta[0] * a[i];
+            }
+
+            for (unsigned i(0) ; i < a.size() ; ++i)
+            {
+                for (unsigned j(0) ; j < a.size() ; ++j)
+                {
+                    K_qcd_2[i][j] = H_qcd_2[i][j] - H_qcd_1_squared[i][j];
+                }
+            }
         }
 
-        Matrix U_qcd_0 = V * H_qcd_0 * V_inverse;
-        Matrix U_qcd_1 = V * ((H_qcd_1 * H_qcd_0) + (-eta) * (H_qcd_0 * H_qcd_1)) * V_inverse;
-        Matrix U_qcd_2 = V * (H_qcd_2 * H_qcd_0 + (-eta) * H_qcd_1 * H_qcd_0 * H_qcd_1 + (-eta*eta) * H_qcd_0 * (H_qcd_2 - H_qcd_1 * H_qcd_1)) * V_inverse;
-        complex<double> a_s = alpha_s / (4 * M_PI);
-        array<complex<double>, 15> result_qcd_0 = U_qcd_0 * wc_qcd_0;
-        array<complex<double>, 15> result_qcd_1 = U_qcd_1 * wc_qcd_0 + eta * (U_qcd_0 * wc_qcd_1);
-        array<complex<double>, 15> result_qcd_2 = U_qcd_2 * wc_qcd_0 + eta * (U_qcd_1 * wc_qcd_1) + power_of<2>(eta) * (U_qcd_0 * wc_qcd_2);
+        /*
+         * With y_n = V^-1 * wc_qcd_n and H_qcd_0 = diag(e), e_i = eta^a_i, [BMU1999], Eq. (25) yields
+         *
+         *   result = V * (p + a_s * (H_qcd_1 * p + eta * e o d_1)
+         *                   + a_s^2 * (H_qcd_2 * p + eta * H_qcd_1 * (e o d_1) + eta^2 * e o d_2)),
+         *
+         * where p = e o y_0, d_1 = y_1 - H_qcd_1 * y_0, d_2 = y_2 - K_qcd_2 * y_0 - H_qcd_1 * y_1, and
+         * 'o' denotes the element-wise product. Only p and the factors e depend on the low scale.
+         */
+        Projections project(const std::array<complex<double>, 15> & wc_qcd_0,
+                const std::array<complex<double>, 15> & wc_qcd_1,
+                const std::array<complex<double>, 15> & wc_qcd_2) const
+        {
+            using namespace rgeimplementation;
+
+            Projections result;
+            SplitVector y_1, y_2, t;
 
-        result._sm_like_coefficients = result_qcd_0 + a_s * result_qcd_1 + power_of<2>(a_s) * result_qcd_2;
+            multiply(V_inverse, split(wc_qcd_0), result.y_0);
+            multiply(V_inverse, split(wc_qcd_1), y_1);
+            multiply(V_inverse, split(wc_qcd_2), y_2);
+
+            multiply_subtract(y_1, H_qcd_1, result.y_0, result.d_1);
+            multiply_subtract(y_2, K_qcd_2, result.y_0, t);
+            multiply_subtract(t, H_qcd_1, y_1, result.d_2);
+
+            return result;
+        }
+
+        WilsonCoefficients<BToS> evolve(const Projections & projections, const double & alpha_s_0, const double & alpha_s) const
+        {
+            using namespace rgeimplementation;
+
+            const double eta = alpha_s_0 / alpha_s;
+            const double a_s = alpha_s / (4.0 * M_PI);
+            const double c_1 = a_s * eta, c_2 = power_of<2>(a_s * eta);
+
+            // u = a_s * p + a_s^2 * eta * e o d_1, z = p + a_s * eta * e o d_1 + a_s^2 * eta^2 * e o d_2
+            SplitVector p, u, z, h_1_u, h_2_p;
+            for (unsigned i(0) ; i < 15 ; ++i)
+            {
+                const double e = std::pow(eta, a[i]);
+
+                p.re[i] = e * projections.y_0.re[i];
+                p.im[i] = e * projections.y_0.im[i];
+
+                const double d_1_re = e * projections.d_1.re[i], d_1_im = e * projections.d_1.im[i];
+                u.re[i] = a_s * p.re[i] + a_s * c_1 * d_1_re;
+                u.im[i] = a_s * p.im[i] + a_s * c_1 * d_1_im;
+                z.re[i] = p.re[i] + c_1 * d_1_re + c_2 * e * projections.d_2.re[i];
+                z.im[i] = p.im[i] + c_1 * d_1_im + c_2 * e * projections.d_2.im[i];
+            }
+
+            multiply(H_qcd_1, u, h_1_u);
+            multiply(H_qcd_2, p, h_2_p);
+
+            const double a_s_squared = power_of<2>(a_s);
+            for (unsigned i(0) ; i < 15 ; ++i)
+            {
+                z.re[i] += h_1_u.re[i] + a_s_squared * h_2_p.re[i];
+                z.im[i] += h_1_u.im[i] + a_s_squared * h_2_p.im[i];
+            }
+
+            SplitVector r;
+            multiply(V, z, r);
+
+            WilsonCoefficients<BToS> result;
+            result._alpha_s = alpha_s;
+            for (unsigned i(0) ; i < 15 ; ++i)
+            {
+                result._sm_like_coefficients[i] = complex<double>(r.re[i], r.im[i]);
+            }
+
+            return result;
+        }
+    };
+
+    WilsonCoefficientsEvolution<BToS>::WilsonCoefficientsEvolution(const double & nf, const QCD::BetaFunction & beta) :
+        PrivateImplementationPattern<WilsonCoefficientsEvolution<BToS>>(new Implementation<WilsonCoefficientsEvolution<BToS>>(nf, beta))
+    {
+    }
+
+    WilsonCoefficientsEvolution<BToS>::~WilsonCoefficientsEvolution()
+    {
+    }
+
+    WilsonCoefficients<BToS>
+    WilsonCoefficientsEvolution<BToS>::evolve(const std::array<complex<double>, 15> & wc_qcd_0,
+            const std::array<complex<double>, 15> & wc_qcd_1,
+            const std::array<complex<double>, 15> & wc_qcd_2,
+            const double & alpha_s_0, const double & alpha_s) const
+    {
+        return _imp->evolve(_imp->project(wc_qcd_0, wc_qcd_1, wc_qcd_2), alpha_s_0, alpha_s);
+    }
+
+    std::vector<WilsonCoefficients<BToS>>
+    WilsonCoefficientsEvolution<BToS>::evolve(const std::array<complex<double>, 15> & wc_qcd_0,
+            const std::array<complex<double>, 15> & wc_qcd_1,
+            const std::array<complex<double>, 15> & wc_qcd_2,
+            const double & alpha_s_0, const std::vector<double> & alpha_s) const
+    {
+        const auto projections = _imp->project(wc_qcd_0, wc_qcd_1, wc_qcd_2);
+
+        std::vector<WilsonCoefficients<BToS>> result;
+        result.reserve(alpha_s.size());
+        for (const auto & a : alpha_s)
+        {
+            result.push_back(_imp->evolve(projections, alpha_s_0, a));
+        }
 
         return result;
     }
+
+    std::vector<WilsonCoefficients<BToS>>
+    WilsonCoefficientsEvolution<BToS>::evolve(const std::array<complex<double>, 15> & wc_qcd_0,
+            const std::array<complex<double>, 15> & wc_qcd_1,
+            const std::array<complex<double>, 15> & wc_qcd_2,
+            const std::vector<double> & alpha_s_0, const std::vector<double> & alpha_s) const
+    {
+        if (alpha_s_0.size() != alpha_s.size())
+            throw InternalError("WilsonCoefficientsEvolution<BToS>::evolve: Mismatch between the number of initial scale ("
+                    + stringify(alpha_s_0.size()) + ") and low scale (" + stringify(alpha_s.size()) + ") couplings");
+
+        const auto projections = _imp->project(wc_qcd_0, wc_qcd_1, wc_qcd_2);
+
+        std::vector<WilsonCoefficients<BToS>> result;
+        result.reserve(alpha_s.size());
+        for (unsigned i(0) ; i < alpha_s.size() ; ++i)
+        {
+            result.push_back(_imp->evolve(projections, alpha_s_0[i], alpha_s[i]));
+        }
+
+        return result;
+    }
+
+    WilsonCoefficients<BToS> evolve(const std::array<complex<double>, 15> & wc_qcd_0,
+            const std::array<complex<double>, 15> & wc_qcd_1,
+            const std::array<complex<double>, 15> & wc_qcd_2,
+            const double & alpha_s_0, const double & alpha_s, const double & nf, const QCD::BetaFunction & beta)
+    {
+        return WilsonCoefficientsEvolution<BToS>(nf, beta).evolve(wc_qcd_0, wc_qcd_1, wc_qcd_2, alpha_s_0, alpha_s);
+    }
 }
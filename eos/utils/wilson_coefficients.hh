@@ -24,10 +24,12 @@
 
 #include <eos/utils/complex.hh>
 #include <eos/utils/parameters.hh>
+#include <eos/utils/private_implementation_pattern.hh>
 #include <eos/utils/qcd.hh>
 
 #include <array>
 #include <cmath>
+#include <vector>
 
 namespace eos
 {
@@ -103,6 +105,75 @@ namespace eos
         inline complex<double> cT5() const { return  _scalar_tensor_coefficients[5]; }
     };
 
+    template <typename Tag_> class WilsonCoefficientsEvolution;
+
+    /*!
+     * Evolution of b -> s Wilson coefficients for a fixed number of active flavors
+     *
+     * Calculation according to [BMU1999], Eq. (25). All quantities that depend only on
+     * the number of active flavors and on the beta function, i.e., the matrices H_qcd_1 and
+     * H_qcd_2 in the eigenbasis of gamma_qcd_0, are computed once upon construction. Since
+     * H_qcd_0 is diagonal, evolving to a given scale then requires only matrix-vector products.
+     */
+    template <> class WilsonCoefficientsEvolution<BToS> :
+        public PrivateImplementationPattern<WilsonCoefficientsEvolution<BToS>>
+    {
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param nf        The number of active flavors
+             * @param beta      Coefficients of the beta function of QCD for nf active flavors.
+             */
+            WilsonCoefficientsEvolution(const double & nf, const QCD::BetaFunction & beta);
+
+            /// Destructor.
+            ~WilsonCoefficientsEvolution();
+            ///@}
+
+            ///@name Evolution
+            ///@{
+            /*!
+             * Evolve the initial scale Wilson coefficients to a single low scale.
+             *
+             * @param wc_qcd_0  The initial scale Wilson coefficients at O(alpha_s^0)
+             * @param wc_qcd_1  The initial scale Wilson coefficients at O(alpha_s^1)
+             * @param wc_qcd_2  The initial scale Wilson coefficients at O(alpha_s^2)
+             * @param alpha_s_0 The strong coupling constant at the initial scale
+             * @param alpha_s   The strong coupling constant at the low scale
+             */
+            WilsonCoefficients<BToS> evolve(const std::array<complex<double>, 15> & wc_qcd_0,
+                    const std::array<complex<double>, 15> & wc_qcd_1,
+                    const std::array<complex<double>, 15> & wc_qcd_2,
+                    const double & alpha_s_0, const double & alpha_s) const;
+
+            /*!
+             * Evolve the initial scale Wilson coefficients to several low scales at once.
+             *
+             * @param alpha_s_0 The strong coupling constant at the initial scale
+             * @param alpha_s   The strong coupling constants at the low scales
+             */
+            std::vector<WilsonCoefficients<BToS>> evolve(const std::array<complex<double>, 15> & wc_qcd_0,
+                    const std::array<complex<double>, 15> & wc_qcd_1,
+                    const std::array<complex<double>, 15> & wc_qcd_2,
+                    const double & alpha_s_0, const std::vector<double> & alpha_s) const;
+
+            /*!
+             * Evolve the initial scale Wilson coefficients for several pairs of strong coupling
+             * constants at once, e.g. when varying alpha_s(m_Z).
+             *
+             * @param alpha_s_0 The strong coupling constants at the initial scale
+             * @param alpha_s   The strong coupling constants at the low scale; must have the same size as alpha_s_0.
+             */
+            std::vector<WilsonCoefficients<BToS>> evolve(const std::array<complex<double>, 15> & wc_qcd_0,
+                    const std::array<complex<double>, 15> & wc_qcd_1,
+                    const std::array<complex<double>, 15> & wc_qcd_2,
+                    const std::vector<double> & alpha_s_0, const std::vector<double> & alpha_s) const;
+            ///@}
+    };
+
     /*!
      * Evolution of b -> s Wilson coefficients
      *
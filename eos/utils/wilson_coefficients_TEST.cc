@@ -25,6 +25,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include <gsl/gsl_sf_clausen.h>
 
@@ -158,6 +159,63 @@ class WilsonCoefficientsTest :
                 TEST_CHECK_NEARLY_EQUAL(+0.0,               imag(wc.c8()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(+0.0,               imag(wc.c9()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(+0.0,               imag(wc.c10()), eps);
+
+                /* Batch evolution */
+                WilsonCoefficientsEvolution<BToS> evolution(nf, beta);
+
+                const std::vector<double> alpha_s_values{ 0.18, alpha_s, 0.26 };
+                std::vector<WilsonCoefficients<BToS>> batch_charm = evolution.evolve(initial_charm_qcd_0,
+                        initial_charm_qcd_1,
+                        initial_charm_qcd_2,
+                        alpha_s_0, alpha_s_values);
+                TEST_CHECK_EQUAL(3, batch_charm.size());
+
+                const std::vector<double> alpha_s_0_values{ 0.118, alpha_s_0, 0.122 };
+                std::vector<WilsonCoefficients<BToS>> batch_top = evolution.evolve(initial_top_qcd_0,
+                        initial_top_qcd_1,
+                        initial_top_qcd_2,
+                        alpha_s_0_values, alpha_s_values);
+                TEST_CHECK_EQUAL(3, batch_top.size());
+
+                for (unsigned i(0) ; i < 3 ; ++i)
+                {
+                    WilsonCoefficients<BToS> single_charm = evolve(initial_charm_qcd_0,
+                            initial_charm_qcd_1,
+                            initial_charm_qcd_2,
+                            alpha_s_0, alpha_s_values[i], nf, beta);
+                    WilsonCoefficients<BToS> single_top = evolve(initial_top_qcd_0,
+                            initial_top_qcd_1,
+                            initial_top_qcd_2,
+                            alpha_s_0_values[i], alpha_s_values[i], nf, beta);
+
+                    TEST_CHECK_EQUAL(single_charm._alpha_s, batch_charm[i]._alpha_s);
+                    TEST_CHECK_EQUAL(single_top._alpha_s,   batch_top[i]._alpha_s);
+                    for (unsigned j(0) ; j < 15 ; ++j)
+                    {
+                        TEST_CHECK_NEARLY_EQUAL(real(single_charm._sm_like_coefficients[j]), real(batch_charm[i]._sm_like_coefficients[j]), 1e-15);
+                        TEST_CHECK_NEARLY_EQUAL(imag(single_charm._sm_like_coefficients[j]), imag(batch_charm[i]._sm_like_coefficients[j]), 1e-15);
+                        TEST_CHECK_NEARLY_EQUAL(real(single_top._sm_like_coefficients[j]),   real(batch_top[i]._sm_like_coefficients[j]),   1e-15);
+                        TEST_CHECK_NEARLY_EQUAL(imag(single_top._sm_like_coefficients[j]),   imag(batch_top[i]._sm_like_coefficients[j]),   1e-15);
+                    }
+                }
+
+                // the evolution is linear in the initial scale Wilson coefficients
+                std::array<complex<double>, 15> initial_sum_qcd_0, initial_sum_qcd_1, initial_sum_qcd_2;
+                for (unsigned j(0) ; j < 15 ; ++j)
+                {
+                    initial_sum_qcd_0[j] = initial_top_qcd_0[j] + complex<double>(0.0, 1.0) * initial_charm_qcd_0[j];
+                    initial_sum_qcd_1[j] = initial_top_qcd_1[j] + complex<double>(0.0, 1.0) * initial_charm_qcd_1[j];
+                    initial_sum_qcd_2[j] = initial_top_qcd_2[j] + complex<double>(0.0, 1.0) * initial_charm_qcd_2[j];
+                }
+                WilsonCoefficients<BToS> sum = evolution.evolve(initial_sum_qcd_0, initial_sum_qcd_1, initial_sum_qcd_2, alpha_s_0, alpha_s);
+                for (unsigned j(0) ; j < 15 ; ++j)
+                {
+                    TEST_CHECK_NEARLY_EQUAL(real(downscaled_top._sm_like_coefficients[j]),   real(sum._sm_like_coefficients[j]), eps);
+                    TEST_CHECK_NEARLY_EQUAL(real(downscaled_charm._sm_like_coefficients[j]), imag(sum._sm_like_coefficients[j]), eps);
+                }
+
+                TEST_CHECK_THROWS(InternalError, evolution.evolve(initial_top_qcd_0, initial_top_qcd_1, initial_top_qcd_2,
+                            std::vector<double>{ alpha_s_0 }, alpha_s_values));
             }
         }
 } wilson_coefficients_test;
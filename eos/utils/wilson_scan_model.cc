@@ -36,11 +36,15 @@ namespace eos
 
     namespace wcimplementation
     {
-        complex<double> polar(const Parameter & abs, const Parameter & arg) { return std::polar(abs(), arg()); }
-        complex<double> cartesian(const Parameter & re, const Parameter & im) { return complex<double>(re(), im()); }
-        complex<double> polar_negative(const Parameter & abs, const Parameter & arg) { return std::polar(abs(), arg() + M_PI); }
-        complex<double> cartesian_negative(const Parameter & re, const Parameter & im) { return complex<double>(-re(), -im()); }
-        complex<double> zero() { return complex<double>(0.0, 0.0); }
+        inline complex<double> cartesian(const Parameter & re, const Parameter & im) { return complex<double>(re(), im()); }
+
+        inline void conjugate(WilsonCoefficients<ChargedCurrent> & wc)
+        {
+            for (auto & c : wc._coefficients)
+            {
+                c = conj(c);
+            }
+        }
     }
 
     /* b->s Wilson coefficients */
@@ -104,66 +108,53 @@ namespace eos
         _mu_im_cT(p["b->smumu::Im{cT}"], u),
         _mu_re_cT5(p["b->smumu::Re{cT5}"], u),
         _mu_im_cT5(p["b->smumu::Im{cT5}"], u),
-
-
-        /* functions for b->sgamma */
-        _c7(std::bind(&wcimplementation::cartesian,          _re_c7,          _im_c7)),
-        _c7prime(std::bind(&wcimplementation::cartesian,     _re_c7prime,     _im_c7prime)),
-
-        /* functions for b->see */
-        _e_c9(std::bind(&wcimplementation::cartesian,        _e_re_c9,        _e_im_c9)),
-        _e_c10(std::bind(&wcimplementation::cartesian,       _e_re_c10,       _e_im_c10)),
-        _e_c9prime(std::bind(&wcimplementation::cartesian,   _e_re_c9prime,   _e_im_c9prime)),
-        _e_c10prime(std::bind(&wcimplementation::cartesian,  _e_re_c10prime,  _e_im_c10prime)),
-        _e_cS(std::bind(&wcimplementation::cartesian,        _e_re_cS,        _e_im_cS)),
-        _e_cSprime(std::bind(&wcimplementation::cartesian,   _e_re_cSprime,   _e_im_cSprime)),
-        _e_cP(std::bind(&wcimplementation::cartesian,        _e_re_cP,        _e_im_cP)),
-        _e_cPprime(std::bind(&wcimplementation::cartesian,   _e_re_cPprime,   _e_im_cPprime)),
-        _e_cT(std::bind(&wcimplementation::cartesian,        _e_re_cT,        _e_im_cT)),
-        _e_cT5(std::bind(&wcimplementation::cartesian,       _e_re_cT5,       _e_im_cT5)),
-
-        /* functions for b->smumu */
-        _mu_c9(std::bind(&wcimplementation::cartesian,       _mu_re_c9,       _mu_im_c9)),
-        _mu_c10(std::bind(&wcimplementation::cartesian,      _mu_re_c10,      _mu_im_c10)),
-        _mu_c9prime(std::bind(&wcimplementation::cartesian,  _mu_re_c9prime,  _mu_im_c9prime)),
-        _mu_c10prime(std::bind(&wcimplementation::cartesian, _mu_re_c10prime, _mu_im_c10prime)),
-        _mu_cS(std::bind(&wcimplementation::cartesian,       _mu_re_cS,       _mu_im_cS)),
-        _mu_cSprime(std::bind(&wcimplementation::cartesian,  _mu_re_cSprime,  _mu_im_cSprime)),
-        _mu_cP(std::bind(&wcimplementation::cartesian,       _mu_re_cP,       _mu_im_cP)),
-        _mu_cPprime(std::bind(&wcimplementation::cartesian,  _mu_re_cPprime,  _mu_im_cPprime)),
-        _mu_cT(std::bind(&wcimplementation::cartesian,       _mu_re_cT,       _mu_im_cT)),
-        _mu_cT5(std::bind(&wcimplementation::cartesian,      _mu_re_cT5,      _mu_im_cT5))
+        _constrained(false)
     {
     }
 
     WilsonCoefficients<BToS>
-    WilsonScanComponent<components::DeltaBS1>::wilson_coefficients_b_to_s(const double & mu, const std::string & lepton_flavour, const bool & cp_conjugate) const
+    WilsonScanComponent<components::DeltaBS1>::wilson_coefficients_b_to_s(const double & mu, const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const
     {
-        std::function<complex<double> ()> c9,  c9prime;
-        std::function<complex<double> ()> c10, c10prime;
-        std::function<complex<double> ()> cS,  cSprime;
-        std::function<complex<double> ()> cP,  cPprime;
-        std::function<complex<double> ()> cT,  cT5;
+        using wcimplementation::cartesian;
 
-        if ("e" == lepton_flavour)
-        {
-            c9 = _e_c9;     c9prime = _e_c9prime;
-            c10 = _e_c10;   c10prime = _e_c10prime;
-            cS = _e_cS;     cSprime = _e_cSprime;
-            cP = _e_cP;     cPprime = _e_cPprime;
-            cT = _e_cT;     cT5 = _e_cT5;
-        }
-        else if ("mu" == lepton_flavour)
+        complex<double> c9,  c9prime;
+        complex<double> c10, c10prime;
+        complex<double> cS,  cSprime;
+        complex<double> cP,  cPprime;
+        complex<double> cT,  cT5;
+
+        switch (lepton_flavour)
         {
-            c9 = _mu_c9;    c9prime = _mu_c9prime;
-            c10 = _mu_c10;  c10prime = _mu_c10prime;
-            cS = _mu_cS;    cSprime = _mu_cSprime;
-            cP = _mu_cP;    cPprime = _mu_cPprime;
-            cT = _mu_cT;    cT5 = _mu_cT5;
+            case LeptonFlavour::electron:
+                c9  = cartesian(_e_re_c9,  _e_im_c9);   c9prime  = cartesian(_e_re_c9prime,  _e_im_c9prime);
+                c10 = cartesian(_e_re_c10, _e_im_c10);  c10prime = cartesian(_e_re_c10prime, _e_im_c10prime);
+                cS  = cartesian(_e_re_cS,  _e_im_cS);   cSprime  = cartesian(_e_re_cSprime,  _e_im_cSprime);
+                if (! _constrained)
+                {
+                    cP = cartesian(_e_re_cP, _e_im_cP); cPprime  = cartesian(_e_re_cPprime,  _e_im_cPprime);
+                    cT = cartesian(_e_re_cT, _e_im_cT); cT5      = cartesian(_e_re_cT5,      _e_im_cT5);
+                }
+                break;
+
+            case LeptonFlavour::muon:
+                c9  = cartesian(_mu_re_c9,  _mu_im_c9);   c9prime  = cartesian(_mu_re_c9prime,  _mu_im_c9prime);
+                c10 = cartesian(_mu_re_c10, _mu_im_c10);  c10prime = cartesian(_mu_re_c10prime, _mu_im_c10prime);
+                cS  = cartesian(_mu_re_cS,  _mu_im_cS);   cSprime  = cartesian(_mu_re_cSprime,  _mu_im_cSprime);
+                if (! _constrained)
+                {
+                    cP = cartesian(_mu_re_cP, _mu_im_cP); cPprime  = cartesian(_mu_re_cPprime,  _mu_im_cPprime);
+                    cT = cartesian(_mu_re_cT, _mu_im_cT); cT5      = cartesian(_mu_re_cT5,      _mu_im_cT5);
+                }
+                break;
+
+            default:
+                throw InternalError("WilsonScan presently only implements 'e' and 'mu' lepton flavours");
         }
-        else
+
+        if (_constrained)
         {
-            throw InternalError("WilsonScan presently only implements 'e' and 'mu' lepton flavours");
+            cP = -cS;      cPprime = cSprime;
+            cT = 0.0;      cT5 = 0.0;
         }
 
         double alpha_s = 0.0;
@@ -183,18 +174,18 @@ namespace eos
         {{
             _c1(), _c2(), _c3(), _c4(), _c5(), _c6(),
             0.0, 0.0, 0.0, 0.0, 0.0,
-            a_s * _c7(), a_s * _c8(), a_s * c9(), a_s * c10()
+            a_s * cartesian(_re_c7, _im_c7), a_s * _c8(), a_s * c9, a_s * c10
         }};
         result._primed_coefficients = std::array<std::complex<double>, 15>
         {{
             /* we only consider c7', c8', c9' and c10' */
             0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
             0.0, 0.0, 0.0, 0.0, 0.0,
-            a_s * _c7prime(), a_s * _c8prime(), a_s * c9prime(), a_s * c10prime()
+            a_s * cartesian(_re_c7prime, _im_c7prime), a_s * _c8prime(), a_s * c9prime, a_s * c10prime
         }};
         result._scalar_tensor_coefficients = std::array<std::complex<double>, 6>
         {{
-            cS(), cSprime(), cP(), cPprime(), cT(), cT5()
+            cS, cSprime, cP, cPprime, cT, cT5
         }};
         result._alpha_s = alpha_s;
 
@@ -252,73 +243,49 @@ namespace eos
         _tau_re_cvr(p["b->utaunutau::Re{cVR}"], u),
         _tau_im_cvr(p["b->utaunutau::Im{cVR}"], u),
         _tau_re_ct(p["b->utaunutau::Re{cT}"], u),
-        _tau_im_ct(p["b->utaunutau::Im{cT}"], u),
-
-        _e_csl(std::bind(&wcimplementation::cartesian, _e_re_csl, _e_im_csl)),
-        _e_csr(std::bind(&wcimplementation::cartesian, _e_re_csr, _e_im_csr)),
-        _e_cvl(std::bind(&wcimplementation::cartesian, _e_re_cvl, _e_im_cvl)),
-        _e_cvr(std::bind(&wcimplementation::cartesian, _e_re_cvr, _e_im_cvr)),
-        _e_ct(std::bind(&wcimplementation::cartesian, _e_re_ct, _e_im_ct)),
-
-        _mu_csl(std::bind(&wcimplementation::cartesian, _mu_re_csl, _mu_im_csl)),
-        _mu_csr(std::bind(&wcimplementation::cartesian, _mu_re_csr, _mu_im_csr)),
-        _mu_cvl(std::bind(&wcimplementation::cartesian, _mu_re_cvl, _mu_im_cvl)),
-        _mu_cvr(std::bind(&wcimplementation::cartesian, _mu_re_cvr, _mu_im_cvr)),
-        _mu_ct(std::bind(&wcimplementation::cartesian, _mu_re_ct, _mu_im_ct)),
-
-        _tau_csl(std::bind(&wcimplementation::cartesian, _tau_re_csl, _tau_im_csl)),
-        _tau_csr(std::bind(&wcimplementation::cartesian, _tau_re_csr, _tau_im_csr)),
-        _tau_cvl(std::bind(&wcimplementation::cartesian, _tau_re_cvl, _tau_im_cvl)),
-        _tau_cvr(std::bind(&wcimplementation::cartesian, _tau_re_cvr, _tau_im_cvr)),
-        _tau_ct(std::bind(&wcimplementation::cartesian, _tau_re_ct, _tau_im_ct))
+        _tau_im_ct(p["b->utaunutau::Im{cT}"], u)
     {
     }
 
     WilsonCoefficients<ChargedCurrent>
-    WilsonScanComponent<components::DeltaBU1>::wilson_coefficients_b_to_u(const std::string & lepton_flavour, const bool & cp_conjugate) const
+    WilsonScanComponent<components::DeltaBU1>::wilson_coefficients_b_to_u(const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const
     {
-        std::function<complex<double> ()> cvl;
-        std::function<complex<double> ()> cvr;
-        std::function<complex<double> ()> csl;
-        std::function<complex<double> ()> csr;
-        std::function<complex<double> ()> ct;
+        using wcimplementation::cartesian;
 
-        if ("e" == lepton_flavour)
-        {
-            cvl = _e_cvl;   cvr = _e_cvr;
-            csl = _e_csl;   csr = _e_csr;
-            ct = _e_ct;
-        }
-        else if ("mu" == lepton_flavour)
+        WilsonCoefficients<ChargedCurrent> result;
+        switch (lepton_flavour)
         {
-            cvl = _mu_cvl;   cvr = _mu_cvr;
-            csl = _mu_csl;   csr = _mu_csr;
-            ct = _mu_ct;
+            case LeptonFlavour::electron:
+                result._coefficients = {{
+                    cartesian(_e_re_cvl, _e_im_cvl), cartesian(_e_re_cvr, _e_im_cvr),
+                    cartesian(_e_re_csl, _e_im_csl), cartesian(_e_re_csr, _e_im_csr),
+                    cartesian(_e_re_ct,  _e_im_ct)
+                }};
+                break;
+
+            case LeptonFlavour::muon:
+                result._coefficients = {{
+                    cartesian(_mu_re_cvl, _mu_im_cvl), cartesian(_mu_re_cvr, _mu_im_cvr),
+                    cartesian(_mu_re_csl, _mu_im_csl), cartesian(_mu_re_csr, _mu_im_csr),
+                    cartesian(_mu_re_ct,  _mu_im_ct)
+                }};
+                break;
+
+            case LeptonFlavour::tau:
+                result._coefficients = {{
+                    cartesian(_tau_re_cvl, _tau_im_cvl), cartesian(_tau_re_cvr, _tau_im_cvr),
+                    cartesian(_tau_re_csl, _tau_im_csl), cartesian(_tau_re_csr, _tau_im_csr),
+                    cartesian(_tau_re_ct,  _tau_im_ct)
+                }};
+                break;
+
+            default:
+                throw InternalError("WilsonScan implements 'e', 'mu' and 'tau' lepton flavours");
         }
-        else if ("tau" == lepton_flavour)
-        {
-            cvl = _tau_cvl;   cvr = _tau_cvr;
-            csl = _tau_csl;   csr = _tau_csr;
-            ct = _tau_ct;
-        }
-        else
-        {
-            throw InternalError("WilsonScan implements 'e', 'mu' and 'tau' lepton flavours");
-        }
-
-        WilsonCoefficients<ChargedCurrent> result
-        {
-            {{
-                cvl(), cvr(), csl(), csr(), ct()
-            }},
-        };
 
         if (cp_conjugate)
         {
-            for (auto c = result._coefficients.begin(), c_end = result._coefficients.end() ; c != c_end ; ++c)
-            {
-                *c = conj(*c);
-            }
+            wcimplementation::conjugate(result);
         }
 
         return result;
@@ -357,73 +324,49 @@ namespace eos
     _tau_re_cvr(p["b->ctaunutau::Re{cVR}"], u),
     _tau_im_cvr(p["b->ctaunutau::Im{cVR}"], u),
     _tau_re_ct(p["b->ctaunutau::Re{cT}"], u),
-    _tau_im_ct(p["b->ctaunutau::Im{cT}"], u),
-
-    _e_csl(std::bind(&wcimplementation::cartesian, _e_re_csl, _e_im_csl)),
-    _e_csr(std::bind(&wcimplementation::cartesian, _e_re_csr, _e_im_csr)),
-    _e_cvl(std::bind(&wcimplementation::cartesian, _e_re_cvl, _e_im_cvl)),
-    _e_cvr(std::bind(&wcimplementation::cartesian, _e_re_cvr, _e_im_cvr)),
-    _e_ct(std::bind(&wcimplementation::cartesian, _e_re_ct, _e_im_ct)),
-
-    _mu_csl(std::bind(&wcimplementation::cartesian, _mu_re_csl, _mu_im_csl)),
-    _mu_csr(std::bind(&wcimplementation::cartesian, _mu_re_csr, _mu_im_csr)),
-    _mu_cvl(std::bind(&wcimplementation::cartesian, _mu_re_cvl, _mu_im_cvl)),
-    _mu_cvr(std::bind(&wcimplementation::cartesian, _mu_re_cvr, _mu_im_cvr)),
-    _mu_ct(std::bind(&wcimplementation::cartesian, _mu_re_ct, _mu_im_ct)),
-
-    _tau_csl(std::bind(&wcimplementation::cartesian, _tau_re_csl, _tau_im_csl)),
-    _tau_csr(std::bind(&wcimplementation::cartesian, _tau_re_csr, _tau_im_csr)),
-    _tau_cvl(std::bind(&wcimplementation::cartesian, _tau_re_cvl, _tau_im_cvl)),
-    _tau_cvr(std::bind(&wcimplementation::cartesian, _tau_re_cvr, _tau_im_cvr)),
-    _tau_ct(std::bind(&wcimplementation::cartesian, _tau_re_ct, _tau_im_ct))
+    _tau_im_ct(p["b->ctaunutau::Im{cT}"], u)
     {
     }
 
     WilsonCoefficients<ChargedCurrent>
-    WilsonScanComponent<components::DeltaBC1>::wilson_coefficients_b_to_c(const std::string & lepton_flavour, const bool & cp_conjugate) const
+    WilsonScanComponent<components::DeltaBC1>::wilson_coefficients_b_to_c(const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const
     {
-        std::function<complex<double> ()> cvl;
-        std::function<complex<double> ()> cvr;
-        std::function<complex<double> ()> csl;
-        std::function<complex<double> ()> csr;
-        std::function<complex<double> ()> ct;
+        using wcimplementation::cartesian;
 
-        if ("e" == lepton_flavour)
-        {
-            cvl = _e_cvl;   cvr = _e_cvr;
-            csl = _e_csl;   csr = _e_csr;
-            ct = _e_ct;
-        }
-        else if ("mu" == lepton_flavour)
-        {
-            cvl = _mu_cvl;   cvr = _mu_cvr;
-            csl = _mu_csl;   csr = _mu_csr;
-            ct = _mu_ct;
-        }
-        else if ("tau" == lepton_flavour)
+        WilsonCoefficients<ChargedCurrent> result;
+        switch (lepton_flavour)
         {
-            cvl = _tau_cvl;   cvr = _tau_cvr;
-            csl = _tau_csl;   csr = _tau_csr;
-            ct = _tau_ct;
+            case LeptonFlavour::electron:
+                result._coefficients = {{
+                    cartesian(_e_re_cvl, _e_im_cvl), cartesian(_e_re_cvr, _e_im_cvr),
+                    cartesian(_e_re_csl, _e_im_csl), cartesian(_e_re_csr, _e_im_csr),
+                    cartesian(_e_re_ct,  _e_im_ct)
+                }};
+                break;
+
+            case LeptonFlavour::muon:
+                result._coefficients = {{
+                    cartesian(_mu_re_cvl, _mu_im_cvl), cartesian(_mu_re_cvr, _mu_im_cvr),
+                    cartesian(_mu_re_csl, _mu_im_csl), cartesian(_mu_re_csr, _mu_im_csr),
+                    cartesian(_mu_re_ct,  _mu_im_ct)
+                }};
+                break;
+
+            case LeptonFlavour::tau:
+                result._coefficients = {{
+                    cartesian(_tau_re_cvl, _tau_im_cvl), cartesian(_tau_re_cvr, _tau_im_cvr),
+                    cartesian(_tau_re_csl, _tau_im_csl), cartesian(_tau_re_csr, _tau_im_csr),
+                    cartesian(_tau_re_ct,  _tau_im_ct)
+                }};
+                break;
+
+            default:
+                throw InternalError("WilsonScan implements 'e', 'mu' and 'tau' lepton flavours");
         }
-        else
-        {
-            throw InternalError("WilsonScan implements 'e', 'mu' and 'tau' lepton flavours");
-        }
-
-        WilsonCoefficients<ChargedCurrent> result
-        {
-            {{
-                cvl(), cvr(), csl(), csr(), ct()
-            }},
-        };
 
         if (cp_conjugate)
         {
-            for (auto c = result._coefficients.begin(), c_end = result._coefficients.end() ; c != c_end ; ++c)
-            {
-                *c = conj(*c);
-            }
+            wcimplementation::conjugate(result);
         }
 
         return result;
@@ -432,23 +375,15 @@ namespace eos
     ConstrainedWilsonScanComponent::ConstrainedWilsonScanComponent(const Parameters & p, const Options & o, ParameterUser & u) :
         WilsonScanComponent<components::DeltaBS1>(p, o, u)
     {
-        /* b->smee */
-        _e_cT = std::bind(&wcimplementation::zero);
-        _e_cT5 = std::bind(&wcimplementation::zero);
-        _e_cP = std::bind(&wcimplementation::cartesian_negative, _e_re_cS,        _e_im_cS);
-        _e_cPprime = std::bind(&wcimplementation::cartesian,     _e_re_cSprime,   _e_im_cSprime);
+        _constrained = true;
 
+        /* b->see */
         u.drop(_e_re_cP.id());       u.drop(_e_im_cP.id());
         u.drop(_e_re_cPprime.id());  u.drop(_e_im_cPprime.id());
         u.drop(_e_re_cT.id());       u.drop(_e_im_cT.id());
         u.drop(_e_re_cT5.id());      u.drop(_e_im_cT5.id());
 
         /* b->smumu */
-        _mu_cT = std::bind(&wcimplementation::zero);
-        _mu_cT5 = std::bind(&wcimplementation::zero);
-        _mu_cP = std::bind(&wcimplementation::cartesian_negative, _mu_re_cS,      _mu_im_cS);
-        _mu_cPprime = std::bind(&wcimplementation::cartesian,     _mu_re_cSprime, _mu_im_cSprime);
-
         u.drop(_mu_re_cP.id());      u.drop(_mu_im_cP.id());
         u.drop(_mu_re_cPprime.id()); u.drop(_mu_im_cPprime.id());
         u.drop(_mu_re_cT.id());      u.drop(_mu_im_cT.id());
@@ -79,39 +79,17 @@ namespace eos
             UsedParameter _mu_re_cT,       _mu_im_cT;
             UsedParameter _mu_re_cT5,      _mu_im_cT5;
 
-            /* b->sgamma */
-            std::function<complex<double> ()> _c7;
-            std::function<complex<double> ()> _c7prime;
-
-            /* b->see */
-            std::function<complex<double> ()> _e_c9;
-            std::function<complex<double> ()> _e_c10;
-            std::function<complex<double> ()> _e_c9prime;
-            std::function<complex<double> ()> _e_c10prime;
-            std::function<complex<double> ()> _e_cS;
-            std::function<complex<double> ()> _e_cSprime;
-            std::function<complex<double> ()> _e_cP;
-            std::function<complex<double> ()> _e_cPprime;
-            std::function<complex<double> ()> _e_cT;
-            std::function<complex<double> ()> _e_cT5;
-
-            /* b->smumu */
-            std::function<complex<double> ()> _mu_c9;
-            std::function<complex<double> ()> _mu_c10;
-            std::function<complex<double> ()> _mu_c9prime;
-            std::function<complex<double> ()> _mu_c10prime;
-            std::function<complex<double> ()> _mu_cS;
-            std::function<complex<double> ()> _mu_cSprime;
-            std::function<complex<double> ()> _mu_cP;
-            std::function<complex<double> ()> _mu_cPprime;
-            std::function<complex<double> ()> _mu_cT;
-            std::function<complex<double> ()> _mu_cT5;
+            /*
+             * If true, C_P = -C_S, C_P' = C_S', and C_T = C_T5 = 0,
+             * cf. ConstrainedWilsonScanComponent.
+             */
+            bool _constrained;
 
         public:
             WilsonScanComponent(const Parameters &, const Options &, ParameterUser &);
 
             /*! b->s Wilson coefficients */
-            virtual WilsonCoefficients<BToS> wilson_coefficients_b_to_s(const double & mu, const std::string & lepton_flavour, const bool & cp_conjugate) const;
+            virtual WilsonCoefficients<BToS> wilson_coefficients_b_to_s(const double & mu, const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const;
     };
 
     template <>
@@ -141,29 +119,11 @@ namespace eos
             UsedParameter _tau_re_cvr, _tau_im_cvr;
             UsedParameter _tau_re_ct,  _tau_im_ct;
 
-            std::function<complex<double> ()> _e_csl;
-            std::function<complex<double> ()> _e_csr;
-            std::function<complex<double> ()> _e_cvl;
-            std::function<complex<double> ()> _e_cvr;
-            std::function<complex<double> ()> _e_ct;
-
-            std::function<complex<double> ()> _mu_csl;
-            std::function<complex<double> ()> _mu_csr;
-            std::function<complex<double> ()> _mu_cvl;
-            std::function<complex<double> ()> _mu_cvr;
-            std::function<complex<double> ()> _mu_ct;
-
-            std::function<complex<double> ()> _tau_csl;
-            std::function<complex<double> ()> _tau_csr;
-            std::function<complex<double> ()> _tau_cvl;
-            std::function<complex<double> ()> _tau_cvr;
-            std::function<complex<double> ()> _tau_ct;
-
         public:
             WilsonScanComponent(const Parameters &, const Options &, ParameterUser &);
 
             /* b->u Wilson coefficients */
-            virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_u(const std::string & lepton_flavour, const bool & cp_conjugate) const;
+            virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_u(const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const;
     };
 
     template <>
@@ -193,29 +153,11 @@ namespace eos
         UsedParameter _tau_re_cvr, _tau_im_cvr;
         UsedParameter _tau_re_ct,  _tau_im_ct;
 
-        std::function<complex<double> ()> _e_csl;
-        std::function<complex<double> ()> _e_csr;
-        std::function<complex<double> ()> _e_cvl;
-        std::function<complex<double> ()> _e_cvr;
-        std::function<complex<double> ()> _e_ct;
-
-        std::function<complex<double> ()> _mu_csl;
-        std::function<complex<double> ()> _mu_csr;
-        std::function<complex<double> ()> _mu_cvl;
-        std::function<complex<double> ()> _mu_cvr;
-        std::function<complex<double> ()> _mu_ct;
-
-        std::function<complex<double> ()> _tau_csl;
-        std::function<complex<double> ()> _tau_csr;
-        std::function<complex<double> ()> _tau_cvl;
-        std::function<complex<double> ()> _tau_cvr;
-        std::function<complex<double> ()> _tau_ct;
-
     public:
         WilsonScanComponent(const Parameters &, const Options &, ParameterUser &);
 
         /* b->c Wilson coefficients */
-        virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_c(const std::string & lepton_flavour, const bool & cp_conjugate) const;
+        virtual WilsonCoefficients<ChargedCurrent> wilson_coefficients_b_to_c(const LeptonFlavour & lepton_flavour, const bool & cp_conjugate) const;
     };
 
     /*!
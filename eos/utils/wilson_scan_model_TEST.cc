@@ -108,7 +108,7 @@ class WilsonCoefficientsBToSTest :
 
                 TEST_CHECK_NEARLY_EQUAL(+0.2233419372, model.alpha_s(mu), eps);
 
-                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
                 TEST_CHECK_NEARLY_EQUAL(+0.2233419372, wc._alpha_s, eps);
                 TEST_CHECK_NEARLY_EQUAL(-0.29063621, real(wc.c1()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(+1.01029623, real(wc.c2()),  eps);
@@ -166,7 +166,7 @@ class WilsonCoefficientsBToSTest :
 
                 TEST_CHECK_NEARLY_EQUAL(+0.2233419372, model.alpha_s(mu), eps);
 
-                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
                 TEST_CHECK_NEARLY_EQUAL(+0.2233419372, wc._alpha_s, eps);
                 TEST_CHECK_NEARLY_EQUAL(-0.29063621, real(wc.c1()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(+1.01029623, real(wc.c2()),  eps);
@@ -197,12 +197,22 @@ class WilsonCoefficientsBToSTest :
                 TEST_CHECK_NEARLY_EQUAL(+0.0,        imag(wc.c9prime()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(-M_PI,       imag(wc.c10prime()), eps);
 
-                wc = model.wilson_coefficients_b_to_s(mu, "e", false);
+                wc = model.wilson_coefficients_b_to_s(mu, LeptonFlavour::electron, false);
                 TEST_CHECK_NEARLY_EQUAL(+3.27,       real(wc.c9()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(+0.007,      real(wc.c9prime()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(+0.006,      real(wc.c10prime()), eps);
                 TEST_CHECK_NEARLY_EQUAL(+0.01,       imag(wc.c9prime()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(-M_PI+0.01,  imag(wc.c10prime()), eps);
+
+                TEST_CHECK_THROWS(InternalError, model.wilson_coefficients_b_to_s(mu, LeptonFlavour::tau, false));
+            }
+
+            /* Lepton flavours */
+            {
+                TEST_CHECK(LeptonFlavour::electron == lepton_flavour_from_option("e"));
+                TEST_CHECK(LeptonFlavour::muon     == lepton_flavour_from_option("mu"));
+                TEST_CHECK(LeptonFlavour::tau      == lepton_flavour_from_option("tau"));
+                TEST_CHECK_THROWS(InvalidOptionValueError, lepton_flavour_from_option("nu"));
             }
         }
 } wilson_coefficients_b_to_s_test;
@@ -235,7 +245,7 @@ class ConstrainedWilsonScanModelTest:
                 p["b->smumu::Re{cT}"] = 2.0;
                 p["b->smumu::Re{cT5}"] = -43.0;
 
-                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
 
                 TEST_CHECK_RELATIVE_ERROR(std::real(wc.c7()),  1.008, eps);
 
@@ -291,7 +301,7 @@ class ConstrainedWilsonScanModelTest:
                 p["b->smumu::Re{cT5}"] = -43.0;
                 p["b->smumu::Im{cT5}"] = M_PI;
 
-                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                WilsonCoefficients<BToS> wc = model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
 
                 TEST_CHECK_RELATIVE_ERROR(real(wc.c7()),      1.008, eps);
 
@@ -348,8 +358,8 @@ class ConstrainedWilsonScanModelTest:
                 ConstrainedWilsonScanModel constrained_model(p, o);
                 WilsonScanModel unconstrained_model(p, o);
 
-                WilsonCoefficients<BToS> constrained_wc = constrained_model.wilson_coefficients_b_to_s(mu, "mu", false);
-                WilsonCoefficients<BToS> unconstrained_wc = constrained_model.wilson_coefficients_b_to_s(mu, "mu", false);
+                WilsonCoefficients<BToS> constrained_wc = constrained_model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
+                WilsonCoefficients<BToS> unconstrained_wc = constrained_model.wilson_coefficients_b_to_s(mu, LeptonFlavour::muon, false);
 
                 auto ux = unconstrained_wc._sm_like_coefficients.begin();
                 for (auto & x : constrained_wc._sm_like_coefficients)
@@ -25,6 +25,7 @@
 #include "eos/signal-pdf.hh"
 #include "eos/utils/kinematic.hh"
 #include "eos/utils/model.hh"
+#include "eos/utils/observable_cache.hh"
 #include "eos/utils/parameters.hh"
 #include "eos/utils/options.hh"
 #include "eos/utils/qualified-name.hh"
@@ -323,9 +324,31 @@ BOOST_PYTHON_MODULE(_eos)
         .def("m_ud_msbar", &Model::m_ud_msbar)
         ;
 
+    // ObservableProfile
+    class_<ObservableProfile>("ObservableProfile", R"(
+            Represents the timings of the evaluations of a single observable within an :class:`ObservableCache <eos.ObservableCache>`.
+        )", no_init)
+        .def_readonly("calls", &ObservableProfile::calls)
+        .def_readonly("total", &ObservableProfile::total)
+        .def_readonly("last", &ObservableProfile::last)
+        ;
+
     // ObservableCache
     class_<ObservableCache>("ObservableCache", no_init)
         .def("__iter__", range(&ObservableCache::begin, &ObservableCache::end))
+        .def("__len__", &ObservableCache::size)
+        .def("observable", &ObservableCache::observable)
+        .def("enable_profiling", &ObservableCache::enable_profiling, (arg("enabled") = true), R"(
+            Enable or disable recording of the timings of each observable's evaluation.
+        )")
+        .def("profiling", &ObservableCache::profiling)
+        .def("profile", &ObservableCache::profile, return_value_policy<copy_const_reference>(), R"(
+            Returns the timings of the observable with the given index, as an :class:`ObservableProfile <eos.ObservableProfile>`.
+
+            :param id: The index of the observable within the cache.
+            :type id: int
+        )")
+        .def("reset_profile", &ObservableCache::reset_profile)
         ;
 
     // ReferenceName
@@ -0,0 +1,722 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2019 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/constraint.hh>
+#include <eos/observable.hh>
+#include <eos/statistics/log-likelihood.hh>
+#include <eos/statistics/log-posterior.hh>
+#include <eos/statistics/log-prior.hh>
+#include <eos/statistics/markov-chain.hh>
+#include <eos/statistics/proposal-functions.hh>
+#include <eos/utils/destringify.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/stringify.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using namespace eos;
+
+class DoUsage
+{
+    private:
+        std::string _what;
+
+    public:
+        DoUsage(const std::string & what) :
+            _what(what)
+        {
+        }
+
+        const std::string & what() const
+        {
+            return _what;
+        }
+};
+
+/*
+ * A workload is the unit of work that is timed by a benchmark.
+ */
+struct Workload
+{
+    // parameters that are pinned to fixed random points prior to each evaluation
+    std::vector<Parameter> parameters;
+
+    // performs 'batch' evaluations at the current parameter point
+    std::function<void ()> evaluate;
+
+    unsigned batch;
+
+    Workload() :
+        batch(1)
+    {
+    }
+};
+
+struct Benchmark
+{
+    std::string name;
+
+    std::string description;
+
+    // sets up the workload for an independent set of parameters
+    std::function<Workload (Parameters &)> make;
+};
+
+struct Result
+{
+    std::string name;
+
+    unsigned repetitions;
+
+    unsigned evaluations;
+
+    // in ns per evaluation
+    double mean, lower, upper;
+};
+
+/*
+ * Collect all parameters used by an observable.
+ */
+void
+used_parameters(const Parameters & parameters, const ObservablePtr & observable, std::set<Parameter::Id> & ids, std::vector<Parameter> & result)
+{
+    for (auto i = observable->begin(), i_end = observable->end() ; i != i_end ; ++i)
+    {
+        if (! ids.insert(*i).second)
+            continue;
+
+        result.push_back(parameters[*i]);
+    }
+}
+
+Benchmark
+make_observable_benchmark(const std::string & name, const std::vector<std::pair<std::string, double>> & kinematics)
+{
+    std::string description = "evaluate " + name;
+    for (const auto & k : kinematics)
+    {
+        description += " " + k.first + "=" + stringify(k.second);
+    }
+
+    return Benchmark
+    {
+        "observable:" + name,
+        description,
+        [name, kinematics] (Parameters & parameters) -> Workload
+        {
+            Kinematics k;
+            for (const auto & kv : kinematics)
+            {
+                k.declare(kv.first, kv.second);
+            }
+
+            ObservablePtr observable = Observable::make(name, parameters, k, Options());
+            if (! observable)
+                throw DoUsage("Unknown observable '" + name + "'");
+
+            Workload result;
+            std::set<Parameter::Id> ids;
+            used_parameters(parameters, observable, ids, result.parameters);
+            result.evaluate = [observable] () { observable->evaluate(); };
+
+            return result;
+        }
+    };
+}
+
+Benchmark
+make_constraint_benchmark(const std::string & name)
+{
+    return Benchmark
+    {
+        "constraint:" + name,
+        "evaluate the log(likelihood) of constraint " + name,
+        [name] (Parameters & parameters) -> Workload
+        {
+            LogLikelihood likelihood(parameters);
+            likelihood.add(Constraint::make(name, Options()));
+
+            Workload result;
+            std::set<Parameter::Id> ids;
+            auto cache = likelihood.observable_cache();
+            for (auto o = cache.begin(), o_end = cache.end() ; o != o_end ; ++o)
+            {
+                used_parameters(parameters, *o, ids, result.parameters);
+            }
+            result.evaluate = [likelihood] () { likelihood(); };
+
+            return result;
+        }
+    };
+}
+
+Benchmark
+make_sampler_benchmark(const std::string & name, const std::vector<std::string> & constraints,
+        const std::vector<std::tuple<std::string, double, double>> & priors, const unsigned long & seed)
+{
+    static const unsigned steps = 100;
+
+    return Benchmark
+    {
+        "sampler:" + name,
+        "run " + stringify(steps) + " Metropolis-Hastings steps for " + stringify(constraints.size()) + " constraints and " + stringify(priors.size()) + " parameters",
+        [constraints, priors, seed] (Parameters & parameters) -> Workload
+        {
+            LogLikelihood likelihood(parameters);
+            for (const auto & c : constraints)
+            {
+                likelihood.add(Constraint::make(c, Options()));
+            }
+
+            LogPosterior posterior(likelihood);
+            std::vector<double> covariance(priors.size() * priors.size(), 0.0);
+            for (unsigned i = 0 ; i < priors.size() ; ++i)
+            {
+                const auto & p = priors[i];
+                posterior.add(LogPrior::Flat(parameters, std::get<0>(p), ParameterRange{ std::get<1>(p), std::get<2>(p) }), false);
+                covariance[i * priors.size() + i] = std::pow((std::get<2>(p) - std::get<1>(p)) / 100.0, 2);
+            }
+
+            std::shared_ptr<MarkovChain::ProposalFunction> proposal(new proposal_functions::MultivariateGaussian(priors.size(), covariance, false));
+            auto chain = std::make_shared<MarkovChain>(posterior.clone(), seed, proposal);
+
+            // the chain moves through parameter space by itself
+            Workload result;
+            result.evaluate = [chain] () { chain->run(steps); };
+            result.batch = steps;
+
+            return result;
+        }
+    };
+}
+
+Benchmark
+make_hdf5_benchmark(const std::string & name, const unsigned & dimension, const std::string & file_name)
+{
+    static const unsigned records = 1000;
+
+    return Benchmark
+    {
+        "hdf5:" + name,
+        "write " + stringify(records) + " records of " + stringify(dimension) + " doubles to " + file_name,
+        [dimension, file_name] (Parameters &) -> Workload
+        {
+            typedef hdf5::Array<1, double> SampleType;
+
+            auto file = std::make_shared<hdf5::File>(hdf5::File::Create(file_name));
+            auto data_set = std::make_shared<hdf5::DataSet<SampleType>>(file->create_data_set("/samples", SampleType{ "samples", { dimension } }));
+            auto record = std::make_shared<std::vector<double>>(dimension);
+            std::iota(record->begin(), record->end(), 0.0);
+
+            Workload result;
+            result.evaluate = [file, data_set, record] ()
+            {
+                for (unsigned i = 0 ; i < records ; ++i)
+                {
+                    (*record)[0] = i;
+                    *data_set << *record;
+                }
+            };
+            result.batch = records;
+
+            return result;
+        }
+    };
+}
+
+class CommandLine :
+    public InstantiationPolicy<CommandLine, Singleton>
+{
+    public:
+        std::vector<Benchmark> catalog;
+
+        std::vector<std::string> selection;
+
+        std::string output;
+
+        std::string baseline;
+
+        std::string scratch;
+
+        unsigned repetitions;
+
+        unsigned evaluations;
+
+        unsigned points;
+
+        unsigned long seed;
+
+        double threshold;
+
+        bool list;
+
+        CommandLine() :
+            scratch("eos-benchmark-scratch.hdf5"),
+            repetitions(10),
+            evaluations(100),
+            points(10),
+            seed(1701),
+            threshold(0.05),
+            list(false)
+        {
+        }
+
+        void make_catalog()
+        {
+            catalog.push_back(make_observable_benchmark("B->K^*::V(q2)", { { "q2", 2.0 } }));
+            catalog.push_back(make_observable_benchmark("B->K^*::A_1(q2)", { { "q2", 2.0 } }));
+            catalog.push_back(make_observable_benchmark("B->K^*ll::BR@LargeRecoil", { { "q2_min", 1.0 }, { "q2_max", 6.0 } }));
+            catalog.push_back(make_observable_benchmark("B->K^*ll::F_L@LargeRecoil", { { "q2_min", 1.0 }, { "q2_max", 6.0 } }));
+            catalog.push_back(make_observable_benchmark("B->K^*ll::BR@LowRecoil", { { "q2_min", 15.0 }, { "q2_max", 19.0 } }));
+            catalog.push_back(make_constraint_benchmark("B^0->K^*0mu^+mu^-::BR[1.00,6.00]@LHCb-2011"));
+            catalog.push_back(make_constraint_benchmark("B^0->K^*0mu^+mu^-::A_FB[1.00,6.00]@LHCb-2011"));
+            catalog.push_back(make_constraint_benchmark("B->X_sgamma::BR[1.8]@BaBar-2012"));
+            catalog.push_back(make_sampler_benchmark("B->K^*mumu",
+                        {
+                            "B^0->K^*0mu^+mu^-::BR[1.00,6.00]@LHCb-2011",
+                            "B^0->K^*0mu^+mu^-::BR[14.18,16.00]@LHCb-2011"
+                        },
+                        {
+                            std::make_tuple("b->smumu::Re{c9}", 2.0, 6.0),
+                            std::make_tuple("b->smumu::Re{c10}", -6.0, -2.0)
+                        },
+                        seed));
+            catalog.push_back(make_hdf5_benchmark("samples", 16, scratch));
+        }
+
+        void parse(int argc, char ** argv)
+        {
+            Log::instance()->set_program_name("eos-benchmark");
+
+            std::vector<std::pair<std::string, double>> kinematics;
+            std::vector<Benchmark> custom;
+
+            for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+            {
+                std::string argument(*a);
+
+                if ("--list" == argument)
+                {
+                    list = true;
+
+                    continue;
+                }
+
+                if ("--benchmark" == argument)
+                {
+                    selection.push_back(std::string(*(++a)));
+
+                    continue;
+                }
+
+                if ("--kinematics" == argument)
+                {
+                    std::string name = std::string(*(++a));
+                    double value = destringify<double>(*(++a));
+                    kinematics.push_back(std::make_pair(name, value));
+
+                    continue;
+                }
+
+                if ("--observable" == argument)
+                {
+                    custom.push_back(make_observable_benchmark(std::string(*(++a)), kinematics));
+                    selection.push_back(custom.back().name);
+                    kinematics.clear();
+
+                    continue;
+                }
+
+                if ("--constraint" == argument)
+                {
+                    custom.push_back(make_constraint_benchmark(std::string(*(++a))));
+                    selection.push_back(custom.back().name);
+
+                    continue;
+                }
+
+                if ("--repetitions" == argument)
+                {
+                    repetitions = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--evaluations" == argument)
+                {
+                    evaluations = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--points" == argument)
+                {
+                    points = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--seed" == argument)
+                {
+                    seed = destringify<unsigned long>(*(++a));
+
+                    continue;
+                }
+
+                if ("--output" == argument)
+                {
+                    output = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--baseline" == argument)
+                {
+                    baseline = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--threshold" == argument)
+                {
+                    threshold = destringify<double>(*(++a));
+
+                    continue;
+                }
+
+                if ("--scratch" == argument)
+                {
+                    scratch = std::string(*(++a));
+
+                    continue;
+                }
+
+                throw DoUsage("Unknown command line argument: " + argument);
+            }
+
+            if (repetitions < 2)
+                throw DoUsage("Need at least two repetitions to estimate the uncertainty");
+
+            if ((0 == evaluations) || (0 == points))
+                throw DoUsage("Need a non-zero number of evaluations and points");
+
+            make_catalog();
+            catalog.insert(catalog.end(), custom.begin(), custom.end());
+        }
+};
+
+/*
+ * Two-sided 95% quantile of Student's t distribution.
+ */
+double
+student_t_quantile(const unsigned & dof)
+{
+    static const double quantiles[] =
+    {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+
+    if ((0 < dof) && (dof <= sizeof(quantiles) / sizeof(quantiles[0])))
+        return quantiles[dof - 1];
+
+    return 1.960;
+}
+
+Result
+run(const Benchmark & benchmark)
+{
+    const CommandLine & cl = *CommandLine::instance();
+
+    Parameters parameters = Parameters::Defaults();
+    Workload workload = benchmark.make(parameters);
+
+    // fixed random points, reproducible through the seed
+    std::mt19937_64 rng(cl.seed);
+    std::vector<std::vector<double>> points(cl.points, std::vector<double>(workload.parameters.size()));
+    for (auto & point : points)
+    {
+        for (unsigned j = 0 ; j < workload.parameters.size() ; ++j)
+        {
+            const Parameter & p = workload.parameters[j];
+
+            if (p.min() < p.max())
+            {
+                point[j] = std::uniform_real_distribution<double>(p.min(), p.max())(rng);
+            }
+            else
+            {
+                point[j] = p.central();
+            }
+        }
+    }
+
+    auto pin = [&] (const std::vector<double> & point)
+    {
+        for (unsigned j = 0 ; j < point.size() ; ++j)
+        {
+            workload.parameters[j] = point[j];
+        }
+    };
+
+    // warm up, e.g. for static tables and lazily initialised members
+    for (const auto & point : points)
+    {
+        pin(point);
+        workload.evaluate();
+    }
+
+    std::vector<double> samples;
+    for (unsigned r = 0 ; r < cl.repetitions ; ++r)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (unsigned e = 0 ; e < cl.evaluations ; ++e)
+        {
+            pin(points[e % points.size()]);
+            workload.evaluate();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+        samples.push_back(ns / (cl.evaluations * workload.batch));
+    }
+
+    double mean = 0.0;
+    for (const auto & s : samples)
+    {
+        mean += s;
+    }
+    mean /= samples.size();
+
+    double variance = 0.0;
+    for (const auto & s : samples)
+    {
+        variance += (s - mean) * (s - mean);
+    }
+    variance /= (samples.size() - 1);
+
+    double delta = student_t_quantile(samples.size() - 1) * std::sqrt(variance / samples.size());
+
+    return Result{ benchmark.name, cl.repetitions, cl.evaluations, mean, mean - delta, mean + delta };
+}
+
+void
+write_results(std::ostream & stream, const std::vector<Result> & results)
+{
+    stream << "# name\trepetitions\tevaluations\tns/eval\tlower[95%]\tupper[95%]" << std::endl;
+    for (const auto & r : results)
+    {
+        stream << r.name << '\t' << r.repetitions << '\t' << r.evaluations << '\t'
+               << r.mean << '\t' << r.lower << '\t' << r.upper << std::endl;
+    }
+}
+
+std::map<std::string, Result>
+read_results(const std::string & file_name)
+{
+    std::ifstream file(file_name);
+    if (! file)
+        throw DoUsage("Cannot open baseline file '" + file_name + "'");
+
+    std::map<std::string, Result> result;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || ('#' == line[0]))
+            continue;
+
+        std::vector<std::string> columns;
+        std::istringstream stream(line);
+        std::string column;
+        while (std::getline(stream, column, '\t'))
+        {
+            columns.push_back(column);
+        }
+
+        if (6 != columns.size())
+            throw DoUsage("Malformed line in baseline file '" + file_name + "': " + line);
+
+        result[columns[0]] = Result
+        {
+            columns[0],
+            destringify<unsigned>(columns[1]),
+            destringify<unsigned>(columns[2]),
+            destringify<double>(columns[3]),
+            destringify<double>(columns[4]),
+            destringify<double>(columns[5])
+        };
+    }
+
+    return result;
+}
+
+/*
+ * Compare results against a baseline. A benchmark regresses if it is slower by more than the
+ * threshold and the confidence intervals do not overlap.
+ *
+ * Returns the number of regressions.
+ */
+unsigned
+compare(const std::vector<Result> & results, const std::map<std::string, Result> & baseline, const double & threshold)
+{
+    unsigned regressions = 0;
+
+    std::cout << "# name\tns/eval\tbaseline\tratio\tstatus" << std::endl;
+    for (const auto & r : results)
+    {
+        auto b = baseline.find(r.name);
+        if (baseline.end() == b)
+        {
+            std::cout << r.name << '\t' << r.mean << "\t-\t-\tnew" << std::endl;
+            continue;
+        }
+
+        double ratio = r.mean / b->second.mean;
+        std::string status = "unchanged";
+
+        if ((ratio > 1.0 + threshold) && (r.lower > b->second.upper))
+        {
+            status = "slower";
+            ++regressions;
+        }
+        else if ((ratio < 1.0 - threshold) && (r.upper < b->second.lower))
+        {
+            status = "faster";
+        }
+
+        std::cout << r.name << '\t' << r.mean << '\t' << b->second.mean << '\t' << ratio << '\t' << status << std::endl;
+    }
+
+    return regressions;
+}
+
+int
+main(int argc, char * argv[])
+{
+    try
+    {
+        CommandLine::instance()->parse(argc, argv);
+        const CommandLine & cl = *CommandLine::instance();
+
+        if (cl.list)
+        {
+            for (const auto & b : cl.catalog)
+            {
+                std::cout << b.name << '\t' << b.description << std::endl;
+            }
+
+            return EXIT_SUCCESS;
+        }
+
+        std::vector<Benchmark> benchmarks;
+        if (cl.selection.empty())
+        {
+            benchmarks = cl.catalog;
+        }
+        else
+        {
+            for (const auto & name : cl.selection)
+            {
+                auto b = std::find_if(cl.catalog.cbegin(), cl.catalog.cend(), [&] (const Benchmark & b) { return b.name == name; });
+                if (cl.catalog.cend() == b)
+                    throw DoUsage("Unknown benchmark '" + name + "'");
+
+                benchmarks.push_back(*b);
+            }
+        }
+
+        std::vector<Result> results;
+        for (const auto & b : benchmarks)
+        {
+            results.push_back(run(b));
+        }
+        std::remove(cl.scratch.c_str());
+
+        write_results(std::cout, results);
+
+        if (! cl.output.empty())
+        {
+            std::ofstream file(cl.output);
+            if (! file)
+                throw DoUsage("Cannot open output file '" + cl.output + "'");
+
+            file.precision(10);
+            write_results(file, results);
+        }
+
+        if (! cl.baseline.empty())
+        {
+            if (0 != compare(results, read_results(cl.baseline), cl.threshold))
+                return EXIT_FAILURE;
+        }
+    }
+    catch(DoUsage & e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << "Usage: eos-benchmark" << std::endl;
+        std::cout << "  [--list]" << std::endl;
+        std::cout << "  [--benchmark NAME]*" << std::endl;
+        std::cout << "  [[--kinematics NAME VALUE]* --observable OBSERVABLE]*" << std::endl;
+        std::cout << "  [--constraint CONSTRAINT]*" << std::endl;
+        std::cout << "  [--repetitions REPETITIONS] [--evaluations EVALUATIONS] [--points POINTS] [--seed SEED]" << std::endl;
+        std::cout << "  [--output FILE] [--baseline FILE [--threshold THRESHOLD]]" << std::endl;
+        std::cout << "  [--scratch FILE]" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Runs all benchmarks from the catalog (see --list), or only the selected ones. Each benchmark" << std::endl;
+        std::cout << "cycles through POINTS fixed random parameter points, and reports the mean time per evaluation" << std::endl;
+        std::cout << "in ns with a 95% confidence interval over REPETITIONS repetitions of EVALUATIONS evaluations." << std::endl;
+        std::cout << "Results written with --output can be passed as --baseline to later runs; the program fails" << std::endl;
+        std::cout << "if any benchmark is slower than its baseline by more than THRESHOLD (default: 0.05)." << std::endl;
+        std::cout << std::endl;
+        std::cout << "Example:" << std::endl;
+        std::cout << "  eos-benchmark --output baseline.tsv" << std::endl;
+        std::cout << "  eos-benchmark --benchmark \"observable:B->K^*ll::BR@LargeRecoil\" \\" << std::endl;
+        std::cout << "                --kinematics q2 2.0 --observable \"B->K^*::T_1(q2)\" \\" << std::endl;
+        std::cout << "                --baseline baseline.tsv" << std::endl;
+    }
+    catch(Exception & e)
+    {
+        std::cerr << "Caught exception: '" << e.what() << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch(...)
+    {
+        std::cerr << "Aborting after unknown exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -255,6 +255,27 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--store-observables" == argument)
+                {
+                    config.store_observables = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--batch-size" == argument)
+                {
+                    config.batch_size = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--compute-covariance" == argument)
+                {
+                    config.compute_covariance = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
                 /*
                  * format: N_SIGMAS in [0, 10]
                  * a) --scan PAR N_SIGMAS --prior ...
@@ -416,43 +437,29 @@ int main(int argc, char * argv[])
                 auto f = hdf5::File::Open(inst->mcmc_sample_file);
                 descriptions = LogPosterior::read_descriptions(f, "/descriptions/prerun/chain #0");
 
-                // we only read chains from one file
-                std::vector<HistoryPtr> chains;
-                {
-                    std::vector<std::shared_ptr<hdf5::File>> input_files;
-                    input_files.push_back(std::make_shared<hdf5::File>(hdf5::File::Open(inst->mcmc_sample_file, H5F_ACC_RDONLY)));
-
-                    // check if main run exists: prefer that, otherwise read the prerun
-                    std::string base("/main run");
-                    const bool have_main = input_files.front()->group_exists(base);
-                    if ((have_main && inst->mcmc_prefer_prerun) || ! have_main)
-                        base = "/prerun";
-                    chains = MarkovChainSampler::read_chains(input_files, base);
-                }
+                // check if main run exists: prefer that, otherwise read the prerun
+                std::string base("/main run");
+                const bool have_main = f.group_exists(base);
+                if ((have_main && inst->mcmc_prefer_prerun) || ! have_main)
+                    base = "/prerun";
 
-                // copy points into expected format
+                // copy slice of samples [a,b] from each chain, but ignore b if it extends beyond the length of the chain to accomodate chains with variable lengths
                 unsigned i = 0;
-                for (const auto & c : chains)
+                for ( ; f.group_exists(base + "/chain #" + std::to_string(i)) ; ++i)
                 {
-                    if (inst->mcmc_sample_min > c->states.size())
+                    const unsigned length = MarkovChain::read_samples(f, base + "/chain #" + std::to_string(i),
+                            inst->mcmc_sample_min, inst->mcmc_sample_max, samples);
+
+                    if (inst->mcmc_sample_min > length)
                     {
                         throw DoUsage("For chain " + std::to_string(i) +
                                       ", the minimum MCMC sample index is larger than the chain's length = " +
-                                      std::to_string(c->states.size()));
+                                      std::to_string(length));
                     }
-
-                    // copy slice of samples [a,b] but ignore b if it extends beyond the length of the chain to accomodate chains with variable lengths
-                    auto s = c->states.begin() + inst->mcmc_sample_min;
-                    const auto end = std::distance(s, c->states.end()) > (inst->mcmc_sample_max - inst->mcmc_sample_min) ?
-                        c->states.begin() + inst->mcmc_sample_max :
-                        c->states.end();
-
-                    for (; s != end; ++s)
-                    {
-                        samples.emplace_back(s->point);
-                    }
-                    ++i;
                 }
+
+                if (0 == i)
+                    throw InternalError("Did not find any usable data in file '" + inst->mcmc_sample_file + "'");
             }
 
             sampler.run(samples, descriptions);
@@ -483,13 +490,19 @@ int main(int argc, char * argv[])
         std::cout << "  [--pmc-input FILENAME MIN_INDEX MAX_INDEX]" << std::endl;
 #endif
         std::cout << "  [--seed LONG_VALUE]" << std::endl;
-        std::cout << "  [--store-parameters]" << std::endl;
+        std::cout << "  [--store-parameters [0|1]]" << std::endl;
+        std::cout << "  [--store-observables [0|1]]" << std::endl;
+        std::cout << "  [--batch-size VALUE]" << std::endl;
+        std::cout << "  [--compute-covariance [0|1]]" << std::endl;
         std::cout << std::endl;
         std::cout << "Vary (nuisance) parameters in consistent way to estimate the uncertainty" << std::endl;
         std::cout << "on theory prediction of observables. Parameter samples are drawn from" << std::endl;
         std::cout << "prior distributions and the observables are calculated and stored to disk." << std::endl;
         std::cout << "One thread is created for each chunk." << std::endl;
         std::cout << "Optionally, the drawn parameters are stored as well." << std::endl;
+        std::cout << "Samples are written to disk in batches. The means, variances and quantiles of the" << std::endl;
+        std::cout << "observables, and optionally their covariance, are stored in '/summary/observables'." << std::endl;
+        std::cout << "Storing the observable values themselves can be disabled." << std::endl;
         std::cout << std::endl;
         std::cout << "MCMC options:" << std::endl;
         std::cout << "If an input file is specified, a slice of the samples from each chain in the file is taken," << std::endl;
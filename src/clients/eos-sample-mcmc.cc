@@ -237,6 +237,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--checkpoint" == argument)
+                {
+                    mcmc_config.checkpoint_file = std::string(*(++a));
+
+                    continue;
+                }
+
                 if ("--chunk-size" == argument)
                 {
                     mcmc_config.chunk_size = destringify<unsigned>(*(++a));
@@ -343,6 +350,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--profile" == argument)
+                {
+                    likelihood.observable_cache().enable_profiling();
+
+                    continue;
+                }
+
                 if ("--parallel" == argument)
                 {
                     mcmc_config.parallelize = destringify<unsigned>(*(++a));
@@ -350,6 +364,28 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--delayed-rejection" == argument)
+                {
+                    mcmc_config.delayed_rejection = true;
+                    mcmc_config.delayed_rejection_scale = destringify<double>(*(++a));
+
+                    continue;
+                }
+
+                if ("--multiple-tries" == argument)
+                {
+                    mcmc_config.multiple_tries = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--parallel-within-chains" == argument)
+                {
+                    mcmc_config.parallelize_within_chains = true;
+
+                    continue;
+                }
+
                 // todo rename here and in scripts
                 if ("--prerun-chains-per-partition" == argument)
                 {
@@ -435,6 +471,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--resume" == argument)
+                {
+                    mcmc_config.resume = true;
+
+                    continue;
+                }
+
                 if ("--scale-nuisance" == argument)
                 {
                     scale_nuisance = destringify<unsigned>(*(++a));
@@ -548,12 +591,17 @@ int main(int argc, char * argv[])
         std::cout << "  [--constraint NAME]+" << std::endl;
         std::cout << "  [ [ [--scan PARAMETER MIN MAX] | [--nuisance PARAMETER MIN MAX] ] --prior [flat | [gaussian LOWER CENTRAL UPPER] ] ]+" << std::endl;
         std::cout << "  [--chains VALUE]" << std::endl;
+        std::cout << "  [--checkpoint FILENAME [--resume]]" << std::endl;
         std::cout << "  [--chunks VALUE]" << std::endl;
         std::cout << "  [--chunksize VALUE]" << std::endl;
         std::cout << "  [--debug]" << std::endl;
+        std::cout << "  [--delayed-rejection SCALE]" << std::endl;
         std::cout << "  [--fix PARAMETER VALUE]+" << std::endl;
+        std::cout << "  [--multiple-tries VALUE]" << std::endl;
         std::cout << "  [--no-prerun]" << std::endl;
         std::cout << "  [--output FILENAME]" << std::endl;
+        std::cout << "  [--parallel-within-chains]" << std::endl;
+        std::cout << "  [--profile]" << std::endl;
         std::cout << "  [--scale VALUE]" << std::endl;
         std::cout << "  [--seed LONG_VALUE]" << std::endl;
         std::cout << "  [--store-prerun]" << std::endl;
@@ -248,6 +248,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--checkpoint" == argument)
+                {
+                    config_pmc.checkpoint_file = std::string(*(++a));
+
+                    continue;
+                }
+
                 if ("--constraint" == argument)
                 {
                     std::string constraint_name(*(++a));
@@ -302,6 +309,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--hc-kmeans-seeding" == argument)
+                {
+                    config_pmc.kmeans_seeding = true;
+
+                    continue;
+                }
+
                 if ("--hc-patch-length" == argument)
                 {
                     config_pmc.patch_length = destringify<double> (*(++a));
@@ -523,6 +537,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--resume" == argument)
+                {
+                    config_pmc.resume = true;
+
+                    continue;
+                }
+
                 if ("--seed" == argument)
                 {
                     std::string value(*(++a));
@@ -647,6 +668,7 @@ int main(int argc, char * argv[])
         std::cout << "  [ [--kinematics NAME VALUE]* --observable NAME LOWER CENTRAL UPPER]+" << std::endl;
         std::cout << "  [--constraint NAME]+" << std::endl;
         std::cout << "  [ [ [--scan PARAMETER MIN MAX] | [--nuisance PARAMETER MIN MAX] ] --prior [flat | [gaussian LOWER CENTRAL UPPER] ] ]+" << std::endl;
+        std::cout << "  [--checkpoint FILENAME [--resume]]" << std::endl;
         std::cout << "  [--debug]" << std::endl;
         std::cout << "  [--fix PARAMETER VALUE]+" << std::endl;
         std::cout << "  [--output FILENAME]" << std::endl;